@@ -1,5 +1,19 @@
 #include "Application.hpp"
 
+#include "Platform/InputRecording.hpp"
+
+#include "Utility/FixedTimestep.hpp"
+#include "Utility/PreciseSleeper.hpp"
+#include "Utility/Utility.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+
 Application::Application(Platform::Input& p_input, Platform::Window& p_window) noexcept
 	: m_input{p_input}
 	, m_window{p_window}
@@ -9,13 +23,21 @@ Application::Application(Platform::Input& p_input, Platform::Window& p_window) n
 	, m_openGL_renderer{m_window, m_scene_system, m_mesh_system, m_texture_system}
 	, m_collision_system{m_scene_system}
 	, m_physics_system{m_scene_system, m_collision_system}
-	, m_input_system{m_input, m_window, m_scene_system}
+	, m_input_system{m_input, m_scene_system}
 	, m_editor{m_input, m_window, m_texture_system, m_mesh_system, m_scene_system, m_collision_system, m_physics_system, m_openGL_renderer}
-	, m_simulation_loop_params_changed{false}
 	, m_physics_ticks_per_second{60}
 	, m_render_ticks_per_second{120}
 	, m_input_ticks_per_second{120}
 	, maxFrameDelta{std::chrono::milliseconds(250)}
+	, m_statistics{}
+	, m_input_timings{m_statistics.add_timings("input")}
+	, m_integrate_timings{m_statistics.add_timings("physics_integrate")}
+	, m_collision_timings{m_statistics.add_timings("collision_update")}
+	, m_publish_timings{m_statistics.add_timings("publish_transforms")}
+	, m_scene_update_timings{m_statistics.add_timings("scene_update")}
+	, m_render_timings{m_statistics.add_timings("render")}
+	, m_editor_timings{m_statistics.add_timings("editor")}
+	, m_frame_timings{m_statistics.add_timings("frame")}
 {
 	Logger::s_editor_sink = &m_editor;
 }
@@ -24,204 +46,252 @@ Application::~Application() noexcept
 	Logger::s_editor_sink = nullptr;
 }
 
-void Application::simulation_loop()
+void Application::simulation_loop(const std::filesystem::path& p_record_input_to)
 {
-	while (!m_window.close_requested())
+	using Clock = Utility::FixedTimestep::Clock;
+
+	// The tick rates are recorded as they are at the start, a replay of a recording that changed them won't match it.
+	std::optional<Platform::InputRecorder> input_recorder;
+	if (!p_record_input_to.empty())
+	{
+		const uint32_t seed = std::random_device{}();
+		Utility::set_random_seed(seed);
+		input_recorder.emplace(m_input, p_record_input_to, Platform::InputLogHeader{m_physics_ticks_per_second, m_input_ticks_per_second, m_render_ticks_per_second, seed, m_input.cursor_position()});
+	}
+
+	const Clock::time_point time_started = Clock::now();
+	Utility::FixedTimestep render_ticks{m_render_ticks_per_second, time_started};
+	Utility::FixedTimestep input_ticks{m_input_ticks_per_second, time_started};
+
+	LOG("Target physics ticks per second: {} (timestep: {}ms)", m_physics_ticks_per_second.load(), 1000.f / m_physics_ticks_per_second);
+	LOG("Target render ticks per second:  {} (timestep: {}ms)", render_ticks.ticks_per_second(), 1000.f / render_ticks.ticks_per_second());
+	LOG("Target input ticks per second:   {} (timestep: {}ms)", input_ticks.ticks_per_second(), 1000.f / input_ticks.ticks_per_second());
+
+	// The physics runs on its own thread updating by a fixed timestep independent of the render rate.
+	// Clock time is produced and the simulation consumes it in discrete timestep sized steps, sleeping until the next step is due.
+	// Each step holds the scene mutex and ends by publishing the RigidBody Transforms for the renderer to read lock-free.
+	Utility::FixedTimestep physics_ticks{m_physics_ticks_per_second, time_started};
+	Utility::PreciseSleeper physics_sleeper;
+	m_physics_system.publish_transforms(physics_ticks.current_time(), physics_ticks.timestep()); // Before the thread starts so the first render has a snapshot.
+	std::atomic<bool> physics_running = true;
+	std::thread physics_thread([&]()
 	{
-		ASSERT(m_physics_ticks_per_second == 30   || m_physics_ticks_per_second == 60   || m_physics_ticks_per_second == 90   || m_physics_ticks_per_second == 120,   "[APPLICATION] Physics ticks per second requested invalid!");
-		ASSERT(m_render_ticks_per_second == 30    || m_render_ticks_per_second == 60    || m_render_ticks_per_second == 90    || m_render_ticks_per_second == 120,    "[APPLICATION] Render ticks per second requested invalid!");
-		ASSERT(m_input_ticks_per_second == 30 || m_input_ticks_per_second == 60 || m_input_ticks_per_second == 90 || m_input_ticks_per_second == 120, "[APPLICATION] Input ticks per second requested invalid!");
+		while (physics_running.load(std::memory_order_relaxed))
+		{
+			physics_ticks.set_ticks_per_second(m_physics_ticks_per_second);
+
+			const Clock::time_point now = Clock::now();
+			physics_ticks.limit_backlog(now, maxFrameDelta);
+
+			// Apply physics updates until the next step is in the future.
+			while (physics_ticks.consume(now))
+				physics_tick(physics_ticks.timestep(), physics_ticks.current_time());
+
+			physics_sleeper.sleep_until(physics_ticks.next_tick());
+		}
+	});
+
+	Clock::time_point time_last_render = time_started;
+	Utility::PreciseSleeper main_sleeper;
+
+	// Continuous loop until the main window is marked for closing or Input requests close.
+	// The main thread polls input and renders, taking the scene mutex only while it reads or changes the state the physics thread writes.
+	// Input and render ticks that were missed are skipped rather than caught up, repeating them would produce identical results.
+	// Between ticks the thread sleeps until the next input or render tick is due rather than polling the clock.
+	while (true)
+	{
+		OpenGL::DebugRenderer::clear();
+		render_ticks.set_ticks_per_second(m_render_ticks_per_second);
+		input_ticks.set_ticks_per_second(m_input_ticks_per_second);
+
+		if (input_ticks.consume(Clock::now()))
+		{
+			input_ticks.skip_missed(Clock::now());
 
-		switch (m_physics_ticks_per_second)
+			Utility::Benchmark::ScopedTimer timer{m_input_timings};
+			std::scoped_lock lock{m_scene_system.get_mutex()}; // Input events are dispatched to the Editor which can change the scene.
+			m_input.update(); // Poll events then check close_requested.
+			if (m_window.close_requested())
+				break;
+
+			m_input_system.update(input_ticks.timestep());
+
+			// The physics thread is waiting on the lock, so its tick count is exactly the physics tick boundary this input tick follows.
+			if (input_recorder)
+				input_recorder->end_tick(m_physics_system.m_update_count, std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - time_started));
+		}
+
+		const Clock::time_point now = Clock::now();
+		if (render_ticks.consume(now))
 		{
-			case 30:
-			{
-				switch (m_render_ticks_per_second)
-				{
-					case 30:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<30, 30, 30>();    break;
-							case 60:  simulation_loop<30, 30, 60>();    break;
-							case 90:  simulation_loop<30, 30, 90>();    break;
-							case 120: simulation_loop<30, 30, 120>();   break;
-						} break;
-					}
-					case 60:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<30, 60, 30>();    break;
-							case 60:  simulation_loop<30, 60, 60>();    break;
-							case 90:  simulation_loop<30, 60, 90>();    break;
-							case 120: simulation_loop<30, 60, 120>();   break;
-						} break;
-					}
-					case 90:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<30, 90, 30>();    break;
-							case 60:  simulation_loop<30, 90, 60>();    break;
-							case 90:  simulation_loop<30, 90, 90>();    break;
-							case 120: simulation_loop<30, 90, 120>();   break;
-						} break;
-					}
-					case 120:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<30, 120, 30>();   break;
-							case 60:  simulation_loop<30, 120, 60>();   break;
-							case 90:  simulation_loop<30, 120, 90>();   break;
-							case 120: simulation_loop<30, 120, 120>();  break;
-						} break;
-					}
-				} break;
-			}
-			case 60:
-			{
-				switch (m_render_ticks_per_second)
-				{
-					case 30:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<60, 30, 30>();    break;
-							case 60:  simulation_loop<60, 30, 60>();    break;
-							case 90:  simulation_loop<60, 30, 90>();    break;
-							case 120: simulation_loop<60, 30, 120>();   break;
-						} break;
-					}
-					case 60:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<60, 60, 30>();    break;
-							case 60:  simulation_loop<60, 60, 60>();    break;
-							case 90:  simulation_loop<60, 60, 90>();    break;
-							case 120: simulation_loop<60, 60, 120>();   break;
-						} break;
-					}
-					case 90:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<60, 90, 30>();    break;
-							case 60:  simulation_loop<60, 90, 60>();    break;
-							case 90:  simulation_loop<60, 90, 90>();    break;
-							case 120: simulation_loop<60, 90, 120>();   break;
-						} break;
-					}
-					case 120:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<60, 120, 30>();   break;
-							case 60:  simulation_loop<60, 120, 60>();   break;
-							case 90:  simulation_loop<60, 120, 90>();   break;
-							case 120: simulation_loop<60, 120, 120>();  break;
-						} break;
-					}
-				} break;
-			}
-			case 90:
-			{
-				switch (m_render_ticks_per_second)
-				{
-					case 30:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<90, 30, 30>();    break;
-							case 60:  simulation_loop<90, 30, 60>();    break;
-							case 90:  simulation_loop<90, 30, 90>();    break;
-							case 120: simulation_loop<90, 30, 120>();   break;
-						} break;
-					}
-					case 60:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<90, 60, 30>();    break;
-							case 60:  simulation_loop<90, 60, 60>();    break;
-							case 90:  simulation_loop<90, 60, 90>();    break;
-							case 120: simulation_loop<90, 60, 120>();   break;
-						} break;
-					}
-					case 90:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<90, 90, 30>();    break;
-							case 60:  simulation_loop<90, 90, 60>();    break;
-							case 90:  simulation_loop<90, 90, 90>();    break;
-							case 120: simulation_loop<90, 90, 120>();   break;
-						} break;
-					}
-					case 120:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<90, 120, 30>();   break;
-							case 60:  simulation_loop<90, 120, 60>();   break;
-							case 90:  simulation_loop<90, 120, 90>();   break;
-							case 120: simulation_loop<90, 120, 120>();  break;
-						} break;
-					}
-				} break;
-			}
-			case 120:
-			{
-				switch (m_render_ticks_per_second)
-				{
-					case 30:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<120, 30, 30>();   break;
-							case 60:  simulation_loop<120, 30, 60>();   break;
-							case 90:  simulation_loop<120, 30, 90>();   break;
-							case 120: simulation_loop<120, 30, 120>();  break;
-						} break;
-					}
-					case 60:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<120, 60, 30>();   break;
-							case 60:  simulation_loop<120, 60, 60>();   break;
-							case 90:  simulation_loop<120, 60, 90>();   break;
-							case 120: simulation_loop<120, 60, 120>();  break;
-						} break;
-					}
-					case 90:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<120, 90, 30>();   break;
-							case 60:  simulation_loop<120, 90, 60>();   break;
-							case 90:  simulation_loop<120, 90, 90>();   break;
-							case 120: simulation_loop<120, 90, 120>();  break;
-						} break;
-					}
-					case 120:
-					{
-						switch (m_input_ticks_per_second)
-						{
-							case 30:  simulation_loop<120, 120, 30>();  break;
-							case 60:  simulation_loop<120, 120, 60>();  break;
-							case 90:  simulation_loop<120, 120, 90>();  break;
-							case 120: simulation_loop<120, 120, 120>(); break;
-						} break;
-					}
-				} break;
-			}
+			render_ticks.skip_missed(now);
+			const DeltaTime duration_since_last_render = std::min<Clock::duration>(now - time_last_render, maxFrameDelta);
+			time_last_render = now;
+			render_tick(duration_since_last_render, now);
 		}
 
-		// After exiting a simulation loop we may have requested a physics timestep change.
-		// Reset this flag to not exit the next simulation_loop when looping back around this While().
-		m_simulation_loop_params_changed = false;
+		main_sleeper.sleep_until(std::min(input_ticks.next_tick(), render_ticks.next_tick()));
 	}
-}
\ No newline at end of file
+
+	physics_running = false;
+	physics_thread.join();
+	if (input_recorder)
+		input_recorder->finish(m_physics_system.m_update_count);
+
+	record_statistics(Clock::now() - time_started);
+	LOG("------------------------------------------------------------------------");
+	LOG("Simulation statistics:\n{}", m_statistics.to_JSON());
+
+	#ifndef Z_RELEASE
+	auto log_sleeper = [](const char* p_thread_name, const Utility::PreciseSleeper& p_sleeper)
+	{
+		const auto& oversleep = p_sleeper.oversleep();
+		LOG("{} thread sleeps: {}, oversleep mean: {:.1f}us, jitter (std dev): {:.1f}us, max: {:.1f}us, mean spin: {:.1f}us", p_thread_name,
+			oversleep.count, oversleep.mean, oversleep.standard_deviation(), oversleep.max, p_sleeper.spin().mean);
+	};
+	log_sleeper("Main", main_sleeper);
+	log_sleeper("Physics", physics_sleeper);
+	#endif
+}
+
+void Application::benchmark(const Utility::Benchmark::Parameters& p_parameters)
+{
+	using Clock = Utility::FixedTimestep::Clock;
+
+	// A replay runs at the rates and seed it was recorded with, its input ticks need the physics ticks to fall where they did.
+	std::optional<Platform::InputReplay> input_replay;
+	std::optional<Utility::Benchmark::Recording> recording;
+	if (!p_parameters.input_log.empty())
+	{
+		input_replay.emplace(m_input, p_parameters.input_log);
+		m_physics_ticks_per_second = input_replay->header().physics_ticks_per_second;
+		m_input_ticks_per_second   = input_replay->header().input_ticks_per_second;
+		m_render_ticks_per_second  = input_replay->header().render_ticks_per_second;
+		recording                  = Utility::Benchmark::Recording{input_replay->header().seed, input_replay->physics_ticks()};
+	}
+	const auto run = m_statistics.start_run(p_parameters, recording, [this](std::istream& p_file)
+	{
+		auto& scene = m_scene_system.add_scene();
+		scene       = System::Scene::deserialise(p_file, Config::Save_Version);
+		m_scene_system.set_current_scene(scene);
+	});
+
+	// The length of the run is known, so every duration is kept for exact percentiles without reallocating mid-run.
+	m_input_timings.keep_samples(input_replay ? input_replay->input_ticks() : 0);
+	Utility::Benchmark::keep_samples({&m_integrate_timings, &m_collision_timings, &m_publish_timings}, run.physics_ticks);
+	Utility::Benchmark::keep_samples({&m_scene_update_timings, &m_render_timings, &m_editor_timings, &m_frame_timings}, run.ticks_at(m_render_ticks_per_second, m_physics_ticks_per_second));
+	m_window.set_VSync(false); // Frames would otherwise be capped by the display refresh rate.
+
+	const Clock::time_point time_started = Clock::now();
+	Utility::FixedTimestep physics_ticks{m_physics_ticks_per_second, time_started};
+	Utility::FixedTimestep render_ticks{m_render_ticks_per_second, time_started};
+	const DeltaTime input_timestep = Utility::FixedTimestep{m_input_ticks_per_second, time_started}.timestep();
+	m_physics_system.publish_transforms(physics_ticks.current_time(), physics_ticks.timestep());
+
+	// The clock is the time of whichever tick is due next rather than the wall clock. The ticks interleave exactly as they would
+	// in real time, never wait and never skip, so the work done doesn't depend on how fast the machine is.
+	// Without an input log the InputSystem isn't run, the window is only polled so it stays responsive and can end the benchmark early.
+	// Replayed input ticks run before the physics tick that followed them in the recording, whatever the time.
+	size_t physics_ticks_run = 0;
+	while (physics_ticks_run < run.physics_ticks)
+	{
+		while (input_replay && input_replay->tick_due(physics_ticks_run))
+		{
+			Utility::Benchmark::ScopedTimer timer{m_input_timings};
+			m_input.update(); // Window events are ignored while replaying.
+			input_replay->apply_next_tick();
+			m_input_system.update(input_timestep);
+		}
+
+		const Clock::time_point now = std::min(physics_ticks.next_tick(), render_ticks.next_tick());
+
+		if (physics_ticks.consume(now))
+		{
+			physics_tick(physics_ticks.timestep(), physics_ticks.current_time());
+			physics_ticks_run++;
+		}
+		if (render_ticks.consume(now))
+		{
+			m_input.update();
+			if (m_window.close_requested())
+				break;
+
+			OpenGL::DebugRenderer::clear();
+			render_tick(render_ticks.timestep(), now);
+		}
+	}
+
+	record_statistics(Clock::now() - time_started);
+	m_statistics.write_JSON(p_parameters.output);
+}
+
+void Application::physics_tick(const DeltaTime& p_timestep, std::chrono::steady_clock::time_point p_tick_time)
+{
+	std::scoped_lock lock{m_scene_system.get_mutex()};
+	{
+		Utility::Benchmark::ScopedTimer timer{m_integrate_timings};
+		m_physics_system.integrate(p_timestep);
+	}
+	{
+		Utility::Benchmark::ScopedTimer timer{m_collision_timings};
+		m_collision_system.update();
+	}
+	{
+		Utility::Benchmark::ScopedTimer timer{m_publish_timings};
+		m_physics_system.publish_transforms(p_tick_time, p_timestep);
+	}
+}
+
+void Application::render_tick(const DeltaTime& p_duration_since_last_render, std::chrono::steady_clock::time_point p_now)
+{
+	Utility::Benchmark::ScopedTimer frame_timer{m_frame_timings};
+	{
+		Utility::Benchmark::ScopedTimer timer{m_scene_update_timings};
+		std::scoped_lock lock{m_scene_system.get_mutex()};
+		m_scene_system.get_current_scene().update(m_window.aspect_ratio(), m_editor.get_editor_view_info());
+	}
+
+	// RigidBodies are drawn from the latest published physics tick, the rest of the scene is only written by this thread.
+	// The time since that tick is not discarded, RigidBodies are interpolated by it to where they were between the last two ticks.
+	const auto& transforms    = m_physics_system.latest_transforms();
+	const float physics_alpha = transforms.get_alpha(p_now);
+	m_window.start_ImGui_frame();
+	m_openGL_renderer.start_frame(transforms, physics_alpha);
+	{
+		Utility::Benchmark::ScopedTimer timer{m_render_timings};
+		m_openGL_renderer.draw(p_duration_since_last_render, transforms, physics_alpha);
+	}
+	{
+		Utility::Benchmark::ScopedTimer timer{m_editor_timings};
+		std::scoped_lock lock{m_scene_system.get_mutex()};
+		m_editor.draw(p_duration_since_last_render);
+	}
+
+	m_openGL_renderer.end_frame();
+	m_window.end_ImGui_frame();
+	m_window.swap_buffers();
+}
+
+void Application::record_statistics(std::chrono::steady_clock::duration p_run_time)
+{
+	const double run_time_seconds = std::chrono::duration<double>(p_run_time).count();
+	auto per_second = [run_time_seconds](size_t p_count) { return run_time_seconds > 0.0 ? static_cast<double>(p_count) / run_time_seconds : 0.0; };
+
+	m_statistics.set("run", "wall_time_seconds", run_time_seconds);
+	m_statistics.set("ticks", "physics", static_cast<uint64_t>(m_physics_system.m_update_count));
+	m_statistics.set("ticks", "render",  static_cast<uint64_t>(m_editor.m_draw_count));
+	m_statistics.set("ticks", "input",   static_cast<uint64_t>(m_input_system.m_update_count));
+	m_statistics.set("ticks_per_second", "physics",        per_second(m_physics_system.m_update_count));
+	m_statistics.set("ticks_per_second", "physics_target", static_cast<uint64_t>(m_physics_ticks_per_second.load()));
+	m_statistics.set("ticks_per_second", "render",         per_second(m_editor.m_draw_count));
+	m_statistics.set("ticks_per_second", "render_target",  static_cast<uint64_t>(m_render_ticks_per_second.load()));
+	m_statistics.set("ticks_per_second", "input",          per_second(m_input_system.m_update_count));
+	m_statistics.set("ticks_per_second", "input_target",   static_cast<uint64_t>(m_input_ticks_per_second.load()));
+
+	const auto& entities = m_scene_system.get_current_scene_entities();
+	m_statistics.set("entities", "total",        static_cast<uint64_t>(entities.count_entities()));
+	m_statistics.set("entities", "rigid_bodies", static_cast<uint64_t>(entities.count_components<Component::RigidBody>()));
+	m_statistics.set("entities", "colliders",    static_cast<uint64_t>(entities.count_components<Component::Collider>()));
+	m_statistics.set("entities", "meshes",       static_cast<uint64_t>(entities.count_components<Component::Mesh>()));
+	m_statistics.record_memory_high_water("end");
+}
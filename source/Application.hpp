@@ -16,6 +16,7 @@
 #include "OpenGL/DebugRenderer.hpp"
 #include "OpenGL/OpenGLRenderer.hpp"
 
+#include "Utility/Benchmark.hpp"
 #include "Utility/File.hpp"
 #include "Utility/Logger.hpp"
 #include "Utility/Stopwatch.hpp"
@@ -32,7 +33,10 @@
 #include "Component/Texture.hpp"
 #include "Component/Transform.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <filesystem>
+#include <string_view>
 
 // Application manages the ownership and calling of all the Systems.
 // Taking an OS window it renders and updates the state of an ECS.
@@ -41,7 +45,21 @@ class Application
 public:
 	Application(Platform::Input& p_input, Platform::Window& p_window) noexcept;
 	~Application() noexcept;
-	void simulation_loop();
+	// Run the physics, input and render ticks until the window is closed.
+	// Each is a Utility::FixedTimestep so every tick happens at an exact multiple of its timestep from the start, with no drift.
+	//@param p_record_input_to If not empty, the events of every input tick and the physics tick it followed are written to this
+	// file by a Platform::InputRecorder, to be replayed with --replay. The random seed is then chosen here and recorded.
+	void simulation_loop(const std::filesystem::path& p_record_input_to = {});
+	// Load the scene in p_parameters and run its physics ticks and the render ticks due over the same simulated time, then write the
+	// timings of each system as JSON. The ticks run back to back on the calling thread in the order they are due, so every run
+	// with the same parameters does the same work. If p_parameters has an input log, its input ticks are replayed after the same
+	// physics ticks as when it was recorded.
+	void benchmark(const Utility::Benchmark::Parameters& p_parameters);
+
+	// Tick rates can be changed at any time from any thread, the running simulation_loop picks them up on its next iteration.
+	void set_physics_ticks_per_second(unsigned p_ticks_per_second) { m_physics_ticks_per_second = p_ticks_per_second; }
+	void set_render_ticks_per_second(unsigned p_ticks_per_second)  { m_render_ticks_per_second = p_ticks_per_second; }
+	void set_input_ticks_per_second(unsigned p_ticks_per_second)   { m_input_ticks_per_second = p_ticks_per_second; }
 
 private:
 	Platform::Input& m_input;
@@ -59,121 +77,34 @@ private:
 
 	UI::Editor m_editor;
 
-	bool m_simulation_loop_params_changed;       // True when the template params of simulation_loop change, causes an exit from the loop and re-run
-	int m_physics_ticks_per_second;              // The number of physics updates to perform per second. This is equivalent to the pPhysicsTicksPerSecond template param of simulation_loop.
-	int m_render_ticks_per_second;               // The number of renders to perform per second. This is equivalent to the pRenderTicksPerSecond template param of simulation_loop.
-	int m_input_ticks_per_second;            // The number of input system updates to perform every second;
+	std::atomic<unsigned> m_physics_ticks_per_second; // The number of physics updates to perform per second.
+	std::atomic<unsigned> m_render_ticks_per_second;  // The number of renders to perform per second.
+	std::atomic<unsigned> m_input_ticks_per_second;   // The number of input system updates to perform every second.
 	std::chrono::milliseconds maxFrameDelta; // If the time between loops is beyond this, cap at this duration
 
-	// This simulation loop uses a physics timestep based on integer type giving no truncation or round-off error.
-	// It's required to be templated to allow physicsTimestep to be set using std::ratio as the chrono::duration period.
-	// pPhysicsTicksPerSecond: The target number of physics ticks per second. This template parameter is always equivalent to m_physics_ticks_per_second.
-	// pRenderTicksPerSecond: The target number of renders per second. This template parameter is always equivalent to m_render_ticks_per_second.
-	template <int pPhysicsTicksPerSecond, int pRenderTicksPerSecond, int p_input_ticks_per_second>
-	void simulation_loop()
-	{
-		using Clock = std::chrono::steady_clock;
-
-		constexpr auto physicsTimestep = std::chrono::duration<Clock::rep, std::ratio<1, pPhysicsTicksPerSecond>>{1};
-		constexpr auto renderTimestep  = std::chrono::duration<Clock::rep, std::ratio<1, pRenderTicksPerSecond>>{1};
-		constexpr auto input_timestep  = std::chrono::duration<Clock::rep, std::ratio<1, p_input_ticks_per_second>>{1};
-
-		// The resultant sum of a Clock::duration and physicsTimestep. This will be the coarsest precision that can exactly represent both a Clock::duration and 1/60 of a second.
-		// Time-based arithmetic will have no truncation error, or any round-off error if Clock::duration is integral-based (std::chrono::nanoseconds for steady_clock is integral based).
-		using Duration  = decltype(Clock::duration{} + physicsTimestep);
-		using TimePoint = std::chrono::time_point<Clock, Duration>;
-
-		LOG("Target physics ticks per second: {} (timestep: {}ms = {})", pPhysicsTicksPerSecond, std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(physicsTimestep).count(), physicsTimestep);
-		LOG("Target render ticks per second:  {} (timestep: {}ms = {})", pRenderTicksPerSecond, std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(renderTimestep).count(), renderTimestep);
-		LOG("Target input ticks per second:   {} (timestep: {}ms = {})", p_input_ticks_per_second, std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(input_timestep).count(), input_timestep);
-
-		Duration duration_since_last_physics_tick   = Duration::zero();     // Accumulated time since the last physics update.
-		Duration duration_since_last_render_tick    = Duration::zero();     // Accumulated time since the last render.
-		Duration duration_since_last_input_tick = Duration::zero();     // Accumulated time since the last input update.
-		Duration duration_since_last_frame         = Duration::zero();     // Time between this frame and last frame.
-		Duration duration_application_running     = Duration::zero();     // Total time the application has been running.
-
-		TimePoint physics_time{};      // The time point the physics is advanced to currently.
-		TimePoint time_frame_started{}; // The time point at the start of a new frame.
-		TimePoint time_last_frame_started = Clock::now();
-
-		// Continuous loop until the main window is marked for closing or Input requests close.
-		// While looping the physics updates by fixed timestep physicsTimestep
-		// The renderer produces time and the simulation consumes it in discrete physicsTimestep sized steps
-		while (true)
-		{
-			OpenGL::DebugRenderer::clear();
-
-			if (duration_since_last_input_tick >= input_timestep)
-			{
-				m_input.update(); // Poll events then check close_requested.
-				if (m_window.close_requested() || m_simulation_loop_params_changed)
-					break;
-
-				m_input_system.update(input_timestep);
-				duration_since_last_input_tick = Duration::zero();
-			}
-
-			time_frame_started = Clock::now();
-			duration_since_last_frame = time_frame_started - time_last_frame_started;
-			if (duration_since_last_frame > maxFrameDelta)
-				duration_since_last_frame = maxFrameDelta;
-
-			time_last_frame_started            = time_frame_started;
-			duration_application_running      += duration_since_last_frame;
-			duration_since_last_physics_tick  += duration_since_last_frame;
-			duration_since_last_render_tick   += duration_since_last_frame;
-			duration_since_last_input_tick    += duration_since_last_frame;
-
-			// Apply physics updates until accumulated time is below physicsTimestep step
-			while (duration_since_last_physics_tick >= physicsTimestep)
-			{
-				duration_since_last_physics_tick -= physicsTimestep;
-				physics_time                     += physicsTimestep;
-				m_physics_system.integrate(physicsTimestep); // PhysicsSystem::Integrate takes a floating point rep duration, conversion here is troublesome.
-				m_collision_system.update();
-			}
-
-			if (duration_since_last_render_tick >= renderTimestep)
-			{
-				m_scene_system.get_current_scene().update(m_window.aspect_ratio(), m_editor.get_editor_view_info());
-
-				// Rendering is only relevant if the data changed in the physics update.
-				// Not neccessary to decrement duration_since_last_render_tick as in physics update above as repeated draws will be identical with no data changes.
-				m_window.start_ImGui_frame();
-				m_openGL_renderer.start_frame();
-
-				m_openGL_renderer.draw(duration_since_last_render_tick);
-				m_editor.draw(duration_since_last_render_tick);
-
-				m_openGL_renderer.end_frame();
-				m_window.end_ImGui_frame();
-				m_window.swap_buffers();
-
-				duration_since_last_render_tick = Duration::zero();
-			}
-		}
-
-		#ifndef Z_RELEASE
-		const auto total_time_seconds = std::chrono::duration_cast<std::chrono::seconds>(duration_application_running);
-		const float render_FPS  = static_cast<float>(m_editor.m_draw_count)           / total_time_seconds.count();
-		const float physics_FPS = static_cast<float>(m_physics_system.m_update_count) / total_time_seconds.count();
-		const float input_FPS   = static_cast<float>(m_input_system.m_update_count)   / total_time_seconds.count();
-
-		LOG("------------------------------------------------------------------------");
-		LOG("Total simulation time: {}", total_time_seconds);
-		LOG("Total physics updates: {}", m_physics_system.m_update_count);
-		LOG("Averaged physics updates per second: {}/s (target: {}/s)", physics_FPS, pPhysicsTicksPerSecond);
-		LOG("Total rendered frames: {}", m_editor.m_draw_count);
-		LOG("Averaged render frames per second: {}/s (target: {}/s)", render_FPS, pRenderTicksPerSecond);
-		LOG("Total input updates: {}", m_input_system.m_update_count);
-		LOG("Averaged input updates per second: {}/s (target: {}/s)", input_FPS, p_input_ticks_per_second);
-		#endif
-	}
+	// The duration of every update of each system, reported when simulation_loop or benchmark end. Binned in simulation_loop, kept in full by benchmark.
+	Utility::Benchmark m_statistics;
+	Utility::Benchmark::Timings& m_input_timings;
+	Utility::Benchmark::Timings& m_integrate_timings;
+	Utility::Benchmark::Timings& m_collision_timings;
+	Utility::Benchmark::Timings& m_publish_timings;
+	Utility::Benchmark::Timings& m_scene_update_timings;
+	Utility::Benchmark::Timings& m_render_timings;
+	Utility::Benchmark::Timings& m_editor_timings;
+	Utility::Benchmark::Timings& m_frame_timings;
+
+	// Advance the physics one tick and publish the RigidBody transforms for the renderer. Holds the scene mutex.
+	void physics_tick(const DeltaTime& p_timestep, std::chrono::steady_clock::time_point p_tick_time);
+	// Update the scene, draw it with the RigidBodies interpolated to p_now, draw the editor and swap buffers.
+	void render_tick(const DeltaTime& p_duration_since_last_render, std::chrono::steady_clock::time_point p_now);
+	// Set the tick counts and rates over p_run_time, the entity counts and the final memory high-water mark into m_statistics.
+	void record_statistics(std::chrono::steady_clock::duration p_run_time);
 };
 
+// Usage: Spirit [--record <input log>]
+//        Spirit [--benchmark <scene file>] [--replay <input log>] [--ticks <physics ticks>] [--seed <seed>] --output <json file>
 int main(int argc, char* argv[])
-{ (void)argv;
+{
 	{
 		Utility::Stopwatch stopwatch;
 
@@ -205,10 +136,18 @@ int main(int argc, char* argv[])
 		for (int index{}; index != argc; ++index)
 			LOG("Argument {}: {}", index + 1, argv[index]);
 
+		std::filesystem::path record_input_to;
+		for (int index = 1; index + 1 < argc; ++index)
+			if (std::string_view(argv[index]) == "--record")
+				record_input_to = argv[++index];
+
 		auto app = Application(input, window);
 		LOG("[INIT] initialisation took {}", stopwatch.duration_since_start<int, std::milli>());
 
-		app.simulation_loop();
+		if (const auto benchmark_parameters = Utility::Benchmark::Parameters::parse(argc, argv))
+			app.benchmark(*benchmark_parameters);
+		else
+			app.simulation_loop(record_input_to);
 	} // Window and input must go out of scope and destroy their resources before Core::deinitialise
 
 	OpenGL::DebugRenderer::deinit();
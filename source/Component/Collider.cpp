@@ -8,8 +8,16 @@
 namespace Component
 {
 	Collider::Collider()
+		: Collider(Shape::ConvexHull)
+	{}
+	Collider::Collider(Shape p_shape)
 		: m_world_AABB{}
 		, m_collided(false)
+		, m_triangle_mesh(false)
+		, m_shape(p_shape)
+		, m_half_extents(1.f)
+		, m_radius(1.f)
+		, m_half_height(1.f)
 	{}
 
 	void Collider::draw_UI()
@@ -17,6 +25,24 @@ namespace Component
 		if (ImGui::TreeNode("Collider"))
 		{
 			ImGui::Checkbox("Colliding", &m_collided);
+			ImGui::Checkbox("Triangle mesh", &m_triangle_mesh);
+
+			const char* shapes[]{"Convex hull", "Sphere", "Box", "Capsule", "Cylinder"};
+			int shape = static_cast<int>(m_shape);
+			if (ImGui::Combo("Shape", &shape, shapes, 5))
+				m_shape = static_cast<Shape>(shape);
+
+			switch (m_shape)
+			{
+				case Shape::Sphere:   ImGui::Slider("Radius", m_radius, 0.01f, 10.f); break;
+				case Shape::Box:      ImGui::Slider("Half extents", m_half_extents, 0.01f, 10.f); break;
+				case Shape::Capsule:
+				case Shape::Cylinder:
+					ImGui::Slider("Radius", m_radius, 0.01f, 10.f);
+					ImGui::Slider("Half height", m_half_height, 0.01f, 10.f);
+					break;
+				default: break;
+			}
 			ImGui::Text("World AABB min", m_world_AABB.m_min);
 			ImGui::Text("World AABB max", m_world_AABB.m_max);
 			ImGui::TreePop();
@@ -27,12 +53,22 @@ namespace Component
 	{
 		Utility::write_binary(p_out, p_version, p_collider.m_world_AABB);
 		Utility::write_binary(p_out, p_version, p_collider.m_collided);
+		Utility::write_binary(p_out, p_version, p_collider.m_triangle_mesh);
+		Utility::write_binary(p_out, p_version, p_collider.m_shape);
+		Utility::write_binary(p_out, p_version, p_collider.m_half_extents);
+		Utility::write_binary(p_out, p_version, p_collider.m_radius);
+		Utility::write_binary(p_out, p_version, p_collider.m_half_height);
 	}
 	Collider Collider::deserialise(std::istream& p_in, uint16_t p_version)
 	{
 		Collider collider;
 		Utility::read_binary(p_in, p_version, collider.m_world_AABB);
 		Utility::read_binary(p_in, p_version, collider.m_collided);
+		Utility::read_binary(p_in, p_version, collider.m_triangle_mesh);
+		Utility::read_binary(p_in, p_version, collider.m_shape);
+		Utility::read_binary(p_in, p_version, collider.m_half_extents);
+		Utility::read_binary(p_in, p_version, collider.m_radius);
+		Utility::read_binary(p_in, p_version, collider.m_half_height);
 		return collider;
 	}
 	static_assert(Utility::Is_Serializable_v<Collider>, "Collider is not serializable, check that the required functions are implemented.");
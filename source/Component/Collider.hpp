@@ -2,6 +2,9 @@
 
 #include "Geometry/AABB.hpp"
 
+#include "glm/vec3.hpp"
+
+#include <cstdint>
 #include <iostream>
 
 namespace Component
@@ -13,11 +16,30 @@ namespace Component
 	public:
 		constexpr static size_t Persistent_ID = 4;
 
+		// The collision shape, centered on the entity's origin in object space and scaled by its Transform.
+		// Pairs of primitive shapes with an analytic test (sphere, box, capsule and cylinder against sphere, box-box and capsule-capsule) skip GJK.
+		// Any other pair falls back to GJK + EPA on the collision points of the Mesh, so the Mesh should match the shape.
+		enum class Shape : uint8_t
+		{
+			ConvexHull, // The convex hull of the Mesh's collision points.
+			Sphere,     // m_radius, scaled by the largest axis of the scale.
+			Box,        // m_half_extents.
+			Capsule,    // Segment of half length m_half_height along the Y axis swept by m_radius.
+			Cylinder    // m_radius and m_half_height along the Y axis.
+		};
+
 		Geometry::AABB m_world_AABB; // The world space AABB of the entity. PhysicsSystem is responsible for updating this.
 		bool m_collided;
+		bool m_triangle_mesh; // Collide using the triangles of the mesh instead of its convex hull. For concave static geometry, the mesh must be built from triangles. Overrides m_shape.
+		Shape m_shape;
+		glm::vec3 m_half_extents; // Object space, used by Shape::Box.
+		float m_radius;           // Object space, used by Shape::Sphere, Shape::Capsule and Shape::Cylinder.
+		float m_half_height;      // Object space, used by Shape::Capsule and Shape::Cylinder.
 
-		// Constructs a collider from an object space AABB and initial world space transformation info.
+		// Constructs a ConvexHull collider.
 		Collider();
+		// Constructs a p_shape collider sized to the matching MeshSystem primitive (radius 1, half extents and half height of 1).
+		explicit Collider(Shape p_shape);
 
 		void draw_UI();
 
@@ -2,6 +2,39 @@
 
 #include "imgui.h"
 
+#include <algorithm>
+
+namespace Data
+{
+	void Mesh::set_collision_shape(const std::vector<glm::vec3>& p_positions, OpenGL::PrimitiveMode p_primitive_mode)
+	{
+		// Triangle lists repeat a position for every triangle sharing it, collision only needs each position once.
+		auto less = [](const glm::vec3& a, const glm::vec3& b) { return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z; };
+		vertex_positions = p_positions;
+		std::sort(vertex_positions.begin(), vertex_positions.end(), less);
+		vertex_positions.erase(std::unique(vertex_positions.begin(), vertex_positions.end()), vertex_positions.end());
+		vertex_positions.shrink_to_fit();
+
+		if (p_primitive_mode == OpenGL::PrimitiveMode::Triangles)
+		{
+			// Map every vertex back to its merged position to re-index the triangles.
+			std::vector<uint32_t> triangle_indices;
+			triangle_indices.reserve(p_positions.size());
+			for (const auto& position : p_positions)
+				triangle_indices.push_back(static_cast<uint32_t>(std::lower_bound(vertex_positions.begin(), vertex_positions.end(), position, less) - vertex_positions.begin()));
+
+			// Only a convex mesh keeps the adjacency for hill-climbing, the support queries of concave meshes stay exact.
+			collision_points    = Geometry::PointCloud(vertex_positions, triangle_indices);
+			collision_triangles = Geometry::TriangleBVH(vertex_positions, triangle_indices);
+		}
+		else
+		{
+			collision_points    = Geometry::PointCloud(vertex_positions);
+			collision_triangles = Geometry::TriangleBVH();
+		}
+	}
+} // namespace Data
+
 namespace Component
 {
 	Mesh::Mesh(MeshRef& p_mesh)
@@ -13,7 +46,11 @@ namespace Component
 		if (ImGui::TreeNode("Mesh"))
 		{
 			if (m_mesh)
+#ifdef Z_HEADLESS
+				ImGui::Text("Collision vertices: %zu", m_mesh->vertex_positions.size());
+#else
 				ImGui::Text("Draw size: %d", m_mesh->get_VAO().draw_count());
+#endif
 			else
 				ImGui::Text("Mesh is null");
 
@@ -2,33 +2,46 @@
 
 #include "Component/Vertex.hpp"
 #include "Geometry/AABB.hpp"
-#include "OpenGL/Types.hpp"
+#include "Geometry/PointCloud.hpp"
+#include "Geometry/TriangleBVH.hpp"
+#ifdef Z_HEADLESS
+	#include "OpenGL/GLState.hpp" // PrimitiveMode only, a headless Mesh has no GPU side.
+#else
+	#include "OpenGL/Types.hpp"
+#endif
+#include "Utility/Logger.hpp"
 #include "Utility/ResourceManager.hpp"
 
 #include <vector>
 
 namespace Data
 {
+	// Mesh data for rendering and collision detection.
+	// In a Z_HEADLESS build there is no GL context, only the CPU side collision data and AABB are kept and nothing is uploaded.
 	class Mesh
 	{
-		OpenGL::VAO VAO;
-		OpenGL::Buffer vert_buffer; // VBO for vertex data.
-
 	public:
 		std::vector<glm::vec3> vertex_positions; // Unique vertex positions for collision detection.
 		Geometry::AABB AABB;                     // Object-space AABB for broad-phase collision detection.
+		Geometry::PointCloud collision_points;   // vertex_positions packed for SIMD support queries in narrow-phase collision detection, with hull adjacency for triangle meshes.
+		Geometry::TriangleBVH collision_triangles; // Object-space triangles for colliders using the mesh surface instead of its convex hull. Empty unless built from triangles.
 
 		template <typename VertexType>
 		requires is_valid_mesh_vert<VertexType>
-		Mesh(const std::vector<VertexType>& vertex_data, OpenGL::PrimitiveMode primitive_mode)
-			: VAO{}
-			, vert_buffer{{OpenGL::BufferStorageFlag::DynamicStorageBit}}
-			, vertex_positions{}// TODO: Feed vertex_positions out of the MeshBuilder directly.
+		Mesh(const std::vector<VertexType>& vertex_data, OpenGL::PrimitiveMode primitive_mode, bool build_collision_shape = false)
+			: vertex_positions{}// Set by set_collision_shape when build_collision_shape is requested.
 			, AABB{} // TODO: Feed AABB out of the MeshBuilder directly.
+			, collision_points{}
+			, collision_triangles{}
+#ifndef Z_HEADLESS
+			, VAO{}
+			, vert_buffer{{OpenGL::BufferStorageFlag::DynamicStorageBit}}
+#endif
 		{
 			static_assert(has_position_member<VertexType>, "VertexType must have a position member");
 			ASSERT_THROW(!vertex_data.empty(), "Vertex data is empty");
 
+#ifndef Z_HEADLESS
 			constexpr GLint vertex_buffer_binding_point = 0;
 
 			if constexpr (std::is_same_v<VertexType, Data::Vertex>)
@@ -65,9 +78,20 @@ namespace Data
 
 			vert_buffer.upload_data(vertex_data);
 			VAO.attach_buffer(vert_buffer, 0, 0, sizeof(VertexType));
+#endif
 
 			for (const auto& vertex : vertex_data)
 				AABB.unite(vertex.position);
+
+			if (build_collision_shape)
+			{
+				std::vector<glm::vec3> positions;
+				positions.reserve(vertex_data.size());
+				for (const auto& vertex : vertex_data)
+					positions.push_back(vertex.position);
+
+				set_collision_shape(positions, primitive_mode);
+			}
 		}
 
 		Mesh(const Mesh&)            = delete;
@@ -75,8 +99,20 @@ namespace Data
 		Mesh(Mesh&&)                 = default;
 		Mesh& operator=(Mesh&&)      = default;
 
+#ifndef Z_HEADLESS
 		const OpenGL::VAO& get_VAO() const { return VAO; }
 		bool empty() const { return VAO.draw_count() > 0; }
+#endif
+		// Set vertex_positions and collision_points from the per-vertex p_positions, merging positions shared by multiple vertices.
+		// If p_primitive_mode is Triangles, the hull adjacency is built from the triangles to allow hill-climbing support queries
+		// and collision_triangles is built for triangle mesh colliders.
+		void set_collision_shape(const std::vector<glm::vec3>& p_positions, OpenGL::PrimitiveMode p_primitive_mode);
+
+#ifndef Z_HEADLESS
+	private:
+		OpenGL::VAO VAO;
+		OpenGL::Buffer vert_buffer; // VBO for vertex data.
+#endif
 	};
 }
 
@@ -26,7 +26,9 @@ namespace Component
 		, max_particle_count{1'000}
 		, alive_count{0}
 		, blending_style{BlendingStyle::AlphaBlended}
+#ifndef Z_HEADLESS
 		, particle_buf{OpenGL::BufferStorageBitfield({OpenGL::BufferStorageFlag::DynamicStorageBit})}
+#endif
 	{
 		ASSERT_THROW(emit_velocity_min.x < emit_velocity_max.x
 			&& emit_velocity_min.y < emit_velocity_max.y
@@ -38,7 +40,9 @@ namespace Component
 		if (ImGui::TreeNode("Paticle Emitter"))
 		{
 			ImGui::Text("Particle count", alive_count);
+#ifndef Z_HEADLESS
 			ImGui::Text("Particlebuffer size", particle_buf.size());
+#endif
 
 
 			{ImGui::SeparatorText("Render styling");
@@ -203,7 +207,9 @@ namespace Component
 	}
 	void ParticleEmitter::reset()
 	{
+#ifndef Z_HEADLESS
 		particle_buf.clear();
+#endif
 		alive_count = 0;
 		spawn_debt  = 0.f;
 	}
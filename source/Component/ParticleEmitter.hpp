@@ -3,7 +3,9 @@
 #include "Component/Texture.hpp"
 #include "Utility/Config.hpp"
 
-#include "OpenGL/Types.hpp"
+#ifndef Z_HEADLESS
+	#include "OpenGL/Types.hpp"
+#endif
 
 #include "glm/vec4.hpp"
 
@@ -125,7 +127,9 @@ namespace Component
 
 		BlendingStyle blending_style;
 
-		OpenGL::Buffer particle_buf; // Contains instances of Particle struct.
+#ifndef Z_HEADLESS
+		OpenGL::Buffer particle_buf; // Contains instances of Particle struct. Particles are simulated on the GPU so a Z_HEADLESS emitter never spawns any.
+#endif
 
 		ParticleEmitter(const TextureRef& p_texture);
 		void draw_UI(System::TextureSystem& p_texture_system);
@@ -1,7 +1,9 @@
 #include "RigidBody.hpp"
 
+#include "Utility/Logger.hpp"
 #include "Utility/Serialise.hpp"
 
+#include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "imgui.h"
 
@@ -15,14 +17,65 @@ namespace Component
 		, m_torque{0.f, 0.f, 0.f}
 		, m_angular_momentum{0.f, 0.f, 0.f}
 		, m_angular_velocity{0.f, 0.f, 0.f}
-		, m_inertia_tensor{glm::identity<glm::mat3>()}
-		, m_mass{1}
 		, m_apply_gravity{p_apply_gravity}
+		, m_bullet{false}
+		, m_asleep{false}
+		, m_sleep_timer{0.f}
+		, m_mass{1}
+		, m_inverse_mass{1}
+		, m_inertia_tensor{glm::identity<glm::mat3>()}
+		, m_inverse_inertia_tensor{glm::identity<glm::mat3>()}
+		, m_world_inertia_tensor{glm::identity<glm::mat3>()}
+		, m_world_inverse_inertia_tensor{glm::identity<glm::mat3>()}
+		, m_world_rotation{glm::identity<glm::mat3>()}
+		, m_infinite_mass{false}
 	{}
 
 	void RigidBody::apply_linear_force(const glm::vec3& p_force)
 	{
 		m_force += p_force;
+		wake();
+	}
+	void RigidBody::wake()
+	{
+		m_asleep      = false;
+		m_sleep_timer = 0.f;
+	}
+
+	void RigidBody::set_mass(float p_mass)
+	{
+		ASSERT_THROW(p_mass > 0.f, "[RIGIDBODY] Mass must be greater than 0, use set_infinite_mass for immovable bodies.");
+		m_mass = p_mass;
+		update_inverses();
+	}
+	void RigidBody::set_inertia_tensor(const glm::mat3& p_inertia_tensor)
+	{
+		ASSERT_THROW(glm::determinant(p_inertia_tensor) != 0.f, "[RIGIDBODY] Inertia tensor must be invertible.");
+		m_inertia_tensor = p_inertia_tensor;
+		update_inverses();
+	}
+	void RigidBody::set_infinite_mass(bool p_infinite_mass)
+	{
+		m_infinite_mass = p_infinite_mass;
+		update_inverses();
+	}
+	void RigidBody::update_world_inertia(const glm::quat& p_orientation)
+	{
+		m_world_rotation = glm::mat3_cast(p_orientation);
+		update_world_tensors();
+	}
+	void RigidBody::update_inverses()
+	{
+		m_inverse_mass           = m_infinite_mass ? 0.f : 1.f / m_mass;
+		m_inverse_inertia_tensor = m_infinite_mass ? glm::mat3(0.f) : glm::inverse(m_inertia_tensor);
+		update_world_tensors();
+	}
+	void RigidBody::update_world_tensors()
+	{
+		// I_world = R I Rᵀ, the inverse of a rotation is its transpose so the inverse tensor rotates the same way without inverting again.
+		const glm::mat3 rotation_transpose = glm::transpose(m_world_rotation);
+		m_world_inertia_tensor         = m_world_rotation * m_inertia_tensor * rotation_transpose;
+		m_world_inverse_inertia_tensor = m_world_rotation * m_inverse_inertia_tensor * rotation_transpose;
 	}
 
 	void RigidBody::draw_UI()
@@ -33,7 +86,14 @@ namespace Component
 			ImGui::SliderFloat3("Momentum          (kg m/s)", &m_momentum.x, -10.f, 10.f);
 			ImGui::SliderFloat3("Acceleration        (m/s²)", &m_acceleration.x, -10.f, 10.f);
 			ImGui::SliderFloat3("Velocity             (m/s)", &m_velocity.x, -10.f, 10.f);
-			ImGui::SliderFloat( "Mass                  (kg)", &m_mass, 0.001f, 100.f);
+			if (m_infinite_mass) ImGui::BeginDisabled();
+			float mass = m_mass;
+			if (ImGui::SliderFloat( "Mass                  (kg)", &mass, 0.001f, 100.f))
+				set_mass(mass);
+			if (m_infinite_mass) ImGui::EndDisabled();
+			bool infinite_mass = m_infinite_mass;
+			if (ImGui::Checkbox("Infinite mass", &infinite_mass))
+				set_infinite_mass(infinite_mass);
 
 			ImGui::Separator();
 			ImGui::SliderFloat3("Torque               (N m)", &m_torque.x, -10.f, 10.f);
@@ -42,12 +102,19 @@ namespace Component
 
 			ImGui::Separator();
 			const float inertiaLimit = m_mass * 100.f;
-			ImGui::SliderFloat3("Angular Tensor 1   (kg m²)", &m_inertia_tensor[0][0], 0.001f, inertiaLimit);
-			ImGui::SliderFloat3("Angular Tensor 2   (kg m²)", &m_inertia_tensor[1][0], 0.001f, inertiaLimit);
-			ImGui::SliderFloat3("Angular Tensor 3   (kg m²)", &m_inertia_tensor[2][0], 0.001f, inertiaLimit);
+			glm::mat3 inertia_tensor = m_inertia_tensor;
+			bool inertia_changed = false;
+			inertia_changed |= ImGui::SliderFloat3("Angular Tensor 1   (kg m²)", &inertia_tensor[0][0], 0.001f, inertiaLimit);
+			inertia_changed |= ImGui::SliderFloat3("Angular Tensor 2   (kg m²)", &inertia_tensor[1][0], 0.001f, inertiaLimit);
+			inertia_changed |= ImGui::SliderFloat3("Angular Tensor 3   (kg m²)", &inertia_tensor[2][0], 0.001f, inertiaLimit);
+			if (inertia_changed && glm::determinant(inertia_tensor) != 0.f)
+				set_inertia_tensor(inertia_tensor);
 
 			ImGui::Separator();
 			ImGui::Checkbox("Apply Gravity", &m_apply_gravity);
+			ImGui::Checkbox("Bullet", &m_bullet);
+			if (ImGui::Checkbox("Asleep", &m_asleep) && !m_asleep)
+				wake();
 			ImGui::TreePop();
 
 			if (ImGui::Button("Reset"))
@@ -62,6 +129,7 @@ namespace Component
 				m_angular_momentum = {0.f, 0.f, 0.f};
 				m_angular_velocity = {0.f, 0.f, 0.f};
 				//m_inertia_tensor   = {glm::identity<glm::mat3>()};
+				wake();
 			}
 		}
 	}
@@ -77,6 +145,8 @@ namespace Component
 		Utility::write_binary(p_out, p_version, p_rigid_body.m_inertia_tensor);
 		Utility::write_binary(p_out, p_version, p_rigid_body.m_mass);
 		Utility::write_binary(p_out, p_version, p_rigid_body.m_apply_gravity);
+		Utility::write_binary(p_out, p_version, p_rigid_body.m_infinite_mass);
+		Utility::write_binary(p_out, p_version, p_rigid_body.m_bullet);
 	}
 	RigidBody RigidBody::deserialise(std::istream& p_in, uint16_t p_version)
 	{
@@ -91,6 +161,9 @@ namespace Component
 		Utility::read_binary(p_in, p_version, rigid_body.m_inertia_tensor);
 		Utility::read_binary(p_in, p_version, rigid_body.m_mass);
 		Utility::read_binary(p_in, p_version, rigid_body.m_apply_gravity);
+		Utility::read_binary(p_in, p_version, rigid_body.m_infinite_mass);
+		Utility::read_binary(p_in, p_version, rigid_body.m_bullet);
+		rigid_body.update_inverses();
 		return rigid_body;
 	}
 	static_assert(Utility::Is_Serializable_v<RigidBody>, "RigidBody is not serializable, check that the required functions are implemented.");
@@ -2,6 +2,7 @@
 
 #include "glm/vec3.hpp"
 #include "glm/mat3x3.hpp"
+#include "glm/gtc/quaternion.hpp"
 
 #include <iostream>
 
@@ -25,15 +26,54 @@ namespace Component
 		glm::vec3 m_torque;          // Angular force T in Newton meters producing a change in rotational motion (kg m²/s²)
 		glm::vec3 m_angular_momentum; // Angular momentum L in Newton meter seconds, a conserved quantity if no external torque is applied (kg m²/s)
 		glm::vec3 m_angular_velocity; // Angular velocity ω representing how quickly (Hz) this body revolves relative to it's axis (/s)
-		glm::mat3 m_inertia_tensor;   // Moment of inertia tensor J, a symmetric matrix determining the torque needed for a desired angular acceleration about a rotational axis (kg m2)
 
-		float m_mass; // Inertial mass measuring the body's resistance to acceleration when a force is applied (kg)
 		bool m_apply_gravity;
+		bool m_bullet; // Fast moving body swept against the other colliders each tick so it can't tunnel through thin geometry. See CollisionSystem::time_of_impact.
 		// Position and orientation are stored in Component::Transform.
 
+		// Sleeping
+		// -----------------------------------------------------------------------------
+		// Runtime state owned by the PhysicsSystem and not serialised, bodies always load awake.
+		bool m_asleep;       // Asleep bodies are skipped by integration and the narrow phase until woken.
+		float m_sleep_timer; // Time (s) the body's island has been at rest.
+
+	private:
+		// Mass properties
+		// -----------------------------------------------------------------------------
+		// Private so the cached inverses are only recomputed through the setters when the mass, shape or orientation change.
+		float m_mass;                             // Inertial mass measuring the body's resistance to acceleration when a force is applied (kg)
+		float m_inverse_mass;                     // 1 / m_mass, 0 if the body has infinite mass.
+		glm::mat3 m_inertia_tensor;               // Moment of inertia tensor J in object space, a symmetric matrix determining the torque needed for a desired angular acceleration about a rotational axis (kg m2)
+		glm::mat3 m_inverse_inertia_tensor;       // Inverse of m_inertia_tensor in object space, 0 if the body has infinite mass.
+		glm::mat3 m_world_inertia_tensor;         // m_inertia_tensor rotated into world space by the orientation last passed to update_world_inertia.
+		glm::mat3 m_world_inverse_inertia_tensor; // m_inverse_inertia_tensor rotated into world space by the orientation last passed to update_world_inertia.
+		glm::mat3 m_world_rotation;               // Rotation of the orientation last passed to update_world_inertia.
+		bool m_infinite_mass;                     // Static or kinematic body unaffected by forces and collisions. Skipped by the integrator, islands and the contact solver.
+
+		void update_inverses();
+		void update_world_tensors();
+
+	public:
 		RigidBody(bool p_apply_gravity = true) noexcept;
-		// Apply a linear p_force (kg m/s²) on the body. Force is applied on a PhysicsSystem::update tick.
+		// Apply a linear p_force (kg m/s²) on the body. Force is applied on a PhysicsSystem::update tick. Wakes the body.
 		void apply_linear_force(const glm::vec3& p_force);
+		// Wake the body so it's simulated on the next tick. Bodies in contact with it are woken by the PhysicsSystem.
+		void wake();
+
+		float get_mass() const                                    { return m_mass; }
+		float get_inverse_mass() const                            { return m_inverse_mass; }
+		const glm::mat3& get_inertia_tensor() const               { return m_inertia_tensor; }
+		const glm::mat3& get_world_inertia_tensor() const         { return m_world_inertia_tensor; }
+		const glm::mat3& get_world_inverse_inertia_tensor() const { return m_world_inverse_inertia_tensor; }
+		bool has_infinite_mass() const                            { return m_infinite_mass; }
+		//@param p_mass Mass of the body in kg. Must be greater than 0, use set_infinite_mass for immovable bodies.
+		void set_mass(float p_mass);
+		//@param p_inertia_tensor Object space moment of inertia tensor (kg m2). Must be invertible.
+		void set_inertia_tensor(const glm::mat3& p_inertia_tensor);
+		// Infinite mass bodies have 0 inverse mass and inertia. They are not moved by the PhysicsSystem, only by changing their Transform.
+		void set_infinite_mass(bool p_infinite_mass);
+		// Rotate the cached inertia tensors into world space. Call whenever the orientation of the body's Transform changes.
+		void update_world_inertia(const glm::quat& p_orientation);
 		void draw_UI();
 
 		static void serialise(std::ostream& p_out, uint16_t p_version, const RigidBody& p_rigid_body);
@@ -12,6 +12,7 @@ Component::Terrain::Terrain(const glm::vec3& p_position, int p_size_x, int p_siz
 	, m_size_z{p_size_z}
 	, m_scale_factor{1.f}
 	, m_texture{}
+	, m_heightfield{generate_heightfield()}
 	, m_mesh{generate_mesh()}
 {}
 
@@ -21,6 +22,7 @@ Component::Terrain::Terrain(const Terrain& p_other) noexcept
 	, m_size_z{p_other.m_size_z}
 	, m_scale_factor{p_other.m_scale_factor}
 	, m_texture{p_other.m_texture}
+	, m_heightfield{p_other.m_heightfield}
 	, m_mesh{generate_mesh()} // TODO: Implement a Data::Mesh copy.
 {}
 Component::Terrain& Component::Terrain::operator=(const Terrain& p_other) noexcept
@@ -30,6 +32,7 @@ Component::Terrain& Component::Terrain::operator=(const Terrain& p_other) noexce
 	m_size_z       = p_other.m_size_z;
 	m_scale_factor = p_other.m_scale_factor;
 	m_texture      = p_other.m_texture;
+	m_heightfield  = p_other.m_heightfield;
 	m_mesh         = generate_mesh(); // TODO: Implement a Data::Mesh copy.
 	return *this;
 }
@@ -39,22 +42,35 @@ float compute_height(float p_x, float p_z, float p_scale_factor, const siv::Perl
 	return static_cast<float>(perlin.noise2D(p_x * p_scale_factor, p_z * p_scale_factor));
 }
 
-Data::Mesh Component::Terrain::generate_mesh() noexcept
+Geometry::Heightfield Component::Terrain::generate_heightfield() const
 {
 	// Use perlin noise to generate a heightmap in the xz plane.
-	auto mb = Utility::MeshBuilder<Data::Vertex, OpenGL::PrimitiveMode::Triangles>{};
-	mb.reserve((m_size_x * m_size_z) * 6);
 	const siv::PerlinNoise::seed_type seed = 123456u;
 	const siv::PerlinNoise perlin{seed};
 
-	for (float x = 0; x < m_size_x; x++)
-		for (float z = 0; z < m_size_z; z++)
+	const size_t samples_x = static_cast<size_t>(m_size_x) + 1;
+	const size_t samples_z = static_cast<size_t>(m_size_z) + 1;
+	std::vector<float> heights(samples_x * samples_z);
+	for (size_t z = 0; z < samples_z; z++)
+		for (size_t x = 0; x < samples_x; x++)
+			heights[(z * samples_x) + x] = compute_height(static_cast<float>(x), static_cast<float>(z), m_scale_factor, perlin);
+
+	return Geometry::Heightfield(static_cast<size_t>(m_size_x), static_cast<size_t>(m_size_z), 1.f, std::move(heights));
+}
+
+Data::Mesh Component::Terrain::generate_mesh() noexcept
+{
+	auto mb = Utility::MeshBuilder<Data::Vertex, OpenGL::PrimitiveMode::Triangles>{};
+	mb.reserve((m_size_x * m_size_z) * 6);
+
+	for (size_t x = 0; x < m_heightfield.cells_x(); x++)
+		for (size_t z = 0; z < m_heightfield.cells_z(); z++)
 		{
 			mb.add_quad(
-				glm::vec3(x + 1, compute_height(x + 1, z,     m_scale_factor, perlin), z),
-				glm::vec3(x + 1, compute_height(x + 1, z + 1, m_scale_factor, perlin), z + 1),
-				glm::vec3(x,     compute_height(x, z,         m_scale_factor, perlin), z),
-				glm::vec3(x,     compute_height(x, z + 1,     m_scale_factor, perlin), z  + 1));
+				m_heightfield.vertex(x + 1, z),
+				m_heightfield.vertex(x + 1, z + 1),
+				m_heightfield.vertex(x,     z),
+				m_heightfield.vertex(x,     z + 1));
 		}
 
 	return mb.get_mesh();
@@ -82,7 +98,10 @@ void Component::Terrain::draw_UI(System::TextureSystem& p_texture_system)
 		ImGui::Slider("Scale factor", m_scale_factor, 0.01f , 10.f);
 
 		if (ImGui::Button("Re-generate terrain"))
-			m_mesh = generate_mesh();
+		{
+			m_heightfield = generate_heightfield();
+			m_mesh        = generate_mesh();
+		}
 
 		ImGui::TreePop();
 	}
@@ -3,6 +3,8 @@
 #include "Component/Texture.hpp"
 #include "Component/Mesh.hpp"
 
+#include "Geometry/Heightfield.hpp"
+
 namespace System
 {
 	class TextureSystem;
@@ -11,6 +13,8 @@ namespace Component
 {
 	class Terrain
 	{
+		Geometry::Heightfield generate_heightfield() const;
+		// Build the render mesh from m_heightfield.
 		Data::Mesh generate_mesh() noexcept;
 
 	public:
@@ -21,6 +25,7 @@ namespace Component
 		int m_size_z;
 		float m_scale_factor;
 		TextureRef m_texture;
+		Geometry::Heightfield m_heightfield; // Heights in the object space of the terrain, offset by m_position in the world. Collides as a static heightfield.
 		Data::Mesh m_mesh;
 
 		Terrain(const glm::vec3& p_position, int p_size_x, int p_size_z) noexcept;
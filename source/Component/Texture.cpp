@@ -8,6 +8,7 @@
 
 namespace Data
 {
+#ifndef Z_HEADLESS
 	OpenGL::TextureFormat format_from_channels(const uint8_t p_channels)
 	{
 		switch (p_channels)
@@ -30,9 +31,11 @@ namespace Data
 			default: throw std::runtime_error("Invalid number of channels for texture internal format.");
 		}
 	}
+#endif
 
 	Texture::Texture(const std::filesystem::path& p_filepath) noexcept
 		: m_image_ref{Utility::File::s_image_files.get_or_create([&p_filepath](const Utility::Image& p_image){ return p_image.m_filepath == p_filepath; }, p_filepath)}
+#ifndef Z_HEADLESS
 		, m_GL_texture{
 		                m_image_ref->resolution(),
 		                OpenGL::TextureMagFunc::Linear,
@@ -42,6 +45,7 @@ namespace Data
 		                OpenGL::TextureDataType::UNSIGNED_BYTE,
 		                true,
 		                m_image_ref->get_data()}
+#endif
 	{
 		LOG("Data::Texture '{}' loaded", m_image_ref->m_filepath.string());
 	}
@@ -1,6 +1,8 @@
 #pragma once
 
-#include "OpenGL/Types.hpp"
+#ifndef Z_HEADLESS
+	#include "OpenGL/Types.hpp"
+#endif
 #include "Utility/ResourceManager.hpp"
 #include "Utility/File.hpp"
 
@@ -11,6 +13,7 @@ namespace Data
 {
 	// Texture represents an image file on disk and its associated GPU handle.
 	// On construction a Texture is loaded into memory and onto the GPU ready for rendering.
+	// In a Z_HEADLESS build there is no GL context and the Texture is only loaded into memory.
 	class Texture
 	{
 	public:
@@ -22,7 +25,9 @@ namespace Data
 		Texture& operator=(const Texture& p_other)     = delete;
 
 		Utility::File::ImageRef m_image_ref;
+#ifndef Z_HEADLESS
 		OpenGL::Texture m_GL_texture;
+#endif
 	};
 }
 
@@ -71,6 +71,15 @@ namespace ECS
 			type_infos[get_ID<ComponentType>()] = ComponentData(Meta::PackArg<ComponentType>());
 		}
 
+		// Unregister ComponentType so another type with the same Persistent_ID can be registered. Every Storage holding it must be destroyed first.
+		template <typename ComponentType>
+		static inline void remove_info()
+		{
+			ASSERT(type_infos[get_ID<ComponentType>()].has_value(), "Component not registered. Call set_info for the ComponentType before removing it.");
+
+			type_infos[get_ID<ComponentType>()] = std::nullopt;
+		}
+
 		// Get the ComponentData given a ComponentID.
 		static inline const ComponentData& get_info(ComponentID p_component_ID)
 		{
@@ -0,0 +1,174 @@
+#include "AABBBatch.hpp"
+
+#include "glm/gtc/quaternion.hpp"
+
+#include <cmath>
+
+#ifdef Z_X86
+	#include <immintrin.h>
+#endif
+
+namespace Geometry
+{
+	AABBBatch::AABBBatch() noexcept
+		: m_arrays{}
+	{}
+
+	void AABBBatch::clear()
+	{
+		auto& a = m_arrays;
+		for (auto* array : {&a.center_x, &a.center_y, &a.center_z, &a.extent_x, &a.extent_y, &a.extent_z,
+		                    &a.position_x, &a.position_y, &a.position_z, &a.orientation_w, &a.orientation_x, &a.orientation_y, &a.orientation_z,
+		                    &a.scale_x, &a.scale_y, &a.scale_z, &a.min_x, &a.min_y, &a.min_z, &a.max_x, &a.max_y, &a.max_z})
+			array->clear();
+	}
+
+	void AABBBatch::add(const AABB& p_AABB, const glm::vec3& p_position, const glm::quat& p_orientation, const glm::vec3& p_scale)
+	{
+		auto& a = m_arrays;
+		const glm::vec3 center = (p_AABB.m_min + p_AABB.m_max) * 0.5f;
+		const glm::vec3 extent = (p_AABB.m_max - p_AABB.m_min) * 0.5f;
+		a.center_x.push_back(center.x);
+		a.center_y.push_back(center.y);
+		a.center_z.push_back(center.z);
+		a.extent_x.push_back(extent.x);
+		a.extent_y.push_back(extent.y);
+		a.extent_z.push_back(extent.z);
+		a.position_x.push_back(p_position.x);
+		a.position_y.push_back(p_position.y);
+		a.position_z.push_back(p_position.z);
+		a.orientation_w.push_back(p_orientation.w);
+		a.orientation_x.push_back(p_orientation.x);
+		a.orientation_y.push_back(p_orientation.y);
+		a.orientation_z.push_back(p_orientation.z);
+		a.scale_x.push_back(p_scale.x);
+		a.scale_y.push_back(p_scale.y);
+		a.scale_z.push_back(p_scale.z);
+	}
+
+	AABB AABBBatch::operator[](size_t p_index) const
+	{
+		const auto& a = m_arrays;
+		return AABB(glm::vec3(a.min_x[p_index], a.min_y[p_index], a.min_z[p_index]), glm::vec3(a.max_x[p_index], a.max_y[p_index], a.max_z[p_index]));
+	}
+
+	static void transform_scalar(AABBBatch::Arrays& p_arrays, size_t p_begin, size_t p_end)
+	{
+		auto& a = p_arrays;
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			// Rotation matrix rows of the unit quaternion.
+			const float w = a.orientation_w[i], x = a.orientation_x[i], y = a.orientation_y[i], z = a.orientation_z[i];
+			const float r_00 = 1.f - 2.f * (y * y + z * z), r_01 = 2.f * (x * y - w * z),       r_02 = 2.f * (x * z + w * y);
+			const float r_10 = 2.f * (x * y + w * z),       r_11 = 1.f - 2.f * (x * x + z * z), r_12 = 2.f * (y * z - w * x);
+			const float r_20 = 2.f * (x * z - w * y),       r_21 = 2.f * (y * z + w * x),       r_22 = 1.f - 2.f * (x * x + y * y);
+
+			// Scale is applied before rotation, |R S| e = |R| (|S| e).
+			const float center_x = a.center_x[i] * a.scale_x[i], center_y = a.center_y[i] * a.scale_y[i], center_z = a.center_z[i] * a.scale_z[i];
+			const float extent_x = a.extent_x[i] * std::abs(a.scale_x[i]), extent_y = a.extent_y[i] * std::abs(a.scale_y[i]), extent_z = a.extent_z[i] * std::abs(a.scale_z[i]);
+
+			const float world_center_x = a.position_x[i] + (r_00 * center_x + r_01 * center_y + r_02 * center_z);
+			const float world_center_y = a.position_y[i] + (r_10 * center_x + r_11 * center_y + r_12 * center_z);
+			const float world_center_z = a.position_z[i] + (r_20 * center_x + r_21 * center_y + r_22 * center_z);
+			const float world_extent_x = std::abs(r_00) * extent_x + std::abs(r_01) * extent_y + std::abs(r_02) * extent_z;
+			const float world_extent_y = std::abs(r_10) * extent_x + std::abs(r_11) * extent_y + std::abs(r_12) * extent_z;
+			const float world_extent_z = std::abs(r_20) * extent_x + std::abs(r_21) * extent_y + std::abs(r_22) * extent_z;
+
+			a.min_x[i] = world_center_x - world_extent_x;
+			a.min_y[i] = world_center_y - world_extent_y;
+			a.min_z[i] = world_center_z - world_extent_z;
+			a.max_x[i] = world_center_x + world_extent_x;
+			a.max_y[i] = world_center_y + world_extent_y;
+			a.max_z[i] = world_center_z + world_extent_z;
+		}
+	}
+
+#ifdef Z_X86
+	// Transforms 8 AABBs per iteration then hands the remainder to transform_scalar.
+	// Rounds identically to transform_scalar, see Utility/CPUFeatures.hpp.
+	TARGET_AVX2 static void transform_AVX2(AABBBatch::Arrays& p_arrays, size_t p_begin, size_t p_end)
+	{
+		auto& a = p_arrays;
+		const __m256 one       = _mm256_set1_ps(1.f);
+		const __m256 two       = _mm256_set1_ps(2.f);
+		const __m256 sign_mask = _mm256_set1_ps(-0.f); // andnot with -0.f clears the sign bit, abs().
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 w  = _mm256_loadu_ps(&a.orientation_w[i]);
+			const __m256 x  = _mm256_loadu_ps(&a.orientation_x[i]);
+			const __m256 y  = _mm256_loadu_ps(&a.orientation_y[i]);
+			const __m256 z  = _mm256_loadu_ps(&a.orientation_z[i]);
+			const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+			const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+			const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+			const __m256 r_00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+			const __m256 r_01 = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+			const __m256 r_02 = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+			const __m256 r_10 = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+			const __m256 r_11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+			const __m256 r_12 = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+			const __m256 r_20 = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+			const __m256 r_21 = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+			const __m256 r_22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+
+			const __m256 scale_x  = _mm256_loadu_ps(&a.scale_x[i]);
+			const __m256 scale_y  = _mm256_loadu_ps(&a.scale_y[i]);
+			const __m256 scale_z  = _mm256_loadu_ps(&a.scale_z[i]);
+			const __m256 center_x = _mm256_mul_ps(_mm256_loadu_ps(&a.center_x[i]), scale_x);
+			const __m256 center_y = _mm256_mul_ps(_mm256_loadu_ps(&a.center_y[i]), scale_y);
+			const __m256 center_z = _mm256_mul_ps(_mm256_loadu_ps(&a.center_z[i]), scale_z);
+			const __m256 extent_x = _mm256_mul_ps(_mm256_loadu_ps(&a.extent_x[i]), _mm256_andnot_ps(sign_mask, scale_x));
+			const __m256 extent_y = _mm256_mul_ps(_mm256_loadu_ps(&a.extent_y[i]), _mm256_andnot_ps(sign_mask, scale_y));
+			const __m256 extent_z = _mm256_mul_ps(_mm256_loadu_ps(&a.extent_z[i]), _mm256_andnot_ps(sign_mask, scale_z));
+
+			// Rows are summed left to right to match the scalar kernel's rounding.
+			const __m256 world_center_x = _mm256_add_ps(_mm256_loadu_ps(&a.position_x[i]),
+				_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r_00, center_x), _mm256_mul_ps(r_01, center_y)), _mm256_mul_ps(r_02, center_z)));
+			const __m256 world_center_y = _mm256_add_ps(_mm256_loadu_ps(&a.position_y[i]),
+				_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r_10, center_x), _mm256_mul_ps(r_11, center_y)), _mm256_mul_ps(r_12, center_z)));
+			const __m256 world_center_z = _mm256_add_ps(_mm256_loadu_ps(&a.position_z[i]),
+				_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r_20, center_x), _mm256_mul_ps(r_21, center_y)), _mm256_mul_ps(r_22, center_z)));
+			const __m256 world_extent_x = _mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_00), extent_x), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_01), extent_y)),
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_02), extent_z));
+			const __m256 world_extent_y = _mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_10), extent_x), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_11), extent_y)),
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_12), extent_z));
+			const __m256 world_extent_z = _mm256_add_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_20), extent_x), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_21), extent_y)),
+				_mm256_mul_ps(_mm256_andnot_ps(sign_mask, r_22), extent_z));
+
+			_mm256_storeu_ps(&a.min_x[i], _mm256_sub_ps(world_center_x, world_extent_x));
+			_mm256_storeu_ps(&a.min_y[i], _mm256_sub_ps(world_center_y, world_extent_y));
+			_mm256_storeu_ps(&a.min_z[i], _mm256_sub_ps(world_center_z, world_extent_z));
+			_mm256_storeu_ps(&a.max_x[i], _mm256_add_ps(world_center_x, world_extent_x));
+			_mm256_storeu_ps(&a.max_y[i], _mm256_add_ps(world_center_y, world_extent_y));
+			_mm256_storeu_ps(&a.max_z[i], _mm256_add_ps(world_center_z, world_extent_z));
+		}
+
+		transform_scalar(p_arrays, i, p_end);
+	}
+#endif
+
+	void AABBBatch::transform()
+	{
+		transform(Utility::instruction_set());
+	}
+	void AABBBatch::transform(Utility::InstructionSet p_instruction_set)
+	{
+		auto& a = m_arrays;
+		for (auto* array : {&a.min_x, &a.min_y, &a.min_z, &a.max_x, &a.max_y, &a.max_z})
+			array->resize(size());
+
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: transform_AVX2(m_arrays, 0, size()); break;
+#endif
+			default: transform_scalar(m_arrays, 0, size()); break;
+		}
+	}
+} // namespace Geometry
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "AABB.hpp"
+
+#include "Utility/CPUFeatures.hpp"
+
+#include "glm/fwd.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Geometry
+{
+	// Transforms a batch of object-space AABBs into world space in one pass.
+	// Inputs are packed as a structure of arrays (all x, then all y, then all z) so the AVX2 kernel transforms 8 AABBs per instruction.
+	// Each AABB is transformed in center-extent form using Arvo's method: the world center is the rotated and scaled center, the world
+	// half extent is the half extent multiplied by the absolute rotation-scale matrix. The rotation rows are built from the quaternion
+	// in the kernel, so no mat4 is formed per AABB. The result matches AABB::transform to within rounding.
+	class AABBBatch
+	{
+	public:
+		// Packed state, index i of every array belongs to the same AABB.
+		struct Arrays
+		{
+			std::vector<float> center_x, center_y, center_z; // Object-space center.
+			std::vector<float> extent_x, extent_y, extent_z; // Object-space half extent.
+			std::vector<float> position_x, position_y, position_z;
+			std::vector<float> orientation_w, orientation_x, orientation_y, orientation_z;
+			std::vector<float> scale_x, scale_y, scale_z;
+
+			std::vector<float> min_x, min_y, min_z; // World-space result.
+			std::vector<float> max_x, max_y, max_z;
+		};
+
+		AABBBatch() noexcept;
+
+		// Remove all the AABBs keeping the allocations.
+		void clear();
+		// Add an AABB to transform by p_position, p_orientation and p_scale, the same transform as AABB::transform.
+		void add(const AABB& p_AABB, const glm::vec3& p_position, const glm::quat& p_orientation, const glm::vec3& p_scale);
+		size_t size() const { return m_arrays.center_x.size(); }
+
+		// Transform every AABB added since the last clear using the widest kernel the running CPU supports.
+		void transform();
+		// Transform every AABB added since the last clear using a specific kernel.
+		// p_instruction_set must be supported by the running CPU, see Utility::instruction_set().
+		void transform(Utility::InstructionSet p_instruction_set);
+		// The world-space AABB of the p_index'th add, valid after transform.
+		AABB operator[](size_t p_index) const;
+
+	private:
+		Arrays m_arrays;
+	};
+} // namespace Geometry
@@ -0,0 +1,318 @@
+#include "AABBTree.hpp"
+#include "Intersect.hpp"
+#include "Ray.hpp"
+
+#include "Utility/Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Geometry
+{
+	AABBTree::AABBTree() noexcept
+		: m_nodes{}
+		, m_item_indices{}
+		, m_item_AABBs{}
+	{}
+
+	void AABBTree::clear()
+	{
+		m_nodes.clear();
+		m_item_indices.clear();
+		m_item_AABBs.clear();
+	}
+
+	void AABBTree::build(std::span<const AABB> p_AABBs)
+	{
+		clear();
+		if (p_AABBs.empty())
+			return;
+
+		m_item_AABBs.assign(p_AABBs.begin(), p_AABBs.end());
+		m_item_indices.resize(p_AABBs.size());
+		std::vector<glm::vec3> centers(p_AABBs.size());
+		for (size_t i = 0; i < p_AABBs.size(); i++)
+		{
+			m_item_indices[i] = static_cast<uint32_t>(i);
+			centers[i]        = p_AABBs[i].get_center();
+		}
+
+		m_nodes.reserve(p_AABBs.size() * 2);
+		m_nodes.push_back({});
+		build_node(0, 0, static_cast<uint32_t>(p_AABBs.size()), centers);
+	}
+
+	void AABBTree::build_node(size_t p_node_index, uint32_t p_begin, uint32_t p_end, std::vector<glm::vec3>& p_centers)
+	{
+		AABB bounds         = m_item_AABBs[m_item_indices[p_begin]];
+		AABB center_bounds  = AABB(p_centers[m_item_indices[p_begin]], p_centers[m_item_indices[p_begin]]);
+		for (uint32_t i = p_begin + 1; i < p_end; i++)
+		{
+			bounds.unite(m_item_AABBs[m_item_indices[i]]);
+			center_bounds.unite(p_centers[m_item_indices[i]]);
+		}
+		m_nodes[p_node_index].bounds = bounds;
+
+		if (p_end - p_begin <= Max_Leaf_Size)
+		{
+			m_nodes[p_node_index].first = p_begin;
+			m_nodes[p_node_index].count = static_cast<uint16_t>(p_end - p_begin);
+			m_nodes[p_node_index].axis  = 0;
+			return;
+		}
+
+		// Split at the median center along the axis the centers spread furthest on.
+		const glm::vec3 spread = center_bounds.get_size();
+		const uint16_t axis    = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+		const uint32_t middle  = p_begin + ((p_end - p_begin) / 2);
+		std::nth_element(m_item_indices.begin() + p_begin, m_item_indices.begin() + middle, m_item_indices.begin() + p_end,
+			[&p_centers, axis](uint32_t p_lhs, uint32_t p_rhs) { return p_centers[p_lhs][axis] < p_centers[p_rhs][axis]; });
+
+		m_nodes[p_node_index].count = 0;
+		m_nodes[p_node_index].axis  = axis;
+
+		m_nodes.push_back({});
+		build_node(m_nodes.size() - 1, p_begin, middle, p_centers);
+
+		m_nodes[p_node_index].first = static_cast<uint32_t>(m_nodes.size());
+		m_nodes.push_back({});
+		build_node(m_nodes.size() - 1, middle, p_end, p_centers);
+	}
+
+	void AABBTree::query(const OverlapTest& p_overlaps, const std::function<void(size_t p_item)>& p_on_item) const
+	{
+		if (m_nodes.empty())
+			return;
+
+		std::array<uint32_t, 64> stack;
+		size_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0)
+		{
+			const uint32_t node_index = stack[--stack_size];
+			const Node& node          = m_nodes[node_index];
+			if (!p_overlaps(node.bounds))
+				continue;
+
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					if (p_overlaps(m_item_AABBs[m_item_indices[i]]))
+						p_on_item(m_item_indices[i]);
+				}
+			}
+			else
+			{
+				stack[stack_size++] = node.first;
+				stack[stack_size++] = node_index + 1;
+			}
+		}
+	}
+
+	void AABBTree::query_pairs(const AABBTree& p_other, const PairOverlapTest& p_overlaps, const std::function<void(size_t p_item, size_t p_other_item)>& p_on_pair) const
+	{
+		if (m_nodes.empty() || p_other.m_nodes.empty())
+			return;
+
+		std::vector<std::pair<uint32_t, uint32_t>> stack = {{0, 0}};
+		while (!stack.empty())
+		{
+			const auto [node_index, other_node_index] = stack.back();
+			stack.pop_back();
+
+			const Node& node       = m_nodes[node_index];
+			const Node& other_node = p_other.m_nodes[other_node_index];
+			if (!p_overlaps(node.bounds, other_node.bounds))
+				continue;
+
+			if (node.count > 0 && other_node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					for (uint32_t j = other_node.first; j < other_node.first + other_node.count; j++)
+					{
+						if (p_overlaps(m_item_AABBs[m_item_indices[i]], p_other.m_item_AABBs[p_other.m_item_indices[j]]))
+							p_on_pair(m_item_indices[i], p_other.m_item_indices[j]);
+					}
+				}
+				continue;
+			}
+
+			// Descend the branch with the larger bounds so both sides shrink at a similar rate.
+			const glm::vec3 size       = node.bounds.get_size();
+			const glm::vec3 other_size = other_node.bounds.get_size();
+			const bool descend_other   = node.count > 0 || (other_node.count == 0 && (other_size.x * other_size.y * other_size.z) > (size.x * size.y * size.z));
+			if (descend_other)
+			{
+				stack.push_back({node_index, other_node.first});
+				stack.push_back({node_index, other_node_index + 1});
+			}
+			else
+			{
+				stack.push_back({node.first, other_node_index});
+				stack.push_back({node_index + 1, other_node_index});
+			}
+		}
+	}
+
+	void AABBTree::query_pairs(const std::function<void(size_t p_item, size_t p_other_item)>& p_on_pair) const
+	{
+		if (m_nodes.empty())
+			return;
+
+		// A node paired with itself stands for the pairs within its subtree: within each child and across the two children.
+		// Splitting it that way reports every pair once and never pairs an item with itself.
+		std::vector<std::pair<uint32_t, uint32_t>> stack = {{0, 0}};
+		while (!stack.empty())
+		{
+			const auto [node_index, other_node_index] = stack.back();
+			stack.pop_back();
+
+			const Node& node       = m_nodes[node_index];
+			const Node& other_node = m_nodes[other_node_index];
+			if (node_index == other_node_index)
+			{
+				if (node.count > 0)
+				{
+					for (uint32_t i = node.first; i < node.first + node.count; i++)
+					{
+						for (uint32_t j = i + 1; j < node.first + node.count; j++)
+						{
+							if (Geometry::intersecting(m_item_AABBs[m_item_indices[i]], m_item_AABBs[m_item_indices[j]]))
+								p_on_pair(m_item_indices[i], m_item_indices[j]);
+						}
+					}
+				}
+				else
+				{
+					stack.push_back({node_index + 1, node_index + 1});
+					stack.push_back({node.first, node.first});
+					stack.push_back({node_index + 1, node.first});
+				}
+				continue;
+			}
+
+			if (!Geometry::intersecting(node.bounds, other_node.bounds))
+				continue;
+
+			if (node.count > 0 && other_node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					for (uint32_t j = other_node.first; j < other_node.first + other_node.count; j++)
+					{
+						if (Geometry::intersecting(m_item_AABBs[m_item_indices[i]], m_item_AABBs[m_item_indices[j]]))
+							p_on_pair(m_item_indices[i], m_item_indices[j]);
+					}
+				}
+				continue;
+			}
+
+			// Descend the branch with the larger bounds so both sides shrink at a similar rate.
+			const glm::vec3 size       = node.bounds.get_size();
+			const glm::vec3 other_size = other_node.bounds.get_size();
+			const bool descend_other   = node.count > 0 || (other_node.count == 0 && (other_size.x * other_size.y * other_size.z) > (size.x * size.y * size.z));
+			if (descend_other)
+			{
+				stack.push_back({node_index, other_node.first});
+				stack.push_back({node_index, other_node_index + 1});
+			}
+			else
+			{
+				stack.push_back({node.first, other_node_index});
+				stack.push_back({node_index + 1, other_node_index});
+			}
+		}
+	}
+
+	// Slab test of a ray against p_AABB using a precomputed reciprocal direction.
+	// Returns the entry distance clamped to 0 or a negative value if the ray misses within p_max_distance.
+	static float ray_entry(const AABB& p_AABB, const glm::vec3& p_start, const glm::vec3& p_inverse_direction, float p_max_distance)
+	{
+		float entry = 0.f;
+		float exit  = p_max_distance;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float near = (p_AABB.m_min[axis] - p_start[axis]) * p_inverse_direction[axis];
+			float far  = (p_AABB.m_max[axis] - p_start[axis]) * p_inverse_direction[axis];
+			if (near > far)
+				std::swap(near, far);
+
+			// NaN (0 * inf from a ray on a slab plane) fails both comparisons and leaves the interval unchanged.
+			if (near > entry) entry = near;
+			if (far < exit)   exit  = far;
+		}
+		return entry <= exit ? entry : -1.f;
+	}
+
+	void AABBTree::raycast(std::span<const Ray> p_rays, std::span<float> p_max_distances, const RayHitCallback& p_on_hit) const
+	{
+		ASSERT_THROW(p_rays.size() <= Packet_Size, "Ray packet exceeds AABBTree::Packet_Size.");
+		ASSERT_THROW(p_rays.size() == p_max_distances.size(), "Ray packet and max distances size mismatch.");
+		if (m_nodes.empty() || p_rays.empty())
+			return;
+
+		const size_t ray_count = p_rays.size();
+		std::array<glm::vec3, Packet_Size> inverse_directions;
+		for (size_t ray = 0; ray < ray_count; ray++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float direction = p_rays[ray].m_direction[axis];
+				inverse_directions[ray][axis] = direction != 0.f ? 1.f / direction : std::copysign(std::numeric_limits<float>::infinity(), direction);
+			}
+		}
+
+		// Depth is bounded by log2 of the item count for a median split, 64 entries covers any item count that fits the uint32_t indices.
+		std::array<uint32_t, 64> stack;
+		size_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0)
+		{
+			const Node& node = m_nodes[stack[--stack_size]];
+
+			// Mask of the rays in the packet hitting this node.
+			uint32_t active = 0;
+			for (size_t ray = 0; ray < ray_count; ray++)
+			{
+				if (ray_entry(node.bounds, p_rays[ray].m_start, inverse_directions[ray], p_max_distances[ray]) >= 0.f)
+					active |= 1u << ray;
+			}
+			if (active == 0)
+				continue;
+
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					const uint32_t item = m_item_indices[i];
+					for (size_t ray = 0; ray < ray_count; ray++)
+					{
+						if (!(active & (1u << ray)))
+							continue;
+
+						const float distance = ray_entry(m_item_AABBs[item], p_rays[ray].m_start, inverse_directions[ray], p_max_distances[ray]);
+						if (distance >= 0.f)
+							p_max_distances[ray] = p_on_hit(ray, item, distance);
+					}
+				}
+			}
+			else
+			{
+				// Push the far child first so the near child (for the first active ray) is visited first.
+				const size_t first_active = static_cast<size_t>(std::countr_zero(active));
+				const uint32_t left       = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+				const bool left_is_near   = p_rays[first_active].m_direction[node.axis] >= 0.f;
+				stack[stack_size++] = left_is_near ? node.first : left;
+				stack[stack_size++] = left_is_near ? left : node.first;
+			}
+		}
+	}
+} // namespace Geometry
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "AABB.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace Geometry
+{
+	class Ray;
+
+	// A bounding volume hierarchy over a set of AABBs identified by their index in the list the tree was built from.
+	// The tree is rebuilt from scratch rather than refitted, a top-down median split is cheap enough to run every tick for scene sized sets.
+	// Nodes are stored depth-first in one array, the left child of a branch directly follows it.
+	class AABBTree
+	{
+	public:
+		struct Node
+		{
+			AABB bounds;
+			uint32_t first; // Branch: index of the right child (the left child is the next node). Leaf: offset into m_item_indices.
+			uint16_t count; // Number of items in a leaf, 0 for a branch.
+			uint16_t axis;  // Axis the children of a branch were split on, used to visit the nearer child first.
+		};
+
+		constexpr static size_t Max_Leaf_Size = 2;
+		constexpr static size_t Packet_Size   = 8; // Max number of rays traversed together by raycast.
+
+		// Called for every item AABB a ray hits.
+		//@param p_ray Index of the ray into the packet.
+		//@param p_item Index of the hit AABB in the list passed to build.
+		//@param p_distance Distance along the ray to the entry point of the AABB in multiples of the ray direction, 0 if the ray starts inside.
+		//@return The new max distance of the ray. Returning p_distance stops the ray at this hit, culling everything further away.
+		using RayHitCallback = std::function<float(size_t p_ray, size_t p_item, float p_distance)>;
+		// Test of a node or item AABB against the volume of a query, see query.
+		using OverlapTest = std::function<bool(const AABB& p_AABB)>;
+		// Test of a node or item AABB of this tree against one of another tree, see query_pairs.
+		using PairOverlapTest = std::function<bool(const AABB& p_AABB, const AABB& p_other_AABB)>;
+
+		AABBTree() noexcept;
+		// Rebuild the tree over p_AABBs. Item indices reported by queries index into p_AABBs.
+		void build(std::span<const AABB> p_AABBs);
+		void clear();
+		bool empty() const { return m_nodes.empty(); }
+		const std::vector<Node>& get_nodes() const { return m_nodes; }
+
+		// Traverse the tree with a packet of rays, calling p_on_hit for each item hit within the max distance of each ray.
+		// A node is visited if any ray of the packet hits it, so coherent rays (e.g. from the same origin) share most of the traversal.
+		// Items are not reported in distance order, near children are visited first so shrinking the max distance culls most of the tree.
+		//@param p_rays At most Packet_Size rays.
+		//@param p_max_distances Max distance along each ray, updated by the return of p_on_hit.
+		void raycast(std::span<const Ray> p_rays, std::span<float> p_max_distances, const RayHitCallback& p_on_hit) const;
+
+		// Call p_on_item for every item whose AABB passes p_overlaps. Subtrees whose bounds fail p_overlaps are skipped.
+		//@param p_overlaps Must return true for any AABB containing an AABB it returns true for, e.g. an intersection test with a fixed volume.
+		void query(const OverlapTest& p_overlaps, const std::function<void(size_t p_item)>& p_on_item) const;
+
+		// Traverse this tree and p_other together, calling p_on_pair for every pair of items whose AABBs pass p_overlaps.
+		// Pairs of subtrees failing p_overlaps are skipped, so only overlapping leaves have their items compared.
+		//@param p_overlaps Must return true for any pair of AABBs containing a pair it returns true for. Transforming both AABBs
+		// into a common space before testing them allows trees built in different object spaces to be queried.
+		void query_pairs(const AABBTree& p_other, const PairOverlapTest& p_overlaps, const std::function<void(size_t p_item, size_t p_other_item)>& p_on_pair) const;
+		// Call p_on_pair once for every pair of distinct items of this tree whose AABBs intersect, a self-collision broad phase.
+		// Each pair is reported once in no particular order and in either order of its items. Subtrees that don't overlap are skipped.
+		void query_pairs(const std::function<void(size_t p_item, size_t p_other_item)>& p_on_pair) const;
+
+	private:
+		std::vector<Node> m_nodes;
+		std::vector<uint32_t> m_item_indices; // Items grouped by leaf.
+		std::vector<AABB> m_item_AABBs;
+
+		void build_node(size_t p_node_index, uint32_t p_begin, uint32_t p_end, std::vector<glm::vec3>& p_centers);
+	};
+} // namespace Geometry
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+namespace Geometry
+{
+	// The set of points within m_radius of the line segment m_start to m_end. A cylinder with hemispherical caps.
+	class Capsule
+	{
+	public:
+		constexpr Capsule(const glm::vec3& p_start, const glm::vec3& p_end, float p_radius) noexcept
+			: m_start{p_start}
+			, m_end{p_end}
+			, m_radius{p_radius}
+		{}
+
+		glm::vec3 m_start;
+		glm::vec3 m_end;
+		float m_radius;
+	};
+}
@@ -0,0 +1,342 @@
+#include "Contact.hpp"
+
+#include "Geometry/Capsule.hpp"
+#include "Geometry/Cuboid.hpp"
+#include "Geometry/Cylinder.hpp"
+#include "Geometry/Sphere.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Geometry
+{
+	static constexpr float Epsilon = 1e-6f;
+
+	Contact swap_perspective(const Contact& p_contact)
+	{
+		Contact contact;
+		contact.position          = p_contact.position + (p_contact.normal * p_contact.penetration_depth);
+		contact.normal            = -p_contact.normal;
+		contact.penetration_depth = p_contact.penetration_depth;
+		return contact;
+	}
+
+	// Any unit vector perpendicular to p_direction.
+	static glm::vec3 perpendicular(const glm::vec3& p_direction)
+	{
+		const glm::vec3 axis = std::abs(p_direction.x) < 0.57735f ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+		return glm::normalize(glm::cross(p_direction, axis));
+	}
+
+	// Contact between two spheres given as center and radius, the building block of the sphere-swept shapes.
+	//@param p_fallback_normal Normal to use if the centers coincide.
+	static std::optional<Contact> sphere_sphere(const glm::vec3& p_center_1, float p_radius_1, const glm::vec3& p_center_2, float p_radius_2, const glm::vec3& p_fallback_normal)
+	{
+		const glm::vec3 offset = p_center_1 - p_center_2;
+		const float distance_squared = glm::dot(offset, offset);
+		const float radii = p_radius_1 + p_radius_2;
+		if (distance_squared > radii * radii)
+			return std::nullopt;
+
+		const float distance = std::sqrt(distance_squared);
+		Contact contact;
+		contact.normal            = distance > Epsilon ? offset / distance : p_fallback_normal;
+		contact.penetration_depth = radii - distance;
+		contact.position          = p_center_1 - (contact.normal * p_radius_1);
+		return contact;
+	}
+
+	// Closest point to p_point on the segment p_start to p_end.
+	static glm::vec3 closest_point_on_segment(const glm::vec3& p_start, const glm::vec3& p_end, const glm::vec3& p_point)
+	{
+		const glm::vec3 direction = p_end - p_start;
+		const float length_squared = glm::dot(direction, direction);
+		if (length_squared <= Epsilon * Epsilon)
+			return p_start;
+
+		return p_start + direction * std::clamp(glm::dot(p_point - p_start, direction) / length_squared, 0.f, 1.f);
+	}
+
+	// Closest points between the segments p_start_1 to p_end_1 and p_start_2 to p_end_2.
+	// Reference: Real-Time Collision Detection (Christer Ericson) 5.1.9.
+	static std::pair<glm::vec3, glm::vec3> closest_points_on_segments(const glm::vec3& p_start_1, const glm::vec3& p_end_1, const glm::vec3& p_start_2, const glm::vec3& p_end_2)
+	{
+		const glm::vec3 direction_1 = p_end_1 - p_start_1;
+		const glm::vec3 direction_2 = p_end_2 - p_start_2;
+		const glm::vec3 offset      = p_start_1 - p_start_2;
+		const float a = glm::dot(direction_1, direction_1);
+		const float e = glm::dot(direction_2, direction_2);
+		const float f = glm::dot(direction_2, offset);
+
+		float s = 0.f;
+		float t = 0.f;
+		if (a <= Epsilon && e <= Epsilon)
+			return {p_start_1, p_start_2}; // Both segments are points.
+
+		if (a <= Epsilon)
+			t = std::clamp(f / e, 0.f, 1.f); // Segment 1 is a point.
+		else
+		{
+			const float c = glm::dot(direction_1, offset);
+			if (e <= Epsilon)
+				s = std::clamp(-c / a, 0.f, 1.f); // Segment 2 is a point.
+			else
+			{
+				const float b     = glm::dot(direction_1, direction_2);
+				const float denom = a * e - b * b; // Zero when the segments are parallel, pick s = 0 and clamp t.
+				s = denom > Epsilon ? std::clamp((b * f - c * e) / denom, 0.f, 1.f) : 0.f;
+				t = (b * s + f) / e;
+
+				// If t is outside the segment clamp it and recompute s for the clamped t.
+				if (t < 0.f)
+				{
+					t = 0.f;
+					s = std::clamp(-c / a, 0.f, 1.f);
+				}
+				else if (t > 1.f)
+				{
+					t = 1.f;
+					s = std::clamp((b - c) / a, 0.f, 1.f);
+				}
+			}
+		}
+		return {p_start_1 + direction_1 * s, p_start_2 + direction_2 * t};
+	}
+
+	std::optional<Contact> contact(const Sphere& p_sphere_1, const Sphere& p_sphere_2)
+	{
+		return sphere_sphere(p_sphere_1.m_center, p_sphere_1.m_radius, p_sphere_2.m_center, p_sphere_2.m_radius, glm::vec3(0.f, 1.f, 0.f));
+	}
+
+	std::optional<Contact> contact(const Sphere& p_sphere, const Cuboid& p_cuboid)
+	{
+		// Work in the space of the cuboid where it is an AABB centered on the origin.
+		const glm::quat inverse_rotation = glm::inverse(p_cuboid.m_rotation);
+		const glm::vec3 center  = inverse_rotation * (p_sphere.m_center - p_cuboid.m_center);
+		const glm::vec3 closest = glm::clamp(center, -p_cuboid.m_half_extents, p_cuboid.m_half_extents);
+
+		glm::vec3 normal;
+		float penetration_depth;
+		const glm::vec3 offset = center - closest;
+		const float distance_squared = glm::dot(offset, offset);
+		if (distance_squared > Epsilon * Epsilon)
+		{
+			// Center outside the cuboid, the closest point is on its surface.
+			if (distance_squared > p_sphere.m_radius * p_sphere.m_radius)
+				return std::nullopt;
+
+			const float distance = std::sqrt(distance_squared);
+			normal            = offset / distance;
+			penetration_depth = p_sphere.m_radius - distance;
+		}
+		else
+		{
+			// Center inside the cuboid, push out through the nearest face.
+			int axis = 0;
+			float face_distance = std::numeric_limits<float>::max();
+			for (int i = 0; i < 3; i++)
+			{
+				const float distance = p_cuboid.m_half_extents[i] - std::abs(center[i]);
+				if (distance < face_distance)
+				{
+					face_distance = distance;
+					axis          = i;
+				}
+			}
+			normal            = glm::vec3(0.f);
+			normal[axis]      = center[axis] >= 0.f ? 1.f : -1.f;
+			penetration_depth = p_sphere.m_radius + face_distance;
+		}
+
+		Contact contact;
+		contact.normal            = p_cuboid.m_rotation * normal;
+		contact.penetration_depth = penetration_depth;
+		contact.position          = p_sphere.m_center - (contact.normal * p_sphere.m_radius);
+		return contact;
+	}
+
+	std::optional<Contact> contact(const Sphere& p_sphere, const Capsule& p_capsule)
+	{
+		const glm::vec3 closest = closest_point_on_segment(p_capsule.m_start, p_capsule.m_end, p_sphere.m_center);
+
+		// If the center is on the segment push out perpendicular to it.
+		const glm::vec3 direction = p_capsule.m_end - p_capsule.m_start;
+		const glm::vec3 fallback_normal = glm::dot(direction, direction) > Epsilon * Epsilon ? perpendicular(glm::normalize(direction)) : glm::vec3(0.f, 1.f, 0.f);
+		return sphere_sphere(p_sphere.m_center, p_sphere.m_radius, closest, p_capsule.m_radius, fallback_normal);
+	}
+
+	std::optional<Contact> contact(const Sphere& p_sphere, const Cylinder& p_cylinder)
+	{
+		// Work in cylindrical coordinates about the axis through the middle of the cylinder.
+		const glm::vec3 middle   = (p_cylinder.m_base + p_cylinder.m_top) * 0.5f;
+		const float half_height  = glm::length(p_cylinder.m_top - p_cylinder.m_base) * 0.5f;
+		const glm::vec3 axis     = half_height > Epsilon ? (p_cylinder.m_top - p_cylinder.m_base) / (half_height * 2.f) : glm::vec3(0.f, 1.f, 0.f);
+		const glm::vec3 offset   = p_sphere.m_center - middle;
+		const float height       = glm::dot(offset, axis);
+		const glm::vec3 radial   = offset - (axis * height);
+		const float radial_distance = glm::length(radial);
+		const glm::vec3 radial_direction = radial_distance > Epsilon ? radial / radial_distance : perpendicular(axis);
+
+		glm::vec3 normal;
+		float penetration_depth;
+		if (std::abs(height) > half_height || radial_distance > p_cylinder.m_radius)
+		{
+			// Center outside the cylinder, the closest point is on the side, a cap or the rim between them.
+			const glm::vec3 closest = middle + (axis * std::clamp(height, -half_height, half_height)) + (radial_direction * std::min(radial_distance, p_cylinder.m_radius));
+			const glm::vec3 to_center = p_sphere.m_center - closest;
+			const float distance_squared = glm::dot(to_center, to_center);
+			if (distance_squared > p_sphere.m_radius * p_sphere.m_radius)
+				return std::nullopt;
+
+			const float distance = std::sqrt(distance_squared);
+			normal            = distance > Epsilon ? to_center / distance : (std::abs(height) > half_height ? axis * (height >= 0.f ? 1.f : -1.f) : radial_direction);
+			penetration_depth = p_sphere.m_radius - distance;
+		}
+		else
+		{
+			// Center inside the cylinder, push out through the nearest cap or the side.
+			const float cap_distance  = half_height - std::abs(height);
+			const float side_distance = p_cylinder.m_radius - radial_distance;
+			if (cap_distance < side_distance)
+			{
+				normal            = axis * (height >= 0.f ? 1.f : -1.f);
+				penetration_depth = p_sphere.m_radius + cap_distance;
+			}
+			else
+			{
+				normal            = radial_direction;
+				penetration_depth = p_sphere.m_radius + side_distance;
+			}
+		}
+
+		Contact contact;
+		contact.normal            = normal;
+		contact.penetration_depth = penetration_depth;
+		contact.position          = p_sphere.m_center - (normal * p_sphere.m_radius);
+		return contact;
+	}
+
+	std::optional<Contact> contact(const Capsule& p_capsule_1, const Capsule& p_capsule_2)
+	{
+		const auto [closest_1, closest_2] = closest_points_on_segments(p_capsule_1.m_start, p_capsule_1.m_end, p_capsule_2.m_start, p_capsule_2.m_end);
+
+		// If the segments cross the normal is perpendicular to both.
+		glm::vec3 fallback_normal = glm::cross(p_capsule_1.m_end - p_capsule_1.m_start, p_capsule_2.m_end - p_capsule_2.m_start);
+		fallback_normal = glm::dot(fallback_normal, fallback_normal) > Epsilon * Epsilon ? glm::normalize(fallback_normal) : glm::vec3(0.f, 1.f, 0.f);
+		return sphere_sphere(closest_1, p_capsule_1.m_radius, closest_2, p_capsule_2.m_radius, fallback_normal);
+	}
+
+	std::optional<Contact> contact(const Cuboid& p_cuboid_1, const Cuboid& p_cuboid_2)
+	{
+		// Reference: Real-Time Collision Detection (Christer Ericson) 4.4.1.
+		const std::array<glm::vec3, 3> axes_1 = {p_cuboid_1.m_rotation * glm::vec3(1.f, 0.f, 0.f), p_cuboid_1.m_rotation * glm::vec3(0.f, 1.f, 0.f), p_cuboid_1.m_rotation * glm::vec3(0.f, 0.f, 1.f)};
+		const std::array<glm::vec3, 3> axes_2 = {p_cuboid_2.m_rotation * glm::vec3(1.f, 0.f, 0.f), p_cuboid_2.m_rotation * glm::vec3(0.f, 1.f, 0.f), p_cuboid_2.m_rotation * glm::vec3(0.f, 0.f, 1.f)};
+		const glm::vec3 offset = p_cuboid_2.m_center - p_cuboid_1.m_center;
+
+		auto projected_radius = [](const std::array<glm::vec3, 3>& p_axes, const glm::vec3& p_half_extents, const glm::vec3& p_axis)
+		{
+			return p_half_extents.x * std::abs(glm::dot(p_axes[0], p_axis)) + p_half_extents.y * std::abs(glm::dot(p_axes[1], p_axis)) + p_half_extents.z * std::abs(glm::dot(p_axes[2], p_axis));
+		};
+
+		enum class AxisSource { Face_1, Face_2, Edge };
+		// Prefer a face axis unless an edge axis is clearly shallower, near-equal axes would otherwise flip between ticks.
+		constexpr float Edge_Axis_Bias = 0.95f;
+
+		float min_overlap  = std::numeric_limits<float>::max();
+		glm::vec3 min_axis = glm::vec3(0.f);
+		AxisSource source  = AxisSource::Face_1;
+		int edge_1 = 0;
+		int edge_2 = 0;
+
+		// Returns false if p_axis separates the cuboids.
+		auto test_axis = [&](const glm::vec3& p_axis, AxisSource p_source, int p_edge_1, int p_edge_2)
+		{
+			const float overlap = projected_radius(axes_1, p_cuboid_1.m_half_extents, p_axis) + projected_radius(axes_2, p_cuboid_2.m_half_extents, p_axis) - std::abs(glm::dot(offset, p_axis));
+			if (overlap < 0.f)
+				return false;
+
+			if (p_source == AxisSource::Edge ? overlap < min_overlap * Edge_Axis_Bias : overlap < min_overlap)
+			{
+				min_overlap = overlap;
+				min_axis    = p_axis;
+				source      = p_source;
+				edge_1      = p_edge_1;
+				edge_2      = p_edge_2;
+			}
+			return true;
+		};
+
+		for (int i = 0; i < 3; i++)
+			if (!test_axis(axes_1[i], AxisSource::Face_1, i, 0))
+				return std::nullopt;
+		for (int i = 0; i < 3; i++)
+			if (!test_axis(axes_2[i], AxisSource::Face_2, 0, i))
+				return std::nullopt;
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				const glm::vec3 axis = glm::cross(axes_1[i], axes_2[j]);
+				const float length = glm::length(axis);
+				if (length < Epsilon)
+					continue; // Parallel edges, the face axes already cover this direction.
+
+				if (!test_axis(axis / length, AxisSource::Edge, i, j))
+					return std::nullopt;
+			}
+		}
+
+		Contact contact;
+		contact.normal            = glm::dot(offset, min_axis) > 0.f ? -min_axis : min_axis;
+		contact.penetration_depth = min_overlap;
+
+		// Furthest vertex of a cuboid in p_direction.
+		auto support = [](const Cuboid& p_cuboid, const std::array<glm::vec3, 3>& p_axes, const glm::vec3& p_direction)
+		{
+			glm::vec3 vertex = p_cuboid.m_center;
+			for (int i = 0; i < 3; i++)
+				vertex += p_axes[i] * (glm::dot(p_axes[i], p_direction) >= 0.f ? p_cuboid.m_half_extents[i] : -p_cuboid.m_half_extents[i]);
+			return vertex;
+		};
+
+		if (source == AxisSource::Edge)
+		{
+			// The contact is between the edge of cuboid 1 along axes_1[edge_1] and the edge of cuboid 2 along axes_2[edge_2].
+			auto edge = [](const Cuboid& p_cuboid, const glm::vec3& p_vertex, const glm::vec3& p_axis, float p_half_extent)
+			{
+				const glm::vec3 middle = p_vertex - (p_axis * glm::dot(p_vertex - p_cuboid.m_center, p_axis));
+				return std::pair<glm::vec3, glm::vec3>{middle - (p_axis * p_half_extent), middle + (p_axis * p_half_extent)};
+			};
+			const auto [start_1, end_1] = edge(p_cuboid_1, support(p_cuboid_1, axes_1, -contact.normal), axes_1[edge_1], p_cuboid_1.m_half_extents[edge_1]);
+			const auto [start_2, end_2] = edge(p_cuboid_2, support(p_cuboid_2, axes_2, contact.normal), axes_2[edge_2], p_cuboid_2.m_half_extents[edge_2]);
+			contact.position = closest_points_on_segments(start_1, end_1, start_2, end_2).first;
+		}
+		else
+		{
+			// The face of the reference cuboid is hit by the deepest vertex of the incident cuboid.
+			// The vertex is clamped onto the extent of the reference face so a large incident cuboid reports a point inside the overlap.
+			const bool reference_1           = source == AxisSource::Face_1;
+			const Cuboid& reference          = reference_1 ? p_cuboid_1 : p_cuboid_2;
+			const auto& reference_axes       = reference_1 ? axes_1 : axes_2;
+			const int reference_axis         = reference_1 ? edge_1 : edge_2;
+			const glm::vec3 incident_vertex  = reference_1 ? support(p_cuboid_2, axes_2, contact.normal) : support(p_cuboid_1, axes_1, -contact.normal);
+
+			const glm::vec3 local = incident_vertex - reference.m_center;
+			glm::vec3 vertex      = reference.m_center;
+			for (int i = 0; i < 3; i++)
+			{
+				const float coordinate = glm::dot(local, reference_axes[i]);
+				vertex += reference_axes[i] * (i == reference_axis ? coordinate : std::clamp(coordinate, -reference.m_half_extents[i], reference.m_half_extents[i]));
+			}
+			// A vertex of cuboid 2 is on the surface of cuboid 2, step back to the deepest point of cuboid 1.
+			contact.position = reference_1 ? vertex - (contact.normal * contact.penetration_depth) : vertex;
+		}
+		return contact;
+	}
+} // namespace Geometry
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include <optional>
+
+namespace Geometry
+{
+	class Capsule;
+	class Cuboid;
+	class Cylinder;
+	class Sphere;
+
+	// The contact between two intersecting shapes from the perspective of the first shape.
+	// The point on the surface of the second shape is position + (normal * penetration_depth).
+	struct Contact
+	{
+		glm::vec3 position      = glm::vec3(0.f); // Deepest point of shape 1 inside shape 2.
+		glm::vec3 normal        = glm::vec3(0.f); // Direction shape 1 is pushed to separate it from shape 2 (normalised).
+		float penetration_depth = 0.f;            // Distance along normal to separate the shapes.
+	};
+
+	// The same contact from the perspective of the second shape.
+	Contact swap_perspective(const Contact& p_contact);
+
+	// Analytic contact tests between primitive shapes. Every test is closed form (or SAT over a fixed set of axes)
+	// so is far cheaper than GJK + EPA over the points of a mesh.
+	// Shapes touching exactly (zero depth) are reported as intersecting.
+	//@return The Contact from the perspective of the first shape if the shapes intersect.
+	std::optional<Contact> contact(const Sphere& p_sphere_1, const Sphere& p_sphere_2);
+	std::optional<Contact> contact(const Sphere& p_sphere, const Cuboid& p_cuboid);
+	std::optional<Contact> contact(const Sphere& p_sphere, const Capsule& p_capsule);
+	std::optional<Contact> contact(const Sphere& p_sphere, const Cylinder& p_cylinder);
+	std::optional<Contact> contact(const Capsule& p_capsule_1, const Capsule& p_capsule_2);
+	// Separating axis test over the 3 face normals of each cuboid and the 9 cross products of their edges.
+	// Face-face and face-edge contacts report the deepest vertex of p_cuboid_1, edge-edge contacts the closest point between the edges.
+	std::optional<Contact> contact(const Cuboid& p_cuboid_1, const Cuboid& p_cuboid_2);
+} // namespace Geometry
@@ -8,7 +8,7 @@
 namespace Geometry
 {
 	// Frustrum represnts a portion of space bounded by 6 planes.
-	// By convention the plane normal's point inside the bounded volume/frustrum.
+	// The left, right, bottom and top plane normals point inside the bounded volume/frustrum, the near and far normals point outside.
 	class Frustrum
 	{
 	public:
@@ -6,10 +6,54 @@
 #include "glm/gtc/quaternion.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 namespace GJK
 {
+	Shape::Shape(const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation, size_t* p_support_hint)
+		: points{&p_points}
+		, few_points{}
+		, transform{p_transform}
+		, inverse_orientation{glm::inverse(p_orientation)}
+		, support_hint{p_support_hint}
+	{}
+	Shape::Shape(std::span<const glm::vec3> p_points, const glm::mat4& p_transform, const glm::quat& p_orientation)
+		: points{nullptr}
+		, few_points{p_points}
+		, transform{p_transform}
+		, inverse_orientation{glm::inverse(p_orientation)}
+		, support_hint{nullptr}
+	{
+		ASSERT(!p_points.empty(), "[GJK] Shape constructed from an empty point set.");
+	}
+	glm::vec3 Shape::object_space_support_point(const glm::vec3& p_direction) const
+	{
+		if (!points)
+		{
+			// Too few points for the SIMD kernels to pay off, ties resolve to the lowest index like PointCloud::support_index.
+			glm::vec3 furthest_point = few_points[0];
+			float furthest_distance  = glm::dot(p_direction, furthest_point);
+			for (size_t i = 1; i < few_points.size(); i++)
+			{
+				const float distance = glm::dot(p_direction, few_points[i]);
+				if (distance > furthest_distance)
+				{
+					furthest_distance = distance;
+					furthest_point    = few_points[i];
+				}
+			}
+			return furthest_point;
+		}
+
+		return support_hint ? (*points)[points->support_index(p_direction, *support_hint)] : points->support_point(p_direction);
+	}
+	glm::vec3 Shape::world_space_support_point(const glm::vec3& p_direction) const
+	{
+		return glm::vec3(transform * glm::vec4(object_space_support_point(inverse_orientation * p_direction), 1.f));
+	}
+
 	bool same_direction(const glm::vec3& A, const glm::vec3& B)
 	{
 		return glm::dot(A, B) > 0.f;
@@ -56,6 +100,24 @@ namespace GJK
 		return mesh_1_support_point_world_space - mesh_2_support_point_world_space;
 	}
 
+	// Returns a callable equivalent to the point set support_point overload, with the inverse orientations computed once up front.
+	static auto make_support_func(const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
+	                              const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2)
+	{
+		return [&p_points_1, &p_transform_1, &p_points_2, &p_transform_2,
+		        inverse_orientation_1 = glm::inverse(p_orientation_1), inverse_orientation_2 = glm::inverse(p_orientation_2)](const glm::vec3& p_direction)
+		{
+			const auto support_1 = support_point(  inverse_orientation_1 * p_direction,  p_points_1);
+			const auto support_2 = support_point(-(inverse_orientation_2 * p_direction), p_points_2);
+			return glm::vec3(p_transform_1 * glm::vec4(support_1, 1.f)) - glm::vec3(p_transform_2 * glm::vec4(support_2, 1.f));
+		};
+	}
+
+	glm::vec3 support_point(const glm::vec3& p_direction, const Shape& p_shape_1, const Shape& p_shape_2)
+	{
+		return p_shape_1.world_space_support_point(p_direction) - p_shape_2.world_space_support_point(-p_direction);
+	}
+
 	bool do_simplex(Simplex& p_simplex, glm::vec3& p_direction)
 	{
 		// Purpose of the do_simplex function is to iteratively construct a simplex that encloses the origin.
@@ -224,211 +286,381 @@ namespace GJK
 			case 2: do_line();     return false;
 			case 3: do_triangle(); return false;
 			case 4:  return do_tetrahedron();
-			default: throw std::runtime_error("[GJK] Invalid simplex size in do_simplex func.");
+			default:
+				ASSERT(false, "[GJK] Invalid simplex size {} in do_simplex func.", p_simplex.size);
+				return false;
 		}
 	}
 
-	bool intersecting(const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
-	                  const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2,
-	                  const glm::vec3& p_initial_direction)
+	// GJK main loop shared by the intersecting overloads.
+	//@param p_support Callable returning the world-space Minkowski difference support point for a direction.
+	//@param p_direction The initial direction to search in. Set to the final search direction, a separating axis if the function returns false.
+	template <typename SupportFunc>
+	static bool intersecting_impl(const SupportFunc& p_support, Simplex& p_simplex, glm::vec3& p_direction)
 	{
-		glm::vec3 direction = p_initial_direction;
-		Simplex simplex = {support_point(direction,
-		                                 p_points_1, p_transform_1, p_orientation_1,
-		                                 p_points_2, p_transform_2, p_orientation_2)};
-		direction = -simplex[0]; // AO, search in the direction of the origin. Reversed direction to point towards the origin.
+		p_simplex = {p_support(p_direction)};
+
+		// If the furthest point in p_direction is not past the origin, p_direction already separates the shapes.
+		// Cheap when p_direction is a separating axis cached from the last query.
+		if (glm::dot(p_simplex[0], p_direction) < 0.f)
+			return false;
+
+		p_direction = -p_simplex[0]; // AO, search in the direction of the origin. Reversed direction to point towards the origin.
 
 		while (true) // Main GJK loop. Converge on A simplex that encloses the origin.
 		{
-			auto new_support_point = support_point(direction,
-			                                       p_points_1, p_transform_1, p_orientation_1,
-			                                       p_points_2, p_transform_2, p_orientation_2);
+			auto new_support_point = p_support(p_direction);
 
 			// If the new support point is not past the origin then its impossible to enclose the origin.
-			if (glm::dot(new_support_point, direction) <= 0.f)
+			if (glm::dot(new_support_point, p_direction) <= 0.f)
 				return false;
 
 			// Shift the simplex points along to retain A as the most recently added support point as do_simplex expects.
-			simplex.push_front(new_support_point);
+			p_simplex.push_front(new_support_point);
 
-			if (do_simplex(simplex, direction))
+			if (do_simplex(p_simplex, p_direction))
 				return true;
 		}
 	}
 
-	// Tests if the reverse of an edge already exists in the list and if so, removes it.
-	void add_if_unique_edge(std::vector<std::pair<unsigned int, unsigned int>>& edges, const std::vector<unsigned int>& faces, unsigned int a, unsigned int b)
+	bool intersecting(const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
+	                  const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2,
+	                  const glm::vec3& p_initial_direction)
 	{
-		// By virtue of winding order, if a neighbouring face shares an edge, it will be in reverse order.
-		// We only want to store the edges that we are going to save because every edge gets removed first, then we repair.
+		auto support = make_support_func(p_points_1, p_transform_1, p_orientation_1, p_points_2, p_transform_2, p_orientation_2);
 
-		auto reverse = std::find(edges.begin(), edges.end(), std::make_pair(faces[b], faces[a]));
+		Simplex simplex;
+		glm::vec3 direction = p_initial_direction;
+		return intersecting_impl(support, simplex, direction);
+	}
+	bool intersecting(const Shape& p_shape_1, const Shape& p_shape_2, Simplex& p_simplex, const glm::vec3& p_initial_direction)
+	{
+		glm::vec3 direction = p_initial_direction;
+		return intersecting_impl([&](const glm::vec3& p_direction) { return support_point(p_direction, p_shape_1, p_shape_2); }, p_simplex, direction);
+	}
+	bool intersecting(const Shape& p_shape_1, const Shape& p_shape_2, Simplex& p_simplex, PairCache& p_cache)
+	{
+		// A zero axis can come from a degenerate last query (e.g. touching at the origin), restart from an arbitrary axis.
+		if (p_cache.separating_axis == glm::vec3(0.f))
+			p_cache.separating_axis = glm::vec3(1.f, 0.f, 0.f);
 
-		if (reverse != edges.end())
-			edges.erase(reverse);
-		else
-			edges.emplace_back(faces[a], faces[b]);
+		return intersecting_impl([&](const glm::vec3& p_direction) { return support_point(p_direction, p_shape_1, p_shape_2); }, p_simplex, p_cache.separating_axis);
 	}
 
-	// Returns a list of face normals and the index of the closest face.
-	//@param polytope: The list of points that define the polytope.
-	//@param faces: The list of indices that define the faces of the polytope.
-	//@returns A pair containing the list of face normals (xyz pos + w distance) and the index of the closest face.
-	std::pair<std::vector<glm::vec4>, size_t> get_face_normals(const std::vector<glm::vec3>& polytope, const std::vector<unsigned int>& faces)
+	// The EPA polytope, a triangle mesh enclosing the origin that is expanded towards the Minkowski difference surface.
+	// Held in fixed capacity arrays on the stack so EPA doesn't allocate.
+	struct Polytope
 	{
-		std::vector<glm::vec4> face_normals;
-		face_normals.reserve(faces.size() / 3);
-		unsigned int min_triangle   = 0;
-		float min_distance = std::numeric_limits<float>::max();
-
-		for (unsigned int i = 0; i < static_cast<unsigned int>(faces.size()); i += 3)
+		struct Face
 		{
-			glm::vec3 a = polytope[faces[i]];
-			glm::vec3 b = polytope[faces[i + 1]];
-			glm::vec3 c = polytope[faces[i + 2]];
+			std::array<uint8_t, 3> indices; // Into points, wound so the normal points away from the origin.
+			glm::vec4 normal;               // xyz normal + w distance to the origin.
+		};
+		using Edge = std::pair<uint8_t, uint8_t>;
+		static_assert(EPA_Max_Points <= std::numeric_limits<uint8_t>::max() + 1, "Face indices are stored as uint8_t");
 
-			glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
-			float distance   = glm::dot(normal, a);
+		std::array<glm::vec3, EPA_Max_Points> points;
+		std::array<Face, EPA_Max_Faces> faces;
+		size_t point_count = 0;
+		size_t face_count  = 0;
 
+		void add_face(uint8_t p_a, uint8_t p_b, uint8_t p_c)
+		{
+			const glm::vec3& a = points[p_a];
+			glm::vec3 normal   = glm::normalize(glm::cross(points[p_b] - a, points[p_c] - a));
+			float distance     = glm::dot(normal, a);
 			if (distance < 0)
 			{
 				normal   *= -1;
 				distance *= -1;
 			}
-			face_normals.emplace_back(normal, distance);
-
-			if (distance < min_distance)
+			faces[face_count++] = {{p_a, p_b, p_c}, glm::vec4(normal, distance)};
+		}
+		size_t closest_face() const
+		{
+			size_t closest     = 0;
+			float min_distance = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < face_count; i++)
 			{
-				min_triangle = i / 3u;
-				min_distance = distance;
+				if (faces[i].normal.w < min_distance)
+				{
+					closest      = i;
+					min_distance = faces[i].normal.w;
+				}
 			}
+			return closest;
 		}
+	};
 
-		return {face_normals, min_triangle};
+	// Adds the edge unless its reverse is already in p_edges, in which case the reverse is removed instead.
+	// By virtue of winding order, if a neighbouring face shares an edge, it will be in reverse order. So after adding the edges of every
+	// removed face only the horizon, the edges between removed and kept faces, remains.
+	static void add_if_unique_edge(std::array<Polytope::Edge, EPA_Max_Faces * 3>& p_edges, size_t& p_edge_count, uint8_t p_a, uint8_t p_b)
+	{
+		for (size_t i = 0; i < p_edge_count; i++)
+		{
+			if (p_edges[i].first == p_b && p_edges[i].second == p_a)
+			{
+				p_edges[i] = p_edges[--p_edge_count];
+				return;
+			}
+		}
+		p_edges[p_edge_count++] = {p_a, p_b};
 	}
 
-	CollisionPoint EPA(const Simplex& p_simplex,
-	                   const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
-	                   const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2)
+	// EPA shared by the EPA overloads.
+	//@param p_support Callable returning the world-space Minkowski difference support point for a direction.
+	//@param p_transform_1,p_transform_2 The object->world space transforms used to return the CollisionPoint in object space.
+	//@param p_result Optional out param set to how the query ended.
+	template <typename SupportFunc>
+	static CollisionPoint EPA_impl(const Simplex& p_simplex, const SupportFunc& p_support, const glm::mat4& p_transform_1, const glm::mat4& p_transform_2, EPAResult* p_result)
 	{
-		if (p_simplex.size != 4)
-			throw std::runtime_error("[GJK] Invalid simplex size in EPA function. EPA expects incoming simplex to be a tetrahedron.");
+		auto set_result = [p_result](EPAResult p_value) { if (p_result) *p_result = p_value; };
 
-		std::vector<glm::vec3> polytope = {p_simplex[0], p_simplex[1], p_simplex[2], p_simplex[3]};
-		std::vector<unsigned int> faces = {
-		    0, 1, 2,
-		    0, 3, 1,
-		    0, 2, 3,
-		    1, 3, 2};
-		auto [face_normals, min_face] = get_face_normals(polytope, faces);
-
-		glm::vec3 min_normal = face_normals[min_face];
-		float min_distance   = std::numeric_limits<float>::max();
+		if (p_simplex.size != 4)
+		{
+			set_result(EPAResult::Invalid_Simplex);
+			return CollisionPoint{glm::vec3(0.f), glm::vec3(0.f), glm::vec3(0.f), 0.f};
+		}
 
-		while (min_distance == std::numeric_limits<float>::max())
+		Polytope polytope;
+		for (int i = 0; i < 4; i++)
+			polytope.points[polytope.point_count++] = p_simplex[i];
+		polytope.add_face(0, 1, 2);
+		polytope.add_face(0, 3, 1);
+		polytope.add_face(0, 2, 3);
+		polytope.add_face(1, 3, 2);
+
+		// Scratch for each expansion, faces visible from the support point and the horizon edges left by removing them.
+		std::array<bool, EPA_Max_Faces> visible;
+		std::array<Polytope::Edge, EPA_Max_Faces * 3> horizon;
+
+		// Every exit leaves min_face as the closest face of a valid polytope, so a query that didn't converge still returns its best estimate.
+		size_t min_face      = polytope.closest_face();
+		EPAResult result     = EPAResult::Iteration_Limit;
+		for (size_t iteration = 0; iteration < EPA_Max_Iterations; iteration++)
 		{
-			min_normal   = face_normals[min_face];
-			min_distance = face_normals[min_face].w;
+			const glm::vec3 min_normal = polytope.faces[min_face].normal;
+			const float min_distance   = polytope.faces[min_face].normal.w;
 
-			glm::vec3 support = support_point(min_normal,
-			                                  p_points_1, p_transform_1, p_orientation_1,
-			                                  p_points_2, p_transform_2, p_orientation_2);
-			float s_distance  = dot(min_normal, support);
+			glm::vec3 support = p_support(min_normal);
+			float s_distance  = glm::dot(min_normal, support);
+			if (std::abs(s_distance - min_distance) <= 0.001f)
+			{
+				result = EPAResult::Converged;
+				break;
+			}
 
-			if (std::abs(s_distance - min_distance) > 0.001f)
+			// When expanding the polytope, we cannot just add a vertex, we need to repair the faces as well.
+			// When two faces result in the same support point being added, duplicate faces end up inside the polytope and cause incorrect results.
+			// We have to remove every face that is pointing in the direction of the support point relative to the triangle.
+			// To repair afterwards, we keep track of the horizon edges and use those along with the support point's index to make new faces.
+			size_t visible_count = 0;
+			size_t horizon_count = 0;
+			for (size_t i = 0; i < polytope.face_count; i++)
 			{
-				min_distance = std::numeric_limits<float>::max();
-
-				// When expanding the polytope, we cannot just add a vertex, we need to repair the faces as well.
-				// When two faces result in the same support point being added, duplicate faces end up inside the polytope and cause incorrect results.
-				// We have to remove every face that is pointing in the direction of the support point relative to the triangle.
-				// To repair afterwards, we keep track of unique_edges and use those along with the support point's index to make new faces.
-				std::vector<std::pair<unsigned int, unsigned int>> unique_edges;
-				for (unsigned int i = 0; i < face_normals.size(); i++)
+				// Check same_direction relative to the triangle, not just the face normal.
+				// If the support point is behind a face, adding it past that face would make the polytope concave.
+				const auto& face = polytope.faces[i];
+				visible[i] = same_direction(face.normal, support - polytope.points[face.indices[0]]);
+				if (visible[i])
 				{
-					// This line compares the shortest distance of two parallel planes and the origin,
-					// passing by a forced point (support vertex vs point of current face).
-					// If the distance of the support point is lower, then the result would be a concave polytope, which is undesired.
-					// if ( normals[i].dot(support) > normals[i].dot(polytope[faces[i*3]]))
-					// Check same_direction relative to the triangle, not just the face normal.
+					visible_count++;
+					add_if_unique_edge(horizon, horizon_count, face.indices[0], face.indices[1]);
+					add_if_unique_edge(horizon, horizon_count, face.indices[1], face.indices[2]);
+					add_if_unique_edge(horizon, horizon_count, face.indices[2], face.indices[0]);
+				}
+			}
+			if (horizon_count == 0)
+			{
+				result = EPAResult::Degenerate;
+				break;
+			}
+			// Checked before changing the polytope so the current one and its closest face remain valid to return.
+			if (polytope.point_count == EPA_Max_Points || polytope.face_count - visible_count + horizon_count > EPA_Max_Faces)
+			{
+				result = EPAResult::Polytope_Full;
+				break;
+			}
 
-					if (same_direction(face_normals[i], support - polytope[faces[i * 3]]))
-					{
-						unsigned int face_index = i * 3;
+			size_t kept = 0;
+			for (size_t i = 0; i < polytope.face_count; i++)
+				if (!visible[i])
+					polytope.faces[kept++] = polytope.faces[i];
+			polytope.face_count = kept;
 
-						add_if_unique_edge(unique_edges, faces, face_index, face_index + 1);
-						add_if_unique_edge(unique_edges, faces, face_index + 1, face_index + 2);
-						add_if_unique_edge(unique_edges, faces, face_index + 2, face_index);
+			const auto support_index = static_cast<uint8_t>(polytope.point_count);
+			polytope.points[polytope.point_count++] = support;
+			for (size_t i = 0; i < horizon_count; i++)
+				polytope.add_face(horizon[i].first, horizon[i].second, support_index);
 
-						faces[face_index + 2] = faces.back();
-						faces.pop_back();
-						faces[face_index + 1] = faces.back();
-						faces.pop_back();
-						faces[face_index] = faces.back();
-						faces.pop_back();
+			min_face = polytope.closest_face();
+		}
+		set_result(result);
 
-						face_normals[i] = face_normals.back(); // pop-erase
-						face_normals.pop_back();
+		// The closest face of the polytope to the origin of the Minkowski difference is the face that represents the deepest penetration.
+		// The normal of this face is the collision normal, and its distance to the origin is the penetration depth.
+		// The collision point is the point on the face closest to the origin.
+		const auto& face         = polytope.faces[min_face];
+		const glm::vec3 normal   = face.normal;
+		const float min_distance = face.normal.w;
+		auto closest_point = Geometry::closest_point(Geometry::Triangle(polytope.points[face.indices[0]], polytope.points[face.indices[1]], polytope.points[face.indices[2]]), glm::vec3(0.f));
 
-						i--;
-					}
+		CollisionPoint point;
+		point.normal            = normal;
+		point.A                 = glm::inverse(p_transform_1) * glm::vec4(closest_point + point.normal * min_distance, 1.f);
+		point.B                 = glm::inverse(p_transform_2) * glm::vec4(closest_point - point.normal * min_distance, 1.f);
+		point.penetration_depth = min_distance + 0.001f;
+		return point;
+	}
+
+	CollisionPoint EPA(const Simplex& p_simplex,
+	                   const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
+	                   const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2,
+	                   EPAResult* p_result)
+	{
+		auto support = make_support_func(p_points_1, p_transform_1, p_orientation_1, p_points_2, p_transform_2, p_orientation_2);
+		return EPA_impl(p_simplex, support, p_transform_1, p_transform_2, p_result);
+	}
+	CollisionPoint EPA(const Simplex& p_simplex, const Shape& p_shape_1, const Shape& p_shape_2, EPAResult* p_result)
+	{
+		return EPA_impl(p_simplex, [&](const glm::vec3& p_direction) { return support_point(p_direction, p_shape_1, p_shape_2); }, p_shape_1.transform, p_shape_2.transform, p_result);
+	}
+
+	// Closest point to the origin on the simplex p_points[0..p_count).
+	// p_points and p_count are reduced to the vertices of the closest feature so the next support point extends it.
+	// If the origin is inside a tetrahedron p_count is left at 4.
+	static glm::vec3 closest_point_to_origin(std::array<glm::vec3, 4>& p_points, int& p_count)
+	{
+		switch (p_count)
+		{
+			case 1: return p_points[0];
+			case 2:
+			{
+				const glm::vec3 a  = p_points[0];
+				const glm::vec3 ab = p_points[1] - a;
+				const float length_squared = glm::dot(ab, ab);
+				const float t = length_squared > 0.f ? glm::dot(-a, ab) / length_squared : 0.f;
+				if (t <= 0.f)      { p_count = 1; return a; }
+				else if (t >= 1.f) { p_points[0] = p_points[1]; p_count = 1; return p_points[0]; }
+				else                 return a + ab * t;
+			}
+			case 3:
+			{
+				// Voronoi region tests of the origin against the triangle, as in Geometry::closest_point(Triangle) but also reducing the simplex.
+				const glm::vec3 a = p_points[0], b = p_points[1], c = p_points[2];
+				const glm::vec3 ab = b - a, ac = c - a, ao = -a, bo = -b, co = -c;
+
+				const float d1 = glm::dot(ab, ao), d2 = glm::dot(ac, ao);
+				if (d1 <= 0.f && d2 <= 0.f) { p_count = 1; return a; }
+
+				const float d3 = glm::dot(ab, bo), d4 = glm::dot(ac, bo);
+				if (d3 >= 0.f && d4 <= d3) { p_points[0] = b; p_count = 1; return b; }
+
+				const float vc = d1 * d4 - d3 * d2;
+				if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) { p_count = 2; return a + ab * (d1 / (d1 - d3)); }
+
+				const float d5 = glm::dot(ab, co), d6 = glm::dot(ac, co);
+				if (d6 >= 0.f && d5 <= d6) { p_points[0] = c; p_count = 1; return c; }
+
+				const float vb = d5 * d2 - d1 * d6;
+				if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) { p_points[1] = c; p_count = 2; return a + ac * (d2 / (d2 - d6)); }
+
+				const float va = d3 * d6 - d5 * d4;
+				if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+				{
+					p_points[0] = b; p_points[1] = c; p_count = 2;
+					return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
 				}
-				if (unique_edges.size() == 0)
-					break;
 
-				// Now that we have a list of unique_edges, we can add the new_faces to a list and add the supporting point to the polytope.
-				// Storing the new_faces in their own list allows us to calculate only the normals of these new_faces.
-				std::vector<unsigned int> new_faces;
-				for (auto [edge_index_1, edge_index_2] : unique_edges)
+				const float sum = va + vb + vc;
+				if (sum <= 0.f) // Degenerate (collinear) triangle, fall back to its longest edge.
 				{
-					new_faces.push_back(edge_index_1);
-					new_faces.push_back(edge_index_2);
-					new_faces.push_back(static_cast<unsigned int>(polytope.size()));
+					p_count = 2;
+					return closest_point_to_origin(p_points, p_count);
 				}
-				polytope.push_back(support);
-				auto [new_normals, new_min_face] = get_face_normals(polytope, new_faces);
-
-				// After calculating the new normals, we need to find the new closest face.
-				// We only iterate over the old normals, and compare the closest one to the closest face of the new normals.
-				// Then we can add these new faces and normals to the end of faces and face_normals respectively.
-				float new_min_distance = std::numeric_limits<float>::max();
-				for (size_t i = 0; i < face_normals.size(); i++)
+				return a + ab * (vb / sum) + ac * (vc / sum);
+			}
+			case 4:
+			{
+				// The origin is outside the tetrahedron if it's on the far side of any face from the opposite vertex.
+				// The closest point is on one of those faces, test each and keep the closest.
+				constexpr std::array<std::array<int, 4>, 4> faces = {{{0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 3, 1}, {1, 2, 3, 0}}}; // 3 face indices + opposite vertex.
+
+				bool outside_any    = false;
+				float best_distance = std::numeric_limits<float>::max();
+				glm::vec3 best_point(0.f);
+				std::array<glm::vec3, 4> best_points = p_points;
+				int best_count = 4;
+
+				for (const auto& face : faces)
 				{
-					if (face_normals[i].w < new_min_distance)
+					const glm::vec3& a = p_points[face[0]];
+					const glm::vec3 normal      = glm::cross(p_points[face[1]] - a, p_points[face[2]] - a);
+					const float side_origin     = glm::dot(normal, -a);
+					const float side_opposite   = glm::dot(normal, p_points[face[3]] - a);
+					const bool degenerate       = std::abs(side_opposite) <= std::numeric_limits<float>::epsilon() * glm::dot(normal, normal);
+					if (!degenerate && side_origin * side_opposite > 0.f)
+						continue; // Origin on the same side as the opposite vertex.
+
+					outside_any = true;
+					std::array<glm::vec3, 4> face_points = {p_points[face[0]], p_points[face[1]], p_points[face[2]], glm::vec3(0.f)};
+					int face_count = 3;
+					const glm::vec3 point = closest_point_to_origin(face_points, face_count);
+					if (glm::dot(point, point) < best_distance)
 					{
-						new_min_distance = face_normals[i].w;
-						min_face         = i;
+						best_distance = glm::dot(point, point);
+						best_point    = point;
+						best_points   = face_points;
+						best_count    = face_count;
 					}
 				}
-				if (new_normals[new_min_face].w < new_min_distance)
-				{
-					min_face = new_min_face + face_normals.size();
-				}
 
-				faces.insert(faces.end(), new_faces.begin(), new_faces.end());
-				face_normals.insert(face_normals.end(), new_normals.begin(), new_normals.end());
+				if (!outside_any)
+					return glm::vec3(0.f); // Origin enclosed, p_count stays 4.
+
+				p_points = best_points;
+				p_count  = best_count;
+				return best_point;
 			}
+			default:
+				ASSERT(false, "[GJK] Invalid simplex size {} in closest_point_to_origin.", p_count);
+				return glm::vec3(0.f);
 		}
+	}
 
-		if (min_distance == std::numeric_limits<float>::max())
-			throw std::runtime_error("[GJK] EPA failed to find a collision point. This should never happen.");
+	std::optional<Separation> distance(const Shape& p_shape_1, const Shape& p_shape_2, float p_tolerance)
+	{
+		constexpr int Max_Iterations = 64;
+		auto support = [&](const glm::vec3& p_direction) { return support_point(p_direction, p_shape_1, p_shape_2); };
 
+		std::array<glm::vec3, 4> points;
+		int count = 1;
+		points[0] = support(glm::vec3(p_shape_2.transform[3]) - glm::vec3(p_shape_1.transform[3]));
+		glm::vec3 closest = points[0];
 
-		// The closest face of the polytope to the origin of the Minkowski difference is the face that represents the deepest penetration.
-		// The normal of this face is the collision normal, and its distance to the origin is the penetration depth.
-		// The collision point is the point on the face closest to the origin.
+		for (int iteration = 0; iteration < Max_Iterations; iteration++)
+		{
+			const float closest_distance_squared = glm::dot(closest, closest);
+			if (closest_distance_squared <= p_tolerance * p_tolerance)
+				return std::nullopt;
+
+			// The support point in -closest bounds the distance from below. Stop once the bound is within tolerance of the current distance.
+			const glm::vec3 new_point = support(-closest);
+			if (closest_distance_squared - glm::dot(closest, new_point) <= p_tolerance * std::sqrt(closest_distance_squared))
+				break;
+
+			points[count++] = new_point;
+			closest = closest_point_to_origin(points, count);
+			if (count == 4)
+				return std::nullopt; // The simplex encloses the origin.
+		}
 
-		auto min_face_a = polytope[faces[min_face * 3]]; // * 3 because faces is a list of indices, not points.
-		auto min_face_b = polytope[faces[min_face * 3 + 1]];
-		auto min_face_c = polytope[faces[min_face * 3 + 2]];
-		auto closest_point = Geometry::closest_point(Geometry::Triangle(min_face_a, min_face_b, min_face_c), glm::vec3(0.f));
-		// Once a supporting point isn't found further from the closest face,
-		// We return that face's normal and its distance in a CollisionPoint.
-		CollisionPoint point;
-		point.normal            = min_normal;
-		point.A                 = glm::inverse(p_transform_1) * glm::vec4(closest_point + point.normal * min_distance, 1.f);
-		point.B                 = glm::inverse(p_transform_2) * glm::vec4(closest_point - point.normal * min_distance, 1.f);
-		point.penetration_depth = min_distance + 0.001f;
-		return point;
+		const float closest_distance = glm::length(closest);
+		if (closest_distance <= p_tolerance)
+			return std::nullopt;
+
+		// closest is the closest point of (shape 1 - shape 2) to the origin, pointing from shape 2 to shape 1.
+		return Separation{closest_distance, -closest / closest_distance};
 	}
-} // namespace GJK
\ No newline at end of file
+} // namespace GJK
@@ -1,12 +1,20 @@
 #pragma once
 
+#include "PointCloud.hpp"
+
+#include "Utility/Logger.hpp"
+
 #include "glm/vec3.hpp"
-#include "glm/fwd.hpp"
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/quaternion.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <initializer_list>
-#include <stdexcept>
+#include <optional>
+#include <span>
 
 namespace GJK
 {
@@ -18,6 +26,20 @@ namespace GJK
 		float penetration_depth; // Length of B – A
 	};
 
+	// How an EPA query ended. Every result but Invalid_Simplex returns the closest face of the polytope it reached.
+	enum class EPAResult : uint8_t
+	{
+		Converged,       // The closest face is within tolerance of the Minkowski difference surface.
+		Iteration_Limit, // Ran EPA_Max_Iterations expansions without converging.
+		Polytope_Full,   // The next expansion would not fit in the fixed capacity polytope.
+		Degenerate,      // The support point couldn't expand the polytope, no horizon was left to repair it from.
+		Invalid_Simplex  // The simplex wasn't a tetrahedron. The CollisionPoint is zeroed.
+	};
+	// EPA works on a polytope held on the stack, so its bounds are fixed. Each iteration adds one point.
+	constexpr size_t EPA_Max_Iterations = 64;
+	constexpr size_t EPA_Max_Points     = 4 + EPA_Max_Iterations;
+	constexpr size_t EPA_Max_Faces      = 2 * EPA_Max_Points; // A convex polytope of n points has 2n - 4 faces, the rest is slack for the non-convex repairs rounding can cause.
+
 	// Simplex is a set of points that define a convex shape.
 	// The size of the simplex determines the shape.
 	// 0 = empty, 1 = point, 2 = line, 3 = triangle, 4 = tetrahedron
@@ -30,22 +52,20 @@ namespace GJK
 			: points({glm::vec3{0.f}})
 			, size(0)
 		{}
+		// Points past the 4th are dropped.
 		Simplex(std::initializer_list<glm::vec3> list)
 			: points()
-			, size(static_cast<int>(list.size()))
+			, size(0)
 		{
-			if (list.size() > 4) throw std::runtime_error("[GJK] Simplex can only hold up to 4 points.");
-
-			std::copy(list.begin(), list.end(), points.begin());
+			*this = list;
 		}
+		// Points past the 4th are dropped.
 		Simplex& operator=(std::initializer_list<glm::vec3> list)
 		{
-			if (list.size() > 4) throw std::runtime_error("[GJK] Simplex can only hold up to 4 points.");
-
-			size = 0;
-			for (auto& point : list)
-				points[size++] = point;
+			ASSERT(list.size() <= 4, "[GJK] Simplex can only hold up to 4 points, {} given.", list.size());
 
+			size = static_cast<int>(std::min(list.size(), points.size()));
+			std::copy_n(list.begin(), size, points.begin());
 			return *this;
 		}
 		void push_front(const glm::vec3& point)
@@ -57,6 +77,42 @@ namespace GJK
 		const glm::vec3& operator[](int index) const { return points[index]; }
 	};
 
+	// A convex shape placed in world space for GJK and EPA queries.
+	// The inverse orientation is computed once on construction, so it is paid once per pair instead of once per support query.
+	struct Shape
+	{
+		const Geometry::PointCloud* points;    // Object-space points that define the convex shape, nullptr if the shape is made of few_points.
+		std::span<const glm::vec3> few_points; // Object-space points of a shape too small to need a PointCloud, searched linearly. Owned by the caller.
+		glm::mat4 transform;                   // Object->world space transform.
+		glm::quat inverse_orientation;         // World->object space rotation used to bring search directions into object space.
+		size_t* support_hint;                  // Optional index of the last support vertex, hill-climbing starts here and updates it. See PairCache.
+
+		Shape(const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation, size_t* p_support_hint = nullptr);
+		// A shape of a handful of points, such as a mesh triangle, tested without building a PointCloud.
+		//@param p_points Must outlive the Shape, typically a std::array on the caller's stack.
+		Shape(std::span<const glm::vec3> p_points, const glm::mat4& p_transform, const glm::quat& p_orientation);
+		// Furthest point in the object-space p_direction, hill-climbing from support_hint if one is set.
+		glm::vec3 object_space_support_point(const glm::vec3& p_direction) const;
+		// Furthest point in the world-space p_direction, returned in world space.
+		glm::vec3 world_space_support_point(const glm::vec3& p_direction) const;
+	};
+
+	// The separation of two convex shapes that do not intersect.
+	struct Separation
+	{
+		float distance;   // Smallest distance between the surfaces of the shapes.
+		glm::vec3 normal; // Direction from shape 1 towards shape 2 along which distance is measured (normalised).
+	};
+
+	// State kept per pair of shapes between queries to exploit coherence.
+	// Owned by the caller, typically alongside the pair in the broadphase, and attached to the Shapes for the pair.
+	struct PairCache
+	{
+		size_t support_index_1    = 0;                         // Last support vertex of shape 1, start of the next hill-climb.
+		size_t support_index_2    = 0;                         // Last support vertex of shape 2, start of the next hill-climb.
+		glm::vec3 separating_axis = glm::vec3(1.f, 0.f, 0.f); // Last GJK search direction, a separating axis if the pair was not intersecting. Warm-starts the next query.
+	};
+
 	// Is a and b in the same direction?
 	//@param a,b: The direction vectors to compare. These don't have to be normalized since we only care about direction.
 	//@return True if a and b are in the same direction, false otherwise.
@@ -80,6 +136,13 @@ namespace GJK
 	                        const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
 	                        const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2);
 
+	// Given two convex shapes, find the furthest point of their Minkowski difference in p_direction in world space.
+	// Uses the SIMD PointCloud::support_index kernels, or hill-climbing from the Shape support_hint when the PointCloud has adjacency.
+	//@param p_direction: The direction to search in world space. Doesn't have to be normalized since we only care about direction.
+	//@param p_shape_1,p_shape_2: The convex shapes to test.
+	//@return The difference between the furthest point of p_shape_1 in p_direction and the furthest point of p_shape_2 in -p_direction in world space.
+	glm::vec3 support_point(const glm::vec3& p_direction, const Shape& p_shape_1, const Shape& p_shape_2);
+
 	// Performs an iteration of the GJK algorithm on p_simplex.
 	// The p_simplex and p_direction are updated in place.
 	//@param p_simplex The simplex to update.
@@ -97,6 +160,13 @@ namespace GJK
 	                  const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2,
 	                  const glm::vec3& p_initial_direction = glm::vec3(1.f, 0.f, 0.f));
 
+	// Given two convex shapes determine if they intersect.
+	//@param p_shape_1,p_shape_2: The convex shapes to test.
+	//@param p_simplex Output simplex. If the shapes intersect, this contains the origin and can be passed to EPA.
+	//@param p_initial_direction The initial direction to search in. A good initial direction is the vector between the two shapes in world space.
+	//@return True if the two convex shapes intersect, false otherwise.
+	bool intersecting(const Shape& p_shape_1, const Shape& p_shape_2, Simplex& p_simplex, const glm::vec3& p_initial_direction = glm::vec3(1.f, 0.f, 0.f));
+
 	// Expanding Polytope Algorithm (EPA).
 	// Given two convex shapes defined by a set of points in object space, and their transforms and orientations, determine their collision point.
 	// This function assumes that the two convex shapes intersect. Use the intersecting function and pass the resulting simplex if true.
@@ -104,7 +174,32 @@ namespace GJK
 	//@param p_transform_1,p_transform_2: The object->world space transform of the convex shapes.
 	//@param p_orientation_1,p_orientation_2 The orientation of the convex shapes.
 	//@param p_simplex The simplex that contains the origin as returned by the GJK algorithm.
+	//@param p_result Optional out param set to how the query ended. See EPAResult.
 	CollisionPoint EPA(const Simplex& p_simplex,
 	                   const std::vector<glm::vec3>& p_points_1, const glm::mat4& p_transform_1, const glm::quat& p_orientation_1,
-	                   const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2);
+	                   const std::vector<glm::vec3>& p_points_2, const glm::mat4& p_transform_2, const glm::quat& p_orientation_2,
+	                   EPAResult* p_result = nullptr);
+
+	// Given two convex shapes determine if they intersect, warm-starting from the last query of the pair.
+	// If the shapes were separated last query and have moved little, the cached separating axis usually still separates them and the test exits after one support query.
+	//@param p_shape_1,p_shape_2: The convex shapes to test. For hill-climbing, their support_hint should point into p_cache.
+	//@param p_simplex Output simplex. If the shapes intersect, this contains the origin and can be passed to EPA.
+	//@param p_cache The pair's cache. p_cache.separating_axis is used as the initial direction and updated with the final search direction.
+	//@return True if the two convex shapes intersect, false otherwise.
+	bool intersecting(const Shape& p_shape_1, const Shape& p_shape_2, Simplex& p_simplex, PairCache& p_cache);
+
+	// Expanding Polytope Algorithm (EPA) for two Shapes.
+	// This function assumes that the two convex shapes intersect. Use the intersecting function and pass the resulting simplex if true.
+	// Doesn't allocate or throw, so it can run per pair in the physics tick.
+	//@param p_simplex The simplex that contains the origin as returned by the GJK algorithm.
+	//@param p_shape_1,p_shape_2: The convex shapes to find the collision point of.
+	//@param p_result Optional out param set to how the query ended. See EPAResult.
+	CollisionPoint EPA(const Simplex& p_simplex, const Shape& p_shape_1, const Shape& p_shape_2, EPAResult* p_result = nullptr);
+
+	// Find the smallest distance between two convex shapes.
+	// Iterates a GJK simplex towards the point of the Minkowski difference closest to the origin instead of towards enclosing the origin.
+	//@param p_shape_1,p_shape_2: The convex shapes to measure between.
+	//@param p_tolerance Distance (m) the result is accurate to. Shapes closer than this are treated as touching.
+	//@return The distance and separating normal, nullopt if the shapes intersect or touch.
+	std::optional<Separation> distance(const Shape& p_shape_1, const Shape& p_shape_2, float p_tolerance = 0.0001f);
 } // namespace GJK
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "Heightfield.hpp"
+#include "Ray.hpp"
+
+#include "Utility/Logger.hpp"
+
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace Geometry
+{
+	Heightfield::Heightfield() noexcept
+		: m_heights{}
+		, m_cells_x{0}
+		, m_cells_z{0}
+		, m_cell_size{1.f}
+		, m_min_height{0.f}
+		, m_max_height{0.f}
+	{}
+
+	Heightfield::Heightfield(size_t p_cells_x, size_t p_cells_z, float p_cell_size, std::vector<float>&& p_heights)
+		: m_heights{std::move(p_heights)}
+		, m_cells_x{p_cells_x}
+		, m_cells_z{p_cells_z}
+		, m_cell_size{p_cell_size}
+		, m_min_height{0.f}
+		, m_max_height{0.f}
+	{
+		ASSERT_THROW(p_cells_x > 0 && p_cells_z > 0, "Heightfield requires at least one cell along x and z.");
+		ASSERT_THROW(p_cell_size > 0.f, "Heightfield cell size must be positive.");
+		ASSERT_THROW(m_heights.size() == (p_cells_x + 1) * (p_cells_z + 1), "Heightfield requires (cells_x + 1) * (cells_z + 1) heights.");
+
+		const auto [min, max] = std::minmax_element(m_heights.begin(), m_heights.end());
+		m_min_height = *min;
+		m_max_height = *max;
+	}
+
+	glm::vec3 Heightfield::vertex(size_t p_x, size_t p_z) const
+	{
+		return glm::vec3(static_cast<float>(p_x) * m_cell_size, sample(p_x, p_z), static_cast<float>(p_z) * m_cell_size);
+	}
+
+	AABB Heightfield::get_AABB() const
+	{
+		return AABB(glm::vec3(0.f, m_min_height, 0.f), glm::vec3(static_cast<float>(m_cells_x) * m_cell_size, m_max_height, static_cast<float>(m_cells_z) * m_cell_size));
+	}
+
+	bool Heightfield::cell_range(float p_min, float p_max, size_t p_cell_count, size_t& p_first, size_t& p_last) const
+	{
+		const float cell_count = static_cast<float>(p_cell_count);
+		if (p_max < 0.f || p_min > cell_count * m_cell_size)
+			return false;
+
+		p_first = cell_index(p_min, p_cell_count);
+		p_last  = cell_index(p_max, p_cell_count);
+		return true;
+	}
+	size_t Heightfield::cell_index(float p_position, size_t p_cell_count) const
+	{
+		return static_cast<size_t>(std::clamp(std::floor(p_position / m_cell_size), 0.f, static_cast<float>(p_cell_count) - 1.f));
+	}
+
+	std::optional<float> Heightfield::height_at(float p_x, float p_z) const
+	{
+		if (empty())
+			return std::nullopt;
+
+		size_t cell_x, cell_z, unused;
+		if (!cell_range(p_x, p_x, m_cells_x, cell_x, unused) || !cell_range(p_z, p_z, m_cells_z, cell_z, unused))
+			return std::nullopt;
+
+		// Position within the cell [0-1], the diagonal splits the cell at u + v = 1.
+		const float u = std::clamp((p_x / m_cell_size) - static_cast<float>(cell_x), 0.f, 1.f);
+		const float v = std::clamp((p_z / m_cell_size) - static_cast<float>(cell_z), 0.f, 1.f);
+		const float height_00 = sample(cell_x,     cell_z);
+		const float height_10 = sample(cell_x + 1, cell_z);
+		const float height_01 = sample(cell_x,     cell_z + 1);
+		const float height_11 = sample(cell_x + 1, cell_z + 1);
+
+		if (u + v <= 1.f)
+			return height_00 + ((height_10 - height_00) * u) + ((height_01 - height_00) * v);
+		else
+			return height_11 + ((height_01 - height_11) * (1.f - u)) + ((height_10 - height_11) * (1.f - v));
+	}
+
+	std::array<Triangle, 2> Heightfield::cell_triangles(size_t p_x, size_t p_z) const
+	{
+		const glm::vec3 top_left     = vertex(p_x + 1, p_z);
+		const glm::vec3 top_right    = vertex(p_x + 1, p_z + 1);
+		const glm::vec3 bottom_left  = vertex(p_x,     p_z);
+		const glm::vec3 bottom_right = vertex(p_x,     p_z + 1);
+		return {Triangle(top_left, bottom_left, bottom_right), Triangle(top_left, bottom_right, top_right)};
+	}
+
+	void Heightfield::query(const AABB& p_AABB, const std::function<void(const Triangle& p_triangle)>& p_on_triangle) const
+	{
+		if (empty() || p_AABB.m_max.y < m_min_height || p_AABB.m_min.y > m_max_height)
+			return;
+
+		size_t first_x, last_x, first_z, last_z;
+		if (!cell_range(p_AABB.m_min.x, p_AABB.m_max.x, m_cells_x, first_x, last_x) || !cell_range(p_AABB.m_min.z, p_AABB.m_max.z, m_cells_z, first_z, last_z))
+			return;
+
+		for (size_t z = first_z; z <= last_z; z++)
+		{
+			for (size_t x = first_x; x <= last_x; x++)
+			{
+				const auto [cell_min, cell_max] = std::minmax({sample(x, z), sample(x + 1, z), sample(x, z + 1), sample(x + 1, z + 1)});
+				if (p_AABB.m_max.y < cell_min || p_AABB.m_min.y > cell_max)
+					continue;
+
+				for (const auto& triangle : cell_triangles(x, z))
+					p_on_triangle(triangle);
+			}
+		}
+	}
+
+	// Möller-Trumbore ray v triangle, hitting either side.
+	//@return The distance along p_ray to the hit in multiples of the ray direction.
+	static std::optional<float> ray_triangle(const Ray& p_ray, const Triangle& p_triangle)
+	{
+		constexpr float Epsilon = 1e-7f;
+
+		const glm::vec3 edge_1 = p_triangle.m_point_2 - p_triangle.m_point_1;
+		const glm::vec3 edge_2 = p_triangle.m_point_3 - p_triangle.m_point_1;
+		const glm::vec3 p      = glm::cross(p_ray.m_direction, edge_2);
+		const float determinant = glm::dot(edge_1, p);
+		if (std::abs(determinant) < Epsilon)
+			return std::nullopt; // Parallel to the triangle.
+
+		const float inverse_determinant = 1.f / determinant;
+		const glm::vec3 s = p_ray.m_start - p_triangle.m_point_1;
+		const float u     = glm::dot(s, p) * inverse_determinant;
+		if (u < 0.f || u > 1.f)
+			return std::nullopt;
+
+		const glm::vec3 q = glm::cross(s, edge_1);
+		const float v     = glm::dot(p_ray.m_direction, q) * inverse_determinant;
+		if (v < 0.f || u + v > 1.f)
+			return std::nullopt;
+
+		const float distance = glm::dot(edge_2, q) * inverse_determinant;
+		return distance >= 0.f ? std::optional<float>(distance) : std::nullopt;
+	}
+
+	std::optional<float> Heightfield::raycast(const Ray& p_ray, float p_max_distance) const
+	{
+		if (empty())
+			return std::nullopt;
+
+		// Clip the ray to the bounds of the grid so marching starts at the first cell the ray enters.
+		const AABB bounds = get_AABB();
+		float entry = 0.f;
+		float exit  = p_max_distance;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (p_ray.m_direction[axis] == 0.f)
+			{
+				if (p_ray.m_start[axis] < bounds.m_min[axis] || p_ray.m_start[axis] > bounds.m_max[axis])
+					return std::nullopt;
+				continue;
+			}
+
+			float near = (bounds.m_min[axis] - p_ray.m_start[axis]) / p_ray.m_direction[axis];
+			float far  = (bounds.m_max[axis] - p_ray.m_start[axis]) / p_ray.m_direction[axis];
+			if (near > far)
+				std::swap(near, far);
+
+			entry = std::max(entry, near);
+			exit  = std::min(exit, far);
+		}
+		if (entry > exit)
+			return std::nullopt;
+
+		const glm::vec3 entry_point = p_ray.m_start + (p_ray.m_direction * entry);
+		// The entry point can land a rounding error outside the grid, clamping keeps it in the boundary cell.
+		size_t cell_x = cell_index(entry_point.x, m_cells_x);
+		size_t cell_z = cell_index(entry_point.z, m_cells_z);
+
+		// Distance along the ray to the next cell boundary on each axis and between consecutive boundaries.
+		auto setup_axis = [&](int p_axis, size_t p_cell, int& p_step, float& p_next, float& p_delta)
+		{
+			const float direction = p_ray.m_direction[p_axis];
+			if (direction == 0.f)
+			{
+				p_step  = 0;
+				p_next  = std::numeric_limits<float>::infinity();
+				p_delta = std::numeric_limits<float>::infinity();
+				return;
+			}
+			p_step  = direction > 0.f ? 1 : -1;
+			p_next  = ((static_cast<float>(p_cell + (direction > 0.f ? 1 : 0)) * m_cell_size) - p_ray.m_start[p_axis]) / direction;
+			p_delta = m_cell_size / std::abs(direction);
+		};
+		int step_x, step_z;
+		float next_x, next_z, delta_x, delta_z;
+		setup_axis(0, cell_x, step_x, next_x, delta_x);
+		setup_axis(2, cell_z, step_z, next_z, delta_z);
+
+		float cell_entry = entry;
+		while (cell_entry <= exit)
+		{
+			const float cell_exit = std::min({next_x, next_z, exit});
+
+			// Skip the triangle tests if the ray passes wholly above or below the cell over the span it crosses it.
+			const float height_entry = p_ray.m_start.y + (p_ray.m_direction.y * cell_entry);
+			const float height_exit  = p_ray.m_start.y + (p_ray.m_direction.y * cell_exit);
+			const auto [cell_min, cell_max] = std::minmax({sample(cell_x, cell_z), sample(cell_x + 1, cell_z), sample(cell_x, cell_z + 1), sample(cell_x + 1, cell_z + 1)});
+			if (std::min(height_entry, height_exit) <= cell_max && std::max(height_entry, height_exit) >= cell_min)
+			{
+				std::optional<float> nearest;
+				for (const auto& triangle : cell_triangles(cell_x, cell_z))
+				{
+					const auto distance = ray_triangle(p_ray, triangle);
+					if (distance.has_value() && *distance <= p_max_distance && (!nearest.has_value() || *distance < *nearest))
+						nearest = distance;
+				}
+				if (nearest.has_value())
+					return nearest;
+			}
+
+			// Step into the neighbouring cell across the nearer boundary.
+			if (next_x < next_z)
+			{
+				if ((step_x < 0 && cell_x == 0) || (step_x > 0 && cell_x + 1 == m_cells_x))
+					break;
+				cell_x     = static_cast<size_t>(static_cast<int64_t>(cell_x) + step_x);
+				cell_entry = next_x;
+				next_x    += delta_x;
+			}
+			else
+			{
+				if (step_z == 0 || (step_z < 0 && cell_z == 0) || (step_z > 0 && cell_z + 1 == m_cells_z))
+					break;
+				cell_z     = static_cast<size_t>(static_cast<int64_t>(cell_z) + step_z);
+				cell_entry = next_z;
+				next_z    += delta_z;
+			}
+		}
+		return std::nullopt;
+	}
+} // namespace Geometry
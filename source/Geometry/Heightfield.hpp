@@ -0,0 +1,70 @@
+#pragma once
+
+#include "AABB.hpp"
+#include "Triangle.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Geometry
+{
+	class Ray;
+
+	// A regular grid of heights in the xz plane of its object space, sample (0, 0) at the origin and x/z increasing by the cell size per sample.
+	// Each cell is split into two triangles along the diagonal from (x + 1, z) to (x, z + 1), matching Utility::MeshBuilder::add_quad.
+	// Because the grid is regular the cell under any xz position is found in O(1), so queries only ever touch the cells they overlap.
+	class Heightfield
+	{
+		std::vector<float> m_heights; // (m_cells_x + 1) * (m_cells_z + 1) samples, x varies fastest.
+		size_t m_cells_x;
+		size_t m_cells_z;
+		float m_cell_size;
+		float m_min_height;
+		float m_max_height;
+
+		// Inclusive range of cells overlapping [p_min, p_max] along an axis with p_cell_count cells. False if the range misses the grid.
+		bool cell_range(float p_min, float p_max, size_t p_cell_count, size_t& p_first, size_t& p_last) const;
+		// Index of the cell containing p_position along an axis with p_cell_count cells, clamped to the grid.
+		size_t cell_index(float p_position, size_t p_cell_count) const;
+
+	public:
+		Heightfield() noexcept;
+		//@param p_cells_x Number of cells along x, the grid has one more sample than cells along each axis.
+		//@param p_cells_z Number of cells along z.
+		//@param p_cell_size Width (m) of a cell along x and z.
+		//@param p_heights (p_cells_x + 1) * (p_cells_z + 1) heights, x varies fastest.
+		Heightfield(size_t p_cells_x, size_t p_cells_z, float p_cell_size, std::vector<float>&& p_heights);
+
+		bool empty() const           { return m_heights.empty(); }
+		size_t cells_x() const       { return m_cells_x; }
+		size_t cells_z() const       { return m_cells_z; }
+		float get_cell_size() const  { return m_cell_size; }
+		// Height of the sample at grid coordinate (p_x, p_z), p_x <= cells_x() and p_z <= cells_z().
+		float sample(size_t p_x, size_t p_z) const { return m_heights[(p_z * (m_cells_x + 1)) + p_x]; }
+		// Object-space position of the sample at grid coordinate (p_x, p_z).
+		glm::vec3 vertex(size_t p_x, size_t p_z) const;
+		AABB get_AABB() const;
+
+		// Height of the surface above the object-space position (p_x, p_z), interpolated across the triangle of the cell it lies in.
+		//@return The height or nullopt if the position is outside the grid.
+		std::optional<float> height_at(float p_x, float p_z) const;
+		// The two triangles of the cell at grid coordinate (p_x, p_z), p_x < cells_x() and p_z < cells_z(). Both are wound with upward facing normals.
+		std::array<Triangle, 2> cell_triangles(size_t p_x, size_t p_z) const;
+
+		// Call p_on_triangle for the triangles of every cell p_AABB overlaps in xz whose height range also overlaps p_AABB.
+		void query(const AABB& p_AABB, const std::function<void(const Triangle& p_triangle)>& p_on_triangle) const;
+
+		// March p_ray through the cells it crosses in xz (a 2D DDA), testing only the triangles of those cells.
+		// Cells are visited front to back so the first hit found is the nearest.
+		//@param p_ray Ray in the object space of the heightfield.
+		//@param p_max_distance Distance along the ray beyond which hits are ignored, in multiples of the ray direction.
+		//@return The distance along the ray to the first hit in multiples of the ray direction.
+		std::optional<float> raycast(const Ray& p_ray, float p_max_distance = std::numeric_limits<float>::max()) const;
+	};
+} // namespace Geometry
@@ -3,6 +3,7 @@
 #include "Geometry/AABB.hpp"
 #include "Geometry/Cone.hpp"
 #include "Geometry/Cylinder.hpp"
+#include "Geometry/Frustrum.hpp"
 #include "Geometry/Plane.hpp"
 #include "Geometry/Ray.hpp"
 #include "Geometry/Sphere.hpp"
@@ -12,6 +13,7 @@
 #include "Utility/Logger.hpp"
 
 #include <glm/glm.hpp>
+#include <array>
 #include <limits>
 
 // This intersections source file is composed of header definitions as well as cpp-static-functions that are used as helpers for them.
@@ -492,6 +494,32 @@ namespace Geometry
 		else
 			return true;
 	}
+	bool intersecting(const AABB& AABB, const Sphere& sphere)
+	{
+		// Adapted from: Real-Time Collision Detection (Christer Ericson) - 5.2.5 Testing Sphere Against AABB pg 165
+		// The sphere intersects the AABB if the distance from its center to the closest point of the AABB is at most its radius.
+		const glm::vec3 closest = glm::clamp(sphere.m_center, AABB.m_min, AABB.m_max);
+		const glm::vec3 offset  = closest - sphere.m_center;
+		return glm::dot(offset, offset) <= sphere.m_radius * sphere.m_radius;
+	}
+	bool intersecting(const Frustrum& frustrum, const AABB& AABB)
+	{
+		// The AABB is outside if its corner furthest along the normal of any plane (the 'positive vertex') is behind that plane.
+		// Frustrum planes are built from the plane equation n·p + d = 0. The side planes face inside but m_near and m_far face outside,
+		// so those two are flipped to test every plane from inside.
+		const std::array<Plane, 6> planes = {frustrum.m_left, frustrum.m_right, frustrum.m_bottom, frustrum.m_top,
+		                                     Plane(glm::vec4(-frustrum.m_near.m_normal, -frustrum.m_near.m_distance)),
+		                                     Plane(glm::vec4(-frustrum.m_far.m_normal,  -frustrum.m_far.m_distance))};
+		for (const Plane& plane : planes)
+		{
+			const glm::vec3 positive_vertex = glm::vec3(plane.m_normal.x >= 0.f ? AABB.m_max.x : AABB.m_min.x,
+			                                            plane.m_normal.y >= 0.f ? AABB.m_max.y : AABB.m_min.y,
+			                                            plane.m_normal.z >= 0.f ? AABB.m_max.z : AABB.m_min.z);
+			if (glm::dot(plane.m_normal, positive_vertex) + plane.m_distance < 0.f)
+				return false;
+		}
+		return true;
+	}
 	bool intersecting(const AABB& AABB, const Ray& ray)
 	{
 		// Adapted from: Real-Time Collision Detection (Christer Ericson) - 5.3.3 Intersecting Ray or Segment Against Box pg 180
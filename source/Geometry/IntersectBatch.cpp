@@ -0,0 +1,646 @@
+#include "IntersectBatch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#ifdef Z_X86
+	#include <immintrin.h>
+#endif
+
+namespace Geometry
+{
+	void AABBArrays::add(const AABB& p_AABB)
+	{
+		min_x.push_back(p_AABB.m_min.x);
+		min_y.push_back(p_AABB.m_min.y);
+		min_z.push_back(p_AABB.m_min.z);
+		max_x.push_back(p_AABB.m_max.x);
+		max_y.push_back(p_AABB.m_max.y);
+		max_z.push_back(p_AABB.m_max.z);
+	}
+	void AABBArrays::clear()
+	{
+		for (auto* array : {&min_x, &min_y, &min_z, &max_x, &max_y, &max_z})
+			array->clear();
+	}
+	AABB AABBArrays::operator[](size_t p_index) const
+	{
+		return AABB(glm::vec3(min_x[p_index], min_y[p_index], min_z[p_index]), glm::vec3(max_x[p_index], max_y[p_index], max_z[p_index]));
+	}
+
+	void SphereArrays::add(const Sphere& p_sphere)
+	{
+		center_x.push_back(p_sphere.m_center.x);
+		center_y.push_back(p_sphere.m_center.y);
+		center_z.push_back(p_sphere.m_center.z);
+		radius.push_back(p_sphere.m_radius);
+	}
+	void SphereArrays::clear()
+	{
+		for (auto* array : {&center_x, &center_y, &center_z, &radius})
+			array->clear();
+	}
+	Sphere SphereArrays::operator[](size_t p_index) const
+	{
+		return Sphere(glm::vec3(center_x[p_index], center_y[p_index], center_z[p_index]), radius[p_index]);
+	}
+
+	size_t BatchHits::hit_count() const
+	{
+		size_t count = 0;
+		for (const uint64_t word : mask)
+			count += static_cast<size_t>(std::popcount(word));
+		return count;
+	}
+
+	// Size p_hits for p_size shapes with no hits, the kernels only set bits.
+	static void reset(BatchHits& p_hits, size_t p_size, bool p_distances)
+	{
+		p_hits.size = p_size;
+		p_hits.mask.assign((p_size + 63) / 64, 0);
+		if (p_distances)
+			p_hits.distances.assign(p_size, std::numeric_limits<float>::infinity());
+		else
+			p_hits.distances.clear();
+	}
+	static void set_hit(BatchHits& p_hits, size_t p_index)
+	{
+		p_hits.mask[p_index / 64] |= uint64_t(1) << (p_index % 64);
+	}
+	// Set the hits of the lanes starting at p_index, a multiple of the lane width so the lanes never straddle two words.
+	static void set_hits(BatchHits& p_hits, size_t p_index, int p_lane_mask)
+	{
+		p_hits.mask[p_index / 64] |= static_cast<uint64_t>(p_lane_mask) << (p_index % 64);
+	}
+
+	// The per ray values every kernel lane shares.
+	// An axis the ray is parallel to, by the same epsilon as get_intersection(AABB, Ray), can't be divided by. Its slab is hit
+	// along the whole ray if the start is inside it and never otherwise.
+	struct RaySlabs
+	{
+		float start[3];
+		float direction[3];
+		float inverse_direction[3]; // 0 for parallel axes.
+		bool parallel[3];
+		bool degenerate;            // Parallel to every axis, a zero direction. Hits nothing, as get_intersection(AABB, Ray).
+
+		RaySlabs(const Ray& p_ray)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				start[axis]             = p_ray.m_start[axis];
+				direction[axis]         = p_ray.m_direction[axis];
+				parallel[axis]          = std::abs(p_ray.m_direction[axis]) < std::numeric_limits<float>::epsilon();
+				inverse_direction[axis] = parallel[axis] ? 0.f : 1.f / p_ray.m_direction[axis];
+			}
+			degenerate = parallel[0] && parallel[1] && parallel[2];
+		}
+	};
+
+	// Scalar kernels ---------------------------------------------------------------------------------------------------------
+	// Each tests the shapes in [p_begin, p_end), the SIMD kernels hand them their remainder.
+
+	static void ray_AABBs_scalar(const RaySlabs& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const float* min[3] = {p_AABBs.min_x.data(), p_AABBs.min_y.data(), p_AABBs.min_z.data()};
+		const float* max[3] = {p_AABBs.max_x.data(), p_AABBs.max_y.data(), p_AABBs.max_z.data()};
+
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			// Slab test, the ray is inside the AABB between the farthest slab entry and the nearest slab exit.
+			float entry = -std::numeric_limits<float>::infinity();
+			float exit  = std::numeric_limits<float>::infinity();
+			bool in_parallel_slabs = true;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (p_ray.parallel[axis])
+					in_parallel_slabs = in_parallel_slabs && p_ray.start[axis] >= min[axis][i] && p_ray.start[axis] <= max[axis][i];
+				else
+				{
+					const float slab_1 = (min[axis][i] - p_ray.start[axis]) * p_ray.inverse_direction[axis];
+					const float slab_2 = (max[axis][i] - p_ray.start[axis]) * p_ray.inverse_direction[axis];
+					entry = std::max(entry, std::min(slab_1, slab_2));
+					exit  = std::min(exit,  std::max(slab_1, slab_2));
+				}
+			}
+
+			if (in_parallel_slabs && entry <= exit && exit >= 0.f)
+			{
+				set_hit(p_hits, i);
+				p_hits.distances[i] = std::max(entry, 0.f);
+			}
+		}
+	}
+	static void ray_spheres_scalar(const RaySlabs& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		// Solves |start + t direction - center|^2 = radius^2 for the smallest t, with m = start - center:
+		// a t^2 + 2 b t + c = 0 where a = direction.direction, b = m.direction, c = m.m - radius^2.
+		const float a = p_ray.direction[0] * p_ray.direction[0] + p_ray.direction[1] * p_ray.direction[1] + p_ray.direction[2] * p_ray.direction[2];
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			const float m_x = p_ray.start[0] - p_spheres.center_x[i];
+			const float m_y = p_ray.start[1] - p_spheres.center_y[i];
+			const float m_z = p_ray.start[2] - p_spheres.center_z[i];
+			const float b   = m_x * p_ray.direction[0] + m_y * p_ray.direction[1] + m_z * p_ray.direction[2];
+			const float c   = (m_x * m_x + m_y * m_y + m_z * m_z) - p_spheres.radius[i] * p_spheres.radius[i];
+			const float discriminant = b * b - a * c;
+
+			// Hit if the start is inside (c <= 0) or the sphere is ahead (b < 0) and the line through it meets the sphere.
+			if (discriminant >= 0.f && (c <= 0.f || b < 0.f))
+			{
+				set_hit(p_hits, i);
+				p_hits.distances[i] = c <= 0.f ? 0.f : (-b - std::sqrt(discriminant)) / a;
+			}
+		}
+	}
+	static void AABB_AABBs_scalar(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			const bool separated = p_AABB.m_max.x < p_AABBs.min_x[i] || p_AABB.m_min.x > p_AABBs.max_x[i]
+			                    || p_AABB.m_max.y < p_AABBs.min_y[i] || p_AABB.m_min.y > p_AABBs.max_y[i]
+			                    || p_AABB.m_max.z < p_AABBs.min_z[i] || p_AABB.m_min.z > p_AABBs.max_z[i];
+			if (!separated)
+				set_hit(p_hits, i);
+		}
+	}
+	// The sphere intersects the AABB if the distance from its center to the closest point of the AABB is at most its radius.
+	static bool sphere_AABB_scalar(float p_center_x, float p_center_y, float p_center_z, float p_radius,
+	                               float p_min_x, float p_min_y, float p_min_z, float p_max_x, float p_max_y, float p_max_z)
+	{
+		const float offset_x = std::min(std::max(p_center_x, p_min_x), p_max_x) - p_center_x;
+		const float offset_y = std::min(std::max(p_center_y, p_min_y), p_max_y) - p_center_y;
+		const float offset_z = std::min(std::max(p_center_z, p_min_z), p_max_z) - p_center_z;
+		return (offset_x * offset_x + offset_y * offset_y) + offset_z * offset_z <= p_radius * p_radius;
+	}
+	static void AABB_spheres_scalar(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		for (size_t i = p_begin; i < p_end; i++)
+			if (sphere_AABB_scalar(p_spheres.center_x[i], p_spheres.center_y[i], p_spheres.center_z[i], p_spheres.radius[i],
+			                       p_AABB.m_min.x, p_AABB.m_min.y, p_AABB.m_min.z, p_AABB.m_max.x, p_AABB.m_max.y, p_AABB.m_max.z))
+				set_hit(p_hits, i);
+	}
+	static void sphere_AABBs_scalar(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		for (size_t i = p_begin; i < p_end; i++)
+			if (sphere_AABB_scalar(p_sphere.m_center.x, p_sphere.m_center.y, p_sphere.m_center.z, p_sphere.m_radius,
+			                       p_AABBs.min_x[i], p_AABBs.min_y[i], p_AABBs.min_z[i], p_AABBs.max_x[i], p_AABBs.max_y[i], p_AABBs.max_z[i]))
+				set_hit(p_hits, i);
+	}
+	static void sphere_spheres_scalar(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		// Compared squared, no square root per sphere.
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			const float offset_x   = p_spheres.center_x[i] - p_sphere.m_center.x;
+			const float offset_y   = p_spheres.center_y[i] - p_sphere.m_center.y;
+			const float offset_z   = p_spheres.center_z[i] - p_sphere.m_center.z;
+			const float radius_sum = p_sphere.m_radius + p_spheres.radius[i];
+			if ((offset_x * offset_x + offset_y * offset_y) + offset_z * offset_z <= radius_sum * radius_sum)
+				set_hit(p_hits, i);
+		}
+	}
+
+#ifdef Z_X86
+	// SSE4 kernels -----------------------------------------------------------------------------------------------------------
+	// Each tests 4 shapes per iteration then hands the remainder to its scalar kernel.
+	// They round identically to the scalar kernels, see Utility/CPUFeatures.hpp.
+
+	TARGET_SSE4 static void ray_AABBs_SSE4(const RaySlabs& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const float* min[3] = {p_AABBs.min_x.data(), p_AABBs.min_y.data(), p_AABBs.min_z.data()};
+		const float* max[3] = {p_AABBs.max_x.data(), p_AABBs.max_y.data(), p_AABBs.max_z.data()};
+		const __m128 zero   = _mm_setzero_ps();
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			__m128 entry = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+			__m128 exit  = _mm_set1_ps(std::numeric_limits<float>::infinity());
+			__m128 hit   = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const __m128 start = _mm_set1_ps(p_ray.start[axis]);
+				const __m128 lower = _mm_loadu_ps(min[axis] + i);
+				const __m128 upper = _mm_loadu_ps(max[axis] + i);
+				if (p_ray.parallel[axis])
+					hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(start, lower), _mm_cmple_ps(start, upper)));
+				else
+				{
+					const __m128 inverse_direction = _mm_set1_ps(p_ray.inverse_direction[axis]);
+					const __m128 slab_1 = _mm_mul_ps(_mm_sub_ps(lower, start), inverse_direction);
+					const __m128 slab_2 = _mm_mul_ps(_mm_sub_ps(upper, start), inverse_direction);
+					entry = _mm_max_ps(entry, _mm_min_ps(slab_1, slab_2));
+					exit  = _mm_min_ps(exit,  _mm_max_ps(slab_1, slab_2));
+				}
+			}
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(entry, exit), _mm_cmpge_ps(exit, zero)));
+
+			const int lane_mask = _mm_movemask_ps(hit);
+			if (lane_mask)
+			{
+				set_hits(p_hits, i, lane_mask);
+				const __m128 missed = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				_mm_storeu_ps(&p_hits.distances[i], _mm_blendv_ps(missed, _mm_max_ps(entry, zero), hit));
+			}
+		}
+
+		ray_AABBs_scalar(p_ray, p_AABBs, p_hits, i, p_end);
+	}
+	TARGET_SSE4 static void ray_spheres_SSE4(const RaySlabs& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const float a_scalar = p_ray.direction[0] * p_ray.direction[0] + p_ray.direction[1] * p_ray.direction[1] + p_ray.direction[2] * p_ray.direction[2];
+		const __m128 a           = _mm_set1_ps(a_scalar);
+		const __m128 start_x     = _mm_set1_ps(p_ray.start[0]);
+		const __m128 start_y     = _mm_set1_ps(p_ray.start[1]);
+		const __m128 start_z     = _mm_set1_ps(p_ray.start[2]);
+		const __m128 direction_x = _mm_set1_ps(p_ray.direction[0]);
+		const __m128 direction_y = _mm_set1_ps(p_ray.direction[1]);
+		const __m128 direction_z = _mm_set1_ps(p_ray.direction[2]);
+		const __m128 zero        = _mm_setzero_ps();
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			const __m128 m_x    = _mm_sub_ps(start_x, _mm_loadu_ps(&p_spheres.center_x[i]));
+			const __m128 m_y    = _mm_sub_ps(start_y, _mm_loadu_ps(&p_spheres.center_y[i]));
+			const __m128 m_z    = _mm_sub_ps(start_z, _mm_loadu_ps(&p_spheres.center_z[i]));
+			const __m128 radius = _mm_loadu_ps(&p_spheres.radius[i]);
+			const __m128 b      = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m_x, direction_x), _mm_mul_ps(m_y, direction_y)), _mm_mul_ps(m_z, direction_z));
+			const __m128 c      = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_x, m_x), _mm_mul_ps(m_y, m_y)), _mm_mul_ps(m_z, m_z)), _mm_mul_ps(radius, radius));
+			const __m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c));
+
+			const __m128 inside = _mm_cmple_ps(c, zero);
+			const __m128 hit    = _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_or_ps(inside, _mm_cmplt_ps(b, zero)));
+
+			const int lane_mask = _mm_movemask_ps(hit);
+			if (lane_mask)
+			{
+				set_hits(p_hits, i, lane_mask);
+				// Missed lanes can have a negative discriminant, their NaN distance is replaced by the blend.
+				const __m128 entry  = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(zero, b), _mm_sqrt_ps(discriminant)), a);
+				const __m128 missed = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				_mm_storeu_ps(&p_hits.distances[i], _mm_blendv_ps(missed, _mm_blendv_ps(entry, zero, inside), hit));
+			}
+		}
+
+		ray_spheres_scalar(p_ray, p_spheres, p_hits, i, p_end);
+	}
+	TARGET_SSE4 static void AABB_AABBs_SSE4(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m128 query_min_x = _mm_set1_ps(p_AABB.m_min.x), query_max_x = _mm_set1_ps(p_AABB.m_max.x);
+		const __m128 query_min_y = _mm_set1_ps(p_AABB.m_min.y), query_max_y = _mm_set1_ps(p_AABB.m_max.y);
+		const __m128 query_min_z = _mm_set1_ps(p_AABB.m_min.z), query_max_z = _mm_set1_ps(p_AABB.m_max.z);
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			const __m128 separated_x = _mm_or_ps(_mm_cmplt_ps(query_max_x, _mm_loadu_ps(&p_AABBs.min_x[i])), _mm_cmpgt_ps(query_min_x, _mm_loadu_ps(&p_AABBs.max_x[i])));
+			const __m128 separated_y = _mm_or_ps(_mm_cmplt_ps(query_max_y, _mm_loadu_ps(&p_AABBs.min_y[i])), _mm_cmpgt_ps(query_min_y, _mm_loadu_ps(&p_AABBs.max_y[i])));
+			const __m128 separated_z = _mm_or_ps(_mm_cmplt_ps(query_max_z, _mm_loadu_ps(&p_AABBs.min_z[i])), _mm_cmpgt_ps(query_min_z, _mm_loadu_ps(&p_AABBs.max_z[i])));
+			const int separated_mask = _mm_movemask_ps(_mm_or_ps(_mm_or_ps(separated_x, separated_y), separated_z));
+			set_hits(p_hits, i, ~separated_mask & 0xF);
+		}
+
+		AABB_AABBs_scalar(p_AABB, p_AABBs, p_hits, i, p_end);
+	}
+	// The lanes of sphere_AABB_scalar.
+	TARGET_SSE4 static __m128 sphere_AABB_SSE4(__m128 p_center_x, __m128 p_center_y, __m128 p_center_z, __m128 p_radius,
+	                                           __m128 p_min_x, __m128 p_min_y, __m128 p_min_z, __m128 p_max_x, __m128 p_max_y, __m128 p_max_z)
+	{
+		const __m128 offset_x = _mm_sub_ps(_mm_min_ps(_mm_max_ps(p_center_x, p_min_x), p_max_x), p_center_x);
+		const __m128 offset_y = _mm_sub_ps(_mm_min_ps(_mm_max_ps(p_center_y, p_min_y), p_max_y), p_center_y);
+		const __m128 offset_z = _mm_sub_ps(_mm_min_ps(_mm_max_ps(p_center_z, p_min_z), p_max_z), p_center_z);
+		const __m128 distance_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offset_x, offset_x), _mm_mul_ps(offset_y, offset_y)), _mm_mul_ps(offset_z, offset_z));
+		return _mm_cmple_ps(distance_squared, _mm_mul_ps(p_radius, p_radius));
+	}
+	TARGET_SSE4 static void AABB_spheres_SSE4(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m128 min_x = _mm_set1_ps(p_AABB.m_min.x), max_x = _mm_set1_ps(p_AABB.m_max.x);
+		const __m128 min_y = _mm_set1_ps(p_AABB.m_min.y), max_y = _mm_set1_ps(p_AABB.m_max.y);
+		const __m128 min_z = _mm_set1_ps(p_AABB.m_min.z), max_z = _mm_set1_ps(p_AABB.m_max.z);
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			const __m128 hit = sphere_AABB_SSE4(_mm_loadu_ps(&p_spheres.center_x[i]), _mm_loadu_ps(&p_spheres.center_y[i]), _mm_loadu_ps(&p_spheres.center_z[i]),
+			                                    _mm_loadu_ps(&p_spheres.radius[i]), min_x, min_y, min_z, max_x, max_y, max_z);
+			set_hits(p_hits, i, _mm_movemask_ps(hit));
+		}
+
+		AABB_spheres_scalar(p_AABB, p_spheres, p_hits, i, p_end);
+	}
+	TARGET_SSE4 static void sphere_AABBs_SSE4(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m128 center_x = _mm_set1_ps(p_sphere.m_center.x);
+		const __m128 center_y = _mm_set1_ps(p_sphere.m_center.y);
+		const __m128 center_z = _mm_set1_ps(p_sphere.m_center.z);
+		const __m128 radius   = _mm_set1_ps(p_sphere.m_radius);
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			const __m128 hit = sphere_AABB_SSE4(center_x, center_y, center_z, radius,
+			                                    _mm_loadu_ps(&p_AABBs.min_x[i]), _mm_loadu_ps(&p_AABBs.min_y[i]), _mm_loadu_ps(&p_AABBs.min_z[i]),
+			                                    _mm_loadu_ps(&p_AABBs.max_x[i]), _mm_loadu_ps(&p_AABBs.max_y[i]), _mm_loadu_ps(&p_AABBs.max_z[i]));
+			set_hits(p_hits, i, _mm_movemask_ps(hit));
+		}
+
+		sphere_AABBs_scalar(p_sphere, p_AABBs, p_hits, i, p_end);
+	}
+	TARGET_SSE4 static void sphere_spheres_SSE4(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m128 center_x = _mm_set1_ps(p_sphere.m_center.x);
+		const __m128 center_y = _mm_set1_ps(p_sphere.m_center.y);
+		const __m128 center_z = _mm_set1_ps(p_sphere.m_center.z);
+		const __m128 radius   = _mm_set1_ps(p_sphere.m_radius);
+
+		size_t i = p_begin;
+		for (; i + 4 <= p_end; i += 4)
+		{
+			const __m128 offset_x   = _mm_sub_ps(_mm_loadu_ps(&p_spheres.center_x[i]), center_x);
+			const __m128 offset_y   = _mm_sub_ps(_mm_loadu_ps(&p_spheres.center_y[i]), center_y);
+			const __m128 offset_z   = _mm_sub_ps(_mm_loadu_ps(&p_spheres.center_z[i]), center_z);
+			const __m128 radius_sum = _mm_add_ps(radius, _mm_loadu_ps(&p_spheres.radius[i]));
+			const __m128 distance_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offset_x, offset_x), _mm_mul_ps(offset_y, offset_y)), _mm_mul_ps(offset_z, offset_z));
+			set_hits(p_hits, i, _mm_movemask_ps(_mm_cmple_ps(distance_squared, _mm_mul_ps(radius_sum, radius_sum))));
+		}
+
+		sphere_spheres_scalar(p_sphere, p_spheres, p_hits, i, p_end);
+	}
+
+	// AVX2 kernels -----------------------------------------------------------------------------------------------------------
+	// The SSE4 kernels 8 wide.
+
+	TARGET_AVX2 static void ray_AABBs_AVX2(const RaySlabs& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const float* min[3] = {p_AABBs.min_x.data(), p_AABBs.min_y.data(), p_AABBs.min_z.data()};
+		const float* max[3] = {p_AABBs.max_x.data(), p_AABBs.max_y.data(), p_AABBs.max_z.data()};
+		const __m256 zero   = _mm256_setzero_ps();
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			__m256 entry = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+			__m256 exit  = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			__m256 hit   = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const __m256 start = _mm256_set1_ps(p_ray.start[axis]);
+				const __m256 lower = _mm256_loadu_ps(min[axis] + i);
+				const __m256 upper = _mm256_loadu_ps(max[axis] + i);
+				if (p_ray.parallel[axis])
+					hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(start, lower, _CMP_GE_OQ), _mm256_cmp_ps(start, upper, _CMP_LE_OQ)));
+				else
+				{
+					const __m256 inverse_direction = _mm256_set1_ps(p_ray.inverse_direction[axis]);
+					const __m256 slab_1 = _mm256_mul_ps(_mm256_sub_ps(lower, start), inverse_direction);
+					const __m256 slab_2 = _mm256_mul_ps(_mm256_sub_ps(upper, start), inverse_direction);
+					entry = _mm256_max_ps(entry, _mm256_min_ps(slab_1, slab_2));
+					exit  = _mm256_min_ps(exit,  _mm256_max_ps(slab_1, slab_2));
+				}
+			}
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(entry, exit, _CMP_LE_OQ), _mm256_cmp_ps(exit, zero, _CMP_GE_OQ)));
+
+			const int lane_mask = _mm256_movemask_ps(hit);
+			if (lane_mask)
+			{
+				set_hits(p_hits, i, lane_mask);
+				const __m256 missed = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+				_mm256_storeu_ps(&p_hits.distances[i], _mm256_blendv_ps(missed, _mm256_max_ps(entry, zero), hit));
+			}
+		}
+
+		ray_AABBs_scalar(p_ray, p_AABBs, p_hits, i, p_end);
+	}
+	TARGET_AVX2 static void ray_spheres_AVX2(const RaySlabs& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const float a_scalar = p_ray.direction[0] * p_ray.direction[0] + p_ray.direction[1] * p_ray.direction[1] + p_ray.direction[2] * p_ray.direction[2];
+		const __m256 a           = _mm256_set1_ps(a_scalar);
+		const __m256 start_x     = _mm256_set1_ps(p_ray.start[0]);
+		const __m256 start_y     = _mm256_set1_ps(p_ray.start[1]);
+		const __m256 start_z     = _mm256_set1_ps(p_ray.start[2]);
+		const __m256 direction_x = _mm256_set1_ps(p_ray.direction[0]);
+		const __m256 direction_y = _mm256_set1_ps(p_ray.direction[1]);
+		const __m256 direction_z = _mm256_set1_ps(p_ray.direction[2]);
+		const __m256 zero        = _mm256_setzero_ps();
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 m_x    = _mm256_sub_ps(start_x, _mm256_loadu_ps(&p_spheres.center_x[i]));
+			const __m256 m_y    = _mm256_sub_ps(start_y, _mm256_loadu_ps(&p_spheres.center_y[i]));
+			const __m256 m_z    = _mm256_sub_ps(start_z, _mm256_loadu_ps(&p_spheres.center_z[i]));
+			const __m256 radius = _mm256_loadu_ps(&p_spheres.radius[i]);
+			const __m256 b      = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m_x, direction_x), _mm256_mul_ps(m_y, direction_y)), _mm256_mul_ps(m_z, direction_z));
+			const __m256 c      = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m_x, m_x), _mm256_mul_ps(m_y, m_y)), _mm256_mul_ps(m_z, m_z)), _mm256_mul_ps(radius, radius));
+			const __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, c));
+
+			const __m256 inside = _mm256_cmp_ps(c, zero, _CMP_LE_OQ);
+			const __m256 hit    = _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ), _mm256_or_ps(inside, _mm256_cmp_ps(b, zero, _CMP_LT_OQ)));
+
+			const int lane_mask = _mm256_movemask_ps(hit);
+			if (lane_mask)
+			{
+				set_hits(p_hits, i, lane_mask);
+				const __m256 entry  = _mm256_div_ps(_mm256_sub_ps(_mm256_sub_ps(zero, b), _mm256_sqrt_ps(discriminant)), a);
+				const __m256 missed = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+				_mm256_storeu_ps(&p_hits.distances[i], _mm256_blendv_ps(missed, _mm256_blendv_ps(entry, zero, inside), hit));
+			}
+		}
+
+		ray_spheres_scalar(p_ray, p_spheres, p_hits, i, p_end);
+	}
+	TARGET_AVX2 static void AABB_AABBs_AVX2(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m256 query_min_x = _mm256_set1_ps(p_AABB.m_min.x), query_max_x = _mm256_set1_ps(p_AABB.m_max.x);
+		const __m256 query_min_y = _mm256_set1_ps(p_AABB.m_min.y), query_max_y = _mm256_set1_ps(p_AABB.m_max.y);
+		const __m256 query_min_z = _mm256_set1_ps(p_AABB.m_min.z), query_max_z = _mm256_set1_ps(p_AABB.m_max.z);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 separated_x = _mm256_or_ps(_mm256_cmp_ps(query_max_x, _mm256_loadu_ps(&p_AABBs.min_x[i]), _CMP_LT_OQ), _mm256_cmp_ps(query_min_x, _mm256_loadu_ps(&p_AABBs.max_x[i]), _CMP_GT_OQ));
+			const __m256 separated_y = _mm256_or_ps(_mm256_cmp_ps(query_max_y, _mm256_loadu_ps(&p_AABBs.min_y[i]), _CMP_LT_OQ), _mm256_cmp_ps(query_min_y, _mm256_loadu_ps(&p_AABBs.max_y[i]), _CMP_GT_OQ));
+			const __m256 separated_z = _mm256_or_ps(_mm256_cmp_ps(query_max_z, _mm256_loadu_ps(&p_AABBs.min_z[i]), _CMP_LT_OQ), _mm256_cmp_ps(query_min_z, _mm256_loadu_ps(&p_AABBs.max_z[i]), _CMP_GT_OQ));
+			const int separated_mask = _mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(separated_x, separated_y), separated_z));
+			set_hits(p_hits, i, ~separated_mask & 0xFF);
+		}
+
+		AABB_AABBs_scalar(p_AABB, p_AABBs, p_hits, i, p_end);
+	}
+	TARGET_AVX2 static __m256 sphere_AABB_AVX2(__m256 p_center_x, __m256 p_center_y, __m256 p_center_z, __m256 p_radius,
+	                                           __m256 p_min_x, __m256 p_min_y, __m256 p_min_z, __m256 p_max_x, __m256 p_max_y, __m256 p_max_z)
+	{
+		const __m256 offset_x = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(p_center_x, p_min_x), p_max_x), p_center_x);
+		const __m256 offset_y = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(p_center_y, p_min_y), p_max_y), p_center_y);
+		const __m256 offset_z = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(p_center_z, p_min_z), p_max_z), p_center_z);
+		const __m256 distance_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(offset_x, offset_x), _mm256_mul_ps(offset_y, offset_y)), _mm256_mul_ps(offset_z, offset_z));
+		return _mm256_cmp_ps(distance_squared, _mm256_mul_ps(p_radius, p_radius), _CMP_LE_OQ);
+	}
+	TARGET_AVX2 static void AABB_spheres_AVX2(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m256 min_x = _mm256_set1_ps(p_AABB.m_min.x), max_x = _mm256_set1_ps(p_AABB.m_max.x);
+		const __m256 min_y = _mm256_set1_ps(p_AABB.m_min.y), max_y = _mm256_set1_ps(p_AABB.m_max.y);
+		const __m256 min_z = _mm256_set1_ps(p_AABB.m_min.z), max_z = _mm256_set1_ps(p_AABB.m_max.z);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 hit = sphere_AABB_AVX2(_mm256_loadu_ps(&p_spheres.center_x[i]), _mm256_loadu_ps(&p_spheres.center_y[i]), _mm256_loadu_ps(&p_spheres.center_z[i]),
+			                                    _mm256_loadu_ps(&p_spheres.radius[i]), min_x, min_y, min_z, max_x, max_y, max_z);
+			set_hits(p_hits, i, _mm256_movemask_ps(hit));
+		}
+
+		AABB_spheres_scalar(p_AABB, p_spheres, p_hits, i, p_end);
+	}
+	TARGET_AVX2 static void sphere_AABBs_AVX2(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m256 center_x = _mm256_set1_ps(p_sphere.m_center.x);
+		const __m256 center_y = _mm256_set1_ps(p_sphere.m_center.y);
+		const __m256 center_z = _mm256_set1_ps(p_sphere.m_center.z);
+		const __m256 radius   = _mm256_set1_ps(p_sphere.m_radius);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 hit = sphere_AABB_AVX2(center_x, center_y, center_z, radius,
+			                                    _mm256_loadu_ps(&p_AABBs.min_x[i]), _mm256_loadu_ps(&p_AABBs.min_y[i]), _mm256_loadu_ps(&p_AABBs.min_z[i]),
+			                                    _mm256_loadu_ps(&p_AABBs.max_x[i]), _mm256_loadu_ps(&p_AABBs.max_y[i]), _mm256_loadu_ps(&p_AABBs.max_z[i]));
+			set_hits(p_hits, i, _mm256_movemask_ps(hit));
+		}
+
+		sphere_AABBs_scalar(p_sphere, p_AABBs, p_hits, i, p_end);
+	}
+	TARGET_AVX2 static void sphere_spheres_AVX2(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits, size_t p_begin, size_t p_end)
+	{
+		const __m256 center_x = _mm256_set1_ps(p_sphere.m_center.x);
+		const __m256 center_y = _mm256_set1_ps(p_sphere.m_center.y);
+		const __m256 center_z = _mm256_set1_ps(p_sphere.m_center.z);
+		const __m256 radius   = _mm256_set1_ps(p_sphere.m_radius);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 offset_x   = _mm256_sub_ps(_mm256_loadu_ps(&p_spheres.center_x[i]), center_x);
+			const __m256 offset_y   = _mm256_sub_ps(_mm256_loadu_ps(&p_spheres.center_y[i]), center_y);
+			const __m256 offset_z   = _mm256_sub_ps(_mm256_loadu_ps(&p_spheres.center_z[i]), center_z);
+			const __m256 radius_sum = _mm256_add_ps(radius, _mm256_loadu_ps(&p_spheres.radius[i]));
+			const __m256 distance_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(offset_x, offset_x), _mm256_mul_ps(offset_y, offset_y)), _mm256_mul_ps(offset_z, offset_z));
+			set_hits(p_hits, i, _mm256_movemask_ps(_mm256_cmp_ps(distance_squared, _mm256_mul_ps(radius_sum, radius_sum), _CMP_LE_OQ)));
+		}
+
+		sphere_spheres_scalar(p_sphere, p_spheres, p_hits, i, p_end);
+	}
+#endif
+
+	// Dispatch -----------------------------------------------------------------------------------------------------------------
+
+	void intersecting(const Ray& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits)
+	{
+		intersecting(p_ray, p_AABBs, p_hits, Utility::instruction_set());
+	}
+	void intersecting(const Ray& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits)
+	{
+		intersecting(p_ray, p_spheres, p_hits, Utility::instruction_set());
+	}
+	void intersecting(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits)
+	{
+		intersecting(p_AABB, p_AABBs, p_hits, Utility::instruction_set());
+	}
+	void intersecting(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits)
+	{
+		intersecting(p_AABB, p_spheres, p_hits, Utility::instruction_set());
+	}
+	void intersecting(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits)
+	{
+		intersecting(p_sphere, p_AABBs, p_hits, Utility::instruction_set());
+	}
+	void intersecting(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits)
+	{
+		intersecting(p_sphere, p_spheres, p_hits, Utility::instruction_set());
+	}
+
+	void intersecting(const Ray& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_AABBs.size(), true);
+		const RaySlabs ray{p_ray};
+		if (ray.degenerate)
+			return;
+
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: ray_AABBs_AVX2(ray, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+			case Utility::InstructionSet::SSE4: ray_AABBs_SSE4(ray, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+#endif
+			default: ray_AABBs_scalar(ray, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+		}
+	}
+	void intersecting(const Ray& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_spheres.size(), true);
+		const RaySlabs ray{p_ray};
+		if (ray.degenerate)
+			return;
+
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: ray_spheres_AVX2(ray, p_spheres, p_hits, 0, p_spheres.size()); break;
+			case Utility::InstructionSet::SSE4: ray_spheres_SSE4(ray, p_spheres, p_hits, 0, p_spheres.size()); break;
+#endif
+			default: ray_spheres_scalar(ray, p_spheres, p_hits, 0, p_spheres.size()); break;
+		}
+	}
+	void intersecting(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_AABBs.size(), false);
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: AABB_AABBs_AVX2(p_AABB, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+			case Utility::InstructionSet::SSE4: AABB_AABBs_SSE4(p_AABB, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+#endif
+			default: AABB_AABBs_scalar(p_AABB, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+		}
+	}
+	void intersecting(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_spheres.size(), false);
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: AABB_spheres_AVX2(p_AABB, p_spheres, p_hits, 0, p_spheres.size()); break;
+			case Utility::InstructionSet::SSE4: AABB_spheres_SSE4(p_AABB, p_spheres, p_hits, 0, p_spheres.size()); break;
+#endif
+			default: AABB_spheres_scalar(p_AABB, p_spheres, p_hits, 0, p_spheres.size()); break;
+		}
+	}
+	void intersecting(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_AABBs.size(), false);
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: sphere_AABBs_AVX2(p_sphere, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+			case Utility::InstructionSet::SSE4: sphere_AABBs_SSE4(p_sphere, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+#endif
+			default: sphere_AABBs_scalar(p_sphere, p_AABBs, p_hits, 0, p_AABBs.size()); break;
+		}
+	}
+	void intersecting(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set)
+	{
+		reset(p_hits, p_spheres.size(), false);
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: sphere_spheres_AVX2(p_sphere, p_spheres, p_hits, 0, p_spheres.size()); break;
+			case Utility::InstructionSet::SSE4: sphere_spheres_SSE4(p_sphere, p_spheres, p_hits, 0, p_spheres.size()); break;
+#endif
+			default: sphere_spheres_scalar(p_sphere, p_spheres, p_hits, 0, p_spheres.size()); break;
+		}
+	}
+} // namespace Geometry
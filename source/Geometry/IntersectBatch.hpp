@@ -0,0 +1,73 @@
+#pragma once
+
+#include "AABB.hpp"
+#include "Ray.hpp"
+#include "Sphere.hpp"
+
+#include "Utility/CPUFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batch intersection kernels: one Ray, AABB or Sphere tested against many AABBs or Spheres per call.
+// The shapes tested against are packed as a structure of arrays so the SSE4 kernels test 4 and the AVX2 kernels 8 shapes per instruction.
+// Hits match the single pair functions in Intersect.hpp, to within rounding for shapes just touching. The Ray v AABB difference is noted below.
+namespace Geometry
+{
+	// AABBs packed as a structure of arrays, index i of every array belongs to the same AABB.
+	struct AABBArrays
+	{
+		std::vector<float> min_x, min_y, min_z;
+		std::vector<float> max_x, max_y, max_z;
+
+		void add(const AABB& p_AABB);
+		// Remove all the AABBs keeping the allocations.
+		void clear();
+		size_t size() const { return min_x.size(); }
+		AABB operator[](size_t p_index) const;
+	};
+	// Spheres packed as a structure of arrays, index i of every array belongs to the same Sphere.
+	struct SphereArrays
+	{
+		std::vector<float> center_x, center_y, center_z;
+		std::vector<float> radius;
+
+		void add(const Sphere& p_sphere);
+		// Remove all the Spheres keeping the allocations.
+		void clear();
+		size_t size() const { return radius.size(); }
+		Sphere operator[](size_t p_index) const;
+	};
+
+	// The result of testing one shape against every shape of an AABBArrays or SphereArrays, index i belongs to shape i.
+	// Reuse a BatchHits between queries to keep its allocations.
+	struct BatchHits
+	{
+		std::vector<uint64_t> mask;   // Bit i % 64 of mask[i / 64] is set if shape i was hit.
+		std::vector<float> distances; // Ray queries only. Distance along the ray to where it enters shape i in multiples of its direction, infinity if missed.
+		size_t size = 0;              // The number of shapes tested.
+
+		bool hit(size_t p_index) const { return (mask[p_index / 64] >> (p_index % 64)) & 1u; }
+		size_t hit_count() const;
+	};
+
+	// Test p_ray against every AABB in p_AABBs. The distance to an AABB containing the ray start is 0.
+	// Unlike get_intersection(AABB, Ray), which tests the infinite line, AABBs entirely behind the ray start are missed.
+	void intersecting(const Ray& p_ray, const AABBArrays& p_AABBs, BatchHits& p_hits);
+	// Test p_ray against every Sphere in p_spheres. The distance to a Sphere containing the ray start is 0.
+	void intersecting(const Ray& p_ray, const SphereArrays& p_spheres, BatchHits& p_hits);
+	void intersecting(const AABB& p_AABB, const AABBArrays& p_AABBs, BatchHits& p_hits);
+	void intersecting(const AABB& p_AABB, const SphereArrays& p_spheres, BatchHits& p_hits);
+	void intersecting(const Sphere& p_sphere, const AABBArrays& p_AABBs, BatchHits& p_hits);
+	void intersecting(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits);
+
+	// The batch functions above using a specific kernel instead of the widest the running CPU supports.
+	// p_instruction_set must be supported by the running CPU, see Utility::instruction_set().
+	void intersecting(const Ray& p_ray,       const AABBArrays& p_AABBs,     BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+	void intersecting(const Ray& p_ray,       const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+	void intersecting(const AABB& p_AABB,     const AABBArrays& p_AABBs,     BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+	void intersecting(const AABB& p_AABB,     const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+	void intersecting(const Sphere& p_sphere, const AABBArrays& p_AABBs,     BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+	void intersecting(const Sphere& p_sphere, const SphereArrays& p_spheres, BatchHits& p_hits, Utility::InstructionSet p_instruction_set);
+} // namespace Geometry
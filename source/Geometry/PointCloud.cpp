@@ -0,0 +1,291 @@
+#include "PointCloud.hpp"
+
+#include "Utility/Logger.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#ifdef Z_X86
+	#include <immintrin.h>
+#endif
+
+namespace Geometry
+{
+	// Reduce per-lane maxima to a single index. Lanes with equal dot products resolve to the lowest index to match the scalar kernel.
+	template <size_t Lanes>
+	static size_t reduce_lanes(const float* p_dots, const int32_t* p_indices)
+	{
+		size_t best_lane = 0;
+		for (size_t lane = 1; lane < Lanes; lane++)
+		{
+			if (p_dots[lane] > p_dots[best_lane] || (p_dots[lane] == p_dots[best_lane] && p_indices[lane] < p_indices[best_lane]))
+				best_lane = lane;
+		}
+		return static_cast<size_t>(p_indices[best_lane]);
+	}
+
+	static size_t max_dot_scalar(const float* p_x, const float* p_y, const float* p_z, size_t p_count, const glm::vec3& p_direction)
+	{
+		size_t furthest_index   = 0;
+		float furthest_distance = p_x[0] * p_direction.x + p_y[0] * p_direction.y + p_z[0] * p_direction.z;
+
+		for (size_t i = 1; i < p_count; i++)
+		{
+			const float distance = p_x[i] * p_direction.x + p_y[i] * p_direction.y + p_z[i] * p_direction.z;
+			if (distance > furthest_distance)
+			{
+				furthest_distance = distance;
+				furthest_index    = i;
+			}
+		}
+		return furthest_index;
+	}
+
+#ifdef Z_X86
+	// The SIMD kernels round identically to max_dot_scalar, see Utility/CPUFeatures.hpp.
+	TARGET_SSE4 static size_t max_dot_SSE4(const float* p_x, const float* p_y, const float* p_z, size_t p_padded_count, const glm::vec3& p_direction)
+	{
+		const __m128 dir_x = _mm_set1_ps(p_direction.x);
+		const __m128 dir_y = _mm_set1_ps(p_direction.y);
+		const __m128 dir_z = _mm_set1_ps(p_direction.z);
+		const __m128i step = _mm_set1_epi32(4);
+
+		__m128 best_dot     = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+		__m128i best_index  = _mm_setzero_si128();
+		__m128i index       = _mm_setr_epi32(0, 1, 2, 3);
+
+		for (size_t i = 0; i < p_padded_count; i += 4)
+		{
+			const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p_x + i), dir_x),
+			                                         _mm_mul_ps(_mm_loadu_ps(p_y + i), dir_y)),
+			                              _mm_mul_ps(_mm_loadu_ps(p_z + i), dir_z));
+			const __m128 greater = _mm_cmpgt_ps(dot, best_dot);
+			best_dot   = _mm_blendv_ps(best_dot, dot, greater);
+			best_index = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(best_index), _mm_castsi128_ps(index), greater));
+			index      = _mm_add_epi32(index, step);
+		}
+
+		alignas(16) float dots[4];
+		alignas(16) int32_t indices[4];
+		_mm_store_ps(dots, best_dot);
+		_mm_store_si128(reinterpret_cast<__m128i*>(indices), best_index);
+		return reduce_lanes<4>(dots, indices);
+	}
+
+	TARGET_AVX2 static size_t max_dot_AVX2(const float* p_x, const float* p_y, const float* p_z, size_t p_padded_count, const glm::vec3& p_direction)
+	{
+		const __m256 dir_x = _mm256_set1_ps(p_direction.x);
+		const __m256 dir_y = _mm256_set1_ps(p_direction.y);
+		const __m256 dir_z = _mm256_set1_ps(p_direction.z);
+		const __m256i step = _mm256_set1_epi32(8);
+
+		__m256 best_dot     = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+		__m256i best_index  = _mm256_setzero_si256();
+		__m256i index       = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+		for (size_t i = 0; i < p_padded_count; i += 8)
+		{
+			const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(p_x + i), dir_x),
+			                                               _mm256_mul_ps(_mm256_loadu_ps(p_y + i), dir_y)),
+			                                 _mm256_mul_ps(_mm256_loadu_ps(p_z + i), dir_z));
+			const __m256 greater = _mm256_cmp_ps(dot, best_dot, _CMP_GT_OQ);
+			best_dot   = _mm256_blendv_ps(best_dot, dot, greater);
+			best_index = _mm256_blendv_epi8(best_index, index, _mm256_castps_si256(greater));
+			index      = _mm256_add_epi32(index, step);
+		}
+
+		alignas(32) float dots[8];
+		alignas(32) int32_t indices[8];
+		_mm256_store_ps(dots, best_dot);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(indices), best_index);
+		return reduce_lanes<8>(dots, indices);
+	}
+#endif
+
+	PointCloud::PointCloud() noexcept
+		: m_x{}
+		, m_y{}
+		, m_z{}
+		, m_size{0}
+	{}
+	PointCloud::PointCloud(const std::vector<glm::vec3>& p_points)
+		: m_x{}
+		, m_y{}
+		, m_z{}
+		, m_size{p_points.size()}
+	{
+		ASSERT_THROW(p_points.size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()), "[PointCloud] Too many points for the 32-bit SIMD lane indices.");
+
+		if (p_points.empty())
+			return;
+
+		const size_t padded_size = ((m_size + Lane_Width - 1) / Lane_Width) * Lane_Width;
+		m_x.reserve(padded_size);
+		m_y.reserve(padded_size);
+		m_z.reserve(padded_size);
+
+		for (const auto& point : p_points)
+		{
+			m_x.push_back(point.x);
+			m_y.push_back(point.y);
+			m_z.push_back(point.z);
+		}
+		// Padding repeats point 0, a padded lane can only ever tie with index 0 which wins the tie.
+		while (m_x.size() < padded_size)
+		{
+			m_x.push_back(p_points.front().x);
+			m_y.push_back(p_points.front().y);
+			m_z.push_back(p_points.front().z);
+		}
+	}
+
+	// Whether steepest ascent over the edges of the triangles always reaches the furthest point of p_cloud: every triangle's plane has all the
+	// points on or behind it (the surface is convex) and every point is reachable over the edges (the surface is connected and has no loose points).
+	// The furthest points either side of each plane are found with the linear kernels, O(triangles * points / Lane_Width) once on construction.
+	//@param p_edges Both directions of every triangle edge, sorted and unique.
+	static bool is_convex_surface(const PointCloud& p_cloud, const std::vector<uint32_t>& p_triangle_indices, const std::vector<std::pair<uint32_t, uint32_t>>& p_edges)
+	{
+		glm::vec3 min = p_cloud[0];
+		glm::vec3 max = p_cloud[0];
+		for (size_t i = 1; i < p_cloud.size(); i++)
+		{
+			min = glm::min(min, p_cloud[i]);
+			max = glm::max(max, p_cloud[i]);
+		}
+		const glm::vec3 size  = max - min;
+		const float tolerance = 1e-4f * std::max({size.x, size.y, size.z}); // Coplanar points of a flat face round to either side of its plane.
+
+		for (size_t i = 0; i < p_triangle_indices.size(); i += 3)
+		{
+			const glm::vec3 a      = p_cloud[p_triangle_indices[i]];
+			const glm::vec3 normal = glm::cross(p_cloud[p_triangle_indices[i + 1]] - a, p_cloud[p_triangle_indices[i + 2]] - a);
+			const float length     = glm::length(normal);
+			if (length == 0.f)
+				continue; // Degenerate triangles have no plane, their edges are still valid.
+
+			// The winding isn't known to face outwards, the points only have to be on one side of the plane.
+			const float in_front = glm::dot(normal, p_cloud.support_point(normal) - a) / length;
+			const float behind   = glm::dot(normal, a - p_cloud.support_point(-normal)) / length;
+			if (in_front > tolerance && behind > tolerance)
+				return false;
+		}
+
+		// Flood fill the edge graph from point 0, p_edges are sorted on the first index so each point's neighbours are a contiguous range.
+		std::vector<bool> reached(p_cloud.size(), false);
+		std::vector<uint32_t> stack = {0u};
+		reached[0] = true;
+		size_t reached_count = 1;
+		while (!stack.empty())
+		{
+			const uint32_t point = stack.back();
+			stack.pop_back();
+			for (auto edge = std::lower_bound(p_edges.begin(), p_edges.end(), std::make_pair(point, 0u)); edge != p_edges.end() && edge->first == point; edge++)
+			{
+				if (!reached[edge->second])
+				{
+					reached[edge->second] = true;
+					reached_count++;
+					stack.push_back(edge->second);
+				}
+			}
+		}
+		return reached_count == p_cloud.size();
+	}
+
+	PointCloud::PointCloud(const std::vector<glm::vec3>& p_points, const std::vector<uint32_t>& p_triangle_indices)
+		: PointCloud(p_points)
+	{
+		ASSERT_THROW(p_triangle_indices.size() % 3 == 0, "[PointCloud] Triangle indices must be a multiple of 3.");
+
+		if (m_size == 0)
+			return;
+
+		// Collect both directions of every triangle edge, then sort and unique to build the compressed rows.
+		std::vector<std::pair<uint32_t, uint32_t>> edges;
+		edges.reserve(p_triangle_indices.size() * 2);
+		for (size_t i = 0; i < p_triangle_indices.size(); i += 3)
+		{
+			const uint32_t a = p_triangle_indices[i];
+			const uint32_t b = p_triangle_indices[i + 1];
+			const uint32_t c = p_triangle_indices[i + 2];
+			ASSERT_THROW(a < m_size && b < m_size && c < m_size, "[PointCloud] Triangle index out of range.");
+
+			edges.insert(edges.end(), {{a, b}, {b, a}, {b, c}, {c, b}, {c, a}, {a, c}});
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		if (!is_convex_surface(*this, p_triangle_indices, edges))
+			return; // Hill-climbing can stop at a local maximum of a concave or disconnected surface, keep to the exact linear kernels.
+
+		m_neighbour_offsets.assign(m_size + 1, 0);
+		m_neighbours.reserve(edges.size());
+		for (const auto& [from, to] : edges)
+		{
+			m_neighbour_offsets[from + 1]++;
+			m_neighbours.push_back(to);
+		}
+		for (size_t i = 0; i < m_size; i++)
+			m_neighbour_offsets[i + 1] += m_neighbour_offsets[i];
+	}
+
+	size_t PointCloud::support_index(const glm::vec3& p_direction) const
+	{
+		return support_index(p_direction, Utility::instruction_set());
+	}
+	size_t PointCloud::support_index(const glm::vec3& p_direction, Utility::InstructionSet p_instruction_set) const
+	{
+		if (empty())
+			throw std::runtime_error("[PointCloud] Empty point set in support_index func.");
+
+		switch (p_instruction_set)
+		{
+#ifdef Z_X86
+			case Utility::InstructionSet::AVX2: return max_dot_AVX2(m_x.data(), m_y.data(), m_z.data(), m_x.size(), p_direction);
+			case Utility::InstructionSet::SSE4: return max_dot_SSE4(m_x.data(), m_y.data(), m_z.data(), m_x.size(), p_direction);
+#endif
+			default: return max_dot_scalar(m_x.data(), m_y.data(), m_z.data(), m_size, p_direction);
+		}
+	}
+	size_t PointCloud::support_index(const glm::vec3& p_direction, size_t& p_start_index) const
+	{
+		if (!has_adjacency() || m_size < Hill_Climb_Threshold)
+		{
+			p_start_index = support_index(p_direction);
+			return p_start_index;
+		}
+
+		auto distance = [&](uint32_t p_index) { return m_x[p_index] * p_direction.x + m_y[p_index] * p_direction.y + m_z[p_index] * p_direction.z; };
+
+		uint32_t current       = p_start_index < m_size ? static_cast<uint32_t>(p_start_index) : 0u;
+		float current_distance = distance(current);
+
+		// Steepest ascent over the hull's vertex graph. On a convex hull a vertex with no further neighbour is the global maximum.
+		// Each step strictly increases the distance so the walk always terminates.
+		while (true)
+		{
+			uint32_t best_neighbour = current;
+			for (uint32_t i = m_neighbour_offsets[current]; i < m_neighbour_offsets[current + 1]; i++)
+			{
+				const float neighbour_distance = distance(m_neighbours[i]);
+				if (neighbour_distance > current_distance)
+				{
+					current_distance = neighbour_distance;
+					best_neighbour   = m_neighbours[i];
+				}
+			}
+
+			if (best_neighbour == current)
+				break;
+
+			current = best_neighbour;
+		}
+
+		p_start_index = current;
+		return current;
+	}
+} // namespace Geometry
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Utility/CPUFeatures.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Geometry
+{
+	// A set of object-space points packed as a structure of arrays (all x, then all y, then all z).
+	// The packing lets support queries evaluate Lane_Width dot products per instruction.
+	// Storage is padded to a multiple of Lane_Width by repeating the first point, so kernels never need a remainder loop.
+	// When constructed from a triangulated convex hull, the vertex adjacency is stored to allow hill-climbing support queries.
+	// Concave or disconnected surfaces don't store it, hill-climbing could stop at a local maximum, so their queries stay on the linear kernels.
+	class PointCloud
+	{
+		std::vector<float> m_x;
+		std::vector<float> m_y;
+		std::vector<float> m_z;
+		size_t m_size; // Number of points excluding the padding.
+
+		// Vertex adjacency in compressed rows. The neighbours of point i are m_neighbours[m_neighbour_offsets[i]] to m_neighbours[m_neighbour_offsets[i + 1]].
+		// Empty if the cloud was constructed without triangles.
+		std::vector<uint32_t> m_neighbour_offsets;
+		std::vector<uint32_t> m_neighbours;
+
+	public:
+		constexpr static size_t Lane_Width           = 8;  // Widest SIMD kernel (AVX2) processes 8 floats at a time.
+		constexpr static size_t Hill_Climb_Threshold = 64; // Below this many points a SIMD linear scan beats walking the adjacency.
+
+		PointCloud() noexcept;
+		explicit PointCloud(const std::vector<glm::vec3>& p_points);
+		// Construct a PointCloud with vertex adjacency if the triangles form a convex, connected surface over every point.
+		// Otherwise the adjacency is left empty, as if constructed from p_points alone. See has_adjacency.
+		//@param p_points The vertices of the surface.
+		//@param p_triangle_indices Every 3 indices into p_points form a triangle of the surface.
+		PointCloud(const std::vector<glm::vec3>& p_points, const std::vector<uint32_t>& p_triangle_indices);
+
+		size_t size() const  { return m_size; }
+		bool empty() const   { return m_size == 0; }
+		glm::vec3 operator[](size_t p_index) const { return glm::vec3(m_x[p_index], m_y[p_index], m_z[p_index]); }
+
+		// Find the index of the furthest point in p_direction (the point with the max dot product).
+		// Uses the widest kernel the running CPU supports. Ties resolve to the lowest index.
+		//@param p_direction The direction to search in. Doesn't have to be normalized since we only care about direction.
+		size_t support_index(const glm::vec3& p_direction) const;
+		// Find the index of the furthest point in p_direction using a specific kernel.
+		// p_instruction_set must be supported by the running CPU, see Utility::instruction_set().
+		size_t support_index(const glm::vec3& p_direction, Utility::InstructionSet p_instruction_set) const;
+		// Find the index of the furthest point in p_direction by hill-climbing the hull adjacency from p_start_index.
+		// When consecutive directions are similar the walk is only a few steps, making the query near O(1) amortised.
+		// Falls back to the linear kernels when there is no adjacency or the cloud is smaller than Hill_Climb_Threshold.
+		//@param p_direction The direction to search in. Doesn't have to be normalized since we only care about direction.
+		//@param p_start_index The index to start climbing from, updated to the returned index so it can be cached for the next query.
+		size_t support_index(const glm::vec3& p_direction, size_t& p_start_index) const;
+		bool has_adjacency() const { return !m_neighbour_offsets.empty(); }
+		// Find the furthest point in p_direction.
+		glm::vec3 support_point(const glm::vec3& p_direction) const { return (*this)[support_index(p_direction)]; }
+	};
+} // namespace Geometry
@@ -0,0 +1,41 @@
+#include "TriangleBVH.hpp"
+
+#include "Utility/Logger.hpp"
+
+namespace Geometry
+{
+	TriangleBVH::TriangleBVH() noexcept
+		: m_triangles{}
+		, m_tree{}
+	{}
+
+	TriangleBVH::TriangleBVH(const std::vector<glm::vec3>& p_positions, const std::vector<uint32_t>& p_triangle_indices)
+		: m_triangles{}
+		, m_tree{}
+	{
+		ASSERT_THROW(p_triangle_indices.size() % 3 == 0, "Triangle indices must be a multiple of 3.");
+
+		m_triangles.reserve(p_triangle_indices.size() / 3);
+		std::vector<AABB> AABBs;
+		AABBs.reserve(p_triangle_indices.size() / 3);
+
+		for (size_t i = 0; i < p_triangle_indices.size(); i += 3)
+		{
+			ASSERT_THROW(p_triangle_indices[i] < p_positions.size() && p_triangle_indices[i + 1] < p_positions.size() && p_triangle_indices[i + 2] < p_positions.size(),
+				"Triangle index out of range of the positions.");
+
+			const auto triangle = Triangle(p_positions[p_triangle_indices[i]], p_positions[p_triangle_indices[i + 1]], p_positions[p_triangle_indices[i + 2]]);
+			if (triangle.is_degenerate())
+				continue;
+
+			AABB bounds = AABB(triangle.m_point_1, triangle.m_point_1);
+			bounds.unite(triangle.m_point_2);
+			bounds.unite(triangle.m_point_3);
+
+			m_triangles.push_back(triangle);
+			AABBs.push_back(bounds);
+		}
+
+		m_tree.build(AABBs);
+	}
+} // namespace Geometry
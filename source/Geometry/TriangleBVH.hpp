@@ -0,0 +1,31 @@
+#pragma once
+
+#include "AABBTree.hpp"
+#include "Triangle.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Geometry
+{
+	// The triangles of a mesh in object space with an AABBTree over them.
+	// Lets concave meshes collide per triangle, the tree narrows a query down to the few triangles near it.
+	class TriangleBVH
+	{
+		std::vector<Triangle> m_triangles;
+		AABBTree m_tree; // Items index m_triangles.
+
+	public:
+		TriangleBVH() noexcept;
+		//@param p_positions Object-space vertex positions.
+		//@param p_triangle_indices Every 3 indices into p_positions form a triangle. Degenerate triangles are skipped.
+		TriangleBVH(const std::vector<glm::vec3>& p_positions, const std::vector<uint32_t>& p_triangle_indices);
+
+		bool empty() const                               { return m_triangles.empty(); }
+		size_t size() const                              { return m_triangles.size(); }
+		const Triangle& operator[](size_t p_index) const { return m_triangles[p_index]; }
+		const AABBTree& get_tree() const                 { return m_tree; }
+	};
+} // namespace Geometry
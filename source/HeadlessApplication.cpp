@@ -0,0 +1,142 @@
+#include "HeadlessApplication.hpp"
+
+#include "Utility/FixedTimestep.hpp"
+#include "Utility/PreciseSleeper.hpp"
+#include "Utility/Utility.hpp"
+
+#include <algorithm>
+#include <istream>
+
+HeadlessApplication::HeadlessApplication() noexcept
+	: m_physics_ticks_per_second{60}
+	, m_input_ticks_per_second{120}
+	, m_input{}
+	, m_texture_system{}
+	, m_mesh_system{m_texture_system}
+	, m_scene_system{m_texture_system, m_mesh_system}
+	, m_collision_system{m_scene_system}
+	, m_physics_system{m_scene_system, m_collision_system}
+	, m_input_system{m_input, m_scene_system}
+	, m_statistics{}
+	, m_input_timings{m_statistics.add_timings("input")}
+	, m_integrate_timings{m_statistics.add_timings("physics_integrate")}
+	, m_collision_timings{m_statistics.add_timings("collision_update")}
+{}
+
+void HeadlessApplication::simulation_loop(std::optional<size_t> p_physics_ticks, bool p_paced)
+{
+	LOG("Target physics ticks per second: {} (timestep: {}ms)", m_physics_ticks_per_second, 1000.f / m_physics_ticks_per_second);
+	LOG("Target input ticks per second:   {} (timestep: {}ms)", m_input_ticks_per_second, 1000.f / m_input_ticks_per_second);
+
+	run_ticks(p_physics_ticks, p_paced, nullptr);
+
+	LOG("------------------------------------------------------------------------");
+	LOG("Simulation statistics:\n{}", m_statistics.to_JSON());
+}
+
+void HeadlessApplication::benchmark(const Utility::Benchmark::Parameters& p_parameters)
+{
+	// A replay runs at the rates and seed it was recorded with, its input ticks need the physics ticks to fall where they did.
+	std::optional<Platform::InputReplay> input_replay;
+	std::optional<Utility::Benchmark::Recording> recording;
+	if (!p_parameters.input_log.empty())
+	{
+		input_replay.emplace(m_input, p_parameters.input_log);
+		m_physics_ticks_per_second = input_replay->header().physics_ticks_per_second;
+		m_input_ticks_per_second   = input_replay->header().input_ticks_per_second;
+		recording                  = Utility::Benchmark::Recording{input_replay->header().seed, input_replay->physics_ticks()};
+	}
+	const auto run = m_statistics.start_run(p_parameters, recording, [this](std::istream& p_file)
+	{
+		auto& scene = m_scene_system.add_scene();
+		scene       = System::Scene::deserialise(p_file, Config::Save_Version);
+		m_scene_system.set_current_scene(scene);
+	});
+
+	// The length of the run is known, so every duration is kept for exact percentiles without reallocating mid-run.
+	m_input_timings.keep_samples(input_replay ? input_replay->input_ticks() : run.ticks_at(m_input_ticks_per_second, m_physics_ticks_per_second));
+	Utility::Benchmark::keep_samples({&m_integrate_timings, &m_collision_timings}, run.physics_ticks);
+
+	run_ticks(run.physics_ticks, false, input_replay ? &*input_replay : nullptr);
+	m_statistics.write_JSON(p_parameters.output);
+}
+
+void HeadlessApplication::run_ticks(std::optional<size_t> p_physics_ticks, bool p_paced, Platform::InputReplay* p_input_replay)
+{
+	using Clock = Utility::FixedTimestep::Clock;
+	constexpr auto Max_Backlog = std::chrono::milliseconds(250); // Paced, a stall longer than this skips ticks rather than bursting.
+
+	const Clock::time_point time_started = Clock::now();
+	Utility::FixedTimestep physics_ticks{m_physics_ticks_per_second, time_started};
+	Utility::FixedTimestep input_ticks{m_input_ticks_per_second, time_started};
+	Utility::PreciseSleeper sleeper;
+	size_t physics_ticks_run = 0;
+
+	// Both streams run on this thread, there is no renderer to run alongside the physics so the scene needs no locking.
+	// Unpaced, the clock is the time of whichever tick is due next rather than the wall clock, so the streams interleave
+	// exactly as they would in real time while never waiting.
+	// Replayed input ticks take the place of the input stream, each runs before the physics tick that followed it in the recording.
+	while (!p_physics_ticks || physics_ticks_run < *p_physics_ticks)
+	{
+		while (p_input_replay && p_input_replay->tick_due(physics_ticks_run))
+		{
+			Utility::Benchmark::ScopedTimer timer{m_input_timings};
+			m_input.update();
+			p_input_replay->apply_next_tick();
+			m_input_system.update(input_ticks.timestep());
+		}
+
+		const Clock::time_point next_tick = p_input_replay ? physics_ticks.next_tick() : std::min(physics_ticks.next_tick(), input_ticks.next_tick());
+		if (p_paced)
+			sleeper.sleep_until(next_tick);
+
+		const Clock::time_point now = p_paced ? Clock::now() : next_tick;
+		if (p_paced)
+			physics_ticks.limit_backlog(now, Max_Backlog);
+
+		if (!p_input_replay && input_ticks.consume(now))
+		{
+			input_ticks.skip_missed(now);
+			Utility::Benchmark::ScopedTimer timer{m_input_timings};
+			m_input.update();
+			m_input_system.update(input_ticks.timestep());
+		}
+
+		while ((!p_physics_ticks || physics_ticks_run < *p_physics_ticks) && physics_ticks.consume(now))
+		{
+			{
+				Utility::Benchmark::ScopedTimer timer{m_integrate_timings};
+				m_physics_system.integrate(physics_ticks.timestep());
+			}
+			{
+				Utility::Benchmark::ScopedTimer timer{m_collision_timings};
+				m_collision_system.update();
+			}
+			physics_ticks_run++;
+		}
+	}
+
+	const double wall_time_seconds      = std::chrono::duration<double>(Clock::now() - time_started).count();
+	const double simulated_time_seconds = std::chrono::duration<double>(physics_ticks.current_time() - time_started).count();
+	m_statistics.set("run", "wall_time_seconds", wall_time_seconds);
+	m_statistics.set("run", "simulated_time_seconds", simulated_time_seconds);
+	m_statistics.set("run", "real_time_factor", wall_time_seconds > 0.0 ? simulated_time_seconds / wall_time_seconds : 0.0);
+	m_statistics.set("ticks", "physics", static_cast<uint64_t>(m_physics_system.m_update_count));
+	m_statistics.set("ticks", "input",   static_cast<uint64_t>(m_input_system.m_update_count));
+	m_statistics.set("ticks_per_second", "physics_target", static_cast<uint64_t>(m_physics_ticks_per_second));
+	m_statistics.set("ticks_per_second", "input_target",   static_cast<uint64_t>(m_input_ticks_per_second));
+	if (p_paced)
+	{
+		m_statistics.set("sleep", "count",                 static_cast<uint64_t>(sleeper.oversleep().count));
+		m_statistics.set("sleep", "oversleep_mean_us",     sleeper.oversleep().mean);
+		m_statistics.set("sleep", "oversleep_std_dev_us",  sleeper.oversleep().standard_deviation());
+		m_statistics.set("sleep", "oversleep_max_us",      sleeper.oversleep().max);
+	}
+
+	const auto& entities = m_scene_system.get_current_scene_entities();
+	m_statistics.set("entities", "total",        static_cast<uint64_t>(entities.count_entities()));
+	m_statistics.set("entities", "rigid_bodies", static_cast<uint64_t>(entities.count_components<Component::RigidBody>()));
+	m_statistics.set("entities", "colliders",    static_cast<uint64_t>(entities.count_components<Component::Collider>()));
+	m_statistics.set("entities", "meshes",       static_cast<uint64_t>(entities.count_components<Component::Mesh>()));
+	m_statistics.record_memory_high_water("end");
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "System/CollisionSystem.hpp"
+#include "System/InputSystem.hpp"
+#include "System/MeshSystem.hpp"
+#include "System/PhysicsSystem.hpp"
+#include "System/SceneSystem.hpp"
+#include "System/TextureSystem.hpp"
+
+#include "Platform/Input.hpp"
+#include "Platform/InputRecording.hpp"
+
+#include "Utility/Benchmark.hpp"
+#include "Utility/Logger.hpp"
+#include "Utility/Stopwatch.hpp"
+
+#include "Component/Collider.hpp"
+#include "Component/FirstPersonCamera.hpp"
+#include "Component/Input.hpp"
+#include "Component/Label.hpp"
+#include "Component/Lights.hpp"
+#include "Component/Mesh.hpp"
+#include "Component/ParticleEmitter.hpp"
+#include "Component/RigidBody.hpp"
+#include "Component/Terrain.hpp"
+#include "Component/Texture.hpp"
+#include "Component/Transform.hpp"
+
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+// HeadlessApplication runs the simulation of an ECS without a window or a GL context.
+// Only the Systems that update the scene state are owned, nothing is rendered and meshes hold only their CPU side collision data.
+// Input comes from a Platform::Input that is never polled, events can be applied to it directly or replayed from a recording.
+class HeadlessApplication
+{
+public:
+	HeadlessApplication() noexcept;
+	// Run the physics and input ticks, the same Utility::FixedTimestep streams the windowed Application runs.
+	//@param p_physics_ticks The number of physics ticks to run before returning. If nullopt, runs until the process is terminated.
+	//@param p_paced If true the ticks run in real time, sleeping until each is due. If false the ticks run back to back as fast as
+	// possible, each stream still advances by its timestep so the results are identical to a paced run.
+	void simulation_loop(std::optional<size_t> p_physics_ticks, bool p_paced);
+	// Load the scene in p_parameters, run its physics ticks unpaced and write the timings of each system as JSON.
+	// If p_parameters has an input log its input ticks are replayed in place of the input stream.
+	void benchmark(const Utility::Benchmark::Parameters& p_parameters);
+
+	unsigned m_physics_ticks_per_second; // The number of physics updates to perform per second.
+	unsigned m_input_ticks_per_second;   // The number of input system updates to perform every second.
+
+private:
+	Platform::Input m_input;
+
+	System::TextureSystem m_texture_system;
+	System::MeshSystem m_mesh_system;
+	System::SceneSystem m_scene_system;
+
+	System::CollisionSystem m_collision_system;
+	System::PhysicsSystem m_physics_system;
+	System::InputSystem m_input_system;
+
+	// The duration of every update of each system, reported when simulation_loop or benchmark end. Binned in simulation_loop, kept in full by benchmark.
+	Utility::Benchmark m_statistics;
+	Utility::Benchmark::Timings& m_input_timings;
+	Utility::Benchmark::Timings& m_integrate_timings;
+	Utility::Benchmark::Timings& m_collision_timings;
+
+	// Run the ticks of simulation_loop then set the run, tick and entity counts and memory high-water mark into m_statistics.
+	//@param p_input_replay If not null, its input ticks are run after the physics ticks they followed when recorded instead of the input stream.
+	void run_ticks(std::optional<size_t> p_physics_ticks, bool p_paced, Platform::InputReplay* p_input_replay);
+};
+
+// Usage: SpiritHeadless [--ticks <physics ticks>] [--unpaced]
+//        SpiritHeadless [--benchmark <scene file>] [--replay <input log>] [--ticks <physics ticks>] [--seed <seed>] --output <json file>
+int main(int argc, char* argv[])
+{
+	Utility::Stopwatch stopwatch;
+
+	ECS::Component::set_info<Component::Collider>();
+	ECS::Component::set_info<Component::FirstPersonCamera>();
+	ECS::Component::set_info<Component::Input>();
+	ECS::Component::set_info<Component::Label>();
+	ECS::Component::set_info<Component::PointLight>();
+	ECS::Component::set_info<Component::DirectionalLight>();
+	ECS::Component::set_info<Component::SpotLight>();
+	ECS::Component::set_info<Component::Mesh>();
+	ECS::Component::set_info<Component::ParticleEmitter>();
+	ECS::Component::set_info<Component::RigidBody>();
+	ECS::Component::set_info<Component::Terrain>();
+	ECS::Component::set_info<Component::Texture>();
+	ECS::Component::set_info<Component::Transform>();
+
+	std::optional<size_t> physics_ticks;
+	bool paced = true;
+	for (int index = 1; index < argc; ++index)
+	{
+		const std::string_view argument = argv[index];
+		if (argument == "--ticks" && index + 1 < argc)
+			physics_ticks = std::strtoull(argv[++index], nullptr, 10);
+		else if (argument == "--unpaced")
+			paced = false;
+		else if (Utility::Benchmark::Parameters::is_option(argument))
+			++index; // Skip the value, parsed by Benchmark::Parameters.
+		else
+			LOG_WARN(false, "[INIT] Unknown argument '{}' ignored", argument);
+	}
+
+	auto app = HeadlessApplication();
+	LOG("[INIT] Headless initialisation took {}", stopwatch.duration_since_start<int, std::milli>());
+
+	if (const auto benchmark_parameters = Utility::Benchmark::Parameters::parse(argc, argv))
+		app.benchmark(*benchmark_parameters);
+	else
+		app.simulation_loop(physics_ticks, paced);
+	return EXIT_SUCCESS;
+}
@@ -85,6 +85,8 @@ namespace OpenGL
 
 		if (opt.m_show_bounding_box)
 		{
+			// Collider state is written by the physics thread.
+			std::scoped_lock lock{p_scene.get_mutex()};
 			scene.foreach([&](Component::Collider& p_collider)
 			{
 				auto model = glm::translate(glm::identity<glm::mat4>(), p_collider.m_world_AABB.get_center());
@@ -11,6 +11,7 @@
 #include "System/MeshSystem.hpp"
 #include "System/SceneSystem.hpp"
 #include "System/TextureSystem.hpp"
+#include "System/TransformSnapshot.hpp"
 
 #include "Platform/Core.hpp"
 #include "Platform/Window.hpp"
@@ -73,11 +74,11 @@ namespace OpenGL
 		LOG("[OPENGL] Constructed new OpenGLRenderer instance");
 	}
 
-	void OpenGLRenderer::start_frame()
+	void OpenGLRenderer::start_frame(const System::TransformSnapshot& p_transforms, float p_alpha)
 	{
 		m_view_properties_buffer.buffer_sub_data(0, m_scene_system.get_current_scene_view_info());
 
-		m_shadow_mapper.shadow_pass(m_scene_system.get_current_scene());
+		m_shadow_mapper.shadow_pass(m_scene_system.get_current_scene(), p_transforms, p_alpha);
 
 		// Prepare m_screen_framebuffer for rendering
 		m_screen_framebuffer.resize(m_window.size());
@@ -88,7 +89,7 @@ namespace OpenGL
 		ASSERT(m_screen_framebuffer.is_complete(), "Screen framebuffer not complete, have you attached a colour or depth buffer to it?");
 	}
 
-	void OpenGLRenderer::draw(const DeltaTime& delta_time)
+	void OpenGLRenderer::draw(const DeltaTime& delta_time, const System::TransformSnapshot& p_transforms, float p_alpha)
 	{
 		auto& entities = m_scene_system.get_current_scene_entities();
 		auto& scene    = m_scene_system.get_current_scene();
@@ -115,12 +116,16 @@ namespace OpenGL
 		{
 			if (mesh_comp.m_mesh)
 			{
+				// The ECS Transform of a RigidBody may be mid-write by the physics thread, it's only read for entities without one.
+				const auto snapshot_model = p_transforms.get_model(p_entity, p_alpha);
+				const glm::mat4 model     = snapshot_model ? *snapshot_model : p_transform.get_model();
+
 				if (entities.has_components<Component::Texture>(p_entity))
 				{
 					auto& texComponent = entities.get_component<Component::Texture>(p_entity);
 
 					DrawCall dc;
-					dc.set_uniform("model", p_transform.get_model());
+					dc.set_uniform("model", model);
 					dc.set_uniform("light_proj_view", get_first_light_proj_view());
 					dc.set_uniform("shininess", texComponent.m_shininess);
 					dc.set_uniform("PCF_bias", Component::DirectionalLight::PCF_bias);
@@ -157,7 +162,7 @@ namespace OpenGL
 
 				// Fallback to rendering using default colour and no lighting.
 				DrawCall dc;
-				dc.set_uniform("model", p_transform.get_model());
+				dc.set_uniform("model", model);
 				dc.set_uniform("colour", glm::vec4(0.06f, 0.44f, 0.81f, 1.f));
 				dc.set_UBO("ViewProperties", m_view_properties_buffer);
 				dc.submit(m_uniform_colour_shader, mesh_comp.m_mesh->get_VAO(), m_screen_framebuffer);
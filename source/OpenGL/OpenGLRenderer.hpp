@@ -18,6 +18,7 @@ namespace System
 	class MeshSystem;
 	class TextureSystem;
 	class SceneSystem;
+	class TransformSnapshot;
 }
 namespace Platform
 {
@@ -66,10 +67,12 @@ namespace OpenGL
 		// OpenGLRenderer reads and renders the current state of pStorage when draw() is called.
 		OpenGLRenderer(Platform::Window& p_window, System::SceneSystem& p_scene_system, System::MeshSystem& p_mesh_system, System::TextureSystem& p_texture_system) noexcept;
 
-		void start_frame();
+		// p_transforms: Transforms of the RigidBodies to draw in place of their ECS Transform, which the physics thread may be writing.
+		// p_alpha: Fraction of the way from the previous to the current Transforms of p_transforms to draw the RigidBodies at.
+		void start_frame(const System::TransformSnapshot& p_transforms, float p_alpha);
 		void end_frame();
-		// Draw the current state of the ECS.
-		void draw(const DeltaTime& delta_time);
+		// Draw the current state of the ECS, RigidBodies interpolated by p_alpha between their Transforms in p_transforms.
+		void draw(const DeltaTime& delta_time, const System::TransformSnapshot& p_transforms, float p_alpha);
 
 		void reload_shaders();
 	};
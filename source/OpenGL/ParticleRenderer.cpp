@@ -93,8 +93,7 @@ namespace OpenGL
 				const unsigned int remaining_size     = p_emitter.max_particle_count - p_emitter.alive_count;
 				const unsigned int new_particle_count = std::min(remaining_size, particles_to_spawn);
 
-				auto rd           = std::random_device();
-				auto gen          = std::mt19937(rd());
+				auto& gen         = Utility::random_engine();
 				auto distribution = std::uniform_real_distribution<float>(0.f, 1.f);
 
 				std::vector<Component::Particle> new_particles;
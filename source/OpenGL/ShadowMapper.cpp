@@ -6,6 +6,7 @@
 #include "Component/Transform.hpp"
 #include "ECS/Storage.hpp"
 #include "System/SceneSystem.hpp"
+#include "System/TransformSnapshot.hpp"
 
 namespace OpenGL
 {
@@ -14,7 +15,7 @@ namespace OpenGL
 		, m_shadow_depth_shader{"shadowDepth"}
 	{}
 
-	void ShadowMapper::shadow_pass(System::Scene& p_scene)
+	void ShadowMapper::shadow_pass(System::Scene& p_scene, const System::TransformSnapshot& p_transforms, float p_alpha)
 	{
 		m_depth_map_FBO.clear();
 		unsigned int directional_light_count = static_cast<unsigned int>(p_scene.m_entities.count_components<Component::DirectionalLight>());
@@ -24,15 +25,17 @@ namespace OpenGL
 			// Draw the scene from the perspective of the light
 			p_scene.m_entities.foreach([&](Component::DirectionalLight& p_light)
 			{
-				p_scene.m_entities.foreach([&](Component::Transform& p_transform, Component::Mesh& p_mesh)
+				p_scene.m_entities.foreach([&](const ECS::Entity& p_entity, Component::Transform& p_transform, Component::Mesh& p_mesh)
 				{
+					const auto snapshot_model = p_transforms.get_model(p_entity, p_alpha);
+
 					DrawCall dc;
 					dc.m_cull_face_enabled = false;
 					dc.m_depth_test_enabled = true;
 					dc.m_write_to_depth_buffer = true;
 					dc.m_depth_test_type = DepthTestType::Less;
 					dc.set_uniform("light_space_mat", p_light.get_view_proj(p_scene.m_bound));
-					dc.set_uniform("model", p_transform.get_model());
+					dc.set_uniform("model", snapshot_model ? *snapshot_model : p_transform.get_model());
 					dc.submit(m_shadow_depth_shader, p_mesh.m_mesh->get_VAO(), m_depth_map_FBO);
 				});
 			});
@@ -8,6 +8,7 @@
 namespace System
 {
 	class Scene;
+	class TransformSnapshot;
 }
 namespace OpenGL
 {
@@ -20,7 +21,8 @@ namespace OpenGL
 		ShadowMapper(const glm::uvec2& p_resolution) noexcept;
 
 		// Renders the scene from the perspective of the light source to fill a depth texture map.
-		void shadow_pass(System::Scene& p_scene);
+		// RigidBodies are drawn interpolated by p_alpha between their Transforms in p_transforms.
+		void shadow_pass(System::Scene& p_scene, const System::TransformSnapshot& p_transforms, float p_alpha);
 		const Texture& get_depth_map() const { return m_depth_map_FBO.depth_attachment(); };
 
 		void draw_UI();
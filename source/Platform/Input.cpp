@@ -2,8 +2,10 @@
 
 #include "Utility/Logger.hpp"
 
-#include "GLFW/glfw3.h"
-#include "imgui.h"
+#ifndef Z_HEADLESS
+	#include "GLFW/glfw3.h"
+	#include "imgui.h"
+#endif
 
 #include <algorithm>
 
@@ -17,17 +19,28 @@ namespace Platform
 		, m_cursor_mode{CursorMode::Normal}
 		, m_captured_this_frame{false}
 		, m_handle{nullptr} // Initial value set in Window constructor
+		, m_replaying{false}
+		, m_replayed_cursor_over_UI{false}
+		, m_replayed_keyboard_captured_by_UI{false}
 		, m_key_event{}
 		, m_mouse_button_event{}
 		, m_mouse_move_event{}
 		, m_mouse_scroll_event{}
+		, m_input_event{}
 	{}
 
 	void Input::update()
 	{
 		m_captured_this_frame = false;
 		m_cursor_delta = {0.f, 0.f};
+#ifndef Z_HEADLESS
 		glfwPollEvents();
+#endif
+	}
+	void Input::apply(const InputEvent& p_event)
+	{
+		m_input_event.dispatch(p_event);
+		std::visit([this](const auto& p_specific_event) { on_event(p_specific_event); }, p_event);
 	}
 
 	bool Input::is_key_down(Key p_key) const
@@ -61,16 +74,22 @@ namespace Platform
 		switch (m_cursor_mode)
 		{
 			case CursorMode::Normal:
+#ifndef Z_HEADLESS
 				glfwSetInputMode(m_handle, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+#endif
 				LOG("[INPUT] Cursor mode set to normal");
 				break;
 			case CursorMode::Hidden:
+#ifndef Z_HEADLESS
 				glfwSetInputMode(m_handle, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+#endif
 				LOG("[INPUT] Cursor mode set to hidden");
 				break;
 			case CursorMode::Captured:
 				m_captured_this_frame = true;
+#ifndef Z_HEADLESS
 				glfwSetInputMode(m_handle, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+#endif
 				LOG("[INPUT] Cursor mode set to captured");
 				break;
 			default:
@@ -79,69 +98,110 @@ namespace Platform
 	}
 	bool Input::cursor_over_UI() const
 	{
+		if (m_replaying)
+			return m_replayed_cursor_over_UI;
+#ifdef Z_HEADLESS
+		return false;
+#else
 		return ImGui::GetIO().WantCaptureMouse;
+#endif
 	}
 	bool Input::keyboard_captured_by_UI() const
 	{
+		if (m_replaying)
+			return m_replayed_keyboard_captured_by_UI;
+#ifdef Z_HEADLESS
+		return false;
+#else
 		return ImGui::GetIO().WantCaptureKeyboard;
+#endif
+	}
+
+	void Input::on_event(const KeyEvent& p_event)
+	{
+		if (p_event.action == Action::Press)
+			m_keys_pressed[static_cast<std::underlying_type_t<Key>>(p_event.key)] = true;
+		else if (p_event.action == Action::Release)
+			m_keys_pressed[static_cast<std::underlying_type_t<Key>>(p_event.key)] = false;
+
+		m_key_event.dispatch(Key{p_event.key}, Action{p_event.action});
+	}
+	void Input::on_event(const ModifierEvent& p_event)
+	{
+		if (p_event.action == Action::Press)
+			m_modifiers_pressed[static_cast<std::underlying_type_t<Modifier>>(p_event.modifier)] = true;
+		else if (p_event.action == Action::Release)
+			m_modifiers_pressed[static_cast<std::underlying_type_t<Modifier>>(p_event.modifier)] = false;
 	}
+	void Input::on_event(const MouseButtonEvent& p_event)
+	{
+		if (p_event.action == Action::Press)
+			m_mouse_buttons_pressed[static_cast<std::underlying_type_t<MouseButton>>(p_event.button)] = true;
+		else if (p_event.action == Action::Release)
+			m_mouse_buttons_pressed[static_cast<std::underlying_type_t<MouseButton>>(p_event.button)] = false;
 
+		m_mouse_button_event.dispatch(MouseButton{p_event.button}, Action{p_event.action});
+	}
+	void Input::on_event(const CursorMoveEvent& p_event)
+	{
+		glm::vec2 old_cursor_pos = m_cursor_position;
+		m_cursor_position = p_event.position;
+		// reversed y-coordinates to stay relative to top-left
+		m_cursor_delta = {m_cursor_position.x - old_cursor_pos.x, old_cursor_pos.y - m_cursor_position.y};
+
+		m_mouse_move_event.dispatch(glm::vec2{m_cursor_delta});
+	}
+	void Input::on_event(const ScrollEvent& p_event)
+	{
+		m_mouse_scroll_event.dispatch(glm::vec2{p_event.offset});
+	}
+
+#ifndef Z_HEADLESS // Without a Window there are no GLFW callbacks.
+
+	// The GLFW callbacks convert to InputEvents and apply them, so recorded and replayed input takes the same path as live input.
 	void Input::glfw_key_press(int p_key, int p_scancode, int p_action, int p_mode)
 	{
 		(void)p_scancode; (void)p_mode; // Unused parameters, required signature for GLFW callbacks, cant be deleted
+		if (m_replaying)
+			return;
 
 		Platform::Modifier modifier = glfw_to_modifier(p_key);
 		if (modifier != Modifier::Unknown)
 		{
-			if (p_action == GLFW_PRESS)
-				m_modifiers_pressed[static_cast<std::underlying_type_t<Modifier>>(modifier)] = true;
-			else if (p_action == GLFW_RELEASE)
-				m_modifiers_pressed[static_cast<std::underlying_type_t<Modifier>>(modifier)] = false;
-
+			apply(ModifierEvent{modifier, glfw_to_action(p_action)});
 			return;
 		}
 
 		Platform::Key key = glfw_to_key(p_key);
 		if (key != Key::Unknown)
-		{
-			if (p_action == GLFW_PRESS)
-				m_keys_pressed[static_cast<std::underlying_type_t<Key>>(key)] = true;
-			else if (p_action == GLFW_RELEASE)
-				m_keys_pressed[static_cast<std::underlying_type_t<Key>>(key)] = false;
-
-			m_key_event.dispatch(glfw_to_key(p_key), glfw_to_action(p_action));
-		}
+			apply(KeyEvent{key, glfw_to_action(p_action)});
 	}
 	void Input::glfw_mouse_press(int p_button, int p_action, int p_modifiers)
 	{ (void)p_modifiers; // Unused parameter, required signature for GLFW callbacks, cant be deleted
+		if (m_replaying)
+			return;
 
 		Platform::MouseButton button = glfw_to_mouse_button(p_button);
-
 		if (button == MouseButton::Unknown)
 			return;
 
-		if (p_action == GLFW_PRESS)
-			m_mouse_buttons_pressed[static_cast<std::underlying_type_t<MouseButton>>(button)] = true;
-		else if (p_action == GLFW_RELEASE)
-			m_mouse_buttons_pressed[static_cast<std::underlying_type_t<MouseButton>>(button)] = false;
-
-		m_mouse_button_event.dispatch(glfw_to_mouse_button(p_button), glfw_to_action(p_action));
+		apply(MouseButtonEvent{button, glfw_to_action(p_action)});
 	}
 	void Input::glfw_mouse_move(double p_cursor_new_x_pos, double p_cursor_new_y_pos)
 	{
 		// p_cursor_new_x_pos and p_cursor_new_y_pos represent the position, in screen coordinates,
 		// relative to the upper-left corner of the content area of the window.
+		if (m_replaying)
+			return;
 
-		glm::vec2 old_cursor_pos = m_cursor_position;
-		m_cursor_position = {static_cast<float>(p_cursor_new_x_pos), static_cast<float>(p_cursor_new_y_pos)};
-		// reversed y-coordinates to stay relative to top-left
-		m_cursor_delta = {m_cursor_position.x - old_cursor_pos.x, old_cursor_pos.y - m_cursor_position.y};
-
-		m_mouse_move_event.dispatch(glm::vec2{m_cursor_delta});
+		apply(CursorMoveEvent{{static_cast<float>(p_cursor_new_x_pos), static_cast<float>(p_cursor_new_y_pos)}});
 	}
 	void Input::glfw_mouse_scroll(double p_x_offset, double p_y_offset)
 	{
-		m_mouse_scroll_event.dispatch(glm::vec2{static_cast<float>(p_x_offset), static_cast<float>(p_y_offset)});
+		if (m_replaying)
+			return;
+
+		apply(ScrollEvent{{static_cast<float>(p_x_offset), static_cast<float>(p_y_offset)}});
 	}
 	constexpr Key Input::glfw_to_key(int p_glfw_key)
 	{
@@ -252,4 +312,5 @@ namespace Platform
 				return Action::Unknown;
 		}
 	}
-}
\ No newline at end of file
+#endif
+}
@@ -5,6 +5,7 @@
 #include "glm/vec2.hpp"
 
 #include <array>
+#include <variant>
 
 typedef struct GLFWwindow GLFWwindow;
 
@@ -44,6 +45,14 @@ namespace Platform
 		Captured // Cursor is hidden and captured by the window.
 	};
 
+	struct KeyEvent         { Key key; Action action;                 bool operator==(const KeyEvent&) const = default; };
+	struct ModifierEvent    { Modifier modifier; Action action;       bool operator==(const ModifierEvent&) const = default; };
+	struct MouseButtonEvent { MouseButton button; Action action;      bool operator==(const MouseButtonEvent&) const = default; };
+	struct CursorMoveEvent  { glm::vec2 position;                     bool operator==(const CursorMoveEvent&) const = default; }; // The new cursor position relative to the upper left corner of the window.
+	struct ScrollEvent      { glm::vec2 offset;                       bool operator==(const ScrollEvent&) const = default; };
+	// An input event independent of the platform that produced it. Recorded and replayed by Platform::InputRecorder and InputReplay.
+	using InputEvent = std::variant<KeyEvent, ModifierEvent, MouseButtonEvent, CursorMoveEvent, ScrollEvent>;
+
 	// Maintains the state of the UI at the current frame/update cycle.
 	class Input
 	{
@@ -73,16 +82,31 @@ namespace Platform
 		static constexpr MouseButton glfw_to_mouse_button(int p_glfw_mouse_button);
 		static constexpr Action glfw_to_action(int p_glfw_action);
 
+		// InputReplay takes the place of the window as the source of events.
+		friend class InputReplay;
+		bool m_replaying; // When true events from the window are ignored and the UI state queries return the replayed state.
+		bool m_replayed_cursor_over_UI;
+		bool m_replayed_keyboard_captured_by_UI;
+
+		void on_event(const KeyEvent& p_event);
+		void on_event(const ModifierEvent& p_event);
+		void on_event(const MouseButtonEvent& p_event);
+		void on_event(const CursorMoveEvent& p_event);
+		void on_event(const ScrollEvent& p_event);
+
 	public:
 		Utility::EventDispatcher<Key, Action> m_key_event;
 		Utility::EventDispatcher<MouseButton, Action> m_mouse_button_event;
 		Utility::EventDispatcher<glm::vec2> m_mouse_move_event;
 		Utility::EventDispatcher<glm::vec2> m_mouse_scroll_event;
+		Utility::EventDispatcher<const InputEvent&> m_input_event; // Every event applied, dispatched before the state is updated by it.
 
 		Input() noexcept;
 		// Polls for events and updates the state.
 		// Cause the window and input callbacks associated with those events to be called.
 		void update();
+		// Update the state by p_event and dispatch it as if the window had received it.
+		void apply(const InputEvent& p_event);
 
 		bool is_key_down(Key p_key) const;
 		bool is_modifier_down(Modifier p_modifier) const;
@@ -0,0 +1,298 @@
+#include "InputRecording.hpp"
+
+#include "Utility/Logger.hpp"
+
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+namespace Platform
+{
+	constexpr std::string_view Log_Magic = "SPRTINPT";
+	constexpr uint16_t Log_Version       = 1;
+
+	// The high nibble of the first byte of a record.
+	enum class RecordType : uint8_t
+	{
+		Tick = 1, // Flags, physics ticks, time, [event count, events]
+		End  = 2  // Physics ticks
+	};
+	// The low nibble of the first byte of a Tick record.
+	enum RecordFlags : uint8_t
+	{
+		Cursor_Over_UI          = 1 << 0,
+		Keyboard_Captured_By_UI = 1 << 1,
+		Has_Events              = 1 << 2
+	};
+
+	static void write_u8(std::vector<uint8_t>& p_buffer, uint8_t p_value)
+	{
+		p_buffer.push_back(p_value);
+	}
+	static void write_u16(std::vector<uint8_t>& p_buffer, uint16_t p_value)
+	{
+		p_buffer.push_back(static_cast<uint8_t>(p_value));
+		p_buffer.push_back(static_cast<uint8_t>(p_value >> 8));
+	}
+	static void write_u32(std::vector<uint8_t>& p_buffer, uint32_t p_value)
+	{
+		for (int byte = 0; byte < 4; byte++)
+			p_buffer.push_back(static_cast<uint8_t>(p_value >> (byte * 8)));
+	}
+	static void write_vec2(std::vector<uint8_t>& p_buffer, const glm::vec2& p_value)
+	{
+		write_u32(p_buffer, std::bit_cast<uint32_t>(p_value.x));
+		write_u32(p_buffer, std::bit_cast<uint32_t>(p_value.y));
+	}
+	// LEB128, 7 bits per byte with the high bit set on every byte but the last.
+	static void write_varint(std::vector<uint8_t>& p_buffer, uint64_t p_value)
+	{
+		while (p_value >= 0x80)
+		{
+			p_buffer.push_back(static_cast<uint8_t>(p_value) | 0x80);
+			p_value >>= 7;
+		}
+		p_buffer.push_back(static_cast<uint8_t>(p_value));
+	}
+	constexpr size_t Min_Event_Size = 3; // Bytes written by write_event for the smallest events, a type and two u8s.
+	static void write_event(std::vector<uint8_t>& p_buffer, const InputEvent& p_event)
+	{
+		write_u8(p_buffer, static_cast<uint8_t>(p_event.index()));
+		if (auto key = std::get_if<KeyEvent>(&p_event))
+		{
+			write_u8(p_buffer, static_cast<uint8_t>(key->key));
+			write_u8(p_buffer, static_cast<uint8_t>(key->action));
+		}
+		else if (auto modifier = std::get_if<ModifierEvent>(&p_event))
+		{
+			write_u8(p_buffer, static_cast<uint8_t>(modifier->modifier));
+			write_u8(p_buffer, static_cast<uint8_t>(modifier->action));
+		}
+		else if (auto button = std::get_if<MouseButtonEvent>(&p_event))
+		{
+			write_u8(p_buffer, static_cast<uint8_t>(button->button));
+			write_u8(p_buffer, static_cast<uint8_t>(button->action));
+		}
+		else if (auto cursor_move = std::get_if<CursorMoveEvent>(&p_event))
+			write_vec2(p_buffer, cursor_move->position);
+		else
+			write_vec2(p_buffer, std::get<ScrollEvent>(p_event).offset);
+	}
+
+	// Reads the values written above from a log held in memory, throwing if the log ends part way through a value.
+	class LogReader
+	{
+	public:
+		LogReader(const std::vector<uint8_t>& p_data) : m_data{p_data}, m_position{0} {}
+
+		bool at_end() const      { return m_position == m_data.size(); }
+		size_t remaining() const { return m_data.size() - m_position; }
+		uint8_t read_u8()
+		{
+			ASSERT_THROW(m_position < m_data.size(), "[INPUT] Input log ends unexpectedly at byte {}", m_position);
+			return m_data[m_position++];
+		}
+		uint16_t read_u16()
+		{
+			const uint16_t low = read_u8();
+			return static_cast<uint16_t>(low | (read_u8() << 8));
+		}
+		uint32_t read_u32()
+		{
+			uint32_t value = 0;
+			for (int byte = 0; byte < 4; byte++)
+				value |= static_cast<uint32_t>(read_u8()) << (byte * 8);
+			return value;
+		}
+		glm::vec2 read_vec2()
+		{
+			const float x = std::bit_cast<float>(read_u32());
+			return {x, std::bit_cast<float>(read_u32())};
+		}
+		uint64_t read_varint()
+		{
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				const uint8_t byte = read_u8();
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+					return value;
+			}
+			ASSERT_THROW(false, "[INPUT] Input log varint at byte {} is longer than 64 bits", m_position);
+			return value;
+		}
+		InputEvent read_event()
+		{
+			const uint8_t type = read_u8();
+			switch (type)
+			{
+				case 0: { const auto key      = static_cast<Key>(read_u8());         return KeyEvent{key, static_cast<Action>(read_u8())}; }
+				case 1: { const auto modifier = static_cast<Modifier>(read_u8());    return ModifierEvent{modifier, static_cast<Action>(read_u8())}; }
+				case 2: { const auto button   = static_cast<MouseButton>(read_u8()); return MouseButtonEvent{button, static_cast<Action>(read_u8())}; }
+				case 3: return CursorMoveEvent{read_vec2()};
+				case 4: return ScrollEvent{read_vec2()};
+				default:
+					ASSERT_THROW(false, "[INPUT] Unknown input event type {} at byte {}", type, m_position - 1);
+					return ScrollEvent{};
+			}
+		}
+
+	private:
+		const std::vector<uint8_t>& m_data;
+		size_t m_position;
+	};
+
+	InputRecorder::InputRecorder(Input& p_input, const std::filesystem::path& p_path, const InputLogHeader& p_header)
+		: m_input{p_input}
+		, m_input_event_ID{0}
+		, m_file{p_path, std::ios::binary}
+		, m_events{}
+		, m_buffer{}
+		, m_last_physics_ticks{0}
+		, m_last_time{0}
+		, m_finished{false}
+	{
+		ASSERT_THROW(m_file.is_open(), "[INPUT] Failed to open '{}' to record input", p_path.string());
+
+		m_buffer.insert(m_buffer.end(), Log_Magic.begin(), Log_Magic.end());
+		write_u16(m_buffer, Log_Version);
+		write_u32(m_buffer, p_header.physics_ticks_per_second);
+		write_u32(m_buffer, p_header.input_ticks_per_second);
+		write_u32(m_buffer, p_header.render_ticks_per_second);
+		write_u32(m_buffer, p_header.seed);
+		write_vec2(m_buffer, p_header.cursor_position);
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+
+		m_input_event_ID = m_input.m_input_event.subscribe(this, &InputRecorder::on_input_event);
+		LOG("[INPUT] Recording input to '{}'", p_path.string());
+	}
+	InputRecorder::~InputRecorder()
+	{
+		m_input.m_input_event.unsubscribe(m_input_event_ID);
+	}
+
+	void InputRecorder::on_input_event(const InputEvent& p_event)
+	{
+		m_events.push_back(p_event);
+	}
+	void InputRecorder::end_tick(uint64_t p_physics_ticks, std::chrono::microseconds p_time)
+	{
+		ASSERT(!m_finished, "Input ticks can't be recorded after the end record");
+
+		uint8_t flags = 0;
+		if (m_input.cursor_over_UI())          flags |= Cursor_Over_UI;
+		if (m_input.keyboard_captured_by_UI()) flags |= Keyboard_Captured_By_UI;
+		if (!m_events.empty())                 flags |= Has_Events;
+
+		m_buffer.clear();
+		write_u8(m_buffer, static_cast<uint8_t>(static_cast<uint8_t>(RecordType::Tick) << 4 | flags));
+		write_varint(m_buffer, p_physics_ticks - m_last_physics_ticks);
+		write_varint(m_buffer, static_cast<uint64_t>((p_time - m_last_time).count()));
+		if (!m_events.empty())
+		{
+			write_varint(m_buffer, m_events.size());
+			for (const auto& event : m_events)
+				write_event(m_buffer, event);
+		}
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+
+		m_events.clear();
+		m_last_physics_ticks = p_physics_ticks;
+		m_last_time          = p_time;
+	}
+	void InputRecorder::finish(uint64_t p_physics_ticks)
+	{
+		if (m_finished)
+			return;
+
+		m_buffer.clear();
+		write_u8(m_buffer, static_cast<uint8_t>(static_cast<uint8_t>(RecordType::End) << 4));
+		write_varint(m_buffer, p_physics_ticks - m_last_physics_ticks);
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+		m_file.flush();
+		m_finished = true;
+	}
+
+	InputReplay::InputReplay(Input& p_input, const std::filesystem::path& p_path)
+		: m_input{p_input}
+		, m_header{}
+		, m_ticks{}
+		, m_physics_ticks{0}
+		, m_next_tick{0}
+	{
+		std::ifstream file(p_path, std::ios::binary);
+		ASSERT_THROW(file.is_open(), "[INPUT] Failed to open input log '{}'", p_path.string());
+		const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+		LogReader reader{data};
+		for (const char magic_character : Log_Magic)
+			ASSERT_THROW(reader.read_u8() == static_cast<uint8_t>(magic_character), "[INPUT] '{}' is not an input log", p_path.string());
+		const uint16_t version = reader.read_u16();
+		ASSERT_THROW(version == Log_Version, "[INPUT] Input log '{}' is version {}, only version {} is supported", p_path.string(), version, Log_Version);
+
+		m_header.physics_ticks_per_second = reader.read_u32();
+		m_header.input_ticks_per_second   = reader.read_u32();
+		m_header.render_ticks_per_second  = reader.read_u32();
+		m_header.seed                     = reader.read_u32();
+		m_header.cursor_position          = reader.read_vec2();
+
+		// A log without an end record, from a run that didn't exit cleanly, ends at its last input tick.
+		std::chrono::microseconds time{0};
+		bool ended = false;
+		while (!ended && !reader.at_end())
+		{
+			const uint8_t type_and_flags = reader.read_u8();
+			const uint8_t flags          = type_and_flags & 0x0F;
+			switch (static_cast<RecordType>(type_and_flags >> 4))
+			{
+				case RecordType::Tick:
+				{
+					auto& tick                   = m_ticks.emplace_back();
+					m_physics_ticks             += reader.read_varint();
+					time                        += std::chrono::microseconds(reader.read_varint());
+					tick.physics_ticks           = m_physics_ticks;
+					tick.time                    = time;
+					tick.cursor_over_UI          = flags & Cursor_Over_UI;
+					tick.keyboard_captured_by_UI = flags & Keyboard_Captured_By_UI;
+					if (flags & Has_Events)
+					{
+						// Bound the count by the bytes left before allocating, a corrupt count could otherwise ask for any amount of memory.
+						const uint64_t event_count = reader.read_varint();
+						ASSERT_THROW(event_count <= reader.remaining() / Min_Event_Size, "[INPUT] Input log '{}' has {} events in a tick but only {} bytes left", p_path.string(), event_count, reader.remaining());
+						tick.events.resize(static_cast<size_t>(event_count));
+						for (auto& event : tick.events)
+							event = reader.read_event();
+					}
+					break;
+				}
+				case RecordType::End:
+					m_physics_ticks += reader.read_varint();
+					ended = true;
+					break;
+				default:
+					ASSERT_THROW(false, "[INPUT] Unknown record type {} in input log '{}'", type_and_flags >> 4, p_path.string());
+			}
+		}
+
+		m_input.m_replaying       = true;
+		m_input.m_cursor_position = m_header.cursor_position;
+		LOG("[INPUT] Replaying {} input ticks over {} physics ticks from '{}'", m_ticks.size(), m_physics_ticks, p_path.string());
+	}
+	InputReplay::~InputReplay()
+	{
+		m_input.m_replaying = false;
+	}
+
+	void InputReplay::apply_next_tick()
+	{
+		ASSERT(m_next_tick < m_ticks.size(), "No input ticks left to replay");
+
+		const auto& tick                          = m_ticks[m_next_tick++];
+		m_input.m_replayed_cursor_over_UI          = tick.cursor_over_UI;
+		m_input.m_replayed_keyboard_captured_by_UI = tick.keyboard_captured_by_UI;
+		for (const auto& event : tick.events)
+			m_input.apply(event);
+	}
+} // namespace Platform
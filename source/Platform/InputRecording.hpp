@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Input.hpp"
+
+#include "Utility/EventDispatcher.hpp"
+
+#include "glm/vec2.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Platform
+{
+	// The rates and seed a recording ran with. A replay runs at the same rates and seed so its ticks do the same work.
+	struct InputLogHeader
+	{
+		uint32_t physics_ticks_per_second = 60;
+		uint32_t input_ticks_per_second   = 120;
+		uint32_t render_ticks_per_second  = 120;
+		uint32_t seed                     = 0; // Seed for Utility::random_engine.
+		glm::vec2 cursor_position         = {0.f, 0.f}; // Cursor position when the recording started.
+	};
+	// The events applied during one input tick and where the tick fell in the physics.
+	struct InputTick
+	{
+		uint64_t physics_ticks         = 0;   // Physics ticks completed before the input tick ran, the physics tick boundary it follows.
+		std::chrono::microseconds time = {};  // Time since the recording started the input tick ran at.
+		bool cursor_over_UI            = false;
+		bool keyboard_captured_by_UI   = false;
+		std::vector<InputEvent> events = {};  // In the order they were applied.
+	};
+
+	// Writes every event applied to an Input to a binary log, grouped by the input tick that applied them.
+	// Each input tick records the number of physics ticks run before it, so a replay can apply the events at the same physics tick
+	// boundary regardless of how the threads were scheduled when recording.
+	// Log layout, little-endian: the "SPRTINPT" magic, a u16 version and the InputLogHeader, followed by one record per input tick and
+	// an end record. A record starts with a byte holding its type in the high nibble and flags in the low nibble. Physics ticks and
+	// times are stored as LEB128 varints of the change since the previous record, so a tick without events takes 4 bytes.
+	class InputRecorder
+	{
+	public:
+		InputRecorder(Input& p_input, const std::filesystem::path& p_path, const InputLogHeader& p_header);
+		~InputRecorder();
+		InputRecorder(const InputRecorder& p_other)            = delete;
+		InputRecorder& operator=(const InputRecorder& p_other) = delete;
+
+		// Write the events applied since the last call as one input tick. Call after every input tick while the physics tick count can't change.
+		//@param p_physics_ticks The physics ticks completed so far.
+		//@param p_time Time since the recording started.
+		void end_tick(uint64_t p_physics_ticks, std::chrono::microseconds p_time);
+		// Write the end record. The replay runs physics ticks up to p_physics_ticks after its last input tick.
+		void finish(uint64_t p_physics_ticks);
+
+	private:
+		Input& m_input;
+		Utility::EventDispatcher<const InputEvent&>::EventFunctionID m_input_event_ID;
+		std::ofstream m_file;
+		std::vector<InputEvent> m_events; // Applied since the last end_tick.
+		std::vector<uint8_t> m_buffer;    // The encoded record, reused between ticks.
+		uint64_t m_last_physics_ticks;
+		std::chrono::microseconds m_last_time;
+		bool m_finished;
+
+		void on_input_event(const InputEvent& p_event);
+	};
+
+	// Reads a log written by InputRecorder and applies its input ticks to an Input in place of the window.
+	// While an InputReplay exists events from the window are ignored and the Input reports the recorded UI capture state.
+	// The whole log is decoded on construction so reading it doesn't add to the timings of the replay.
+	class InputReplay
+	{
+	public:
+		// Throws if p_path can't be read or isn't an input log of a supported version.
+		InputReplay(Input& p_input, const std::filesystem::path& p_path);
+		~InputReplay();
+		InputReplay(const InputReplay& p_other)            = delete;
+		InputReplay& operator=(const InputReplay& p_other) = delete;
+
+		const InputLogHeader& header() const { return m_header; }
+		// The physics ticks the recording ran.
+		uint64_t physics_ticks() const { return m_physics_ticks; }
+		size_t input_ticks() const { return m_ticks.size(); }
+
+		//@return True if the next input tick followed p_physics_ticks physics ticks (or fewer) in the recording.
+		bool tick_due(uint64_t p_physics_ticks) const { return m_next_tick < m_ticks.size() && m_ticks[m_next_tick].physics_ticks <= p_physics_ticks; }
+		// Apply the events of the next input tick. Call where the recording called Input::update, after it.
+		void apply_next_tick();
+
+	private:
+		Input& m_input;
+		InputLogHeader m_header;
+		std::vector<InputTick> m_ticks;
+		uint64_t m_physics_ticks;
+		size_t m_next_tick;
+	};
+} // namespace Platform
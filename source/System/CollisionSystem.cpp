@@ -4,16 +4,324 @@
 
 #include "Component/Collider.hpp"
 #include "Component/Mesh.hpp"
+#include "Component/RigidBody.hpp"
+#include "Component/Terrain.hpp"
 #include "Component/Transform.hpp"
 
+#include "Geometry/Capsule.hpp"
+#include "Geometry/Contact.hpp"
+#include "Geometry/Cuboid.hpp"
+#include "Geometry/Cylinder.hpp"
+#include "Geometry/Frustrum.hpp"
+#include "Geometry/Heightfield.hpp"
 #include "Geometry/Point.hpp"
+#include "Geometry/PointCloud.hpp"
 #include "Geometry/Ray.hpp"
+#include "Geometry/Sphere.hpp"
 #include "Geometry/Triangle.hpp"
 
+#include "Utility/ThreadPool.hpp"
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtx/norm.hpp"
+
+#include <algorithm>
+#include <variant>
+
 namespace System
 {
+	// Meshes without the collision shape their collider uses can only be tested by their AABB and cannot generate contacts.
+	// Primitive shapes don't need the Mesh unless they fall back to GJK, see narrow_phase.
+	static bool has_collision_shape(const Component::Collider& p_collider, const Data::Mesh& p_mesh)
+	{
+		if (p_collider.m_triangle_mesh)
+			return !p_mesh.collision_triangles.empty();
+		return p_collider.m_shape != Component::Collider::Shape::ConvexHull || !p_mesh.collision_points.empty();
+	}
+
+	// The primitive shape of a collider placed in world space. std::monostate for shapes without an analytic form.
+	using WorldShape = std::variant<std::monostate, Geometry::Sphere, Geometry::Cuboid, Geometry::Capsule, Geometry::Cylinder>;
+	static WorldShape world_shape(const Component::Collider& p_collider, const Component::Transform& p_transform)
+	{
+		if (p_collider.m_triangle_mesh)
+			return std::monostate{};
+
+		const glm::vec3 scale = glm::abs(p_transform.m_scale);
+		const glm::vec3 axis  = p_transform.m_orientation * glm::vec3(0.f, p_collider.m_half_height * scale.y, 0.f);
+		switch (p_collider.m_shape)
+		{
+			case Component::Collider::Shape::Sphere:   return Geometry::Sphere(p_transform.m_position, p_collider.m_radius * std::max({scale.x, scale.y, scale.z}));
+			case Component::Collider::Shape::Box:      return Geometry::Cuboid(p_transform.m_position, p_collider.m_half_extents * scale, p_transform.m_orientation);
+			case Component::Collider::Shape::Capsule:  return Geometry::Capsule(p_transform.m_position - axis, p_transform.m_position + axis, p_collider.m_radius * std::max(scale.x, scale.z));
+			case Component::Collider::Shape::Cylinder: return Geometry::Cylinder(p_transform.m_position - axis, p_transform.m_position + axis, p_collider.m_radius * std::max(scale.x, scale.z));
+			default: return std::monostate{};
+		}
+	}
+	// Contact between two primitive shapes using the Geometry::contact analytic tests.
+	//@param p_tested Set to whether the pair has an analytic test. If false the pair must be tested another way.
+	//@return The ContactPoint from the perspective of p_shape_1 if the shapes intersect.
+	static std::optional<ContactPoint> analytic_contact(const WorldShape& p_shape_1, const WorldShape& p_shape_2, bool& p_tested)
+	{
+		return std::visit([&p_tested](const auto& p_1, const auto& p_2) -> std::optional<ContactPoint>
+		{
+			std::optional<Geometry::Contact> contact;
+			if constexpr (requires { Geometry::contact(p_1, p_2); })
+				contact = Geometry::contact(p_1, p_2);
+			else if constexpr (requires { Geometry::contact(p_2, p_1); })
+			{
+				if (const auto swapped = Geometry::contact(p_2, p_1))
+					contact = Geometry::swap_perspective(*swapped);
+			}
+			else
+			{
+				p_tested = false;
+				return std::nullopt;
+			}
+
+			p_tested = true;
+			if (!contact.has_value())
+				return std::nullopt;
+
+			ContactPoint contact_point;
+			contact_point.position          = contact->position;
+			contact_point.normal            = contact->normal;
+			contact_point.penetration_depth = contact->penetration_depth;
+			return contact_point;
+		}, p_shape_1, p_shape_2);
+	}
+	// The AABB in the object space of p_model enclosing the world-space p_AABB.
+	static Geometry::AABB to_object_space(const Geometry::AABB& p_AABB, const glm::mat4& p_model)
+	{
+		const glm::mat4 inverse_model = glm::inverse(p_model);
+		Geometry::AABB object_AABB;
+		for (int corner = 0; corner < 8; corner++)
+		{
+			const glm::vec3 world_corner = glm::vec3(corner & 1 ? p_AABB.m_max.x : p_AABB.m_min.x, corner & 2 ? p_AABB.m_max.y : p_AABB.m_min.y, corner & 4 ? p_AABB.m_max.z : p_AABB.m_min.z);
+			const glm::vec3 object_corner = glm::vec3(inverse_model * glm::vec4(world_corner, 1.f));
+			if (corner == 0) object_AABB = Geometry::AABB(object_corner, object_corner);
+			else             object_AABB.unite(object_corner);
+		}
+		return object_AABB;
+	}
+	// The points of p_triangle for a GJK::Shape, held on the stack as a shape is made for every triangle tested.
+	static std::array<glm::vec3, 3> triangle_points(const Geometry::Triangle& p_triangle)
+	{
+		return {p_triangle.m_point_1, p_triangle.m_point_2, p_triangle.m_point_3};
+	}
+	// The same contact from the perspective of the other shape, its deepest point is the matching point on the first shape.
+	static ContactPoint swap_perspective(const ContactPoint& p_contact)
+	{
+		ContactPoint contact;
+		contact.position          = p_contact.position + (p_contact.normal * p_contact.penetration_depth);
+		contact.normal            = -p_contact.normal;
+		contact.penetration_depth = p_contact.penetration_depth;
+		return contact;
+	}
+
+	// Contact between two meshes where at least one collides using its triangles.
+	// The TriangleBVH of the triangle mesh is the midphase, only triangles in leaves overlapping the other shape are tested.
+	//@return The deepest ContactPoint from the perspective of mesh 1 if the shapes intersect.
+	static std::optional<ContactPoint> triangle_mesh_contact(const Component::Transform& p_transform_1, const Data::Mesh& p_mesh_1, bool p_triangles_1,
+	                                                         const Component::Transform& p_transform_2, const Data::Mesh& p_mesh_2, bool p_triangles_2)
+	{
+		const auto model_1 = p_transform_1.get_model();
+		const auto model_2 = p_transform_2.get_model();
+
+		if (p_triangles_1 && p_triangles_2)
+		{
+			// Both concave, compare the trees in world space and run tri-tri on the triangles of overlapping leaves.
+			// Tri-tri only finds where the surfaces cross, so the normal is picked from the faces of the crossing triangles as in SAT,
+			// the face normal that separates every crossing pair with the least displacement along it. That displacement is the depth.
+			const auto rotation_1 = glm::mat4_cast(p_transform_1.m_orientation);
+			const auto rotation_2 = glm::mat4_cast(p_transform_2.m_orientation);
+			auto to_world = [](const Geometry::Triangle& p_triangle, const glm::mat4& p_model)
+			{
+				return Geometry::Triangle(glm::vec3(p_model * glm::vec4(p_triangle.m_point_1, 1.f)), glm::vec3(p_model * glm::vec4(p_triangle.m_point_2, 1.f)), glm::vec3(p_model * glm::vec4(p_triangle.m_point_3, 1.f)));
+			};
+
+			std::vector<std::pair<Geometry::Triangle, Geometry::Triangle>> crossing_triangles; // World-space triangles of mesh 1 and mesh 2 whose surfaces cross.
+			p_mesh_1.collision_triangles.get_tree().query_pairs(p_mesh_2.collision_triangles.get_tree(),
+				[&](const Geometry::AABB& p_AABB_1, const Geometry::AABB& p_AABB_2)
+				{
+					return Geometry::intersecting(Geometry::AABB::transform(p_AABB_1, p_transform_1.m_position, rotation_1, p_transform_1.m_scale),
+					                              Geometry::AABB::transform(p_AABB_2, p_transform_2.m_position, rotation_2, p_transform_2.m_scale));
+				},
+				[&](size_t p_triangle_1, size_t p_triangle_2)
+				{
+					const auto triangle_1 = to_world(p_mesh_1.collision_triangles[p_triangle_1], model_1);
+					const auto triangle_2 = to_world(p_mesh_2.collision_triangles[p_triangle_2], model_2);
+					if (Geometry::triangle_triangle(triangle_1, triangle_2))
+						crossing_triangles.emplace_back(triangle_1, triangle_2);
+				});
+			if (crossing_triangles.empty())
+				return std::nullopt;
+
+			// Candidate normals from the perspective of mesh 1, each face of mesh 2 facing the triangle it crosses and each face of mesh 1 reversed.
+			std::vector<glm::vec3> normals;
+			auto add_normal = [&normals](const glm::vec3& p_normal)
+			{
+				if (std::none_of(normals.begin(), normals.end(), [&p_normal](const glm::vec3& p_other) { return glm::dot(p_other, p_normal) > 0.999f; }))
+					normals.push_back(p_normal);
+			};
+			for (const auto& [triangle_1, triangle_2] : crossing_triangles)
+			{
+				const glm::vec3 normal_2 = triangle_2.normal();
+				const glm::vec3 normal_1 = triangle_1.normal();
+				add_normal(glm::dot(normal_2, triangle_1.centroid() - triangle_2.centroid()) >= 0.f ? normal_2 : -normal_2);
+				add_normal(glm::dot(normal_1, triangle_2.centroid() - triangle_1.centroid()) >= 0.f ? -normal_1 : normal_1);
+			}
+
+			// Moving mesh 1 along a normal separates a crossing pair once the deepest vertex of triangle 1 clears the highest vertex of triangle 2.
+			std::optional<ContactPoint> contact;
+			for (const auto& normal : normals)
+			{
+				ContactPoint candidate;
+				candidate.normal            = normal;
+				candidate.penetration_depth = std::numeric_limits<float>::lowest();
+				for (const auto& [triangle_1, triangle_2] : crossing_triangles)
+				{
+					const std::array<glm::vec3, 3> points_1 = {triangle_1.m_point_1, triangle_1.m_point_2, triangle_1.m_point_3};
+					const auto deepest = *std::min_element(points_1.begin(), points_1.end(), [&normal](const glm::vec3& p_a, const glm::vec3& p_b) { return glm::dot(p_a, normal) < glm::dot(p_b, normal); });
+					const float depth  = std::max({glm::dot(triangle_2.m_point_1, normal), glm::dot(triangle_2.m_point_2, normal), glm::dot(triangle_2.m_point_3, normal)}) - glm::dot(deepest, normal);
+					if (depth > candidate.penetration_depth)
+					{
+						candidate.position          = deepest;
+						candidate.penetration_depth = depth;
+					}
+				}
+
+				if (!contact.has_value() || candidate.penetration_depth < contact->penetration_depth)
+					contact = candidate;
+			}
+			return contact;
+		}
+
+		// One convex shape against a triangle mesh. Each nearby triangle is a convex shape of its own, GJK + EPA against each keeps the deepest.
+		const bool convex_first        = !p_triangles_1;
+		const auto& convex_transform   = convex_first ? p_transform_1 : p_transform_2;
+		const auto& convex_mesh        = convex_first ? p_mesh_1 : p_mesh_2;
+		const auto& convex_model       = convex_first ? model_1 : model_2;
+		const auto& triangle_transform = convex_first ? p_transform_2 : p_transform_1;
+		const auto& triangle_mesh      = convex_first ? p_mesh_2 : p_mesh_1;
+		const auto& triangle_model     = convex_first ? model_2 : model_1;
+
+		const auto convex_shape = GJK::Shape(convex_mesh.collision_points, convex_model, convex_transform.m_orientation);
+		const auto convex_AABB  = to_object_space(Geometry::AABB::transform(convex_mesh.AABB, convex_transform.m_position, glm::mat4_cast(convex_transform.m_orientation), convex_transform.m_scale), triangle_model);
+
+		std::optional<ContactPoint> deepest; // From the perspective of the convex shape.
+		triangle_mesh.collision_triangles.get_tree().query([&convex_AABB](const Geometry::AABB& p_AABB) { return Geometry::intersecting(convex_AABB, p_AABB); }, [&](size_t p_triangle)
+		{
+			const auto points         = triangle_points(triangle_mesh.collision_triangles[p_triangle]);
+			const auto triangle_shape = GJK::Shape(points, triangle_model, triangle_transform.m_orientation);
+
+			GJK::Simplex simplex;
+			if (!GJK::intersecting(convex_shape, triangle_shape, simplex))
+				return;
+
+			const auto collision = GJK::EPA(simplex, convex_shape, triangle_shape);
+			if (deepest.has_value() && collision.penetration_depth <= deepest->penetration_depth)
+				return;
+
+			ContactPoint contact;
+			contact.normal            = -collision.normal;
+			contact.position          = convex_shape.world_space_support_point(collision.normal);
+			contact.penetration_depth = collision.penetration_depth;
+			deepest = contact;
+		});
+
+		if (!deepest.has_value() || convex_first)
+			return deepest;
+
+		return swap_perspective(*deepest);
+	}
+
+	constexpr float Heightfield_Prism_Depth = 1.f; // Extrusion (m) of heightfield triangles below the lowest point of the heightfield, see heightfield_prism_points.
+
+	// Terrain has no Transform, its heightfield is only offset by the terrain position.
+	static glm::mat4 terrain_model(const Component::Terrain& p_terrain)
+	{
+		return glm::translate(glm::identity<glm::mat4>(), p_terrain.m_position);
+	}
+	// World-space bounds of the solid part of p_terrain, including the extrusion below the heightfield.
+	static Geometry::AABB terrain_AABB(const Component::Terrain& p_terrain)
+	{
+		const auto bounds = p_terrain.m_heightfield.get_AABB();
+		return Geometry::AABB(bounds.m_min + p_terrain.m_position - glm::vec3(0.f, Heightfield_Prism_Depth, 0.f), bounds.m_max + p_terrain.m_position);
+	}
+	// A heightfield triangle extruded down below the lowest point of the heightfield.
+	// A lone triangle has no inside, a shape sunk more than halfway through it would be pushed out of the bottom. The prism is solid
+	// below the surface so EPA always finds the shallowest way out through the top.
+	static std::array<glm::vec3, 6> heightfield_prism_points(const Geometry::Triangle& p_triangle, float p_bottom)
+	{
+		return {
+			p_triangle.m_point_1, p_triangle.m_point_2, p_triangle.m_point_3,
+			glm::vec3(p_triangle.m_point_1.x, p_bottom, p_triangle.m_point_1.z),
+			glm::vec3(p_triangle.m_point_2.x, p_bottom, p_triangle.m_point_2.z),
+			glm::vec3(p_triangle.m_point_3.x, p_bottom, p_triangle.m_point_3.z)};
+	}
+	// Call p_on_prism for the prism of every heightfield triangle under the world-space p_AABB, see heightfield_prism_points.
+	// p_on_prism is called as p_on_prism(std::span<const glm::vec3> p_prism).
+	template <typename Func>
+	static void query_heightfield_prisms(const Component::Terrain& p_terrain, const Geometry::AABB& p_AABB, const Func& p_on_prism)
+	{
+		const auto bounds     = p_terrain.m_heightfield.get_AABB();
+		const float bottom    = bounds.m_min.y - Heightfield_Prism_Depth;
+		const auto local_AABB = Geometry::AABB(p_AABB.m_min - p_terrain.m_position, p_AABB.m_max - p_terrain.m_position);
+		if (local_AABB.m_max.y < bottom)
+			return;
+
+		// Shapes sunk below the surface are still inside the prisms. Raising the top of the query keeps their cells from being culled,
+		// only cells wholly below the shape are skipped.
+		const auto query_AABB = Geometry::AABB(local_AABB.m_min, glm::vec3(local_AABB.m_max.x, std::max(local_AABB.m_max.y, bounds.m_max.y), local_AABB.m_max.z));
+		p_terrain.m_heightfield.query(query_AABB, [&](const Geometry::Triangle& p_triangle)
+		{
+			const auto prism = heightfield_prism_points(p_triangle, bottom);
+			p_on_prism(prism);
+		});
+	}
+
+	// Contact between a convex mesh and a terrain heightfield. The cells under the mesh are found in O(1) from its AABB,
+	// GJK + EPA against the prism of each of their triangles keeps the deepest.
+	//@return The deepest ContactPoint from the perspective of the mesh if it intersects the terrain.
+	static std::optional<ContactPoint> heightfield_contact(const Component::Transform& p_transform, const Data::Mesh& p_mesh, const Geometry::AABB& p_world_AABB, const Component::Terrain& p_terrain)
+	{
+		const auto convex_shape = GJK::Shape(p_mesh.collision_points, p_transform.get_model(), p_transform.m_orientation);
+		const auto model        = terrain_model(p_terrain);
+		const auto orientation  = glm::identity<glm::quat>();
+
+		std::optional<ContactPoint> deepest;
+		query_heightfield_prisms(p_terrain, p_world_AABB, [&](std::span<const glm::vec3> p_prism)
+		{
+			const auto prism_shape = GJK::Shape(p_prism, model, orientation);
+
+			GJK::Simplex simplex;
+			if (!GJK::intersecting(convex_shape, prism_shape, simplex))
+				return;
+
+			const auto collision = GJK::EPA(simplex, convex_shape, prism_shape);
+			if (deepest.has_value() && collision.penetration_depth <= deepest->penetration_depth)
+				return;
+
+			ContactPoint contact;
+			contact.normal            = -collision.normal;
+			contact.position          = convex_shape.world_space_support_point(collision.normal);
+			contact.penetration_depth = collision.penetration_depth;
+			deepest = contact;
+		});
+		return deepest;
+	}
+
 	CollisionSystem::CollisionSystem(SceneSystem& p_scene_system) noexcept
 		: m_scene_system{p_scene_system}
+		, m_pairs{}
+		, m_manifolds{}
+		, m_manifold_update{0}
+		, m_contact_events{}
+		, m_broad_phase{}
+		, m_world_AABBs{}
+		, m_broad_phase_entities{}
+		, m_broad_phase_AABBs{}
+		, m_contact_event{}
 	{}
 
 	void CollisionSystem::update()
@@ -23,43 +331,661 @@ namespace System
 			p_collider.m_collided = false;
 		});
 
-		m_scene_system.get_current_scene_entities().foreach([&](Component::Transform& transform, Component::Collider& collider, Component::Mesh& mesh)
+		// Transform every collider's AABB in one batch. This is the only place m_world_AABB is refreshed each tick, the batch output
+		// builds the broad phase tree that update_manifolds pairs colliders from, and the queries and scene bounds reuse it until the next update().
+		m_broad_phase_entities.clear();
+		m_world_AABBs.clear();
+		m_scene_system.get_current_scene_entities().foreach([&](const ECS::Entity& p_entity, Component::Transform& transform, Component::Collider&, Component::Mesh& mesh)
+		{
+			m_world_AABBs.add(mesh.m_mesh->AABB, transform.m_position, transform.m_orientation, transform.m_scale);
+			m_broad_phase_entities.push_back(p_entity.ID);
+		});
+		m_world_AABBs.transform();
+
+		m_broad_phase_AABBs.clear();
+		m_scene_system.get_current_scene_entities().foreach([&](Component::Transform&, Component::Collider& collider, Component::Mesh&)
+		{
+			// Same components as the foreach above so the entities are visited in the same order.
+			collider.m_world_AABB = m_world_AABBs[m_broad_phase_AABBs.size()];
+			m_broad_phase_AABBs.push_back(collider.m_world_AABB);
+		});
+		m_broad_phase.build(m_broad_phase_AABBs);
+
+		// Run the narrow phase every tick whether or not the PhysicsSystem responds, the contact events are driven by these manifolds.
+		update_manifolds();
+
+		// Invalidate the cached state of pairs that have left the broad phase (including pairs with a removed entity, Collider or Terrain).
+		auto& scene = m_scene_system.get_current_scene_entities();
+		auto world_AABB = [&scene](EntityID p_entity) -> std::optional<Geometry::AABB>
+		{
+			if (scene.has_components<Component::Collider>(p_entity))
+				return scene.get_component<Component::Collider>(p_entity).m_world_AABB;
+			if (scene.has_components<Component::Terrain>(p_entity))
+				return terrain_AABB(scene.get_component<Component::Terrain>(p_entity));
+			return std::nullopt;
+		};
+		m_contact_events.clear();
+		m_pairs.erase_if([&](const auto& p_entities, const PairState& p_pair)
+		{
+			const auto AABB_1 = world_AABB(p_entities.first);
+			const auto AABB_2 = world_AABB(p_entities.second);
+			const bool erase  = !AABB_1.has_value() || !AABB_2.has_value() || !Geometry::intersecting(*AABB_1, *AABB_2);
+			if (erase && p_pair.touching)
+				m_contact_events.push_back({ContactEventType::End, p_entities.first, p_entities.second, nullptr});
+			return erase;
+		});
+
+		// Collect the manifolds in contact once every pair is inserted and erased, both move the entries of m_pairs.
+		// Only manifolds refreshed by update_manifolds above are current, the rest are left over from pairs it no longer tests.
+		m_manifolds.clear();
+		m_pairs.for_each([&](const auto& p_entities, PairState& p_pair)
+		{
+			const bool touching = p_pair.manifold_update == m_manifold_update && p_pair.manifold.point_count > 0;
+			if (touching)
+			{
+				m_manifolds.push_back(&p_pair.manifold);
+				m_contact_events.push_back({p_pair.touching ? ContactEventType::Persist : ContactEventType::Begin, p_entities.first, p_entities.second, &p_pair.manifold});
+				for (const EntityID entity : {p_entities.first, p_entities.second})
+				{
+					if (scene.has_components<Component::Collider>(entity))
+						scene.get_component<Component::Collider>(entity).m_collided = true;
+				}
+			}
+			else if (p_pair.touching)
+				m_contact_events.push_back({ContactEventType::End, p_entities.first, p_entities.second, nullptr});
+
+			p_pair.touching = touching;
+		});
+
+		// Dispatch once the cache is settled so handlers see a consistent state.
+		for (const auto& event : m_contact_events)
+			m_contact_event.dispatch(event);
+	}
+
+	// Update p_manifold with the contact found between its entities this tick.
+	//@param p_contact The contact from the perspective of entity_1 or nullopt if the entities are no longer touching.
+	static void add_contact(ContactManifold& p_manifold, const std::optional<ContactPoint>& p_contact, const glm::mat4& p_model_1, const glm::mat4& p_model_2)
+	{
+		if (!p_contact.has_value())
+		{
+			p_manifold.point_count = 0;
+			return;
+		}
+
+		// Points found under a different normal belong to a different feature pair, their impulses no longer apply.
+		if (p_manifold.point_count > 0 && glm::dot(p_manifold.normal, p_contact->normal) < 0.95f)
+			p_manifold.point_count = 0;
+
+		p_manifold.normal = p_contact->normal;
+		p_manifold.refresh(p_model_1, p_model_2);
+
+		const glm::vec3 point_on_2 = p_contact->position + (p_contact->normal * p_contact->penetration_depth);
+		ManifoldPoint point;
+		point.local_point_1     = glm::vec3(glm::inverse(p_model_1) * glm::vec4(p_contact->position, 1.f));
+		point.local_point_2     = glm::vec3(glm::inverse(p_model_2) * glm::vec4(point_on_2, 1.f));
+		point.position          = (p_contact->position + point_on_2) * 0.5f;
+		point.penetration_depth = p_contact->penetration_depth;
+		p_manifold.add_point(point);
+	}
+
+	void CollisionSystem::update_manifolds()
+	{
+		struct ColliderProxy
+		{
+			ECS::Entity entity;
+			const Component::Transform* transform;
+			const Data::Mesh* mesh;
+			const Component::Collider* collider;
+			const Geometry::AABB* world_AABB;
+			bool awake; // Has a RigidBody that is not asleep or of infinite mass. A pair with neither side awake cannot need a response.
+		};
+		constexpr size_t No_Proxy = std::numeric_limits<size_t>::max();
+		std::vector<ColliderProxy> proxies;
+		std::vector<size_t> item_proxies(m_broad_phase_entities.size(), No_Proxy); // Index into proxies of each broad phase item.
+
+		auto& scene = m_scene_system.get_current_scene_entities();
+		// Positions are integrated after the manifolds are updated, so the broad phase built by the last update() is still current.
+		// Entities that lost a component since then are skipped, entities that gained one are tested from the next update().
+		for (size_t item = 0; item < m_broad_phase_entities.size(); item++)
+		{
+			const ECS::Entity entity{m_broad_phase_entities[item]};
+			if (!scene.has_components<Component::Transform, Component::Collider, Component::Mesh>(entity))
+				continue;
+
+			const auto& collider = scene.get_component<Component::Collider>(entity);
+			const auto& mesh     = *scene.get_component<Component::Mesh>(entity).m_mesh;
+			if (!has_collision_shape(collider, mesh))
+				continue;
+
+			bool awake = false;
+			if (scene.has_components<Component::RigidBody>(entity))
+			{
+				const auto& rigid_body = scene.get_component<Component::RigidBody>(entity);
+				awake = !rigid_body.m_asleep && !rigid_body.has_infinite_mass();
+			}
+			item_proxies[item] = proxies.size();
+			proxies.push_back({entity, &scene.get_component<Component::Transform>(entity), &mesh, &collider, &m_broad_phase_AABBs[item], awake});
+		}
+
+		// The broad phase tree finds the pairs with overlapping AABBs. Sorting them on (lower, higher) EntityID matches the m_pairs key
+		// and keeps the narrow phase, and so the order of m_pairs, warm starting and the contact events, independent of the tree layout.
+		std::vector<std::pair<size_t, size_t>> candidates; // Indices into proxies, ordered (lower, higher) EntityID.
+		m_broad_phase.query_pairs([&](size_t p_item, size_t p_other_item)
+		{
+			const size_t proxy_1 = item_proxies[p_item];
+			const size_t proxy_2 = item_proxies[p_other_item];
+			if (proxy_1 == No_Proxy || proxy_2 == No_Proxy)
+				return;
+
+			if (proxies[proxy_1].entity.ID < proxies[proxy_2].entity.ID)
+				candidates.push_back({proxy_1, proxy_2});
+			else
+				candidates.push_back({proxy_2, proxy_1});
+		});
+		std::sort(candidates.begin(), candidates.end(), [&proxies](const auto& p_lhs, const auto& p_rhs)
+		{
+			return std::make_pair(proxies[p_lhs.first].entity.ID, proxies[p_lhs.second].entity.ID) < std::make_pair(proxies[p_rhs.first].entity.ID, proxies[p_rhs.second].entity.ID);
+		});
+
+		m_manifold_update++;
+		for (const auto& [index_1, index_2] : candidates)
+		{
+			const auto& proxy_1 = proxies[index_1];
+			const auto& proxy_2 = proxies[index_2];
+			if (!proxy_1.awake && !proxy_2.awake)
+			{
+				// Sleeping (or static) pairs keep their manifold as-is. It's still reported so islands stay connected through it.
+				if (auto* pair = m_pairs.find({proxy_1.entity.ID, proxy_2.entity.ID}))
+					pair->manifold_update = m_manifold_update;
+				continue;
+			}
+
+			const auto contact = narrow_phase(proxy_1.entity, *proxy_1.transform, *proxy_1.mesh, *proxy_1.collider, proxy_2.entity, *proxy_2.transform, *proxy_2.mesh, *proxy_2.collider);
+
+			auto& pair             = m_pairs[{proxy_1.entity.ID, proxy_2.entity.ID}];
+			pair.manifold.entity_1 = proxy_1.entity.ID;
+			pair.manifold.entity_2 = proxy_2.entity.ID;
+			pair.manifold_update   = m_manifold_update;
+			add_contact(pair.manifold, contact, proxy_1.transform->get_model(), proxy_2.transform->get_model());
+		}
+
+		// Terrain is static and collides as a heightfield against the convex colliders over it, found by querying the broad phase with its bounds.
+		std::vector<size_t> terrain_proxies;
+		scene.foreach([&](const ECS::Entity& p_terrain_entity, Component::Terrain& p_terrain)
+		{
+			if (p_terrain.m_heightfield.empty())
+				return;
+
+			const auto bounds = terrain_AABB(p_terrain);
+			const auto model  = terrain_model(p_terrain);
+			terrain_proxies.clear();
+			m_broad_phase.query([&bounds](const Geometry::AABB& p_AABB) { return Geometry::intersecting(bounds, p_AABB); }, [&](size_t p_item)
+			{
+				if (item_proxies[p_item] != No_Proxy)
+					terrain_proxies.push_back(item_proxies[p_item]);
+			});
+			std::sort(terrain_proxies.begin(), terrain_proxies.end());
+
+			for (const size_t proxy_index : terrain_proxies)
+			{
+				const auto& proxy = proxies[proxy_index];
+				if (proxy.collider->m_triangle_mesh || proxy.mesh->collision_points.empty())
+					continue;
+
+				const bool terrain_first = p_terrain_entity.ID < proxy.entity.ID;
+				const auto key           = terrain_first ? std::make_pair(p_terrain_entity.ID, proxy.entity.ID) : std::make_pair(proxy.entity.ID, p_terrain_entity.ID);
+				if (!proxy.awake)
+				{
+					if (auto* pair = m_pairs.find(key))
+						pair->manifold_update = m_manifold_update;
+					continue;
+				}
+
+				auto contact = heightfield_contact(*proxy.transform, *proxy.mesh, *proxy.world_AABB, p_terrain);
+				if (contact.has_value() && terrain_first)
+					contact = swap_perspective(*contact);
+
+				auto& pair             = m_pairs[key];
+				pair.manifold.entity_1 = key.first;
+				pair.manifold.entity_2 = key.second;
+				pair.manifold_update   = m_manifold_update;
+				const auto proxy_model = proxy.transform->get_model();
+				add_contact(pair.manifold, contact, terrain_first ? model : proxy_model, terrain_first ? proxy_model : model);
+			}
+		});
+	}
+
+	void ContactManifold::refresh(const glm::mat4& p_model_1, const glm::mat4& p_model_2)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < point_count; i++)
+		{
+			auto& point = points[i];
+			const glm::vec3 world_1 = glm::vec3(p_model_1 * glm::vec4(point.local_point_1, 1.f));
+			const glm::vec3 world_2 = glm::vec3(p_model_2 * glm::vec4(point.local_point_2, 1.f));
+
+			// normal points from body 2 to body 1, while penetrating the point on body 2 lies further along the normal than the point on body 1.
+			point.penetration_depth = glm::dot(world_2 - world_1, normal);
+			point.position          = (world_1 + world_2) * 0.5f;
+
+			const glm::vec3 tangential_drift = (world_2 - world_1) - (normal * point.penetration_depth);
+			if (point.penetration_depth < -Breaking_Threshold || glm::length2(tangential_drift) > Breaking_Threshold * Breaking_Threshold)
+				continue;
+
+			points[kept++] = point;
+		}
+		point_count = kept;
+	}
+
+	void ContactManifold::add_point(const ManifoldPoint& p_point)
+	{
+		// A point close to an existing one is the same contact, replace it and keep the accumulated impulses for warm starting.
+		for (size_t i = 0; i < point_count; i++)
+		{
+			if (glm::length2(points[i].position - p_point.position) < Breaking_Threshold * Breaking_Threshold)
+			{
+				points[i].local_point_1     = p_point.local_point_1;
+				points[i].local_point_2     = p_point.local_point_2;
+				points[i].position          = p_point.position;
+				points[i].penetration_depth = p_point.penetration_depth;
+				return;
+			}
+		}
+
+		if (point_count < Max_Points)
+		{
+			points[point_count++] = p_point;
+			return;
+		}
+
+		// Full manifold, replace the point whose removal leaves the largest contact area. The deepest point is always kept.
+		size_t deepest = 0;
+		for (size_t i = 1; i < Max_Points; i++)
+		{
+			if (points[i].penetration_depth > points[deepest].penetration_depth)
+				deepest = i;
+		}
+		if (p_point.penetration_depth > points[deepest].penetration_depth)
+			deepest = Max_Points; // The new point is the deepest, any existing point can be replaced.
+
+		size_t replace  = Max_Points;
+		float best_area = -1.f;
+		for (size_t i = 0; i < Max_Points; i++)
+		{
+			if (i == deepest)
+				continue;
+
+			std::array<glm::vec3, Max_Points> quad;
+			for (size_t j = 0; j < Max_Points; j++)
+				quad[j] = j == i ? p_point.position : points[j].position;
+
+			// The largest cross product of the quad diagonals approximates twice its area without knowing the winding order.
+			const float area = std::max({glm::length2(glm::cross(quad[0] - quad[1], quad[2] - quad[3])),
+			                             glm::length2(glm::cross(quad[0] - quad[2], quad[1] - quad[3])),
+			                             glm::length2(glm::cross(quad[0] - quad[3], quad[1] - quad[2]))});
+			if (area > best_area)
+			{
+				best_area = area;
+				replace   = i;
+			}
+		}
+
+		points[replace] = p_point;
+	}
+
+	std::optional<ContactPoint> CollisionSystem::get_collision(const ECS::Entity& p_entity, ECS::Entity* p_collided_entity)
+	{
+		auto& scene = m_scene_system.get_current_scene_entities();
+		if (!scene.has_components<Component::Collider, Component::Mesh, Component::Transform>(p_entity))
+			return std::nullopt;
+
+		auto& collider  = scene.get_component<Component::Collider>(p_entity);
+		auto& mesh      = scene.get_component<Component::Mesh>(p_entity);
+		auto& transform = scene.get_component<Component::Transform>(p_entity);
+
+		const auto rotation_matrix = glm::mat4_cast(transform.m_orientation);
+		collider.m_world_AABB      = Geometry::AABB::transform(mesh.m_mesh->AABB, transform.m_position, rotation_matrix, transform.m_scale);
+		collider.m_collided        = false;
+
+		std::optional<ContactPoint> contact;
+		scene.foreach([&](const ECS::Entity& p_entity_other, Component::Transform& p_transform_other, Component::Mesh& p_mesh_other, Component::Collider& p_collider_other)
+		{
+			if (contact.has_value() || &collider == &p_collider_other)
+				return;
+
+			// The other colliders' m_world_AABB were refreshed by update(), only p_entity may have moved since.
+			if (!Geometry::intersecting(collider.m_world_AABB, p_collider_other.m_world_AABB)) // Broad phase AABB check
+				return;
+
+			// Meshes without a collision shape can only be tested by their AABB.
+			if (!has_collision_shape(collider, *mesh.m_mesh) || !has_collision_shape(p_collider_other, *p_mesh_other.m_mesh))
+			{
+				collider.m_collided = true;
+				if (p_collided_entity)
+					*p_collided_entity = p_entity_other;
+				return;
+			}
+
+			contact = narrow_phase(p_entity, transform, *mesh.m_mesh, collider, p_entity_other, p_transform_other, *p_mesh_other.m_mesh, p_collider_other);
+			if (contact.has_value())
+			{
+				collider.m_collided         = true;
+				p_collider_other.m_collided = true;
+				if (p_collided_entity)
+					*p_collided_entity = p_entity_other;
+			}
+		});
+
+		return contact;
+	}
+
+	// Conservative advancement of a convex shape along p_displacement against the static p_other.
+	// The separation along the current normal shrinks no faster than the displacement closes it,
+	// so advancing by distance / closing speed can never step past the first contact.
+	//@param p_max_fraction Stop once the shape can no longer reach p_other before this fraction of p_displacement.
+	//@return The fraction and normal of the first contact, fraction 0 with a 0 normal if the shapes intersect before moving.
+	static std::optional<TimeOfImpact> conservative_advancement(const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation,
+	                                                            const glm::vec3& p_displacement, const GJK::Shape& p_other, float p_max_fraction)
+	{
+		constexpr int Max_Iterations = 32;
+		constexpr float Tolerance    = CollisionSystem::Time_Of_Impact_Tolerance;
+
+		float fraction = 0.f;
+		for (int iteration = 0; iteration < Max_Iterations; iteration++)
+		{
+			const auto shape      = GJK::Shape(p_points, glm::translate(glm::identity<glm::mat4>(), p_displacement * fraction) * p_transform, p_orientation);
+			const auto separation = GJK::distance(shape, p_other);
+			if (!separation.has_value()) // Touching or intersecting.
+				return TimeOfImpact{fraction, fraction == 0.f ? glm::vec3(0.f) : glm::normalize(p_displacement), 0};
+			if (separation->distance < Tolerance)
+				return TimeOfImpact{fraction, separation->normal, 0};
+
+			const float closing = glm::dot(p_displacement, separation->normal);
+			if (closing <= 0.f)
+				return std::nullopt; // Moving apart along the separating normal, the shapes can't meet.
+
+			// Aim to stop half the tolerance short of touching so the shape is left just separated at the impact.
+			fraction += (separation->distance - (Tolerance * 0.5f)) / closing;
+			if (fraction > p_max_fraction)
+				return std::nullopt;
+		}
+		return std::nullopt;
+	}
+
+	// Conservative advancement against the prism of every heightfield triangle of p_terrain under p_swept_AABB, the earliest impact bounds the rest.
+	static std::optional<TimeOfImpact> sweep_against_terrain(const Component::Terrain& p_terrain, const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation,
+	                                                         const glm::vec3& p_displacement, const Geometry::AABB& p_swept_AABB, float p_max_fraction)
+	{
+		if (p_terrain.m_heightfield.empty() || !Geometry::intersecting(p_swept_AABB, terrain_AABB(p_terrain)))
+			return std::nullopt;
+
+		const auto model       = terrain_model(p_terrain);
+		const auto orientation = glm::identity<glm::quat>();
+		std::optional<TimeOfImpact> first_impact;
+		query_heightfield_prisms(p_terrain, p_swept_AABB, [&](std::span<const glm::vec3> p_prism)
+		{
+			const auto shape  = GJK::Shape(p_prism, model, orientation);
+			const auto impact = conservative_advancement(p_points, p_transform, p_orientation, p_displacement, shape, first_impact.has_value() ? first_impact->fraction : p_max_fraction);
+			if (impact.has_value() && (!first_impact.has_value() || impact->fraction < first_impact->fraction))
+				first_impact = impact;
+		});
+		return first_impact;
+	}
+
+	std::optional<TimeOfImpact> CollisionSystem::sweep_against(EntityID p_other, const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation,
+	                                                           const glm::vec3& p_displacement, const Geometry::AABB& p_swept_AABB, float p_max_fraction) const
+	{
+		auto& scene = m_scene_system.get_current_scene_entities();
+		if (!scene.has_components<Component::Collider, Component::Mesh, Component::Transform>(p_other))
+			return std::nullopt;
+
+		const auto& collider  = scene.get_component<Component::Collider>(p_other);
+		const auto& mesh      = *scene.get_component<Component::Mesh>(p_other).m_mesh;
+		const auto& transform = scene.get_component<Component::Transform>(p_other);
+		if (!has_collision_shape(collider, mesh))
+			return std::nullopt;
+
+		const auto model = transform.get_model();
+		if (!collider.m_triangle_mesh)
+		{
+			const auto shape = GJK::Shape(mesh.collision_points, model, transform.m_orientation);
+			return conservative_advancement(p_points, p_transform, p_orientation, p_displacement, shape, p_max_fraction);
+		}
+
+		// Advance against each triangle under the swept AABB, the earliest impact bounds the rest.
+		std::optional<TimeOfImpact> first_impact;
+		const auto object_swept_AABB = to_object_space(p_swept_AABB, model);
+		mesh.collision_triangles.get_tree().query([&object_swept_AABB](const Geometry::AABB& p_AABB) { return Geometry::intersecting(object_swept_AABB, p_AABB); }, [&](size_t p_triangle)
 		{
-			collider.m_world_AABB = Geometry::AABB::transform(mesh.m_mesh->AABB, transform.m_position, glm::mat4_cast(transform.m_orientation), transform.m_scale);
+			const auto points = triangle_points(mesh.collision_triangles[p_triangle]);
+			const auto shape  = GJK::Shape(points, model, transform.m_orientation);
+			const auto impact = conservative_advancement(p_points, p_transform, p_orientation, p_displacement, shape, first_impact.has_value() ? first_impact->fraction : p_max_fraction);
+			if (impact.has_value() && (!first_impact.has_value() || impact->fraction < first_impact->fraction))
+				first_impact = impact;
 		});
+		return first_impact;
 	}
 
-	std::optional<ContactPoint> CollisionSystem::get_collision(const ECS::Entity& p_entity, const ECS::Entity* p_collided_entity) const
+	std::optional<TimeOfImpact> CollisionSystem::time_of_impact(const ECS::Entity& p_entity, const glm::vec3& p_displacement)
 	{
 		auto& scene = m_scene_system.get_current_scene_entities();
-		if (scene.has_components<Component::Collider, Component::Mesh, Component::Transform>(p_entity))
+		if (!scene.has_components<Component::Collider, Component::Mesh, Component::Transform>(p_entity))
+			return std::nullopt;
+
+		const auto& mesh      = *scene.get_component<Component::Mesh>(p_entity).m_mesh;
+		const auto& transform = scene.get_component<Component::Transform>(p_entity);
+		if (mesh.collision_points.empty() || glm::length2(p_displacement) == 0.f)
+			return std::nullopt;
+
+		// Broad phase against the AABB enclosing the start and end of the sweep.
+		// Entities are swept before they move, so the m_world_AABB refreshed by the last update() is the start of the sweep.
+		auto swept_AABB = scene.get_component<Component::Collider>(p_entity).m_world_AABB;
+		swept_AABB.unite(Geometry::AABB(swept_AABB.m_min + p_displacement, swept_AABB.m_max + p_displacement));
+
+		const auto model = transform.get_model();
+		std::optional<TimeOfImpact> first_impact;
+		m_broad_phase.query([&swept_AABB](const Geometry::AABB& p_AABB) { return Geometry::intersecting(swept_AABB, p_AABB); }, [&](size_t p_item)
 		{
-			auto& collider  = scene.get_component<Component::Collider>(p_entity);
-			auto& mesh      = scene.get_component<Component::Mesh>(p_entity);
-			auto& transform = scene.get_component<Component::Transform>(p_entity);
+			const EntityID other = m_broad_phase_entities[p_item];
+			if (other == p_entity.ID)
+				return;
+
+			const float max_fraction = first_impact.has_value() ? first_impact->fraction : 1.f;
+			const auto impact = sweep_against(other, mesh.collision_points, model, transform.m_orientation, p_displacement, swept_AABB, max_fraction);
+			if (!impact.has_value() || impact->normal == glm::vec3(0.f))
+				return; // No hit or intersecting before moving, the latter is left to the narrow phase.
 
-			const auto rotation_matrix = glm::mat4_cast(transform.m_orientation);
-			collider.m_world_AABB      = Geometry::AABB::transform(mesh.m_mesh->AABB, transform.m_position, rotation_matrix, transform.m_scale);
-			collider.m_collided        = false;
+			if (!first_impact.has_value() || impact->fraction < first_impact->fraction)
+				first_impact = TimeOfImpact{impact->fraction, impact->normal, other};
+		});
 
-			scene.foreach([&](const ECS::Entity& p_entity_other, Component::Transform& p_transform_other, Component::Mesh& p_mesh_other, Component::Collider& p_collider_other)
-			{(void)p_mesh_other;
-				if (&collider != &p_collider_other)
+		scene.foreach([&](const ECS::Entity& p_terrain_entity, Component::Terrain& p_terrain)
+		{
+			const float max_fraction = first_impact.has_value() ? first_impact->fraction : 1.f;
+			const auto impact = sweep_against_terrain(p_terrain, mesh.collision_points, model, transform.m_orientation, p_displacement, swept_AABB, max_fraction);
+			if (impact.has_value() && impact->normal != glm::vec3(0.f) && (!first_impact.has_value() || impact->fraction < first_impact->fraction))
+				first_impact = TimeOfImpact{impact->fraction, impact->normal, p_terrain_entity.ID};
+		});
+
+		return first_impact;
+	}
+
+	void CollisionSystem::query_broad_phase(const Geometry::AABBTree::OverlapTest& p_overlaps, std::vector<EntityID>& p_entities) const
+	{
+		p_entities.clear();
+		m_broad_phase.query(p_overlaps, [&](size_t p_item) { p_entities.push_back(m_broad_phase_entities[p_item]); });
+	}
+	void CollisionSystem::overlap(const Geometry::Sphere& p_sphere, std::vector<EntityID>& p_entities) const
+	{
+		query_broad_phase([&p_sphere](const Geometry::AABB& p_AABB) { return Geometry::intersecting(p_AABB, p_sphere); }, p_entities);
+	}
+	void CollisionSystem::overlap(const Geometry::AABB& p_AABB, std::vector<EntityID>& p_entities) const
+	{
+		query_broad_phase([&p_AABB](const Geometry::AABB& p_node_AABB) { return Geometry::intersecting(p_AABB, p_node_AABB); }, p_entities);
+	}
+	void CollisionSystem::overlap(const Geometry::Frustrum& p_frustrum, std::vector<EntityID>& p_entities) const
+	{
+		query_broad_phase([&p_frustrum](const Geometry::AABB& p_AABB) { return Geometry::intersecting(p_frustrum, p_AABB); }, p_entities);
+	}
+
+	void CollisionSystem::shape_cast(const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation, const glm::vec3& p_displacement, std::vector<TimeOfImpact>& p_hits) const
+	{
+		p_hits.clear();
+		if (p_points.empty())
+			return;
+
+		Geometry::AABB swept_AABB;
+		for (size_t i = 0; i < p_points.size(); i++)
+		{
+			const glm::vec3 point = glm::vec3(p_transform * glm::vec4(p_points[i], 1.f));
+			if (i == 0) swept_AABB = Geometry::AABB(point, point);
+			else        swept_AABB.unite(point);
+		}
+		swept_AABB.unite(Geometry::AABB(swept_AABB.m_min + p_displacement, swept_AABB.m_max + p_displacement));
+
+		m_broad_phase.query([&swept_AABB](const Geometry::AABB& p_AABB) { return Geometry::intersecting(swept_AABB, p_AABB); }, [&](size_t p_item)
+		{
+			const EntityID other = m_broad_phase_entities[p_item];
+			if (auto impact = sweep_against(other, p_points, p_transform, p_orientation, p_displacement, swept_AABB, 1.f))
+			{
+				if (impact->normal == glm::vec3(0.f))
+					impact->normal = glm::length2(p_displacement) > 0.f ? glm::normalize(p_displacement) : glm::vec3(0.f);
+				impact->other = other;
+				p_hits.push_back(*impact);
+			}
+		});
+		m_scene_system.get_current_scene_entities().foreach([&](const ECS::Entity& p_terrain_entity, Component::Terrain& p_terrain)
+		{
+			if (auto impact = sweep_against_terrain(p_terrain, p_points, p_transform, p_orientation, p_displacement, swept_AABB, 1.f))
+			{
+				if (impact->normal == glm::vec3(0.f))
+					impact->normal = glm::length2(p_displacement) > 0.f ? glm::normalize(p_displacement) : glm::vec3(0.f);
+				impact->other = p_terrain_entity.ID;
+				p_hits.push_back(*impact);
+			}
+		});
+
+		std::sort(p_hits.begin(), p_hits.end(), [](const TimeOfImpact& p_lhs, const TimeOfImpact& p_rhs) { return p_lhs.fraction < p_rhs.fraction; });
+	}
+
+	std::optional<ContactPoint> CollisionSystem::narrow_phase(const ECS::Entity& p_entity_1, const Component::Transform& p_transform_1, const Data::Mesh& p_mesh_1, const Component::Collider& p_collider_1,
+	                                                          const ECS::Entity& p_entity_2, const Component::Transform& p_transform_2, const Data::Mesh& p_mesh_2, const Component::Collider& p_collider_2)
+	{
+		if (p_collider_1.m_triangle_mesh || p_collider_2.m_triangle_mesh)
+			return triangle_mesh_contact(p_transform_1, p_mesh_1, p_collider_1.m_triangle_mesh, p_transform_2, p_mesh_2, p_collider_2.m_triangle_mesh);
+
+		bool analytic = false;
+		if (auto contact = analytic_contact(world_shape(p_collider_1, p_transform_1), world_shape(p_collider_2, p_transform_2), analytic); analytic)
+			return contact;
+		if (p_mesh_1.collision_points.empty() || p_mesh_2.collision_points.empty())
+			return std::nullopt; // A primitive without an analytic test against the other shape needs its Mesh's collision points for GJK.
+
+		// The pair is always tested in EntityID order so the cache is shared whichever entity of the pair is queried.
+		const bool entity_1_first = p_entity_1.ID < p_entity_2.ID;
+		auto& cache = (entity_1_first ? m_pairs[{p_entity_1.ID, p_entity_2.ID}] : m_pairs[{p_entity_2.ID, p_entity_1.ID}]).GJK_cache;
+
+		const auto shape_1 = GJK::Shape(p_mesh_1.collision_points, p_transform_1.get_model(), p_transform_1.m_orientation, entity_1_first ? &cache.support_index_1 : &cache.support_index_2);
+		const auto shape_2 = GJK::Shape(p_mesh_2.collision_points, p_transform_2.get_model(), p_transform_2.m_orientation, entity_1_first ? &cache.support_index_2 : &cache.support_index_1);
+		const auto& first  = entity_1_first ? shape_1 : shape_2;
+		const auto& second = entity_1_first ? shape_2 : shape_1;
+
+		GJK::Simplex simplex;
+		if (!GJK::intersecting(first, second, simplex, cache))
+			return std::nullopt;
+
+		const auto collision = GJK::EPA(simplex, first, second);
+		cache.separating_axis = collision.normal; // Resting contacts stay close to the last contact normal.
+
+		// EPA normal points out of the Minkowski difference (first - second), first is pushed out along -normal.
+		const glm::vec3 normal_1 = entity_1_first ? -collision.normal : collision.normal;
+
+		ContactPoint contact;
+		contact.position          = shape_1.world_space_support_point(-normal_1); // Deepest point of shape 1 inside shape 2.
+		contact.normal            = normal_1;
+		contact.penetration_depth = collision.penetration_depth;
+		return contact;
+	}
+
+	void CollisionSystem::raycast_batch(std::span<const Geometry::Ray> p_rays, RaycastMode p_mode, std::vector<std::vector<RaycastHit>>& p_hits, float p_max_distance, Utility::ThreadPool* p_thread_pool) const
+	{
+		constexpr size_t Packet_Size = Geometry::AABBTree::Packet_Size;
+		p_hits.resize(p_rays.size());
+
+		// Terrain isn't in the broad phase tree, each ray marches the heightfield cells it crosses instead.
+		std::vector<std::pair<EntityID, const Component::Terrain*>> terrains;
+		m_scene_system.get_current_scene_entities().foreach([&terrains](const ECS::Entity& p_entity, Component::Terrain& p_terrain)
+		{
+			if (!p_terrain.m_heightfield.empty())
+				terrains.push_back({p_entity.ID, &p_terrain});
+		});
+
+		auto cast_packet = [&](size_t p_packet)
+		{
+			const size_t begin = p_packet * Packet_Size;
+			const size_t count = std::min(Packet_Size, p_rays.size() - begin);
+			const auto rays    = p_rays.subspan(begin, count);
+
+			std::array<float, Packet_Size> max_distances;
+			for (size_t ray = 0; ray < count; ray++)
+			{
+				max_distances[ray] = p_max_distance;
+				p_hits[begin + ray].clear();
+			}
+
+			m_broad_phase.raycast(rays, std::span<float>(max_distances.data(), count), [&](size_t p_ray, size_t p_item, float p_distance)
+			{
+				auto& hits = p_hits[begin + p_ray];
+				const RaycastHit hit = {m_broad_phase_entities[p_item], p_distance, rays[p_ray].m_start + (rays[p_ray].m_direction * p_distance)};
+
+				if (p_mode == RaycastMode::Closest)
+				{
+					// The tree only reports hits within the shrinking max distance, so each reported hit is the closest so far.
+					if (hits.empty()) hits.push_back(hit);
+					else              hits.front() = hit;
+					return p_distance;
+				}
+
+				hits.push_back(hit);
+				return max_distances[p_ray];
+			});
+
+			for (const auto& [terrain_entity, terrain] : terrains)
+			{
+				for (size_t ray = 0; ray < count; ray++)
 				{
-					const auto rotation_matrix_other = glm::mat4_cast(p_transform_other.m_orientation);
-					p_collider_other.m_world_AABB    = Geometry::AABB::transform(mesh.m_mesh->AABB, p_transform_other.m_position, rotation_matrix_other, p_transform_other.m_scale);
+					const auto local_ray = Geometry::Ray(rays[ray].m_start - terrain->m_position, rays[ray].m_direction);
+					const auto distance  = terrain->m_heightfield.raycast(local_ray, max_distances[ray]);
+					if (!distance.has_value())
+						continue;
 
-					if (Geometry::intersecting(collider.m_world_AABB, p_collider_other.m_world_AABB)) // Broad phase AABB check
+					auto& hits = p_hits[begin + ray];
+					const RaycastHit hit = {terrain_entity, *distance, rays[ray].m_start + (rays[ray].m_direction * *distance)};
+					if (p_mode == RaycastMode::Closest)
 					{
-						p_collided_entity = &p_entity_other;
-						collider.m_collided = true;
-						return;
+						if (hits.empty()) hits.push_back(hit);
+						else              hits.front() = hit;
+						max_distances[ray] = *distance;
 					}
+					else
+						hits.push_back(hit);
 				}
-			});
-		}
+			}
 
-		return std::nullopt;
+			if (p_mode == RaycastMode::All)
+			{
+				for (size_t ray = 0; ray < count; ray++)
+					std::sort(p_hits[begin + ray].begin(), p_hits[begin + ray].end(), [](const RaycastHit& p_lhs, const RaycastHit& p_rhs) { return p_lhs.distance < p_rhs.distance; });
+			}
+		};
+
+		const size_t packet_count = (p_rays.size() + Packet_Size - 1) / Packet_Size;
+		if (p_thread_pool)
+			p_thread_pool->parallel_for(packet_count, cast_packet);
+		else
+		{
+			for (size_t packet = 0; packet < packet_count; packet++)
+				cast_packet(packet);
+		}
 	}
 
 	bool CollisionSystem::castRay(const Geometry::Ray& p_ray, glm::vec3& out_first_intersection) const
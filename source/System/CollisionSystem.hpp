@@ -1,22 +1,45 @@
 #pragma once
 
+#include "EntityPairMap.hpp"
+
 #include "ECS/Storage.hpp"
+#include "Geometry/AABBBatch.hpp"
+#include "Geometry/AABBTree.hpp"
+#include "Geometry/GJK.hpp"
 #include "Geometry/Intersect.hpp"
 
+#include "Utility/EventDispatcher.hpp"
+
 #include "glm/fwd.hpp"
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include <vector>
 #include <utility>
 
 namespace Geometry
 {
+	class Frustrum;
+	class PointCloud;
 	class Ray;
+	class Sphere;
 }
 namespace Component
 {
+	class Collider;
 	struct Transform;
 }
+namespace Data
+{
+	class Mesh;
+}
+namespace Utility
+{
+	class ThreadPool;
+}
 namespace System
 {
 	class SceneSystem;
@@ -31,17 +54,187 @@ namespace System
 		float penetration_depth = 0.f;            // The depth of overlap. Unsigned displacement required to separate the two shapes along normal.
 	};
 
+	// A contact point kept between ticks as part of a ContactManifold.
+	// The anchors are stored in each body's object space so the point can be re-validated after the bodies move.
+	struct ManifoldPoint
+	{
+		glm::vec3 local_point_1 = glm::vec3(0.f); // Deepest point of body 1 inside body 2 in body 1 object space.
+		glm::vec3 local_point_2 = glm::vec3(0.f); // Matching point on the surface of body 2 in body 2 object space.
+		glm::vec3 position      = glm::vec3(0.f); // World-space contact point, midway between the anchors.
+		float penetration_depth = 0.f;            // Depth of overlap along the manifold normal.
+		// Impulses accumulated by the last solve. Re-applied at the start of the next solve to warm-start it.
+		float normal_impulse    = 0.f;
+		float tangent_impulse_1 = 0.f;
+		float tangent_impulse_2 = 0.f;
+	};
+
+	// Up to Max_Points contact points between a pair of entities sharing a normal.
+	// A single GJK/EPA query finds one point per tick, the manifold persists points over ticks to support the pair on a face.
+	struct ContactManifold
+	{
+		constexpr static size_t Max_Points            = 4;
+		constexpr static float Breaking_Threshold     = 0.02f; // Distance (m) a point can drift or separate by before it's dropped.
+
+		EntityID entity_1 = 0;
+		EntityID entity_2 = 0;
+		glm::vec3 normal  = glm::vec3(0.f); // Response normal from the perspective of entity_1, pushing entity_1 away from entity_2.
+		std::array<ManifoldPoint, Max_Points> points = {};
+		size_t point_count = 0;
+
+		// Recompute the world-space positions and depths of the points for the new model matrices, dropping points that have drifted or separated.
+		void refresh(const glm::mat4& p_model_1, const glm::mat4& p_model_2);
+		// Add p_point, replacing a point it's close to (keeping its accumulated impulses) or,
+		// if the manifold is full, the point whose removal leaves the largest contact area.
+		void add_point(const ManifoldPoint& p_point);
+	};
+
+	enum class ContactEventType : uint8_t
+	{
+		Begin,   // The pair started touching this tick.
+		Persist, // The pair was touching last tick and still is.
+		End      // The pair stopped touching this tick, or one of the entities lost its Collider or Terrain.
+	};
+	// A contact between a pair of entities reported by CollisionSystem::update, see CollisionSystem::m_contact_event.
+	struct ContactEvent
+	{
+		ContactEventType type = ContactEventType::Begin;
+		EntityID entity_1     = 0; // The lower EntityID of the pair.
+		EntityID entity_2     = 0;
+		const ContactManifold* manifold = nullptr; // The contact of a Begin or Persist event, nullptr for End.
+	};
+
+	// The first contact of a moving shape swept along a displacement. See CollisionSystem::time_of_impact and shape_cast.
+	struct TimeOfImpact
+	{
+		float fraction   = 0.f;            // Fraction [0-1] of the displacement travelled before the contact.
+		glm::vec3 normal = glm::vec3(0.f); // Contact normal pointing from the swept shape towards other (normalised).
+		EntityID other   = 0;              // The entity hit.
+	};
+
+	// An entity hit by a ray of CollisionSystem::raycast_batch.
+	struct RaycastHit
+	{
+		EntityID entity = 0;
+		float distance  = 0.f;            // Distance along the ray to the entry point (or terrain surface) in multiples of the ray direction, 0 if the ray starts inside.
+		glm::vec3 position = glm::vec3(0.f); // World-space entry point of the ray.
+	};
+	enum class RaycastMode : uint8_t
+	{
+		Closest, // Only report the nearest hit of each ray.
+		All      // Report every hit of each ray.
+	};
+
 	// An optimisation layer and helper for quickly finding collision information for an Entity in a scene.
 	class CollisionSystem
 	{
+	public:
+		constexpr static float Time_Of_Impact_Tolerance = 0.005f; // Separation (m) at which a swept entity is considered to have hit.
+
 	private:
 		SceneSystem& m_scene_system;
+		// State kept per pair of entities with overlapping AABBs.
+		struct PairState
+		{
+			GJK::PairCache GJK_cache; // Consecutive ticks test the same pairs with similar transforms, the cached separating axis and support vertices warm-start the next test.
+			ContactManifold manifold;
+			uint32_t manifold_update = 0; // m_manifold_update when update_manifolds last tested (or kept) the manifold.
+			bool touching            = false; // Whether the pair was touching at the last update(), used to tell Begin from Persist and detect End.
+		};
+		// Keyed on the (lower, higher) EntityID of the pair. Entries are added by the narrow phase and erased in update() when the pair's AABBs stop overlapping.
+		EntityPairMap<PairState> m_pairs;
+		std::vector<ContactManifold*> m_manifolds; // Manifolds with at least one point, pointing into m_pairs. Invalidated by inserting into or erasing from m_pairs.
+		uint32_t m_manifold_update;                // Incremented by every update_manifolds call, once per update().
+		std::vector<ContactEvent> m_contact_events; // Events of the current update(), dispatched once the pair cache is settled.
+
+		// Broad phase tree over the world AABBs of every collider, rebuilt in update(). update_manifolds takes its pairs from a self-pair query of it.
+		Geometry::AABBTree m_broad_phase;
+		Geometry::AABBBatch m_world_AABBs; // Refreshes every Collider::m_world_AABB in one pass at the start of update().
+		std::vector<EntityID> m_broad_phase_entities; // Entity of each item in m_broad_phase.
+		std::vector<Geometry::AABB> m_broad_phase_AABBs; // Output of m_world_AABBs for each item in m_broad_phase, the AABBs the tree is built from and the narrow phase culls with.
+
+		// Collect the entities of the broad phase items passing p_overlaps into p_entities.
+		void query_broad_phase(const Geometry::AABBTree::OverlapTest& p_overlaps, std::vector<EntityID>& p_entities) const;
+
+		// Run the narrow phase over every pair of colliders with overlapping AABBs and update their persistent ContactManifolds. Called by update.
+		// The pairs come from a self-pair query of the broad phase tree, so only colliders near each other are compared.
+		// Terrain collides as a static heightfield with the convex colliders over it, only the cells under each collider are tested.
+		// Pairs where neither entity has an awake RigidBody skip the narrow phase and keep their manifold from when they fell asleep.
+		void update_manifolds();
+		// Narrow phase test between two entities whose AABBs overlap.
+		// Colliders flagged as triangle meshes are tested per triangle with their mesh's TriangleBVH as the midphase.
+		// A pair of triangle meshes is only found where their surfaces cross, a mesh wholly inside the other isn't found. Its normal is the face normal
+		// of the crossing triangles that separates them with the least displacement, the penetration depth.
+		// Pairs of primitive Collider::Shapes with an analytic test use it, everything else uses GJK + EPA on the meshes' collision points.
+		//@return The ContactPoint from the perspective of p_entity_1 if the collision shapes of the meshes intersect.
+		std::optional<ContactPoint> narrow_phase(const ECS::Entity& p_entity_1, const Component::Transform& p_transform_1, const Data::Mesh& p_mesh_1, const Component::Collider& p_collider_1,
+		                                         const ECS::Entity& p_entity_2, const Component::Transform& p_transform_2, const Data::Mesh& p_mesh_2, const Component::Collider& p_collider_2);
+		// Conservative advancement of a convex shape against the collision shape of p_other, see shape_cast.
+		// Triangle mesh colliders are advanced against each of their triangles under p_swept_AABB.
+		//@return The first impact before p_max_fraction, with a 0 normal if the shapes intersect before moving. TimeOfImpact::other is not set.
+		std::optional<TimeOfImpact> sweep_against(EntityID p_other, const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation,
+		                                          const glm::vec3& p_displacement, const Geometry::AABB& p_swept_AABB, float p_max_fraction) const;
 
 	public:
+		// Dispatched by update() for every pair of entities that began, persisted or ended contact since the previous update().
+		// ContactEvent::manifold is only valid during the dispatch, handlers must not call update or get_collision.
+		Utility::EventDispatcher<const ContactEvent&> m_contact_event;
+
 		CollisionSystem(SceneSystem& p_scene_system) noexcept;
+		// Refresh every Collider::m_world_AABB, rebuild the broad phase tree, update the ContactManifolds of the pairs in it, drop the cached pairs
+		// that left it and dispatch m_contact_event for the contacts found.
+		// Call once per tick after the positions are integrated, the other functions reuse the world AABBs from here so entities moved in between are a tick behind.
+		// The PhysicsSystem solves the manifolds found here on the next tick, before integrating the positions.
 		void update();
 
-		std::optional<ContactPoint> get_collision(const ECS::Entity& p_entity, const ECS::Entity* p_collided_entity = nullptr) const;
+		// The manifolds in contact after the last update, at the positions it was called with.
+		// The points are mutable so a solver can store its accumulated impulses on them for warm starting.
+		// The pointers are invalidated by the next update or get_collision call.
+		const std::vector<ContactManifold*>& get_manifolds() const { return m_manifolds; }
+
+		// Sweep p_entity along p_displacement against the other colliders and find the first it touches.
+		// The swept AABB is tested against the broad phase tree of the last update, then conservative advancement finds the fraction of
+		// p_displacement at which the convex hulls come within Time_Of_Impact_Tolerance. Only translation is swept and the other colliders are treated as static.
+		// Terrain is swept against the heightfield cells under the swept AABB.
+		// Colliders p_entity already intersects at the start of the sweep are skipped, those contacts are left to the narrow phase.
+		//@param p_entity The entity to sweep from its Transform at the last update(). Requires a Collider, Mesh and Transform.
+		//@param p_displacement World-space translation (m) of p_entity over the sweep.
+		//@return The earliest TimeOfImpact along p_displacement if p_entity hits anything.
+		std::optional<TimeOfImpact> time_of_impact(const ECS::Entity& p_entity, const glm::vec3& p_displacement);
+
+		// Find the first entity p_entity is colliding with.
+		// p_entity's world AABB is refreshed from its current Transform, the other colliders use their world AABB from the last update().
+		//@param p_entity The entity to test against the scene. Requires a Collider, Mesh and Transform.
+		//@param p_collided_entity Optional output set to the entity p_entity is colliding with.
+		//@return The ContactPoint from the perspective of p_entity if a collision was found.
+		std::optional<ContactPoint> get_collision(const ECS::Entity& p_entity, ECS::Entity* p_collided_entity = nullptr);
+
+		// Cast a batch of rays against the collider world AABBs using the broad phase tree built in the last update.
+		// Terrain is hit on its surface, each ray marches the heightfield cells it crosses.
+		// Rays are traversed in packets of Geometry::AABBTree::Packet_Size, consecutive rays with similar origins and directions share most of the traversal.
+		// Unlike castRay this has no side effects, Collider::m_collided is not written.
+		//@param p_rays The rays to cast.
+		//@param p_mode Whether to find the closest or all hits of each ray.
+		//@param p_hits Resized to p_rays.size(), p_hits[i] is set to the hits of p_rays[i] sorted by distance. The inner vectors are reused between calls.
+		//@param p_max_distance Distance along the rays beyond which hits are ignored, in multiples of the ray direction.
+		//@param p_thread_pool Optional pool to cast the packets across. Single-threaded if nullptr.
+		void raycast_batch(std::span<const Geometry::Ray> p_rays, RaycastMode p_mode, std::vector<std::vector<RaycastHit>>& p_hits,
+		                   float p_max_distance = std::numeric_limits<float>::max(), Utility::ThreadPool* p_thread_pool = nullptr) const;
+
+		// Find the entities whose collider world AABB intersects the query volume, using the broad phase tree built in the last update.
+		// Only the world AABB is tested, not the collider shape, so an entity whose AABB intersects the volume but whose shape doesn't is still found.
+		// The Frustrum test is conservative too, see Geometry::intersecting(Frustrum, AABB).
+		//@param p_entities Cleared and filled with the entities found. Reuse the vector between calls to avoid allocating.
+		void overlap(const Geometry::Sphere& p_sphere, std::vector<EntityID>& p_entities) const;
+		void overlap(const Geometry::AABB& p_AABB, std::vector<EntityID>& p_entities) const;
+		void overlap(const Geometry::Frustrum& p_frustrum, std::vector<EntityID>& p_entities) const;
+		// Sweep a convex shape along p_displacement and find every collider or terrain it hits, using conservative advancement against the convex hull of each collider.
+		// Colliders the shape intersects at the start of the sweep are hit at fraction 0, with the direction of p_displacement as the normal.
+		//@param p_points Object-space points of the convex shape.
+		//@param p_transform Object->world transform of the shape at the start of the sweep.
+		//@param p_orientation Rotation of p_transform.
+		//@param p_displacement World-space translation (m) of the shape over the sweep.
+		//@param p_hits Cleared and filled with the hits sorted by fraction. Reuse the vector between calls to avoid allocating.
+		void shape_cast(const Geometry::PointCloud& p_points, const glm::mat4& p_transform, const glm::quat& p_orientation, const glm::vec3& p_displacement, std::vector<TimeOfImpact>& p_hits) const;
 
 		// Does this ray collide with any entities.
 		bool castRay(const Geometry::Ray& p_ray, glm::vec3& out_first_intersection) const;
@@ -0,0 +1,152 @@
+#include "ContactSolver.hpp"
+#include "CollisionSystem.hpp"
+
+#include "Utility/Logger.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+
+namespace System
+{
+	// Impulse p_impulse applied at r_1/r_2 pushes body 2 along p_impulse and body 1 against it.
+	static void apply_impulse(SolverBody& p_body_1, SolverBody& p_body_2, const ContactConstraint& p_constraint, const glm::vec3& p_impulse)
+	{
+		p_body_1.velocity         -= p_impulse * p_body_1.inverse_mass;
+		p_body_1.angular_velocity -= p_body_1.inverse_inertia * glm::cross(p_constraint.r_1, p_impulse);
+		p_body_2.velocity         += p_impulse * p_body_2.inverse_mass;
+		p_body_2.angular_velocity += p_body_2.inverse_inertia * glm::cross(p_constraint.r_2, p_impulse);
+	}
+	// Velocity of the contact point on body 2 relative to the contact point on body 1.
+	static glm::vec3 relative_velocity(const SolverBody& p_body_1, const SolverBody& p_body_2, const ContactConstraint& p_constraint)
+	{
+		return (p_body_2.velocity + glm::cross(p_body_2.angular_velocity, p_constraint.r_2))
+		     - (p_body_1.velocity + glm::cross(p_body_1.angular_velocity, p_constraint.r_1));
+	}
+	// Inverse of the effective mass of the pair along p_axis at the contact point.
+	static float effective_mass(const SolverBody& p_body_1, const SolverBody& p_body_2, const ContactConstraint& p_constraint, const glm::vec3& p_axis)
+	{
+		const glm::vec3 r_1_cross_axis = glm::cross(p_constraint.r_1, p_axis);
+		const glm::vec3 r_2_cross_axis = glm::cross(p_constraint.r_2, p_axis);
+		const float k = p_body_1.inverse_mass + p_body_2.inverse_mass
+		              + glm::dot(r_1_cross_axis, p_body_1.inverse_inertia * r_1_cross_axis)
+		              + glm::dot(r_2_cross_axis, p_body_2.inverse_inertia * r_2_cross_axis);
+		return k > 0.f ? 1.f / k : 0.f;
+	}
+
+	ContactSolver::ContactSolver() noexcept
+		: m_bodies{}
+		, m_constraints{}
+	{
+		clear();
+	}
+
+	void ContactSolver::clear()
+	{
+		m_bodies.clear();
+		m_constraints.clear();
+		m_bodies.push_back(SolverBody{}); // Zero inverse mass and inertia, never moved by an impulse.
+	}
+
+	size_t ContactSolver::add_body(const SolverBody& p_body)
+	{
+		m_bodies.push_back(p_body);
+		return m_bodies.size() - 1;
+	}
+
+	void ContactSolver::add_manifold(ContactManifold& p_manifold, size_t p_body_1, size_t p_body_2, float p_friction, float p_restitution, float p_delta_time)
+	{
+		ASSERT(p_body_1 < m_bodies.size() && p_body_2 < m_bodies.size(), "Manifold bodies must be added before the manifold");
+		if (p_body_1 == 0 && p_body_2 == 0)
+			return; // Two static bodies, nothing to solve.
+
+		// The manifold normal pushes entity_1 away from entity_2, the constraint normal points from body 1 to body 2.
+		const glm::vec3 normal = -p_manifold.normal;
+
+		// Tangent basis depends only on the normal so the warm-started friction impulses stay aligned between ticks.
+		const glm::vec3 tangent_1 = glm::abs(normal.x) >= 0.57735f
+			? glm::normalize(glm::vec3(normal.y, -normal.x, 0.f))
+			: glm::normalize(glm::vec3(0.f, normal.z, -normal.y));
+		const glm::vec3 tangent_2 = glm::cross(normal, tangent_1);
+
+		for (size_t i = 0; i < p_manifold.point_count; i++)
+		{
+			auto& point = p_manifold.points[i];
+
+			ContactConstraint constraint;
+			constraint.body_1    = p_body_1;
+			constraint.body_2    = p_body_2;
+			constraint.normal    = normal;
+			constraint.tangent_1 = tangent_1;
+			constraint.tangent_2 = tangent_2;
+			constraint.r_1       = point.position - m_bodies[p_body_1].position;
+			constraint.r_2       = point.position - m_bodies[p_body_2].position;
+			constraint.friction  = p_friction;
+			constraint.point     = &point;
+
+			constraint.normal_mass    = effective_mass(m_bodies[p_body_1], m_bodies[p_body_2], constraint, normal);
+			constraint.tangent_mass_1 = effective_mass(m_bodies[p_body_1], m_bodies[p_body_2], constraint, tangent_1);
+			constraint.tangent_mass_2 = effective_mass(m_bodies[p_body_1], m_bodies[p_body_2], constraint, tangent_2);
+
+			// Separating velocity to aim for. Restitution bounces fast impacts, Baumgarte stabilisation pushes out the remaining penetration over a few ticks.
+			const float closing_velocity    = glm::dot(relative_velocity(m_bodies[p_body_1], m_bodies[p_body_2], constraint), normal);
+			const float restitution_bias    = closing_velocity < -Restitution_Threshold ? -p_restitution * closing_velocity : 0.f;
+			const float position_correction = (Baumgarte / p_delta_time) * std::max(point.penetration_depth - Penetration_Slop, 0.f);
+			constraint.bias = std::max(restitution_bias, position_correction);
+
+			constraint.normal_impulse    = point.normal_impulse;
+			constraint.tangent_impulse_1 = point.tangent_impulse_1;
+			constraint.tangent_impulse_2 = point.tangent_impulse_2;
+
+			m_constraints.push_back(constraint);
+		}
+	}
+
+	void ContactSolver::solve(int p_iterations)
+	{
+		// Warm start, contacts that persisted from the last tick start from the impulse that held them last time.
+		for (const auto& constraint : m_constraints)
+		{
+			const glm::vec3 impulse = (constraint.normal * constraint.normal_impulse)
+			                        + (constraint.tangent_1 * constraint.tangent_impulse_1)
+			                        + (constraint.tangent_2 * constraint.tangent_impulse_2);
+			apply_impulse(m_bodies[constraint.body_1], m_bodies[constraint.body_2], constraint, impulse);
+		}
+
+		for (int iteration = 0; iteration < p_iterations; iteration++)
+		{
+			for (auto& constraint : m_constraints)
+			{
+				auto& body_1 = m_bodies[constraint.body_1];
+				auto& body_2 = m_bodies[constraint.body_2];
+
+				{ // Friction, clamped to the Coulomb cone (approximated as a box) using the current normal impulse.
+					const float max_friction = constraint.friction * constraint.normal_impulse;
+					const glm::vec3 velocity = relative_velocity(body_1, body_2, constraint);
+
+					const float old_impulse_1    = constraint.tangent_impulse_1;
+					constraint.tangent_impulse_1 = std::clamp(old_impulse_1 - (glm::dot(velocity, constraint.tangent_1) * constraint.tangent_mass_1), -max_friction, max_friction);
+					const float old_impulse_2    = constraint.tangent_impulse_2;
+					constraint.tangent_impulse_2 = std::clamp(old_impulse_2 - (glm::dot(velocity, constraint.tangent_2) * constraint.tangent_mass_2), -max_friction, max_friction);
+
+					apply_impulse(body_1, body_2, constraint, (constraint.tangent_1 * (constraint.tangent_impulse_1 - old_impulse_1))
+					                                        + (constraint.tangent_2 * (constraint.tangent_impulse_2 - old_impulse_2)));
+				}
+				{ // Non-penetration, the accumulated impulse can only push the bodies apart.
+					const float normal_velocity = glm::dot(relative_velocity(body_1, body_2, constraint), constraint.normal);
+					const float old_impulse     = constraint.normal_impulse;
+					constraint.normal_impulse   = std::max(old_impulse + ((constraint.bias - normal_velocity) * constraint.normal_mass), 0.f);
+
+					apply_impulse(body_1, body_2, constraint, constraint.normal * (constraint.normal_impulse - old_impulse));
+				}
+			}
+		}
+
+		for (const auto& constraint : m_constraints)
+		{
+			constraint.point->normal_impulse    = constraint.normal_impulse;
+			constraint.point->tangent_impulse_1 = constraint.tangent_impulse_1;
+			constraint.point->tangent_impulse_2 = constraint.tangent_impulse_2;
+		}
+	}
+} // namespace System
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+#include "glm/mat3x3.hpp"
+
+#include <vector>
+
+namespace System
+{
+	struct ContactManifold;
+	struct ManifoldPoint;
+
+	// The velocity state of a body copied out of its RigidBody and Transform for the duration of a solve.
+	struct SolverBody
+	{
+		glm::vec3 position         = glm::vec3(0.f); // Centre of mass in world space.
+		glm::vec3 velocity         = glm::vec3(0.f);
+		glm::vec3 angular_velocity = glm::vec3(0.f);
+		glm::mat3 inverse_inertia  = glm::mat3(0.f);
+		float inverse_mass         = 0.f;
+	};
+
+	// A non-penetration constraint with friction for one ManifoldPoint.
+	// Everything the iterations need is precomputed so the hot loop only reads this struct and the two SolverBodies.
+	struct ContactConstraint
+	{
+		size_t body_1 = 0;
+		size_t body_2 = 0;
+		glm::vec3 normal    = glm::vec3(0.f); // Points from body 1 towards body 2.
+		glm::vec3 tangent_1 = glm::vec3(0.f);
+		glm::vec3 tangent_2 = glm::vec3(0.f);
+		glm::vec3 r_1       = glm::vec3(0.f); // Contact point relative to body 1's centre of mass.
+		glm::vec3 r_2       = glm::vec3(0.f); // Contact point relative to body 2's centre of mass.
+
+		float normal_mass    = 0.f; // Inverse of the effective mass along normal.
+		float tangent_mass_1 = 0.f;
+		float tangent_mass_2 = 0.f;
+		float bias           = 0.f; // Target separating velocity from restitution and position correction.
+		float friction       = 0.f;
+
+		float normal_impulse    = 0.f; // Accumulated impulses, clamped as a total rather than per iteration.
+		float tangent_impulse_1 = 0.f;
+		float tangent_impulse_2 = 0.f;
+
+		ManifoldPoint* point = nullptr; // The point the accumulated impulses are read from and stored back to.
+	};
+
+	// Sequential-impulse contact solver.
+	// Each tick the bodies and manifolds in contact are added, the impulses accumulated on the previous tick are re-applied (warm starting)
+	// and a number of velocity iterations are run over the constraints. Resolving every contact a little at a time converges on a
+	// solution where all the contacts of a stack are satisfied together, rather than each contact undoing the last.
+	// Bodies and constraints are kept in contiguous arrays that are reused between ticks. Constraints refer to their bodies by index
+	// into the body array, the caller resolves the entities of a manifold to those indices when adding it.
+	class ContactSolver
+	{
+		std::vector<SolverBody> m_bodies; // m_bodies[0] is the static world, any entity without a body resolves to it.
+		std::vector<ContactConstraint> m_constraints;
+
+	public:
+		constexpr static float Baumgarte             = 0.2f;  // Fraction of the penetration corrected per tick.
+		constexpr static float Penetration_Slop      = 0.01f; // Penetration (m) allowed before position correction starts, keeps resting contacts from jittering.
+		constexpr static float Restitution_Threshold = 1.f;   // Closing speed (m/s) below which restitution is ignored so bodies can come to rest.
+
+		ContactSolver() noexcept;
+
+		// Remove all bodies and constraints keeping the allocations.
+		void clear();
+		// Add a dynamic body. Bodies are indexed in the order they're added starting from 1, after the static world.
+		//@return The index of the body in the solver.
+		size_t add_body(const SolverBody& p_body);
+		const SolverBody& get_body(size_t p_index) const { return m_bodies[p_index]; }
+
+		// Build the constraints for every point of p_manifold.
+		//@param p_body_1 Index of the body of p_manifold.entity_1 returned by add_body, or 0 if it's static.
+		//@param p_body_2 Index of the body of p_manifold.entity_2 returned by add_body, or 0 if it's static.
+		//@param p_friction Coefficient of friction used for the tangential impulses.
+		//@param p_restitution Coefficient of restitution applied to closing speeds above Restitution_Threshold.
+		//@param p_delta_time The timestep the solved velocities will be integrated over (s).
+		void add_manifold(ContactManifold& p_manifold, size_t p_body_1, size_t p_body_2, float p_friction, float p_restitution, float p_delta_time);
+		// Warm start and iterate the constraints, storing the accumulated impulses back on the ManifoldPoints.
+		//@param p_iterations Number of velocity iterations. More iterations improve the convergence of stacks at a linear cost.
+		void solve(int p_iterations);
+	};
+} // namespace System
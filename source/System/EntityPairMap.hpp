@@ -0,0 +1,176 @@
+#pragma once
+
+#include "ECS/Entity.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace System
+{
+	// Open-addressing hash map from a pair of EntityIDs to a Value, resolving collisions by linear probing.
+	// Entries live in one flat array so a lookup is usually a single cache line, where a node based std::map chases a pointer per level.
+	// The table grows to keep the load factor at or below 1/2, growing moves every entry so any insert invalidates pointers into the map.
+	// Pairs are not reordered, (a, b) and (b, a) are different keys.
+	template <typename Value>
+	class EntityPairMap
+	{
+	public:
+		using Key = std::pair<EntityID, EntityID>;
+
+		EntityPairMap() noexcept
+			: m_slots{}
+			, m_size{0}
+		{}
+
+		size_t size() const { return m_size; }
+		bool empty() const  { return m_size == 0; }
+		void clear()
+		{
+			m_slots.clear();
+			m_size = 0;
+		}
+
+		Value* find(const Key& p_key)
+		{
+			const size_t index = index_of(p_key);
+			return index != Not_Found ? &m_slots[index].value : nullptr;
+		}
+		const Value* find(const Key& p_key) const
+		{
+			const size_t index = index_of(p_key);
+			return index != Not_Found ? &m_slots[index].value : nullptr;
+		}
+		// Find the value of p_key, inserting a default constructed value if it's not in the map.
+		Value& operator[](const Key& p_key)
+		{
+			if (const size_t index = index_of(p_key); index != Not_Found)
+				return m_slots[index].value;
+
+			if ((m_size + 1) * 2 > m_slots.size())
+				grow();
+
+			size_t index = hash(p_key) & (m_slots.size() - 1);
+			while (m_slots[index].occupied)
+				index = (index + 1) & (m_slots.size() - 1);
+
+			m_slots[index].key      = p_key;
+			m_slots[index].value    = Value{};
+			m_slots[index].occupied = true;
+			m_size++;
+			return m_slots[index].value;
+		}
+
+		// Call p_function(const Key&, Value&) for every entry in slot order.
+		template <typename Function>
+		void for_each(Function&& p_function)
+		{
+			for (auto& slot : m_slots)
+			{
+				if (slot.occupied)
+					p_function(std::as_const(slot.key), slot.value);
+			}
+		}
+
+		// Erase every entry p_predicate(const Key&, Value&) returns true for. p_predicate is called exactly once per entry.
+		template <typename Predicate>
+		void erase_if(Predicate&& p_predicate)
+		{
+			// Mark first then erase, erasing shifts later entries back which could otherwise revisit or skip them.
+			bool any_marked = false;
+			for (auto& slot : m_slots)
+			{
+				if (slot.occupied && p_predicate(std::as_const(slot.key), slot.value))
+				{
+					slot.marked = true;
+					any_marked  = true;
+				}
+			}
+			if (!any_marked)
+				return;
+
+			for (size_t i = 0; i < m_slots.size();)
+			{
+				if (m_slots[i].occupied && m_slots[i].marked)
+					erase_at(i); // Re-check i, erase_at may have shifted another marked entry into it.
+				else
+					i++;
+			}
+		}
+
+	private:
+		struct Slot
+		{
+			Key key        = {0, 0};
+			Value value    = {};
+			bool occupied  = false;
+			bool marked    = false; // Pending erase in erase_if.
+		};
+
+		constexpr static size_t Not_Found    = static_cast<size_t>(-1);
+		constexpr static size_t Min_Capacity = 64; // Must be a power of two, capacity is doubled from here so the index is a mask of the hash.
+
+		std::vector<Slot> m_slots;
+		size_t m_size;
+
+		static size_t hash(const Key& p_key)
+		{
+			// Combine both IDs then apply the splitmix64 finaliser, EntityIDs are sequential so their low bits alone would cluster.
+			uint64_t hash = (static_cast<uint64_t>(p_key.first) * 0x9E3779B97F4A7C15ull) ^ static_cast<uint64_t>(p_key.second);
+			hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+			hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+			return static_cast<size_t>(hash ^ (hash >> 31));
+		}
+
+		size_t index_of(const Key& p_key) const
+		{
+			if (m_slots.empty())
+				return Not_Found;
+
+			// The load factor is at most 1/2 so there is always an empty slot to end the probe.
+			for (size_t index = hash(p_key) & (m_slots.size() - 1); m_slots[index].occupied; index = (index + 1) & (m_slots.size() - 1))
+			{
+				if (m_slots[index].key == p_key)
+					return index;
+			}
+			return Not_Found;
+		}
+
+		void grow()
+		{
+			std::vector<Slot> old_slots = std::move(m_slots);
+			m_slots = std::vector<Slot>(old_slots.empty() ? Min_Capacity : old_slots.size() * 2);
+
+			for (auto& old_slot : old_slots)
+			{
+				if (!old_slot.occupied)
+					continue;
+
+				size_t index = hash(old_slot.key) & (m_slots.size() - 1);
+				while (m_slots[index].occupied)
+					index = (index + 1) & (m_slots.size() - 1);
+				m_slots[index] = std::move(old_slot);
+			}
+		}
+
+		// Backward shift deletion, entries after p_index in its probe run are moved back so no tombstones are needed and lookups stay short.
+		void erase_at(size_t p_index)
+		{
+			const size_t mask = m_slots.size() - 1;
+			size_t hole = p_index;
+			for (size_t index = (hole + 1) & mask; m_slots[index].occupied; index = (index + 1) & mask)
+			{
+				// An entry can fill the hole if the hole lies between its home slot and where it is now (cyclically).
+				const size_t home = hash(m_slots[index].key) & mask;
+				if (((index - home) & mask) >= ((index - hole) & mask))
+				{
+					m_slots[hole] = std::move(m_slots[index]);
+					hole = index;
+				}
+			}
+			m_slots[hole] = Slot{};
+			m_size--;
+		}
+	};
+} // namespace System
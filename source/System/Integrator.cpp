@@ -0,0 +1,287 @@
+#include "Integrator.hpp"
+
+#include "Component/RigidBody.hpp"
+#include "Component/Transform.hpp"
+
+#include "Utility/CPUFeatures.hpp"
+#include "Utility/Logger.hpp"
+#include "Utility/ThreadPool.hpp"
+
+#include "glm/glm.hpp"
+
+#include <cmath>
+
+#ifdef Z_X86
+	#include <immintrin.h>
+#endif
+
+namespace System
+{
+	static void integrate_velocities_scalar(Integrator::Arrays& p_arrays, size_t p_begin, size_t p_end, float p_delta_time)
+	{
+		auto& a = p_arrays;
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			// dp = F dt, v = p/m
+			a.momentum_x[i] += a.force_x[i] * p_delta_time;
+			a.momentum_y[i] += a.force_y[i] * p_delta_time;
+			a.momentum_z[i] += a.force_z[i] * p_delta_time;
+			a.velocity_x[i]  = a.momentum_x[i] * a.inverse_mass[i];
+			a.velocity_y[i]  = a.momentum_y[i] * a.inverse_mass[i];
+			a.velocity_z[i]  = a.momentum_z[i] * a.inverse_mass[i];
+
+			// dL = T dt, ω = I⁻¹L
+			a.angular_momentum_x[i] += a.torque_x[i] * p_delta_time;
+			a.angular_momentum_y[i] += a.torque_y[i] * p_delta_time;
+			a.angular_momentum_z[i] += a.torque_z[i] * p_delta_time;
+			const auto& I = a.inverse_inertia;
+			a.angular_velocity_x[i] = I[0][i] * a.angular_momentum_x[i] + I[3][i] * a.angular_momentum_y[i] + I[6][i] * a.angular_momentum_z[i];
+			a.angular_velocity_y[i] = I[1][i] * a.angular_momentum_x[i] + I[4][i] * a.angular_momentum_y[i] + I[7][i] * a.angular_momentum_z[i];
+			a.angular_velocity_z[i] = I[2][i] * a.angular_momentum_x[i] + I[5][i] * a.angular_momentum_y[i] + I[8][i] * a.angular_momentum_z[i];
+		}
+	}
+	static void integrate_positions_scalar(Integrator::Arrays& p_arrays, size_t p_begin, size_t p_end, float p_delta_time)
+	{
+		auto& a = p_arrays;
+		const float half_delta_time = 0.5f * p_delta_time;
+		for (size_t i = p_begin; i < p_end; i++)
+		{
+			// dx = v dt
+			a.position_x[i] += a.velocity_x[i] * p_delta_time;
+			a.position_y[i] += a.velocity_y[i] * p_delta_time;
+			a.position_z[i] += a.velocity_z[i] * p_delta_time;
+
+			// Spin dq = ½ (0, ω dt) q, expanded from the quaternion product with a zero real part.
+			const float w = a.orientation_w[i], x = a.orientation_x[i], y = a.orientation_y[i], z = a.orientation_z[i];
+			const float spin_x = a.angular_velocity_x[i] * half_delta_time;
+			const float spin_y = a.angular_velocity_y[i] * half_delta_time;
+			const float spin_z = a.angular_velocity_z[i] * half_delta_time;
+
+			const float new_w = w - (spin_x * x + spin_y * y + spin_z * z);
+			const float new_x = x + (spin_x * w + (spin_y * z - spin_z * y));
+			const float new_y = y + (spin_y * w + (spin_z * x - spin_x * z));
+			const float new_z = z + (spin_z * w + (spin_x * y - spin_y * x));
+
+			const float inverse_length = 1.f / std::sqrt((new_w * new_w + new_x * new_x) + (new_y * new_y + new_z * new_z));
+			a.orientation_w[i] = new_w * inverse_length;
+			a.orientation_x[i] = new_x * inverse_length;
+			a.orientation_y[i] = new_y * inverse_length;
+			a.orientation_z[i] = new_z * inverse_length;
+		}
+	}
+
+#ifdef Z_X86
+	// The AVX2 kernels integrate 8 bodies per iteration then hand the remainder of the range to the scalar kernels.
+	// They round identically to the scalar kernels, see Utility/CPUFeatures.hpp.
+	TARGET_AVX2 static void integrate_velocities_AVX2(Integrator::Arrays& p_arrays, size_t p_begin, size_t p_end, float p_delta_time)
+	{
+		auto& a = p_arrays;
+		const __m256 dt = _mm256_set1_ps(p_delta_time);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			const __m256 inverse_mass = _mm256_loadu_ps(&a.inverse_mass[i]);
+			const __m256 momentum_x   = _mm256_add_ps(_mm256_loadu_ps(&a.momentum_x[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.force_x[i]), dt));
+			const __m256 momentum_y   = _mm256_add_ps(_mm256_loadu_ps(&a.momentum_y[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.force_y[i]), dt));
+			const __m256 momentum_z   = _mm256_add_ps(_mm256_loadu_ps(&a.momentum_z[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.force_z[i]), dt));
+			_mm256_storeu_ps(&a.momentum_x[i], momentum_x);
+			_mm256_storeu_ps(&a.momentum_y[i], momentum_y);
+			_mm256_storeu_ps(&a.momentum_z[i], momentum_z);
+			_mm256_storeu_ps(&a.velocity_x[i], _mm256_mul_ps(momentum_x, inverse_mass));
+			_mm256_storeu_ps(&a.velocity_y[i], _mm256_mul_ps(momentum_y, inverse_mass));
+			_mm256_storeu_ps(&a.velocity_z[i], _mm256_mul_ps(momentum_z, inverse_mass));
+
+			const __m256 L_x = _mm256_add_ps(_mm256_loadu_ps(&a.angular_momentum_x[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.torque_x[i]), dt));
+			const __m256 L_y = _mm256_add_ps(_mm256_loadu_ps(&a.angular_momentum_y[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.torque_y[i]), dt));
+			const __m256 L_z = _mm256_add_ps(_mm256_loadu_ps(&a.angular_momentum_z[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.torque_z[i]), dt));
+			_mm256_storeu_ps(&a.angular_momentum_x[i], L_x);
+			_mm256_storeu_ps(&a.angular_momentum_y[i], L_y);
+			_mm256_storeu_ps(&a.angular_momentum_z[i], L_z);
+
+			const auto& I = a.inverse_inertia;
+			_mm256_storeu_ps(&a.angular_velocity_x[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&I[0][i]), L_x), _mm256_mul_ps(_mm256_loadu_ps(&I[3][i]), L_y)), _mm256_mul_ps(_mm256_loadu_ps(&I[6][i]), L_z)));
+			_mm256_storeu_ps(&a.angular_velocity_y[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&I[1][i]), L_x), _mm256_mul_ps(_mm256_loadu_ps(&I[4][i]), L_y)), _mm256_mul_ps(_mm256_loadu_ps(&I[7][i]), L_z)));
+			_mm256_storeu_ps(&a.angular_velocity_z[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&I[2][i]), L_x), _mm256_mul_ps(_mm256_loadu_ps(&I[5][i]), L_y)), _mm256_mul_ps(_mm256_loadu_ps(&I[8][i]), L_z)));
+		}
+
+		integrate_velocities_scalar(p_arrays, i, p_end, p_delta_time);
+	}
+	TARGET_AVX2 static void integrate_positions_AVX2(Integrator::Arrays& p_arrays, size_t p_begin, size_t p_end, float p_delta_time)
+	{
+		auto& a = p_arrays;
+		const __m256 dt      = _mm256_set1_ps(p_delta_time);
+		const __m256 half_dt = _mm256_set1_ps(0.5f * p_delta_time);
+		const __m256 one     = _mm256_set1_ps(1.f);
+
+		size_t i = p_begin;
+		for (; i + 8 <= p_end; i += 8)
+		{
+			_mm256_storeu_ps(&a.position_x[i], _mm256_add_ps(_mm256_loadu_ps(&a.position_x[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.velocity_x[i]), dt)));
+			_mm256_storeu_ps(&a.position_y[i], _mm256_add_ps(_mm256_loadu_ps(&a.position_y[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.velocity_y[i]), dt)));
+			_mm256_storeu_ps(&a.position_z[i], _mm256_add_ps(_mm256_loadu_ps(&a.position_z[i]), _mm256_mul_ps(_mm256_loadu_ps(&a.velocity_z[i]), dt)));
+
+			const __m256 w      = _mm256_loadu_ps(&a.orientation_w[i]);
+			const __m256 x      = _mm256_loadu_ps(&a.orientation_x[i]);
+			const __m256 y      = _mm256_loadu_ps(&a.orientation_y[i]);
+			const __m256 z      = _mm256_loadu_ps(&a.orientation_z[i]);
+			const __m256 spin_x = _mm256_mul_ps(_mm256_loadu_ps(&a.angular_velocity_x[i]), half_dt);
+			const __m256 spin_y = _mm256_mul_ps(_mm256_loadu_ps(&a.angular_velocity_y[i]), half_dt);
+			const __m256 spin_z = _mm256_mul_ps(_mm256_loadu_ps(&a.angular_velocity_z[i]), half_dt);
+
+			const __m256 new_w = _mm256_sub_ps(w, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(spin_x, x), _mm256_mul_ps(spin_y, y)), _mm256_mul_ps(spin_z, z)));
+			const __m256 new_x = _mm256_add_ps(x, _mm256_add_ps(_mm256_mul_ps(spin_x, w), _mm256_sub_ps(_mm256_mul_ps(spin_y, z), _mm256_mul_ps(spin_z, y))));
+			const __m256 new_y = _mm256_add_ps(y, _mm256_add_ps(_mm256_mul_ps(spin_y, w), _mm256_sub_ps(_mm256_mul_ps(spin_z, x), _mm256_mul_ps(spin_x, z))));
+			const __m256 new_z = _mm256_add_ps(z, _mm256_add_ps(_mm256_mul_ps(spin_z, w), _mm256_sub_ps(_mm256_mul_ps(spin_x, y), _mm256_mul_ps(spin_y, x))));
+
+			const __m256 length_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(new_w, new_w), _mm256_mul_ps(new_x, new_x)),
+			                                            _mm256_add_ps(_mm256_mul_ps(new_y, new_y), _mm256_mul_ps(new_z, new_z)));
+			// Full precision sqrt and divide rather than _mm256_rsqrt_ps, the 12-bit estimate drifts the orientation over many ticks.
+			const __m256 inverse_length = _mm256_div_ps(one, _mm256_sqrt_ps(length_squared));
+			_mm256_storeu_ps(&a.orientation_w[i], _mm256_mul_ps(new_w, inverse_length));
+			_mm256_storeu_ps(&a.orientation_x[i], _mm256_mul_ps(new_x, inverse_length));
+			_mm256_storeu_ps(&a.orientation_y[i], _mm256_mul_ps(new_y, inverse_length));
+			_mm256_storeu_ps(&a.orientation_z[i], _mm256_mul_ps(new_z, inverse_length));
+		}
+
+		integrate_positions_scalar(p_arrays, i, p_end, p_delta_time);
+	}
+#endif
+
+	Integrator::Integrator() noexcept
+		: m_arrays{}
+		, m_rigid_bodies{}
+		, m_transforms{}
+	{}
+
+	void Integrator::clear()
+	{
+		m_rigid_bodies.clear();
+		m_transforms.clear();
+	}
+
+	void Integrator::add(Component::RigidBody& p_rigid_body, Component::Transform& p_transform)
+	{
+		m_rigid_bodies.push_back(&p_rigid_body);
+		m_transforms.push_back(&p_transform);
+	}
+
+	void Integrator::resize_arrays()
+	{
+		auto& a = m_arrays;
+		if (a.inverse_mass.size() == size())
+			return;
+
+		for (auto* array : {&a.force_x, &a.force_y, &a.force_z, &a.momentum_x, &a.momentum_y, &a.momentum_z, &a.velocity_x, &a.velocity_y, &a.velocity_z, &a.inverse_mass,
+		                    &a.torque_x, &a.torque_y, &a.torque_z, &a.angular_momentum_x, &a.angular_momentum_y, &a.angular_momentum_z,
+		                    &a.angular_velocity_x, &a.angular_velocity_y, &a.angular_velocity_z,
+		                    &a.position_x, &a.position_y, &a.position_z, &a.orientation_w, &a.orientation_x, &a.orientation_y, &a.orientation_z})
+			array->resize(size());
+		for (auto& array : a.inverse_inertia)
+			array.resize(size());
+	}
+
+	void Integrator::integrate_velocities(float p_delta_time, const glm::vec3& p_gravity, Utility::ThreadPool& p_thread_pool)
+	{
+		integrate_velocities(p_delta_time, p_gravity, p_thread_pool, Utility::instruction_set());
+	}
+	void Integrator::integrate_velocities(float p_delta_time, const glm::vec3& p_gravity, Utility::ThreadPool& p_thread_pool, [[maybe_unused]] Utility::InstructionSet p_instruction_set)
+	{
+		resize_arrays();
+
+		// Each range gathers its bodies into the arrays, integrates them and scatters the results back, so the copies run in parallel
+		// with the kernels and a range's bodies are still in cache when written back.
+		p_thread_pool.parallel_for_ranges(size(), Min_Range_Size, [&](size_t p_begin, size_t p_end)
+		{
+			auto& a = m_arrays;
+			for (size_t i = p_begin; i < p_end; i++)
+			{
+				const auto& rigid_body = *m_rigid_bodies[i];
+				const auto& transform  = *m_transforms[i];
+				const glm::vec3 force  = rigid_body.m_apply_gravity ? rigid_body.m_force + (rigid_body.get_mass() * p_gravity) : rigid_body.m_force; // F = ma
+				a.force_x[i]            = force.x;
+				a.force_y[i]            = force.y;
+				a.force_z[i]            = force.z;
+				a.momentum_x[i]         = rigid_body.m_momentum.x;
+				a.momentum_y[i]         = rigid_body.m_momentum.y;
+				a.momentum_z[i]         = rigid_body.m_momentum.z;
+				a.inverse_mass[i]       = rigid_body.get_inverse_mass();
+
+				a.torque_x[i]           = rigid_body.m_torque.x;
+				a.torque_y[i]           = rigid_body.m_torque.y;
+				a.torque_z[i]           = rigid_body.m_torque.z;
+				a.angular_momentum_x[i] = rigid_body.m_angular_momentum.x;
+				a.angular_momentum_y[i] = rigid_body.m_angular_momentum.y;
+				a.angular_momentum_z[i] = rigid_body.m_angular_momentum.z;
+				const glm::mat3& inverse_inertia = rigid_body.get_world_inverse_inertia_tensor();
+				for (glm::length_t column = 0; column < 3; column++)
+					for (glm::length_t row = 0; row < 3; row++)
+						a.inverse_inertia[column * 3 + row][i] = inverse_inertia[column][row];
+
+				a.position_x[i]    = transform.m_position.x;
+				a.position_y[i]    = transform.m_position.y;
+				a.position_z[i]    = transform.m_position.z;
+				a.orientation_w[i] = transform.m_orientation.w;
+				a.orientation_x[i] = transform.m_orientation.x;
+				a.orientation_y[i] = transform.m_orientation.y;
+				a.orientation_z[i] = transform.m_orientation.z;
+			}
+
+#ifdef Z_X86
+			if (p_instruction_set == Utility::InstructionSet::AVX2)
+				integrate_velocities_AVX2(m_arrays, p_begin, p_end, p_delta_time);
+			else
+#endif
+				integrate_velocities_scalar(m_arrays, p_begin, p_end, p_delta_time);
+
+			for (size_t i = p_begin; i < p_end; i++)
+			{
+				auto& rigid_body = *m_rigid_bodies[i];
+				rigid_body.m_momentum         = glm::vec3(a.momentum_x[i], a.momentum_y[i], a.momentum_z[i]);
+				rigid_body.m_velocity         = glm::vec3(a.velocity_x[i], a.velocity_y[i], a.velocity_z[i]);
+				rigid_body.m_angular_momentum = glm::vec3(a.angular_momentum_x[i], a.angular_momentum_y[i], a.angular_momentum_z[i]);
+				rigid_body.m_angular_velocity = glm::vec3(a.angular_velocity_x[i], a.angular_velocity_y[i], a.angular_velocity_z[i]);
+				rigid_body.m_force            = glm::vec3(0.f); // Reset back to 0 after applying the force on the body.
+			}
+		});
+	}
+
+	void Integrator::integrate_positions(float p_delta_time, Utility::ThreadPool& p_thread_pool)
+	{
+		integrate_positions(p_delta_time, p_thread_pool, Utility::instruction_set());
+	}
+	void Integrator::integrate_positions(float p_delta_time, Utility::ThreadPool& p_thread_pool, [[maybe_unused]] Utility::InstructionSet p_instruction_set)
+	{
+		ASSERT(m_arrays.inverse_mass.size() == size(), "Bodies added since integrate_velocities haven't been gathered");
+
+		p_thread_pool.parallel_for_ranges(size(), Min_Range_Size, [&](size_t p_begin, size_t p_end)
+		{
+			auto& a = m_arrays;
+			for (size_t i = p_begin; i < p_end; i++)
+			{
+				const auto& rigid_body  = *m_rigid_bodies[i];
+				a.velocity_x[i]         = rigid_body.m_velocity.x;
+				a.velocity_y[i]         = rigid_body.m_velocity.y;
+				a.velocity_z[i]         = rigid_body.m_velocity.z;
+				a.angular_velocity_x[i] = rigid_body.m_angular_velocity.x;
+				a.angular_velocity_y[i] = rigid_body.m_angular_velocity.y;
+				a.angular_velocity_z[i] = rigid_body.m_angular_velocity.z;
+			}
+
+#ifdef Z_X86
+			if (p_instruction_set == Utility::InstructionSet::AVX2)
+				integrate_positions_AVX2(m_arrays, p_begin, p_end, p_delta_time);
+			else
+#endif
+				integrate_positions_scalar(m_arrays, p_begin, p_end, p_delta_time);
+
+			for (size_t i = p_begin; i < p_end; i++)
+			{
+				auto& transform = *m_transforms[i];
+				transform.m_position    = glm::vec3(a.position_x[i], a.position_y[i], a.position_z[i]);
+				transform.m_orientation = glm::quat(a.orientation_w[i], a.orientation_x[i], a.orientation_y[i], a.orientation_z[i]);
+				m_rigid_bodies[i]->update_world_inertia(transform.m_orientation);
+			}
+		});
+	}
+} // namespace System
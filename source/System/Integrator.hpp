@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Utility/CPUFeatures.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Component
+{
+	class RigidBody;
+	struct Transform;
+}
+namespace Utility
+{
+	class ThreadPool;
+}
+namespace System
+{
+	// Numerically integrates the awake RigidBodies using packed copies of their state.
+	// Bodies are gathered into structure-of-arrays storage (all x, then all y, then all z) so the kernels evaluate 8 bodies per AVX2
+	// instruction, and the arrays are split into contiguous ranges integrated in parallel. Each range gathers its bodies, integrates them
+	// and scatters the results back, so only collecting the body pointers in add is serial.
+	// The arrays are kept between ticks and only resized when the body count changes.
+	// Integration is split into velocities and positions so a contact solver can run between the two, see PhysicsSystem::integrate.
+	class Integrator
+	{
+	public:
+		// Packed body state, index i of every array belongs to the same body.
+		struct Arrays
+		{
+			std::vector<float> force_x, force_y, force_z;
+			std::vector<float> momentum_x, momentum_y, momentum_z;
+			std::vector<float> velocity_x, velocity_y, velocity_z;
+			std::vector<float> inverse_mass;
+
+			std::vector<float> torque_x, torque_y, torque_z;
+			std::vector<float> angular_momentum_x, angular_momentum_y, angular_momentum_z;
+			std::vector<float> angular_velocity_x, angular_velocity_y, angular_velocity_z;
+			std::array<std::vector<float>, 9> inverse_inertia; // Column-major, element [column * 3 + row].
+
+			std::vector<float> position_x, position_y, position_z;
+			std::vector<float> orientation_w, orientation_x, orientation_y, orientation_z;
+		};
+
+		// Minimum number of bodies per parallel range. Below this the cost of dispatching a range outweighs integrating it.
+		constexpr static size_t Min_Range_Size = 2048;
+
+		Integrator() noexcept;
+
+		// Remove all the bodies keeping the allocations.
+		void clear();
+		// Add a body to integrate. p_rigid_body and p_transform must outlive the next integrate_positions call.
+		// The cached inverse mass and world inverse inertia of p_rigid_body are used, infinite mass bodies should not be added.
+		void add(Component::RigidBody& p_rigid_body, Component::Transform& p_transform);
+		size_t size() const { return m_rigid_bodies.size(); }
+
+		// Integrate forces and torques into momentum and velocity then write them back to the RigidBodies. Resets the force of each body.
+		// The state of every body is gathered from its RigidBody and Transform here, call after the last add of the tick.
+		//@param p_gravity Acceleration due to gravity added to the force of the bodies that apply gravity.
+		void integrate_velocities(float p_delta_time, const glm::vec3& p_gravity, Utility::ThreadPool& p_thread_pool);
+		// integrate_velocities using a specific kernel. p_instruction_set must be supported by the running CPU, see Utility::instruction_set().
+		// Every kernel gives bit-identical results.
+		void integrate_velocities(float p_delta_time, const glm::vec3& p_gravity, Utility::ThreadPool& p_thread_pool, Utility::InstructionSet p_instruction_set);
+		// Integrate the current velocities of the RigidBodies into the position and orientation of their Transforms.
+		// Velocities are re-read from the RigidBodies so changes made after integrate_velocities (e.g. by a contact solver) are integrated.
+		// The world inertia tensors of the RigidBodies are updated for their new orientations.
+		void integrate_positions(float p_delta_time, Utility::ThreadPool& p_thread_pool);
+		// integrate_positions using a specific kernel, see integrate_velocities.
+		void integrate_positions(float p_delta_time, Utility::ThreadPool& p_thread_pool, Utility::InstructionSet p_instruction_set);
+
+	private:
+		Arrays m_arrays;
+		std::vector<Component::RigidBody*> m_rigid_bodies;
+		std::vector<Component::Transform*> m_transforms;
+
+		// Size every array to the body count, keeping the values of the bodies already packed.
+		void resize_arrays();
+	};
+} // namespace System
@@ -7,18 +7,38 @@
 #include "Component/Transform.hpp"
 #include "ECS/Storage.hpp"
 
-#include "Geometry/Geometry.hpp"
 #include "Utility/Utility.hpp"
 
+#include "glm/gtx/norm.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
 namespace System
 {
 	PhysicsSystem::PhysicsSystem(SceneSystem& scene_system, CollisionSystem& collision_system)
 		: m_update_count{0}
 		, m_restitution{0.8f}
+		, m_friction{0.5f}
+		, m_velocity_iterations{10}
 		, m_apply_collision_response{true}
 		, m_bool_apply_kinematic{true}
+		, m_allow_sleeping{true}
 		, m_scene_system{scene_system}
 		, m_collision_system{collision_system}
+		, m_bodies{}
+		, m_body_indices{}
+		, m_union_find{}
+		, m_islands{}
+		, m_island_bodies{}
+		, m_island_manifolds{}
+		, m_solve_islands{}
+		, m_island_solvers{}
+		, m_bullet_impacts{}
+		, m_integrator{}
+		, m_thread_pool{}
+		, m_transform_snapshots{}
 		, m_total_simulation_time{DeltaTime::zero()}
 		, m_gravity{glm::vec3(0.f, -9.81f, 0.f)}
 	{}
@@ -31,71 +51,301 @@ namespace System
 		if (!m_bool_apply_kinematic)
 			return;
 
+		// Bodies awake at the start of the tick are packed once and integrated in two passes either side of the contact solve.
+		m_integrator.clear();
+		m_scene_system.get_current_scene_entities().foreach([this](Component::RigidBody& rigid_body, Component::Transform& transform)
+		{
+			if (!rigid_body.m_asleep && !rigid_body.has_infinite_mass())
+				m_integrator.add(rigid_body, transform);
+		});
+
+		m_integrator.integrate_velocities(p_delta_time.count(), m_gravity, m_thread_pool);
+
+		// Contacts are solved between integrating the velocities and the positions so the positions integrate the constrained velocities.
+		if (m_apply_collision_response)
+		{
+			solve_islands(p_delta_time);
+			update_sleep(p_delta_time);
+			sweep_bullets(p_delta_time);
+		}
+		else
+			m_bullet_impacts.clear();
+
+		m_integrator.integrate_positions(p_delta_time.count(), m_thread_pool);
+
+		// Bullets that hit something stop at the impact instead of where their velocity took them this tick.
+		for (const auto& impact : m_bullet_impacts)
+			impact.transform->m_position = impact.position;
+	}
+
+	void PhysicsSystem::publish_transforms(std::chrono::steady_clock::time_point p_time, const DeltaTime& p_timestep)
+	{
+		const auto& last_snapshot = m_transform_snapshots.published_buffer();
+		auto& snapshot            = m_transform_snapshots.write_buffer();
+		snapshot.clear();
+		snapshot.m_time     = p_time;
+		snapshot.m_timestep = p_timestep;
+
+		m_scene_system.get_current_scene_entities().foreach([&](const ECS::Entity& p_entity, Component::RigidBody&, Component::Transform& p_transform)
+		{
+			// Bodies new since the last publish have no previous Transform to interpolate from.
+			const auto* previous = last_snapshot.find(p_entity);
+			snapshot.set(p_entity, previous ? *previous : p_transform, p_transform);
+		});
+		m_transform_snapshots.publish();
+	}
+	const TransformSnapshot& PhysicsSystem::latest_transforms()
+	{
+		m_transform_snapshots.update();
+		return m_transform_snapshots.read_buffer();
+	}
+
+	void PhysicsSystem::sweep_bullets(const DeltaTime& p_delta_time)
+	{
+		m_bullet_impacts.clear();
+
 		auto& scene = m_scene_system.get_current_scene_entities();
-		scene.foreach([this, &p_delta_time, &scene](ECS::Entity& entity, Component::RigidBody& rigid_body, Component::Transform& transform)
+		scene.foreach([&](const ECS::Entity& p_entity, Component::RigidBody& p_rigid_body, Component::Transform& p_transform)
 		{
-			if (rigid_body.m_apply_gravity)
-				rigid_body.m_force += rigid_body.m_mass * m_gravity; // F = ma
+			if (!p_rigid_body.m_bullet || p_rigid_body.m_asleep || p_rigid_body.has_infinite_mass())
+				return;
 
-			{ // Linear motion
-				// Change in momentum is equal to the force = dp/dt = F
-				const auto change_in_momentum = rigid_body.m_force * p_delta_time.count(); // dp = F dt
-				rigid_body.m_momentum += change_in_momentum;
+			const glm::vec3 displacement = p_rigid_body.m_velocity * p_delta_time.count();
+			const auto impact = m_collision_system.time_of_impact(p_entity, displacement);
+			if (!impact.has_value())
+				return;
 
-				// Convert momentum to velocity by dividing by mass: p = mv
-				rigid_body.m_velocity = rigid_body.m_momentum / rigid_body.m_mass; // v = p/v
+			Component::RigidBody* other = scene.has_components<Component::RigidBody>(impact->other) ? &scene.get_component<Component::RigidBody>(impact->other) : nullptr;
+			const float other_inverse_mass   = other ? other->get_inverse_mass() : 0.f;
+			const glm::vec3 other_velocity   = other ? other->m_velocity : glm::vec3(0.f);
+			const float closing_velocity     = glm::dot(p_rigid_body.m_velocity - other_velocity, impact->normal);
 
-				// Integrate velocity to find new position: dx/dt = v
-				const auto change_in_position = rigid_body.m_velocity * p_delta_time.count(); // dx = v dt
-				transform.m_position += change_in_position;
+			if (closing_velocity > 0.f)
+			{
+				// Single restitution impulse along the impact normal, the contact solver takes over from next tick once the bodies touch.
+				const float impulse = ((1.f + m_restitution) * closing_velocity) / (p_rigid_body.get_inverse_mass() + other_inverse_mass);
 
-				rigid_body.m_force = glm::vec3(0.f); // Reset back to 0 after applying the force on the body.
+				p_rigid_body.m_velocity -= impact->normal * (impulse * p_rigid_body.get_inverse_mass());
+				p_rigid_body.m_momentum  = p_rigid_body.m_velocity * p_rigid_body.get_mass();
+				if (other && !other->has_infinite_mass())
+				{
+					other->m_velocity += impact->normal * (impulse * other_inverse_mass);
+					other->m_momentum  = other->m_velocity * other->get_mass();
+					other->wake();
+				}
 			}
 
-			{ // Angular motion
-				// http://physics.bu.edu/~redner/211-sp06/class-rigid-body/angularmo.html
-				const auto change_in_angular_momentum = rigid_body.m_torque * p_delta_time.count(); // dL = T dt
-				rigid_body.m_angular_momentum += change_in_angular_momentum;
+			m_bullet_impacts.push_back({&p_transform, p_transform.m_position + (displacement * impact->fraction)});
+		});
+	}
 
-				// Convert angular momentum to angular velocity by dividing by inertia tensor: L = Iω
-				rigid_body.m_angular_velocity = rigid_body.m_angular_momentum / rigid_body.m_inertia_tensor; // ω = L / I
+	// Find the root of p_index, halving the path on the way so later finds are near O(1).
+	static size_t find_root(std::vector<size_t>& p_union_find, size_t p_index)
+	{
+		while (p_union_find[p_index] != p_index)
+		{
+			p_union_find[p_index] = p_union_find[p_union_find[p_index]];
+			p_index               = p_union_find[p_index];
+		}
+		return p_index;
+	}
 
-				// To integrate the new quat orientation we convert the angular velocity into quaternion form - spin.
-				// Spin represents a time derivative of orientation. https://www.cs.cmu.edu/~baraff/sigcourse/notesd1.pdf
-				const glm::quat spin = 0.5f * glm::quat(0.f, (rigid_body.m_angular_velocity * p_delta_time.count())) * transform.m_orientation;
+	void PhysicsSystem::solve_islands(const DeltaTime& p_delta_time)
+	{
+		// The manifolds of the last CollisionSystem::update, found at the positions this tick starts from.
+		const auto& manifolds = m_collision_system.get_manifolds();
 
-				// Integrate spin to find the new orientation
-				transform.m_orientation += spin;
-				transform.m_orientation = glm::normalize(transform.m_orientation);
+		auto& scene = m_scene_system.get_current_scene_entities();
+		m_bodies.clear();
+		m_body_indices.clear();
+		scene.foreach([this](ECS::Entity& entity, Component::RigidBody& rigid_body, Component::Transform& transform)
+		{
+			// Infinite mass bodies act as part of the static world, they don't join islands and resolve to the solver's static body.
+			if (rigid_body.has_infinite_mass())
+				return;
+
+			m_body_indices[entity] = m_bodies.size();
+			m_bodies.push_back({entity, &rigid_body, &transform, 0, 0});
+		});
+
+		auto body_index = [this](EntityID p_entity) -> std::optional<size_t>
+		{
+			const auto it = m_body_indices.find(p_entity);
+			return it != m_body_indices.end() ? std::optional<size_t>(it->second) : std::nullopt;
+		};
+
+		{ // Union the bodies of every contact. Static entities (without a RigidBody) don't join islands, a floor shouldn't connect everything resting on it.
+			m_union_find.resize(m_bodies.size());
+			for (size_t i = 0; i < m_union_find.size(); i++)
+				m_union_find[i] = i;
+
+			for (const auto* manifold : manifolds)
+			{
+				const auto body_1 = body_index(manifold->entity_1);
+				const auto body_2 = body_index(manifold->entity_2);
+				if (body_1 && body_2)
+					m_union_find[find_root(m_union_find, *body_1)] = find_root(m_union_find, *body_2);
 			}
+		}
 
-			ECS::Entity collided_entity = ECS::Entity(0);
-			if (auto collision = m_collision_system.get_collision(entity, &collided_entity))
+		{ // Assign each root a dense island index and group the bodies by island with a counting sort.
+			m_islands.clear();
+			std::vector<size_t>& root_island = m_island_bodies; // Reused as scratch before it's filled below.
+			root_island.assign(m_bodies.size(), std::numeric_limits<size_t>::max());
+			for (size_t i = 0; i < m_bodies.size(); i++)
 			{
-				if (m_apply_collision_response)
+				const size_t root = find_root(m_union_find, i);
+				if (root_island[root] == std::numeric_limits<size_t>::max())
 				{
-					// A collision has occurred at the new position, the response depends on the collided entity having a rigibBody to apply a response to.
-					// We already know the collided Entity has a Transform component from CollisionSystem::getCollision so we dont have to check it here.
-					// The collision data returned is original-Entity-centric this convention is carried over in the response here when calling angular_impulse.
-					if (scene.has_components<Component::RigidBody>(collided_entity))
-					{
-						auto& rigid_body_2 = m_scene_system.get_current_scene_entities().get_component<Component::RigidBody>(collided_entity);
-						auto& transform_2  = m_scene_system.get_current_scene_entities().get_component<Component::Transform>(collided_entity);
-
-						auto impulse = Geometry::angular_impulse(collision->position, collision->normal, m_restitution,
-																transform.m_position, rigid_body.m_velocity, rigid_body.m_angular_velocity, rigid_body.m_mass, rigid_body.m_inertia_tensor,
-																transform_2.m_position, rigid_body_2.m_velocity, rigid_body_2.m_angular_velocity, rigid_body_2.m_mass, rigid_body_2.m_inertia_tensor);
-
-						const auto r             = collision->position - transform.m_position;
-						const auto inverseTensor = glm::inverse(rigid_body.m_inertia_tensor);
-
-						rigid_body.m_velocity        = rigid_body.m_velocity + (impulse / rigid_body.m_mass);
-						rigid_body.m_angular_velocity = rigid_body.m_angular_velocity + (glm::cross(r, impulse) * inverseTensor);
-
-						// #TODO: Apply a response to collision.mEntity
-					}
+					root_island[root] = m_islands.size();
+					m_islands.push_back({});
 				}
+
+				auto& island = m_islands[root_island[root]];
+				m_bodies[i].island = root_island[root];
+				island.body_end++; // Count first, converted to ranges below.
+				island.awake |= !m_bodies[i].rigid_body->m_asleep;
+			}
+
+			size_t offset = 0;
+			for (auto& island : m_islands)
+			{
+				island.body_begin = offset;
+				offset           += island.body_end;
+				island.body_end   = island.body_begin;
+			}
+			m_island_bodies.resize(m_bodies.size());
+			for (size_t i = 0; i < m_bodies.size(); i++)
+			{
+				auto& island = m_islands[m_bodies[i].island];
+				m_bodies[i].solver_index = island.body_end - island.body_begin + 1;
+				m_island_bodies[island.body_end++] = i;
+			}
+		}
+
+		{ // Group the manifolds by island. Manifolds between two static entities belong to no island.
+			for (const auto* manifold : manifolds)
+			{
+				const auto body = body_index(manifold->entity_1) ? body_index(manifold->entity_1) : body_index(manifold->entity_2);
+				if (body)
+					m_islands[m_bodies[*body].island].manifold_end++;
+			}
+
+			size_t offset = 0;
+			for (auto& island : m_islands)
+			{
+				island.manifold_begin = offset;
+				offset               += island.manifold_end;
+				island.manifold_end   = island.manifold_begin;
+			}
+			m_island_manifolds.resize(offset);
+			for (auto* manifold : manifolds)
+			{
+				const auto body_1 = body_index(manifold->entity_1);
+				const auto body_2 = body_index(manifold->entity_2);
+				if (!body_1 && !body_2)
+					continue;
+
+				const size_t island = m_bodies[body_1 ? *body_1 : *body_2].island;
+				m_island_manifolds[m_islands[island].manifold_end++] = {manifold, body_1 ? m_bodies[*body_1].solver_index : 0, body_2 ? m_bodies[*body_2].solver_index : 0};
+			}
+		}
+
+		// An awake body touching a sleeping island wakes the whole island.
+		m_solve_islands.clear();
+		for (size_t i = 0; i < m_islands.size(); i++)
+		{
+			const auto& island = m_islands[i];
+			if (!island.awake)
+				continue;
+
+			for (size_t j = island.body_begin; j < island.body_end; j++)
+			{
+				if (m_bodies[m_island_bodies[j]].rigid_body->m_asleep)
+					m_bodies[m_island_bodies[j]].rigid_body->wake();
+			}
+			if (island.manifold_begin != island.manifold_end)
+				m_solve_islands.push_back(i);
+		}
+		if (m_island_solvers.size() < m_solve_islands.size())
+			m_island_solvers.resize(m_solve_islands.size());
+
+		// Islands share no bodies or manifolds so each is solved on its own thread without synchronisation.
+		m_thread_pool.parallel_for(m_solve_islands.size(), [this, &p_delta_time](size_t p_index)
+		{
+			const auto& island = m_islands[m_solve_islands[p_index]];
+			auto& solver       = m_island_solvers[p_index];
+			solver.clear();
+
+			for (size_t i = island.body_begin; i < island.body_end; i++)
+			{
+				const auto& body       = m_bodies[m_island_bodies[i]];
+				const auto& rigid_body = *body.rigid_body;
+
+				SolverBody solver_body;
+				solver_body.position         = body.transform->m_position;
+				solver_body.velocity         = rigid_body.m_velocity;
+				solver_body.angular_velocity = rigid_body.m_angular_velocity;
+				solver_body.inverse_inertia  = rigid_body.get_world_inverse_inertia_tensor();
+				solver_body.inverse_mass     = rigid_body.get_inverse_mass();
+				solver.add_body(solver_body);
+			}
+
+			for (size_t i = island.manifold_begin; i < island.manifold_end; i++)
+				solver.add_manifold(*m_island_manifolds[i].manifold, m_island_manifolds[i].solver_body_1, m_island_manifolds[i].solver_body_2, m_friction, m_restitution, p_delta_time.count());
+
+			solver.solve(m_velocity_iterations);
+
+			// Velocities are derived from momentum each tick, write the solved velocities back as momentum so the response persists.
+			for (size_t i = island.body_begin; i < island.body_end; i++)
+			{
+				const auto& body        = m_bodies[m_island_bodies[i]];
+				auto& rigid_body        = *body.rigid_body;
+				const auto& solver_body = solver.get_body(body.solver_index);
+				rigid_body.m_velocity         = solver_body.velocity;
+				rigid_body.m_angular_velocity = solver_body.angular_velocity;
+				rigid_body.m_momentum         = rigid_body.m_velocity * rigid_body.get_mass();                        // p = mv
+				rigid_body.m_angular_momentum = rigid_body.get_world_inertia_tensor() * rigid_body.m_angular_velocity; // L = Iω
 			}
 		});
 	}
+
+	void PhysicsSystem::update_sleep(const DeltaTime& p_delta_time)
+	{
+		for (const auto& island : m_islands)
+		{
+			if (!island.awake)
+				continue;
+
+			// An island can only sleep as a whole, a single moving body keeps every body it touches awake.
+			bool at_rest = m_allow_sleeping;
+			for (size_t i = island.body_begin; i < island.body_end && at_rest; i++)
+			{
+				const auto& rigid_body = *m_bodies[m_island_bodies[i]].rigid_body;
+				at_rest = glm::length2(rigid_body.m_velocity)         < Sleep_Linear_Velocity * Sleep_Linear_Velocity
+				       && glm::length2(rigid_body.m_angular_velocity) < Sleep_Angular_Velocity * Sleep_Angular_Velocity;
+			}
+
+			float min_sleep_timer = std::numeric_limits<float>::max();
+			for (size_t i = island.body_begin; i < island.body_end; i++)
+			{
+				auto& rigid_body         = *m_bodies[m_island_bodies[i]].rigid_body;
+				rigid_body.m_sleep_timer = at_rest ? rigid_body.m_sleep_timer + p_delta_time.count() : 0.f;
+				min_sleep_timer          = std::min(min_sleep_timer, rigid_body.m_sleep_timer);
+			}
+
+			if (min_sleep_timer < Time_To_Sleep)
+				continue;
+
+			for (size_t i = island.body_begin; i < island.body_end; i++)
+			{
+				auto& rigid_body = *m_bodies[m_island_bodies[i]].rigid_body;
+				rigid_body.m_asleep           = true;
+				rigid_body.m_velocity         = glm::vec3(0.f);
+				rigid_body.m_angular_velocity = glm::vec3(0.f);
+				rigid_body.m_momentum         = glm::vec3(0.f);
+				rigid_body.m_angular_momentum = glm::vec3(0.f);
+			}
+		}
+	}
 } // namespace System
\ No newline at end of file
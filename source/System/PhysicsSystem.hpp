@@ -1,13 +1,29 @@
 #pragma once
 
+#include "ContactSolver.hpp"
+#include "Integrator.hpp"
+#include "TransformSnapshot.hpp"
+
 #include "glm/vec3.hpp"
 
 #include "Utility/Config.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "Utility/TripleBuffer.hpp"
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
 
+namespace Component
+{
+	class RigidBody;
+	struct Transform;
+}
 namespace System
 {
 	class SceneSystem;
 	class CollisionSystem;
+	struct ContactManifold;
 
 	// A numerical integrator, PhysicsSystem take Transform and RigidBody components and applies kinematic equations.
 	// The system is force based and numerically integrates
@@ -17,15 +33,89 @@ namespace System
 		PhysicsSystem(SceneSystem& scene_system, CollisionSystem& collision_system);
 		void integrate(const DeltaTime& delta_time);
 
+		// Copy the Transform of every RigidBody into a TransformSnapshot and make it the latest for latest_transforms.
+		// The previous Transform of each body is taken from the last publish so the renderer can interpolate between the two.
+		// Called by the thread running the physics after each integrate and CollisionSystem::update.
+		//@param p_time The time the physics has been advanced to.
+		//@param p_timestep The time between this publish and the last.
+		void publish_transforms(std::chrono::steady_clock::time_point p_time, const DeltaTime& p_timestep);
+		// The TransformSnapshot of the last publish_transforms. Lock-free, the renderer reads RigidBody Transforms from here while
+		// the physics thread writes the ECS. The returned reference is valid until the next call, only one thread may call this.
+		const TransformSnapshot& latest_transforms();
+		// Number of islands the RigidBodies were grouped into by the last integrate, each body without contacts is an island of its own.
+		size_t island_count() const { return m_islands.size(); }
+
+		constexpr static float Sleep_Linear_Velocity  = 0.05f; // Speed (m/s) below which a body is considered at rest.
+		constexpr static float Sleep_Angular_Velocity = 0.05f; // Angular speed (rad/s) below which a body is considered at rest.
+		constexpr static float Time_To_Sleep          = 0.5f;  // Time (s) every body of an island must be at rest before the island sleeps.
+
 		size_t m_update_count;
 		float m_restitution;             // Coefficient of restitution applied in collision response.
+		float m_friction;                // Coefficient of friction applied in collision response.
+		int m_velocity_iterations;       // Number of iterations the ContactSolver runs per tick.
 		bool m_apply_collision_response; // Whether to apply collision response or not.
 		bool m_bool_apply_kinematic;     // Whether to apply kinematic equations or not.
+		bool m_allow_sleeping;           // Whether islands at rest are put to sleep.
 
 	private:
+		// A set of bodies connected by contacts. Bodies only interact with other bodies of their island,
+		// so islands are woken, put to sleep and solved independently of each other.
+		struct Island
+		{
+			size_t body_begin     = 0; // Range into m_island_bodies.
+			size_t body_end       = 0;
+			size_t manifold_begin = 0; // Range into m_island_manifolds.
+			size_t manifold_end   = 0;
+			bool awake            = false;
+		};
+		// Position a bullet is moved back to after integration, where its sweep first hit another collider.
+		struct BulletImpact
+		{
+			Component::Transform* transform;
+			glm::vec3 position;
+		};
+		struct IslandBody
+		{
+			EntityID entity;
+			Component::RigidBody* rigid_body;
+			Component::Transform* transform;
+			size_t island;
+			size_t solver_index; // Index of the body in its island's ContactSolver, the order it's added in after the static world.
+		};
+		// A manifold with the ContactSolver indices of its bodies resolved when it's grouped, 0 for a static entity.
+		struct IslandManifold
+		{
+			ContactManifold* manifold;
+			size_t solver_body_1;
+			size_t solver_body_2;
+		};
+
 		SceneSystem& m_scene_system;
 		CollisionSystem& m_collision_system;
 
+		// Island state rebuilt every tick. Kept as members to reuse the allocations.
+		std::vector<IslandBody> m_bodies;
+		std::unordered_map<EntityID, size_t> m_body_indices;  // EntityID to index into m_bodies.
+		std::vector<size_t> m_union_find;                     // Parent of each body in m_bodies, the root identifies the island.
+		std::vector<Island> m_islands;
+		std::vector<size_t> m_island_bodies;                  // Indices into m_bodies grouped by island.
+		std::vector<IslandManifold> m_island_manifolds;       // Manifolds grouped by island.
+		std::vector<size_t> m_solve_islands;                  // Awake islands with contacts to solve this tick.
+		std::vector<ContactSolver> m_island_solvers;          // One per island in m_solve_islands, grown but never shrunk.
+		std::vector<BulletImpact> m_bullet_impacts;          // Impacts found by sweep_bullets this tick.
+		Integrator m_integrator;
+		Utility::ThreadPool m_thread_pool;                    // Runs the integrator ranges and the island solves.
+		Utility::TripleBuffer<TransformSnapshot> m_transform_snapshots; // Written by publish_transforms, read by latest_transforms.
+
+		// Group the RigidBodies into islands using the manifolds of the last CollisionSystem::update.
+		// Islands touched by an awake body are woken, then the contacts of every awake island are solved in parallel.
+		void solve_islands(const DeltaTime& p_delta_time);
+		// Sweep the awake bullet RigidBodies along their velocity for this tick and respond to the first impact of each.
+		// A bullet that hits is given a restitution impulse against what it hit and recorded in m_bullet_impacts to stop it at the impact.
+		void sweep_bullets(const DeltaTime& p_delta_time);
+		// Advance the sleep timers of the awake islands, putting islands that have been at rest for Time_To_Sleep to sleep.
+		void update_sleep(const DeltaTime& p_delta_time);
+
 		DeltaTime m_total_simulation_time; // Total time simulated using the integrate function.
 		glm::vec3 m_gravity;               // The acceleration due to gravity.
 	};
@@ -26,6 +26,7 @@ namespace System
 		, m_mesh_system(p_mesh_system)
 		, m_scenes{}
 		, m_current_scene_index{0}
+		, m_mutex{}
 	{
 		auto& scene = add_scene();
 		set_current_scene(scene);
@@ -47,6 +48,7 @@ namespace System
 			m_bound.m_min = glm::vec3(0.f);
 			m_bound.m_max = glm::vec3(0.f);
 
+			m_mesh_AABBs.clear();
 			m_entities.foreach([&](ECS::Entity p_entity, Component::Transform& p_transform, Component::Mesh& p_mesh)
 			{
 				if (m_entities.has_components<Component::Collider>(p_entity))
@@ -55,11 +57,12 @@ namespace System
 					m_bound.unite(collider.m_world_AABB);
 				}
 				else
-				{
-					const auto world_AABB = Geometry::AABB::transform(p_mesh.m_mesh->AABB, p_transform.m_position, glm::mat4_cast(p_transform.m_orientation), p_transform.m_scale);
-					m_bound.unite(world_AABB);
-				}
+					m_mesh_AABBs.add(p_mesh.m_mesh->AABB, p_transform.m_position, p_transform.m_orientation, p_transform.m_scale);
 			});
+
+			m_mesh_AABBs.transform();
+			for (size_t i = 0; i < m_mesh_AABBs.size(); i++)
+				m_bound.unite(m_mesh_AABBs[i]);
 		}
 		{// Update the view information
 			if (view_info_override)
@@ -117,9 +120,12 @@ namespace System
 			auto transform    = Component::Transform{glm::vec3(0.f, 0.f, 0.f)};
 			transform.m_scale  = glm::vec3(10.f, 1.f, 10.f);
 
+			Component::RigidBody rigid_body;
+			rigid_body.set_infinite_mass(true); // The floor is static, the ball bounces off it without moving it.
+
 			p_scene.m_entities.add_entity(
 				Component::Label{"Floor"},
-				Component::RigidBody{},
+				rigid_body,
 				Component::Texture{m_texture_system.getTexture(Config::Texture_Directory / "wood_floor.png")},
 				transform,
 				Component::Mesh{m_mesh_system.m_quad},
@@ -145,7 +151,7 @@ namespace System
 				Component::RigidBody{},
 				Component::Transform{glm::vec3(running_x, start_y, -mesh_width)},
 				Component::Mesh{m_mesh_system.m_cube},
-				Component::Collider{},
+				Component::Collider{Component::Collider::Shape::Box},
 				texture);
 			running_x += increment;
 		}
@@ -165,7 +171,7 @@ namespace System
 				Component::RigidBody{},
 				Component::Transform{glm::vec3(running_x, start_y, -mesh_width)},
 				Component::Mesh{m_mesh_system.m_cylinder},
-				Component::Collider{});
+				Component::Collider{Component::Collider::Shape::Cylinder});
 			running_x += increment;
 		}
 		{ // quad
@@ -183,7 +189,7 @@ namespace System
 				Component::RigidBody{},
 				Component::Transform{glm::vec3(running_x, start_y, -mesh_width)},
 				Component::Mesh{m_mesh_system.m_sphere},
-				Component::Collider{});
+				Component::Collider{Component::Collider::Shape::Sphere});
 			running_x += increment;
 		}
 		{ // Lights
@@ -232,7 +238,7 @@ namespace System
 					Component::Label("Cube " + std::to_string((i / 2) + 1)),
 					Component::Mesh(m_mesh_system.m_cube),
 					Component::Transform{glm::vec3(i, 0.f, 0.f)},
-					Component::Collider{},
+					Component::Collider{Component::Collider::Shape::Box},
 					Component::RigidBody{},
 					texture);
 			}
@@ -288,7 +294,7 @@ namespace System
 			Component::Transform{glm::vec3(2.f, 0.f, 0.f)},
 			Component::Mesh{icosphere_meshref},
 			Component::Texture{glm::vec4(0.5f, 0.5f, 0.5f, 0.6f)}, // Grey
-			Component::Collider{});
+			Component::Collider{Component::Collider::Shape::Sphere});
 
 		p_scene.m_entities.add_entity(
 			Component::Label{"Sphere 2"},
@@ -296,7 +302,7 @@ namespace System
 			Component::Transform{glm::vec3(5.f, 0.f, 0.f)},
 			Component::Mesh{icosphere_meshref},
 			Component::Texture{glm::vec4(1.f, 0.647f, 0.f, 0.6f)}, // Orange
-			Component::Collider{});
+			Component::Collider{Component::Collider::Shape::Sphere});
 	}
 	void SceneSystem::constructBouncingBallScene(Scene& p_scene)
 	{
@@ -315,16 +321,19 @@ namespace System
 			texture.m_specular = m_texture_system.getTexture(containerSpecular);
 
 			Component::RigidBody rigidBody;
-			rigidBody.m_mass = 1.f;
-			p_scene.m_entities.add_entity(mesh, transform, Component::Collider(), rigidBody, name);
+			rigidBody.set_mass(1.f);
+			p_scene.m_entities.add_entity(mesh, transform, Component::Collider(Component::Collider::Shape::Sphere), rigidBody, name);
 		}
 		{ // Floor
 			auto transform     = Component::Transform{glm::vec3(0.f, 0.f, 0.f)};
 			transform.m_scale  = glm::vec3(10.f, 1.f, 10.f);
 
+			Component::RigidBody rigid_body;
+			rigid_body.set_infinite_mass(true); // The floor is static, the ball bounces off it without moving it.
+
 			p_scene.m_entities.add_entity(
 				Component::Label{"Floor"},
-				Component::RigidBody{},
+				rigid_body,
 				Component::Texture{m_texture_system.getTexture(Config::Texture_Directory / "wood_floor.png")},
 				transform,
 				Component::Mesh{m_mesh_system.m_quad},
@@ -2,9 +2,11 @@
 
 #include "ECS/Storage.hpp"
 #include "Geometry/AABB.hpp"
+#include "Geometry/AABBBatch.hpp"
 #include "Component/ViewInformation.hpp"
 
 #include <memory>
+#include <mutex>
 
 namespace System
 {
@@ -20,10 +22,14 @@ namespace System
 
 		// When the state of the scene changes update the m_bound and m_view_information.
 		// Should be called when the scene is first created, when entities are added/removed/changed, when the aspect ratio changes or when the editor changes the scene.
+		// Entities with a Collider are bound by the Collider::m_world_AABB of the last CollisionSystem::update, the rest are transformed here in one batch.
 		void update(float aspect_ratio, Component::ViewInformation* view_info_override = nullptr);
 
 		static void serialise(std::ostream& p_out, uint16_t p_version, const Scene& p_Scene);
 		static Scene deserialise(std::istream& p_in, uint16_t p_version);
+
+	private:
+		Geometry::AABBBatch m_mesh_AABBs; // World AABBs of the meshes without a Collider, reused across update calls to keep the allocations.
 	};
 
 	class SceneSystem
@@ -33,6 +39,7 @@ namespace System
 
 		std::vector<std::unique_ptr<Scene>> m_scenes;
 		size_t m_current_scene_index;
+		std::mutex m_mutex;
 
 	public:
 		SceneSystem(TextureSystem& p_texture_system, MeshSystem& p_mesh_system);
@@ -44,6 +51,10 @@ namespace System
 		Scene& add_scene()                                              { return *m_scenes.emplace_back(std::make_unique<Scene>()); }
 		ECS::Storage& get_current_scene_entities()                      { return m_scenes[m_current_scene_index]->m_entities; }
 		const Component::ViewInformation& get_current_scene_view_info() { return m_scenes[m_current_scene_index]->m_view_information; }
+		// Guards the scenes between the main thread and the physics thread. The physics thread holds it for every tick, the main thread
+		// whenever it changes the scenes or reads state the physics writes (Transform and RigidBody of RigidBodies, Collider).
+		// Rendering reads RigidBody Transforms from PhysicsSystem::latest_transforms instead so it runs alongside the physics.
+		std::mutex& get_mutex()                                         { return m_mutex; }
 
 	private:
 		void add_default_camera(Scene& p_scene);
@@ -0,0 +1,60 @@
+#include "TransformSnapshot.hpp"
+
+#include "glm/gtc/quaternion.hpp"
+
+#include <algorithm>
+
+namespace System
+{
+	TransformSnapshot::TransformSnapshot() noexcept
+		: m_previous{}
+		, m_current{}
+		, m_has_transform{}
+		, m_time{}
+		, m_timestep{DeltaTime::zero()}
+	{}
+
+	void TransformSnapshot::clear()
+	{
+		m_has_transform.assign(m_has_transform.size(), false);
+	}
+	void TransformSnapshot::set(EntityID p_entity, const Component::Transform& p_previous, const Component::Transform& p_current)
+	{
+		if (p_entity >= m_has_transform.size())
+		{
+			m_previous.resize(p_entity + 1);
+			m_current.resize(p_entity + 1);
+			m_has_transform.resize(p_entity + 1, false);
+		}
+		m_previous[p_entity]      = p_previous;
+		m_current[p_entity]       = p_current;
+		m_has_transform[p_entity] = true;
+	}
+	const Component::Transform* TransformSnapshot::find(EntityID p_entity) const
+	{
+		return p_entity < m_has_transform.size() && m_has_transform[p_entity] ? &m_current[p_entity] : nullptr;
+	}
+
+	float TransformSnapshot::get_alpha(std::chrono::steady_clock::time_point p_time) const
+	{
+		if (m_timestep <= DeltaTime::zero())
+			return 1.f;
+
+		const auto since_tick = std::chrono::duration_cast<DeltaTime>(p_time - m_time);
+		return std::clamp(since_tick / m_timestep, 0.f, 1.f);
+	}
+	std::optional<glm::mat4> TransformSnapshot::get_model(EntityID p_entity, float p_alpha) const
+	{
+		if (p_entity >= m_has_transform.size() || !m_has_transform[p_entity])
+			return std::nullopt;
+
+		const auto& previous = m_previous[p_entity];
+		const auto& current  = m_current[p_entity];
+
+		Component::Transform interpolated;
+		interpolated.m_position    = previous.m_position + (current.m_position - previous.m_position) * p_alpha;
+		interpolated.m_scale       = previous.m_scale    + (current.m_scale    - previous.m_scale)    * p_alpha;
+		interpolated.m_orientation = glm::slerp(previous.m_orientation, current.m_orientation, p_alpha);
+		return interpolated.get_model();
+	}
+} // namespace System
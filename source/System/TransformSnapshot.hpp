@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ECS/Entity.hpp"
+
+#include "Component/Transform.hpp"
+
+#include "Utility/Config.hpp"
+
+#include "glm/mat4x4.hpp"
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace System
+{
+	// A copy of the Transform of every RigidBody at the end of a physics tick along with its Transform at the end of the tick before.
+	// Published by the physics thread for the renderer to read without touching the Transforms the physics thread is writing.
+	// Stored densely by EntityID so a lookup while drawing is an index rather than a search.
+	//
+	// Rendering happens between physics ticks, drawing the current Transforms would stutter whenever the render and physics rates differ.
+	// Instead the renderer draws the bodies interpolated between the previous and current Transform by how far the render time is into
+	// the next tick. This shows the physics one tick late but never predicts a position the physics won't reach, unlike extrapolation.
+	class TransformSnapshot
+	{
+		std::vector<Component::Transform> m_previous;   // Indexed by EntityID.
+		std::vector<Component::Transform> m_current;    // Indexed by EntityID.
+		std::vector<bool> m_has_transform;              // Indexed by EntityID, true if m_previous and m_current hold the Transforms of that entity.
+
+	public:
+		TransformSnapshot() noexcept;
+
+		std::chrono::steady_clock::time_point m_time; // The time the physics was advanced to, the time of the current Transforms.
+		DeltaTime m_timestep;                          // The time between the previous and current Transforms.
+
+		// Remove all the Transforms keeping the allocations.
+		void clear();
+		void set(EntityID p_entity, const Component::Transform& p_previous, const Component::Transform& p_current);
+		//@return The current Transform of p_entity or nullptr if p_entity had no RigidBody.
+		const Component::Transform* find(EntityID p_entity) const;
+
+		//@return How far p_time is into the tick after m_time as a fraction of m_timestep, clamped to [0, 1].
+		float get_alpha(std::chrono::steady_clock::time_point p_time) const;
+		//@param p_alpha Fraction of the way from the previous to the current Transform, see get_alpha.
+		//@return The model matrix of p_entity interpolated between its previous and current Transform or nullopt if p_entity had no RigidBody.
+		std::optional<glm::mat4> get_model(EntityID p_entity, float p_alpha) const;
+	};
+} // namespace System
@@ -1,9 +1,13 @@
 #include "Test/TestManager.hpp"
+#include "Test/Tests/CollisionTester.hpp"
 #include "Test/Tests/ComponentSerialiseTester.hpp"
 #include "Test/Tests/ECSTester.hpp"
 #include "Test/Tests/GeometryTester.hpp"
+#include "Test/Tests/PhysicsTester.hpp"
+#include "Test/Tests/PlatformTester.hpp"
 #include "Test/Tests/ResourceManagerTester.hpp"
 #include "Test/Tests/GraphicsTester.hpp"
+#include "Test/Tests/UtilityTester.hpp"
 
 #include <cstring>
 #include "Utility/Stopwatch.hpp"
@@ -34,10 +38,14 @@ int main(int argc, char* argv[])
 	const char* seperator = "--------------------------------------------------\n";
 
 	std::vector<std::unique_ptr<Test::TestManager>> test_managers;
+	test_managers.emplace_back(std::make_unique<Test::CollisionTester>(!skip_graphics_test));
 	test_managers.emplace_back(std::make_unique<Test::ComponentSerialiseTester>());
 	test_managers.emplace_back(std::make_unique<Test::ECSTester>());
 	test_managers.emplace_back(std::make_unique<Test::GeometryTester>());
+	test_managers.emplace_back(std::make_unique<Test::PhysicsTester>(!skip_graphics_test));
+	test_managers.emplace_back(std::make_unique<Test::PlatformTester>());
 	test_managers.emplace_back(std::make_unique<Test::ResourceManagerTester>());
+	test_managers.emplace_back(std::make_unique<Test::UtilityTester>());
 	if (!skip_graphics_test)
 		test_managers.emplace_back(std::make_unique<Test::GraphicsTester>());
 
@@ -63,6 +71,16 @@ int main(int argc, char* argv[])
 		unit_test_overall_fail_count += tester->m_unit_tests_fail_count;
 		unit_tests_failed_messages += tester->m_unit_tests_failed_messages;
 	}
+	if (should_run_perf_tests)
+	{
+		for (auto& tester : test_managers)
+		{
+			printf("***************** STARTING %s PERFORMANCE TESTS *****************\n", tester->m_name.c_str());
+			tester->run_performance_tests();
+			printf("%s", seperator);
+		}
+	}
+
 	printf("\n\n***************** OVERALL SUMMARY *****************\nTOTAL TESTS: %zu\nPASSED: %zu\nFAILED: %zu\nTIME TAKEN: %fms\n%s",
 		unit_test_overall_pass_count + unit_test_overall_fail_count,
 		unit_test_overall_pass_count,
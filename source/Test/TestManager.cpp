@@ -1,5 +1,10 @@
 #include "TestManager.hpp"
 
+#include "Utility/Stopwatch.hpp"
+
+#include <algorithm>
+#include <limits>
+
 namespace Test
 {
 	std::string to_string(const std::source_location& p_location)
@@ -44,6 +49,23 @@ namespace Test
 		}
 	}
 
+	void TestManager::run_performance_test(const std::string& p_name, size_t p_operations, const std::function<size_t()>& p_test)
+	{
+		size_t result = p_test();
+		double fastest_ms = std::numeric_limits<double>::max();
+		for (size_t i = 0; i < Performance_Test_Repeats; i++)
+		{
+			Utility::Stopwatch stopwatch;
+			result     = p_test();
+			fastest_ms = std::min(fastest_ms, stopwatch.duration_since_start<double, std::milli>().count());
+		}
+
+		const double operations_per_second = fastest_ms > 0.0 ? static_cast<double>(p_operations) / (fastest_ms / 1000.0) : 0.0;
+		const std::string name             = running_section_name.empty() ? p_name : running_section_name + " - " + p_name;
+		printf("PERF %s: %zu ops in %.3fms, %.2f Mops/s, %.1fns/op (result %zu)\n", name.c_str(), p_operations, fastest_ms,
+			operations_per_second / 1e6, p_operations > 0 ? fastest_ms * 1e6 / static_cast<double>(p_operations) : 0.0, result);
+	}
+
 	void TestManager::push_section(const std::string& p_section_name)
 	{
 		running_section_name += '[' + p_section_name + ']';
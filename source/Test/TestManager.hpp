@@ -4,6 +4,7 @@
 #include "glm/gtc/quaternion.hpp"
 #include "Geometry/Triangle.hpp"
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <format>
@@ -47,6 +48,8 @@ namespace Test
 	class TestManager
 	{
 	public:
+		constexpr static size_t Performance_Test_Repeats = 5;
+
 		TestManager(const std::string& p_name) noexcept;
 
 		std::string m_name;
@@ -77,6 +80,10 @@ namespace Test
 		friend ScopeSection;
 
 		void run_unit_test(const bool& p_condition, const std::string& p_name, const std::string& p_fail_message);
+		// Time p_test, which calls the kernel being measured p_operations times, and print the kernel throughput.
+		// p_test is run once to warm the caches then Performance_Test_Repeats times, the fastest run is reported.
+		// p_test returns a value computed from the kernel results, e.g. a hit count, printed so the calls can't be optimised away.
+		void run_performance_test(const std::string& p_name, size_t p_operations, const std::function<size_t()>& p_test);
 		void push_section(const std::string& p_section_name);
 		void pop_section();
 
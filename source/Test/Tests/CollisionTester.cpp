@@ -0,0 +1,322 @@
+#include "CollisionTester.hpp"
+#include "ComponentInfos.hpp"
+
+#include "Component/Collider.hpp"
+#include "Component/Mesh.hpp"
+#include "Component/RigidBody.hpp"
+#include "Component/Terrain.hpp"
+#include "Component/Transform.hpp"
+
+#include "Platform/Core.hpp"
+#include "Platform/Input.hpp"
+#include "Platform/Window.hpp"
+
+#include "System/CollisionSystem.hpp"
+#include "System/EntityPairMap.hpp"
+#include "System/MeshSystem.hpp"
+#include "System/SceneSystem.hpp"
+#include "System/TextureSystem.hpp"
+
+#include "Utility/Utility.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtx/norm.hpp"
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_HIDES_PREVIOUS_DECLERATION // Required to allow shadowing for the SCOPE_SECTION macro
+
+namespace Test
+{
+	void CollisionTester::run_unit_tests()
+	{
+		run_entity_pair_map_tests();
+
+		if (m_graphics)
+		{
+			Platform::Core::initialise_directories();
+			Platform::Core::initialise_GLFW();
+			Platform::Input input   = Platform::Input();
+			Platform::Window window = Platform::Window(1920, 1080, input);
+			Platform::Core::initialise_OpenGL();
+			EngineComponentInfos component_infos;
+
+			run_contact_event_tests();
+			run_triangle_mesh_tests();
+
+			Platform::Core::deinitialise_GLFW();
+		}
+	}
+	void CollisionTester::run_performance_tests()
+	{}
+
+	// The slot p_key is probed from in an EntityPairMap of p_capacity slots, mirrors EntityPairMap::hash.
+	static size_t home_slot(const std::pair<EntityID, EntityID>& p_key, size_t p_capacity)
+	{
+		uint64_t hash = (static_cast<uint64_t>(p_key.first) * 0x9E3779B97F4A7C15ull) ^ static_cast<uint64_t>(p_key.second);
+		hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+		hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+		return static_cast<size_t>(hash ^ (hash >> 31)) & (p_capacity - 1);
+	}
+
+	void CollisionTester::run_entity_pair_map_tests()
+	{
+		using Map = System::EntityPairMap<size_t>;
+		SCOPE_SECTION("EntityPairMap");
+
+		{SCOPE_SECTION("Insert with growth")
+			Map map;
+			CHECK_TRUE(map.empty(), "Starts empty");
+			CHECK_TRUE(map.find({1, 2}) == nullptr, "Find in empty map");
+
+			constexpr size_t Pair_Count = 1000; // Grows from the minimum of 64 slots to 2048.
+			for (size_t i = 0; i < Pair_Count; i++)
+				map[{i, i + 1}] = i;
+			CHECK_EQUAL(map.size(), Pair_Count, "Size after inserts");
+
+			bool all_found = true;
+			for (size_t i = 0; i < Pair_Count; i++)
+			{
+				const size_t* value = map.find({i, i + 1});
+				all_found = all_found && value != nullptr && *value == i;
+			}
+			CHECK_TRUE(all_found, "Every pair found with its value after growing");
+			CHECK_TRUE(map.find({1, 0}) == nullptr, "Reversed pair is a different key");
+			CHECK_TRUE(map.find({Pair_Count, Pair_Count + 1}) == nullptr, "Pair never inserted");
+
+			map[{10, 11}] = 42;
+			CHECK_EQUAL(map.size(), Pair_Count, "Inserting an existing pair doesn't add an entry");
+			CHECK_EQUAL(*map.find({10, 11}), 42, "Existing pair's value is returned");
+		}
+		{SCOPE_SECTION("erase_if wrapping probe run")
+			// Three keys homed on the last of the 64 slots fill it then wrap to slots 0 and 1, a key homed on slot 0 is pushed on to slot 2.
+			std::vector<Map::Key> last_slot_keys;
+			std::optional<Map::Key> first_slot_key;
+			for (EntityID i = 0; last_slot_keys.size() < 3 || !first_slot_key; i++)
+			{
+				const Map::Key key = {i, i + 1};
+				const size_t slot  = home_slot(key, 64);
+				if (slot == 63 && last_slot_keys.size() < 3)
+					last_slot_keys.push_back(key);
+				else if (slot == 0 && !first_slot_key)
+					first_slot_key = key;
+			}
+
+			Map map;
+			for (size_t i = 0; i < last_slot_keys.size(); i++)
+				map[last_slot_keys[i]] = i;
+			map[*first_slot_key] = 3;
+
+			std::vector<Map::Key> slot_order;
+			auto collect_slot_order = [&]()
+			{
+				slot_order.clear();
+				map.for_each([&](const Map::Key& p_key, size_t&) { slot_order.push_back(p_key); });
+			};
+			collect_slot_order();
+			CHECK_TRUE(slot_order.size() == 4 && slot_order.front() == last_slot_keys[1] && slot_order.back() == last_slot_keys[0], "Probe run wraps past the end of the table");
+
+			// Erasing the entry in the last slot shifts the rest of the run back across the end of the table.
+			size_t predicate_calls = 0;
+			map.erase_if([&](const Map::Key&, size_t& p_value) { predicate_calls++; return p_value == 0; });
+			CHECK_EQUAL(predicate_calls, 4, "Predicate called once per entry");
+			CHECK_EQUAL(map.size(), 3, "Size after erase");
+			collect_slot_order();
+			CHECK_TRUE(slot_order.size() == 3 && slot_order.front() == last_slot_keys[2] && slot_order.back() == last_slot_keys[1], "Wrapped entries shifted back into the last slot");
+
+			{SCOPE_SECTION("find after erase")
+				CHECK_TRUE(map.find(last_slot_keys[0]) == nullptr, "Erased key not found");
+				CHECK_TRUE(map.find(last_slot_keys[1]) != nullptr && *map.find(last_slot_keys[1]) == 1, "Key shifted across the end found");
+				CHECK_TRUE(map.find(last_slot_keys[2]) != nullptr && *map.find(last_slot_keys[2]) == 2, "Key shifted into slot 0 found");
+				CHECK_TRUE(map.find(*first_slot_key) != nullptr && *map.find(*first_slot_key) == 3, "Key shifted towards its home slot found");
+			}
+
+			// Two marked entries, one either side of the end of the table.
+			predicate_calls = 0;
+			map.erase_if([&](const Map::Key&, size_t& p_value) { predicate_calls++; return p_value % 2 == 1; });
+			CHECK_EQUAL(predicate_calls, 3, "Predicate called once per entry");
+			CHECK_EQUAL(map.size(), 1, "Size after erasing two");
+			CHECK_TRUE(map.find(last_slot_keys[1]) == nullptr && map.find(*first_slot_key) == nullptr, "Erased keys not found");
+			CHECK_TRUE(map.find(last_slot_keys[2]) != nullptr && *map.find(last_slot_keys[2]) == 2, "Remaining key found");
+
+			map[last_slot_keys[0]] = 5;
+			CHECK_EQUAL(map.size(), 2, "Size after re-inserting an erased key");
+			CHECK_TRUE(map.find(last_slot_keys[0]) != nullptr && *map.find(last_slot_keys[0]) == 5, "Re-inserted key found with its new value");
+		}
+		{SCOPE_SECTION("erase_if half of a grown map")
+			Map map;
+			constexpr size_t Pair_Count = 1000;
+			for (size_t i = 0; i < Pair_Count; i++)
+				map[{i, i * 7}] = i;
+
+			map.erase_if([](const Map::Key&, size_t& p_value) { return p_value % 2 == 0; });
+			CHECK_EQUAL(map.size(), Pair_Count / 2, "Size after erase");
+
+			bool erased_not_found = true;
+			bool kept_found       = true;
+			for (size_t i = 0; i < Pair_Count; i++)
+			{
+				const size_t* value = map.find({i, i * 7});
+				if (i % 2 == 0)
+					erased_not_found = erased_not_found && value == nullptr;
+				else
+					kept_found = kept_found && value != nullptr && *value == i;
+			}
+			CHECK_TRUE(erased_not_found, "Erased pairs not found");
+			CHECK_TRUE(kept_found, "Kept pairs found with their values");
+
+			map.erase_if([](const Map::Key&, size_t&) { return true; });
+			CHECK_TRUE(map.empty(), "Empty after erasing every entry");
+			CHECK_TRUE(map.find({1, 7}) == nullptr, "Find after erasing every entry");
+		}
+	}
+
+	void CollisionTester::run_contact_event_tests()
+	{
+		SCOPE_SECTION("ContactEvent");
+
+		System::TextureSystem texture_system;
+		System::MeshSystem mesh_system{texture_system};
+		System::SceneSystem scene_system{texture_system, mesh_system};
+		auto& scene = scene_system.add_scene();
+		scene_system.set_current_scene(scene);
+		System::CollisionSystem collision_system{scene_system};
+
+		std::vector<System::ContactEvent> events;
+		collision_system.m_contact_event.subscribe(&events, [](std::vector<System::ContactEvent>* p_events, const System::ContactEvent& p_event) { p_events->push_back(p_event); });
+
+		// Unit spheres, touching while less than 2 apart.
+		auto& entities      = scene.m_entities;
+		const auto sphere_1 = entities.add_entity(Component::Transform{glm::vec3(0.f)}, Component::Mesh{mesh_system.m_sphere}, Component::Collider{Component::Collider::Shape::Sphere}, Component::RigidBody{});
+		const auto sphere_2 = entities.add_entity(Component::Transform{glm::vec3(1.5f, 0.f, 0.f)}, Component::Mesh{mesh_system.m_sphere}, Component::Collider{Component::Collider::Shape::Sphere}, Component::RigidBody{});
+		auto move_sphere_2  = [&](const glm::vec3& p_position) { entities.get_component<Component::Transform>(sphere_2).m_position = p_position; };
+
+		// A physics tick, update() refreshes the manifolds of the pairs in the broad phase and reports their contacts.
+		auto tick = [&]()
+		{
+			events.clear();
+			collision_system.update();
+		};
+		auto only_event = [&](System::ContactEventType p_type)
+		{
+			return events.size() == 1 && events[0].type == p_type && events[0].entity_1 == sphere_1.ID && events[0].entity_2 == sphere_2.ID
+				&& (events[0].manifold == nullptr) == (p_type == System::ContactEventType::End);
+		};
+
+		{SCOPE_SECTION("Begin")
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::Begin), "Touching pair begins contact");
+		}
+		{SCOPE_SECTION("Persist")
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::Persist), "Pair still touching persists");
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::Persist), "Pair still touching persists again");
+		}
+		{SCOPE_SECTION("End leaving the broad phase")
+			// The narrow phase no longer tests the pair, the End comes from its cached state being dropped as its AABBs separate.
+			move_sphere_2(glm::vec3(10.f, 0.f, 0.f));
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::End), "Pair whose AABBs separate ends contact");
+			tick();
+			CHECK_TRUE(events.empty(), "No events after the pair left the broad phase");
+		}
+		{SCOPE_SECTION("End with overlapping AABBs")
+			move_sphere_2(glm::vec3(1.5f, 0.f, 0.f));
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::Begin), "Pair begins contact again");
+
+			// The AABBs still overlap but the spheres are over 2 apart.
+			move_sphere_2(glm::vec3(1.8f, 1.8f, 0.f));
+			tick();
+			CHECK_TRUE(only_event(System::ContactEventType::End), "Separated pair in the broad phase ends contact");
+			tick();
+			CHECK_TRUE(events.empty(), "No events while separated");
+		}
+	}
+	void CollisionTester::run_triangle_mesh_tests()
+	{
+		SCOPE_SECTION("Triangle mesh");
+
+		System::TextureSystem texture_system;
+		System::MeshSystem mesh_system{texture_system};
+		System::SceneSystem scene_system{texture_system, mesh_system};
+		auto& scene = scene_system.add_scene();
+		scene_system.set_current_scene(scene);
+		System::CollisionSystem collision_system{scene_system};
+		auto& entities = scene.m_entities;
+
+		// The MeshSystem cube is built from triangles, so it has collision_triangles as well as the convex hull of its 8 corners.
+		auto add_cube = [&](const glm::vec3& p_position, float p_scale, bool p_triangle_mesh)
+		{
+			Component::Collider collider;
+			collider.m_triangle_mesh = p_triangle_mesh;
+			const auto entity = entities.add_entity(Component::Transform{p_position}, Component::Mesh{mesh_system.m_cube}, collider);
+			entities.get_component<Component::Transform>(entity).m_scale = glm::vec3(p_scale);
+			return entity;
+		};
+		auto move = [&](const ECS::Entity& p_entity, const glm::vec3& p_position)
+		{
+			entities.get_component<Component::Transform>(p_entity).m_position = p_position;
+			collision_system.update();
+		};
+		auto close_to = [](const glm::vec3& p_a, const glm::vec3& p_b) { return glm::length2(p_a - p_b) < 0.001f * 0.001f; };
+
+		// A unit cube mesh whose top face is at y = 1, and a cube of half size 0.5 sunk 0.1 into it.
+		const auto mesh = add_cube(glm::vec3(0.f), 1.f, true);
+		const auto box  = add_cube(glm::vec3(0.f, 1.4f, 0.f), 0.5f, false);
+		collision_system.update();
+
+		{SCOPE_SECTION("Convex v mesh")
+			ECS::Entity other{0};
+			auto contact = collision_system.get_collision(box, &other);
+			CHECK_TRUE(contact.has_value(), "Box sunk into the mesh collides");
+			if (contact.has_value())
+			{
+				CHECK_TRUE(other.ID == mesh.ID, "Collides with the mesh");
+				CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, 1.f, 0.f)), "Normal pushes the box up out of the mesh");
+				CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.001f, "Depth is how far the box is sunk");
+			}
+
+			contact = collision_system.get_collision(mesh);
+			CHECK_TRUE(contact.has_value(), "Mesh collides with the box sunk into it");
+			if (contact.has_value())
+			{
+				CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, -1.f, 0.f)), "Normal from the perspective of the mesh pushes it down");
+				CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.001f, "Depth is the same from either perspective");
+			}
+
+			move(box, glm::vec3(0.f, 1.6f, 0.f));
+			CHECK_TRUE(!collision_system.get_collision(box).has_value(), "Box resting above the mesh doesn't collide");
+			move(box, glm::vec3(0.f, 1.4f, 0.f));
+		}
+		{SCOPE_SECTION("Mesh v mesh")
+			entities.get_component<Component::Collider>(box).m_triangle_mesh = true;
+
+			// Two triangle meshes are found where their surfaces cross, the depth is measured along the face separating them the least. See CollisionSystem::narrow_phase.
+			auto contact = collision_system.get_collision(box);
+			CHECK_TRUE(contact.has_value(), "Meshes whose surfaces cross collide");
+			if (contact.has_value())
+			{
+				CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, 1.f, 0.f)), "Normal is the face of the other mesh facing the box");
+				CHECK_TRUE(std::abs(contact->position.y - 0.9f) < 0.001f, "Contact is the deepest point of the box");
+				CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.001f, "Depth is how far the box is sunk");
+			}
+
+			contact = collision_system.get_collision(mesh);
+			CHECK_TRUE(contact.has_value(), "Mesh collides with the mesh sunk into it");
+			if (contact.has_value())
+			{
+				CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, -1.f, 0.f)), "Normal from the perspective of the mesh pushes it down");
+				CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.001f, "Depth is the same from either perspective");
+			}
+
+			move(box, glm::vec3(0.f, 1.6f, 0.f));
+			CHECK_TRUE(!collision_system.get_collision(box).has_value(), "Separated meshes don't collide");
+		}
+	}
+} // namespace Test
+DISABLE_WARNING_POP
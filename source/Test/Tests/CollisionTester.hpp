@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Test/TestManager.hpp"
+
+namespace Test
+{
+	class CollisionTester : public TestManager
+	{
+	public:
+		// Without p_graphics the tests that need a CollisionSystem are skipped, the MeshSystem of its scene uploads its meshes to a GL context.
+		CollisionTester(bool p_graphics) : TestManager(std::string("COLLISION")), m_graphics{p_graphics} {}
+
+		void run_unit_tests()        override;
+		void run_performance_tests() override;
+
+	private:
+		bool m_graphics;
+
+		void run_entity_pair_map_tests();
+		void run_contact_event_tests();
+		void run_triangle_mesh_tests();
+	};
+} // namespace Test
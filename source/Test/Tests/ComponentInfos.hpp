@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Component/Collider.hpp"
+#include "Component/FirstPersonCamera.hpp"
+#include "Component/Input.hpp"
+#include "Component/Label.hpp"
+#include "Component/Lights.hpp"
+#include "Component/Mesh.hpp"
+#include "Component/ParticleEmitter.hpp"
+#include "Component/RigidBody.hpp"
+#include "Component/Terrain.hpp"
+#include "Component/Texture.hpp"
+#include "Component/Transform.hpp"
+
+#include "ECS/Component.hpp"
+
+namespace Test
+{
+	// Registers the ComponentTypes for its lifetime. The Persistent_IDs of the engine Components are reused by the types ECSTester
+	// registers, so they are only registered while the tests that need a scene run.
+	template <typename... ComponentTypes>
+	struct ComponentInfos
+	{
+		ComponentInfos()  { (ECS::Component::set_info<ComponentTypes>(), ...); }
+		~ComponentInfos() { (ECS::Component::remove_info<ComponentTypes>(), ...); }
+		ComponentInfos(const ComponentInfos& p_other)            = delete;
+		ComponentInfos& operator=(const ComponentInfos& p_other) = delete;
+	};
+	using EngineComponentInfos = ComponentInfos<Component::Collider, Component::FirstPersonCamera, Component::Input, Component::Label, Component::PointLight,
+		Component::DirectionalLight, Component::SpotLight, Component::Mesh, Component::ParticleEmitter, Component::RigidBody, Component::Terrain, Component::Texture, Component::Transform>;
+} // namespace Test
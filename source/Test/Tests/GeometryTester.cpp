@@ -1,23 +1,37 @@
 #include "GeometryTester.hpp"
 
 #include "Geometry/AABB.hpp"
+#include "Geometry/AABBBatch.hpp"
+#include "Geometry/AABBTree.hpp"
+#include "Geometry/Capsule.hpp"
 #include "Geometry/Cone.hpp"
+#include "Geometry/Contact.hpp"
+#include "Geometry/Cuboid.hpp"
 #include "Geometry/Cylinder.hpp"
 #include "Geometry/Sphere.hpp"
 #include "Geometry/Frustrum.hpp"
+#include "Geometry/GJK.hpp"
+#include "Geometry/Heightfield.hpp"
 #include "Geometry/Intersect.hpp"
+#include "Geometry/IntersectBatch.hpp"
 #include "Geometry/Line.hpp"
 #include "Geometry/LineSegment.hpp"
+#include "Geometry/PointCloud.hpp"
 #include "Geometry/Ray.hpp"
 #include "Geometry/Triangle.hpp"
 
+#include "Utility/CPUFeatures.hpp"
 #include "Utility/Utility.hpp"
 
 #include "glm/glm.hpp"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
 
+#include <algorithm>
 #include <array>
+#include <limits>
+#include <random>
 
 DISABLE_WARNING_PUSH
 DISABLE_WARNING_HIDES_PREVIOUS_DECLERATION // Required to allow shadowing for the SCOPE_SECTION macro
@@ -28,46 +42,266 @@ namespace Test
 	{
 		run_AABB_tests();
 		run_triangle_tests();
+		run_heightfield_tests();
 		run_frustrum_tests();
 		run_sphere_tests();
 		run_point_tests();
+		run_support_point_tests();
+		run_contact_tests();
+		run_batch_intersection_tests();
 	}
 	void GeometryTester::run_performance_tests()
 	{
-		//constexpr size_t triangle_count = 1000000 * 2;
-		//std::vector<float> random_triangle_points = Utility::get_random_numbers(std::numeric_limits<float>::min(), std::numeric_limits<float>::max(), triangle_count * 3 * 3);
-		//std::vector<Geometry::Triangle> triangles;
-		//triangles.reserve(triangle_count);
-
-		//for (size_t i = 0; i < triangle_count; i++)
-		//	triangles.emplace_back(Geometry::Triangle(
-		//		glm::vec3(random_triangle_points[i], random_triangle_points[i + 1], random_triangle_points[i + 2]),
-		//		glm::vec3(random_triangle_points[i + 3], random_triangle_points[i + 4], random_triangle_points[i + 5]),
-		//		glm::vec3(random_triangle_points[i + 6], random_triangle_points[i + 7], random_triangle_points[i + 8])));
-
-		//auto triangle_test = [&triangles](const size_t& p_number_of_tests)
-		//{
-		//	if (p_number_of_tests * 2 > triangles.size()) // Multiply by two to account for intersection calling in pairs.
-		//		throw std::logic_error("Not enough triangles to perform p_number_of_tests. Bump up the triangle_count variable to at least double the size of the largest performance test.");
-
-		//	for (size_t i = 0; i < p_number_of_tests * 2; i += 2)
-		//		Geometry::intersecting(triangles[i], triangles[i + 1]);
-		//};
-
-		//auto triangle_test1 = [&triangle_test]() { triangle_test(1); };
-		//auto triangle_test10 = [&triangle_test]() { triangle_test(10); };
-		//auto triangle_test100 = [&triangle_test]() { triangle_test(100); };
-		//auto triangle_test1000 = [&triangle_test]() { triangle_test(1000); };
-		//auto triangle_test10000 = [&triangle_test]() { triangle_test(10000); };
-		//auto triangle_test100000 = [&triangle_test]() { triangle_test(100000); };
-		//auto triangle_test1000000 = [&triangle_test]() { triangle_test(1000000); };
-		//emplace_performance_test({"Triangle v Triangle 1", triangle_test1});
-		//emplace_performance_test({"Triangle v Triangle 10", triangle_test10});
-		//emplace_performance_test({"Triangle v Triangle 100", triangle_test100});
-		//emplace_performance_test({"Triangle v Triangle 1,000", triangle_test1000});
-		//emplace_performance_test({"Triangle v Triangle 10,000", triangle_test10000});
-		//emplace_performance_test({"Triangle v Triangle 100,000", triangle_test100000});
-		//emplace_performance_test({"Triangle v Triangle 1,000,000", triangle_test1000000});
+		// Every dataset is generated from its own fixed seed so each run, on any build, times the same work.
+		std::mt19937 generator;
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+		auto random_vec3 = [&]() { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+		auto random_AABB = [&](float p_spread, float p_max_half_size)
+		{
+			const auto center    = random_vec3() * p_spread;
+			const auto half_size = glm::abs(random_vec3()) * p_max_half_size + glm::vec3(0.01f);
+			return Geometry::AABB(center - half_size, center + half_size);
+		};
+		auto random_orientation = [&]() { return glm::normalize(glm::quat(distribution(generator), distribution(generator), distribution(generator), distribution(generator)) + glm::quat(0.01f, 0.f, 0.f, 0.f)); };
+
+		{SCOPE_SECTION("Triangle v Triangle");
+			generator.seed(1001);
+			constexpr size_t pair_count = 500000;
+			std::vector<Geometry::Triangle> triangles;
+			triangles.reserve(pair_count * 2);
+			for (size_t i = 0; i < pair_count; i++)
+			{// The second triangle is offset by up to a unit so some pairs intersect, exercising both the early outs and the full interval test.
+				const auto center = random_vec3();
+				triangles.emplace_back(random_vec3(), random_vec3(), random_vec3());
+				triangles.emplace_back(center + random_vec3(), center + random_vec3(), center + random_vec3());
+			}
+			run_performance_test("triangle_triangle", pair_count, [&triangles]()
+			{
+				size_t intersections = 0;
+				for (size_t i = 0; i < triangles.size(); i += 2)
+					if (Geometry::triangle_triangle(triangles[i], triangles[i + 1]))
+						intersections++;
+				return intersections;
+			});
+		}
+		{SCOPE_SECTION("AABB v AABB");
+			generator.seed(1002);
+			constexpr size_t pair_count = 2000000;
+			std::vector<Geometry::AABB> AABBs;
+			AABBs.reserve(pair_count * 2);
+			for (size_t i = 0; i < pair_count * 2; i++)
+				AABBs.push_back(random_AABB(10.f, 3.f));
+
+			run_performance_test("intersecting", pair_count, [&AABBs]()
+			{
+				size_t intersections = 0;
+				for (size_t i = 0; i < AABBs.size(); i += 2)
+					if (Geometry::intersecting(AABBs[i], AABBs[i + 1]))
+						intersections++;
+				return intersections;
+			});
+		}
+		{SCOPE_SECTION("AABB v Ray");
+			generator.seed(1003);
+			constexpr size_t pair_count = 2000000;
+			std::vector<Geometry::AABB> AABBs;
+			std::vector<Geometry::Ray> rays;
+			AABBs.reserve(pair_count);
+			rays.reserve(pair_count);
+			for (size_t i = 0; i < pair_count; i++)
+			{// Rays start around the AABBs and point anywhere, so most miss as they would in a scene raycast.
+				AABBs.push_back(random_AABB(10.f, 3.f));
+				auto direction = random_vec3();
+				if (glm::length(direction) < 0.01f)
+					direction = glm::vec3(1.f, 0.f, 0.f);
+				rays.emplace_back(random_vec3() * 20.f, glm::normalize(direction));
+			}
+			run_performance_test("get_intersection", pair_count, [&AABBs, &rays]()
+			{
+				size_t intersections = 0;
+				for (size_t i = 0; i < AABBs.size(); i++)
+				{
+					float distance_along_ray = 0.f;
+					if (Geometry::get_intersection(AABBs[i], rays[i], &distance_along_ray))
+						intersections++;
+				}
+				return intersections;
+			});
+		}
+		{SCOPE_SECTION("Batch intersection");
+			generator.seed(1007);
+			constexpr size_t shape_count = 100000;
+			constexpr size_t query_count = 20;
+			Geometry::AABBArrays AABBs;
+			Geometry::SphereArrays spheres;
+			for (size_t i = 0; i < shape_count; i++)
+			{
+				AABBs.add(random_AABB(100.f, 3.f));
+				spheres.add(Geometry::Sphere(random_vec3() * 100.f, std::abs(distribution(generator)) * 3.f + 0.01f));
+			}
+			std::vector<Geometry::Ray> rays;
+			std::vector<Geometry::AABB> query_AABBs;
+			for (size_t i = 0; i < query_count; i++)
+			{
+				auto direction = random_vec3();
+				if (glm::length(direction) < 0.01f)
+					direction = glm::vec3(1.f, 0.f, 0.f);
+				rays.emplace_back(random_vec3() * 100.f, glm::normalize(direction));
+				query_AABBs.push_back(random_AABB(100.f, 10.f));
+			}
+
+			const std::array<Utility::InstructionSet, 3> instruction_sets = {Utility::InstructionSet::Scalar, Utility::InstructionSet::SSE4, Utility::InstructionSet::AVX2};
+			for (const auto instruction_set : instruction_sets)
+			{
+				if (instruction_set > Utility::instruction_set())
+					continue; // Kernel not supported by the running CPU.
+
+				Geometry::BatchHits hits;
+				run_performance_test(std::format("Ray v AABBArrays {}", Utility::to_string(instruction_set)), shape_count * query_count, [&]()
+				{
+					size_t hit_count = 0;
+					for (const auto& ray : rays)
+					{
+						Geometry::intersecting(ray, AABBs, hits, instruction_set);
+						hit_count += hits.hit_count();
+					}
+					return hit_count;
+				});
+				run_performance_test(std::format("Ray v SphereArrays {}", Utility::to_string(instruction_set)), shape_count * query_count, [&]()
+				{
+					size_t hit_count = 0;
+					for (const auto& ray : rays)
+					{
+						Geometry::intersecting(ray, spheres, hits, instruction_set);
+						hit_count += hits.hit_count();
+					}
+					return hit_count;
+				});
+				run_performance_test(std::format("AABB v AABBArrays {}", Utility::to_string(instruction_set)), shape_count * query_count, [&]()
+				{
+					size_t hit_count = 0;
+					for (const auto& AABB : query_AABBs)
+					{
+						Geometry::intersecting(AABB, AABBs, hits, instruction_set);
+						hit_count += hits.hit_count();
+					}
+					return hit_count;
+				});
+			}
+		}
+		{SCOPE_SECTION("AABB transform");
+			generator.seed(1004);
+			constexpr size_t AABB_count = 2000000;
+			std::vector<Geometry::AABB> AABBs;
+			std::vector<glm::vec3> positions;
+			std::vector<glm::mat4> rotations;
+			std::vector<glm::vec3> scales;
+			AABBs.reserve(AABB_count);
+			positions.reserve(AABB_count);
+			rotations.reserve(AABB_count);
+			scales.reserve(AABB_count);
+			for (size_t i = 0; i < AABB_count; i++)
+			{
+				AABBs.push_back(random_AABB(1.f, 2.f));
+				positions.push_back(random_vec3() * 100.f);
+				rotations.push_back(glm::mat4_cast(random_orientation()));
+				scales.push_back(glm::abs(random_vec3()) * 2.f + glm::vec3(0.1f));
+			}
+			run_performance_test("AABB::transform", AABB_count, [&]()
+			{// Count the results above the origin to use every transformed AABB.
+				size_t above_origin = 0;
+				for (size_t i = 0; i < AABBs.size(); i++)
+					if (Geometry::AABB::transform(AABBs[i], positions[i], rotations[i], scales[i]).m_min.y > 0.f)
+						above_origin++;
+				return above_origin;
+			});
+		}
+		{SCOPE_SECTION("GJK");
+			constexpr size_t pair_count = 20000;
+			for (const size_t hull_size : {8, 32, 128, 512})
+			{
+				generator.seed(static_cast<std::mt19937::result_type>(1005 + hull_size));
+
+				// Points on the unit sphere are all vertices of their convex hull.
+				std::vector<glm::vec3> points;
+				points.reserve(hull_size);
+				while (points.size() < hull_size)
+				{
+					const auto point = random_vec3();
+					if (glm::length(point) > 0.01f)
+						points.push_back(glm::normalize(point));
+				}
+				const auto cloud = Geometry::PointCloud(points);
+
+				// Shape 2 is placed up to 1.5 units along each axis from shape 1, so most pairs intersect and the rest are separated.
+				std::vector<glm::mat4> transforms;
+				std::vector<glm::quat> orientations;
+				transforms.reserve(pair_count * 2);
+				orientations.reserve(pair_count * 2);
+				for (size_t i = 0; i < pair_count * 2; i++)
+				{
+					const auto orientation = random_orientation();
+					const auto position    = i % 2 == 0 ? glm::vec3(0.f) : random_vec3() * 1.5f;
+					orientations.push_back(orientation);
+					transforms.push_back(glm::translate(glm::identity<glm::mat4>(), position) * glm::mat4_cast(orientation));
+				}
+
+				run_performance_test(std::format("intersecting {} point hulls", hull_size), pair_count, [&]()
+				{
+					size_t intersections = 0;
+					for (size_t i = 0; i < transforms.size(); i += 2)
+					{
+						const auto shape_1 = GJK::Shape(cloud, transforms[i], orientations[i]);
+						const auto shape_2 = GJK::Shape(cloud, transforms[i + 1], orientations[i + 1]);
+						GJK::Simplex simplex;
+						if (GJK::intersecting(shape_1, shape_2, simplex))
+							intersections++;
+					}
+					return intersections;
+				});
+				run_performance_test(std::format("intersecting + EPA {} point hulls", hull_size), pair_count, [&]()
+				{// Count the contacts deeper than a centimetre to use every EPA result.
+					size_t deep_contacts = 0;
+					for (size_t i = 0; i < transforms.size(); i += 2)
+					{
+						const auto shape_1 = GJK::Shape(cloud, transforms[i], orientations[i]);
+						const auto shape_2 = GJK::Shape(cloud, transforms[i + 1], orientations[i + 1]);
+						GJK::Simplex simplex;
+						if (GJK::intersecting(shape_1, shape_2, simplex) && GJK::EPA(simplex, shape_1, shape_2).penetration_depth > 0.01f)
+							deep_contacts++;
+					}
+					return deep_contacts;
+				});
+			}
+		}
+		{SCOPE_SECTION("Frustrum");
+			generator.seed(1006);
+			constexpr size_t frustrum_count = 500000;
+			std::vector<glm::mat4> view_projections;
+			view_projections.reserve(frustrum_count);
+			for (size_t i = 0; i < frustrum_count; i++)
+			{// Perspective cameras looking in random directions from random positions, as the renderer constructs each frame.
+				const auto eye = random_vec3() * 50.f;
+				auto forward   = random_vec3();
+				if (glm::length(forward) < 0.01f || std::abs(glm::normalize(forward).y) > 0.99f)
+					forward = glm::vec3(0.f, 0.f, -1.f);
+				const float field_of_view = glm::radians(45.f + 45.f * std::abs(distribution(generator)));
+				const auto projection     = glm::perspective(field_of_view, 16.f / 9.f, 0.1f, 1000.f);
+				view_projections.push_back(projection * glm::lookAt(eye, eye + forward, glm::vec3(0.f, 1.f, 0.f)));
+			}
+			run_performance_test("Frustrum construction", frustrum_count, [&view_projections]()
+			{// Fold every plane into the result so none of the construction can be optimised away.
+				size_t positive_distance_sums = 0;
+				for (const auto& view_projection : view_projections)
+				{
+					const auto frustrum = Geometry::Frustrum(view_projection);
+					if (frustrum.m_left.m_distance + frustrum.m_right.m_distance + frustrum.m_bottom.m_distance
+					  + frustrum.m_top.m_distance + frustrum.m_near.m_distance + frustrum.m_far.m_distance > 0.f)
+						positive_distance_sums++;
+				}
+				return positive_distance_sums;
+			});
+		}
 	}
 
 	void GeometryTester::run_AABB_tests()
@@ -90,6 +324,184 @@ namespace Test
 			CHECK_EQUAL(aabb.get_size(), glm::vec3(4.f), "AABB initialised with min and max not at origin");
 			CHECK_EQUAL(aabb.get_center(), glm::vec3(3.f), "AABB initialised with min and max not at origin");
 		}
+		{SCOPE_SECTION("AABBTree raycast v brute force");
+			std::mt19937 generator(654321);
+			std::uniform_real_distribution<float> position(-50.f, 50.f);
+			std::uniform_real_distribution<float> extent(0.1f, 3.f);
+
+			std::vector<Geometry::AABB> AABBs;
+			for (size_t i = 0; i < 500; i++)
+			{
+				const auto center    = glm::vec3(position(generator), position(generator), position(generator));
+				const auto half_size = glm::vec3(extent(generator), extent(generator), extent(generator));
+				AABBs.push_back(Geometry::AABB(center - half_size, center + half_size));
+			}
+			Geometry::AABBTree tree;
+			tree.build(AABBs);
+
+			// Rays start outside the volume of the AABBs so the brute force distance (which treats the ray as a line) is comparable.
+			std::vector<Geometry::Ray> rays;
+			for (size_t i = 0; i < Geometry::AABBTree::Packet_Size; i++)
+			{
+				const auto start = glm::vec3(100.f, position(generator), position(generator));
+				rays.push_back(Geometry::Ray(start, glm::vec3(0.f, position(generator), position(generator)) - start));
+			}
+			rays[1].m_direction = glm::vec3(-1.f, 0.f, 0.f); // Axis aligned, infinite reciprocal direction on y and z.
+
+			std::array<float, Geometry::AABBTree::Packet_Size> max_distances;
+			max_distances.fill(std::numeric_limits<float>::max());
+			std::vector<std::vector<size_t>> tree_hits(rays.size());
+			std::vector<float> closest(rays.size(), std::numeric_limits<float>::max());
+			tree.raycast(rays, max_distances, [&](size_t p_ray, size_t p_item, float p_distance)
+			{
+				tree_hits[p_ray].push_back(p_item);
+				closest[p_ray] = std::min(closest[p_ray], p_distance);
+				return std::numeric_limits<float>::max();
+			});
+
+			bool all_match = true;
+			for (size_t ray = 0; ray < rays.size(); ray++)
+			{
+				std::vector<size_t> brute_force_hits;
+				float brute_force_closest = std::numeric_limits<float>::max();
+				for (size_t i = 0; i < AABBs.size(); i++)
+				{
+					float distance = 0.f;
+					if (Geometry::get_intersection(AABBs[i], rays[ray], &distance) && distance >= 0.f)
+					{
+						brute_force_hits.push_back(i);
+						brute_force_closest = std::min(brute_force_closest, distance);
+					}
+				}
+				std::sort(tree_hits[ray].begin(), tree_hits[ray].end());
+				if (tree_hits[ray] != brute_force_hits || std::abs(closest[ray] - brute_force_closest) > 0.001f)
+					all_match = false;
+			}
+			CHECK_TRUE(all_match, "Matches Geometry::get_intersection");
+
+			{SCOPE_SECTION("Query v brute force");
+				const auto query_AABB = Geometry::AABB(glm::vec3(-20.f), glm::vec3(10.f));
+				std::vector<size_t> query_hits;
+				tree.query([&](const Geometry::AABB& p_AABB) { return Geometry::intersecting(query_AABB, p_AABB); }, [&](size_t p_item) { query_hits.push_back(p_item); });
+
+				std::vector<size_t> brute_force_hits;
+				for (size_t i = 0; i < AABBs.size(); i++)
+					if (Geometry::intersecting(query_AABB, AABBs[i]))
+						brute_force_hits.push_back(i);
+
+				std::sort(query_hits.begin(), query_hits.end());
+				CHECK_TRUE(query_hits == brute_force_hits, "Matches Geometry::intersecting");
+			}
+			{SCOPE_SECTION("Query pairs v brute force");
+				std::vector<Geometry::AABB> other_AABBs;
+				for (size_t i = 0; i < 200; i++)
+				{
+					const auto center    = glm::vec3(position(generator), position(generator), position(generator));
+					const auto half_size = glm::vec3(extent(generator), extent(generator), extent(generator));
+					other_AABBs.push_back(Geometry::AABB(center - half_size, center + half_size));
+				}
+				Geometry::AABBTree other_tree;
+				other_tree.build(other_AABBs);
+
+				std::vector<std::pair<size_t, size_t>> tree_pairs;
+				tree.query_pairs(other_tree, [](const Geometry::AABB& p_AABB, const Geometry::AABB& p_other_AABB) { return Geometry::intersecting(p_AABB, p_other_AABB); },
+					[&](size_t p_item, size_t p_other_item) { tree_pairs.push_back({p_item, p_other_item}); });
+
+				std::vector<std::pair<size_t, size_t>> brute_force_pairs;
+				for (size_t i = 0; i < AABBs.size(); i++)
+					for (size_t j = 0; j < other_AABBs.size(); j++)
+						if (Geometry::intersecting(AABBs[i], other_AABBs[j]))
+							brute_force_pairs.push_back({i, j});
+
+				std::sort(tree_pairs.begin(), tree_pairs.end());
+				CHECK_TRUE(tree_pairs == brute_force_pairs, "Matches Geometry::intersecting");
+			}
+			{SCOPE_SECTION("Self pairs v brute force");
+				// Each overlapping pair once in either order, no item paired with itself.
+				std::vector<std::pair<size_t, size_t>> tree_pairs;
+				bool self_paired = false;
+				tree.query_pairs([&](size_t p_item, size_t p_other_item)
+				{
+					self_paired = self_paired || p_item == p_other_item;
+					tree_pairs.push_back({std::min(p_item, p_other_item), std::max(p_item, p_other_item)});
+				});
+
+				std::vector<std::pair<size_t, size_t>> brute_force_pairs;
+				for (size_t i = 0; i < AABBs.size(); i++)
+					for (size_t j = i + 1; j < AABBs.size(); j++)
+						if (Geometry::intersecting(AABBs[i], AABBs[j]))
+							brute_force_pairs.push_back({i, j});
+
+				std::sort(tree_pairs.begin(), tree_pairs.end());
+				CHECK_TRUE(!self_paired, "No item paired with itself");
+				CHECK_EQUAL(tree_pairs.size(), brute_force_pairs.size(), "Every pair reported once");
+				CHECK_TRUE(tree_pairs == brute_force_pairs, "Matches Geometry::intersecting");
+
+				// Coincident AABBs share leaves and centers, the pairs within a leaf must still all be found.
+				Geometry::AABBTree stacked_tree;
+				const std::vector<Geometry::AABB> stacked_AABBs(9, Geometry::AABB(glm::vec3(-1.f), glm::vec3(1.f)));
+				stacked_tree.build(stacked_AABBs);
+				size_t stacked_pairs = 0;
+				stacked_tree.query_pairs([&](size_t, size_t) { stacked_pairs++; });
+				CHECK_EQUAL(stacked_pairs, 36, "9 coincident AABBs form 9 choose 2 pairs");
+			}
+		}
+		{SCOPE_SECTION("AABBBatch v AABB::transform");
+			std::mt19937 generator(246810);
+			std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+			std::uniform_real_distribution<float> extent(0.1f, 3.f);
+			auto random_vec3 = [&]() { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+
+			// 37 AABBs is not a multiple of the lane width, so the scalar remainder of the wider kernels is exercised.
+			struct Input
+			{
+				Geometry::AABB AABB;
+				glm::vec3 position;
+				glm::quat orientation;
+				glm::vec3 scale;
+			};
+			std::vector<Input> inputs;
+			for (size_t i = 0; i < 37; i++)
+			{
+				const auto center    = random_vec3();
+				const auto half_size = glm::vec3(extent(generator), extent(generator), extent(generator));
+				const auto axis      = random_vec3();
+				inputs.push_back({Geometry::AABB(center - half_size, center + half_size), random_vec3(),
+				                  glm::length(axis) > 0.f ? glm::angleAxis(distribution(generator), glm::normalize(axis)) : glm::identity<glm::quat>(),
+				                  random_vec3() * 0.2f}); // Includes negative scale.
+			}
+
+			const std::array<Utility::InstructionSet, 3> instruction_sets = {Utility::InstructionSet::Scalar, Utility::InstructionSet::SSE4, Utility::InstructionSet::AVX2};
+			for (const auto instruction_set : instruction_sets)
+			{
+				if (instruction_set > Utility::instruction_set())
+					continue; // Kernel not supported by the running CPU.
+
+				SCOPE_SECTION(Utility::to_string(instruction_set));
+				Geometry::AABBBatch batch;
+				for (const auto& input : inputs)
+					batch.add(input.AABB, input.position, input.orientation, input.scale);
+				batch.transform(instruction_set);
+				CHECK_EQUAL(batch.size(), inputs.size(), "Size");
+
+				bool all_match = true;
+				for (size_t i = 0; i < inputs.size(); i++)
+				{
+					const auto expected = Geometry::AABB::transform(inputs[i].AABB, inputs[i].position, glm::mat4_cast(inputs[i].orientation), inputs[i].scale);
+					const auto AABB     = batch[i];
+					if (glm::length(AABB.m_min - expected.m_min) > 0.001f || glm::length(AABB.m_max - expected.m_max) > 0.001f)
+						all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches AABB::transform");
+			}
+		}
+		{SCOPE_SECTION("AABB v Sphere");
+			const auto aabb = Geometry::AABB(glm::vec3(-1.f), glm::vec3(1.f));
+			CHECK_TRUE(Geometry::intersecting(aabb, Geometry::Sphere(glm::vec3(0.f), 0.5f)), "Sphere inside");
+			CHECK_TRUE(Geometry::intersecting(aabb, Geometry::Sphere(glm::vec3(2.f, 0.f, 0.f), 1.f)), "Touching face");
+			CHECK_TRUE(!Geometry::intersecting(aabb, Geometry::Sphere(glm::vec3(2.f, 0.f, 0.f), 0.9f)), "Separated from face");
+			CHECK_TRUE(!Geometry::intersecting(aabb, Geometry::Sphere(glm::vec3(1.8f, 1.8f, 0.f), 1.f)), "Separated diagonally from edge");
+		}
 	}
 
 	void GeometryTester::run_triangle_tests()
@@ -236,6 +648,51 @@ namespace Test
 		}
 	}
 
+	void GeometryTester::run_heightfield_tests()
+	{SCOPE_SECTION("Heightfield");
+		// A plane sloping up along x and z, interpolating across either triangle of a cell is exact.
+		constexpr size_t cells_x = 8;
+		constexpr size_t cells_z = 6;
+		constexpr float cell_size = 2.f;
+		auto plane_height = [](float p_x, float p_z) { return (0.5f * p_x) + (0.25f * p_z); };
+
+		std::vector<float> heights;
+		for (size_t z = 0; z <= cells_z; z++)
+			for (size_t x = 0; x <= cells_x; x++)
+				heights.push_back(plane_height(static_cast<float>(x) * cell_size, static_cast<float>(z) * cell_size));
+		const auto heightfield = Geometry::Heightfield(cells_x, cells_z, cell_size, std::move(heights));
+
+		{SCOPE_SECTION("Height at");
+			const auto below_triangle_1 = heightfield.height_at(3.f, 4.5f);
+			const auto below_triangle_2 = heightfield.height_at(3.5f, 5.5f);
+			CHECK_TRUE(below_triangle_1.has_value() && std::abs(*below_triangle_1 - plane_height(3.f, 4.5f)) < 0.0001f, "First triangle of cell");
+			CHECK_TRUE(below_triangle_2.has_value() && std::abs(*below_triangle_2 - plane_height(3.5f, 5.5f)) < 0.0001f, "Second triangle of cell");
+			CHECK_TRUE(!heightfield.height_at(-1.f, 2.f).has_value(), "Outside grid");
+			CHECK_TRUE(!heightfield.height_at(2.f, 13.f).has_value(), "Outside grid far edge");
+		}
+		{SCOPE_SECTION("Raycast");
+			const auto down = heightfield.raycast(Geometry::Ray(glm::vec3(5.f, 10.f, 3.f), glm::vec3(0.f, -1.f, 0.f)));
+			CHECK_TRUE(down.has_value() && std::abs(*down - (10.f - plane_height(5.f, 3.f))) < 0.0001f, "Straight down");
+
+			// Solve 8 - t = plane_height(1 + t, 1 + 0.5t) for the distance along a ray crossing several cells.
+			const auto diagonal = heightfield.raycast(Geometry::Ray(glm::vec3(1.f, 8.f, 1.f), glm::vec3(1.f, -1.f, 0.5f)));
+			CHECK_TRUE(diagonal.has_value() && std::abs(*diagonal - (7.25f / 1.625f)) < 0.0001f, "Diagonal across cells");
+
+			CHECK_TRUE(!heightfield.raycast(Geometry::Ray(glm::vec3(5.f, 10.f, 3.f), glm::vec3(0.f, 1.f, 0.f))).has_value(), "Pointing away");
+			CHECK_TRUE(!heightfield.raycast(Geometry::Ray(glm::vec3(5.f, 10.f, 3.f), glm::vec3(0.f, -1.f, 0.f)), 5.f).has_value(), "Beyond max distance");
+			CHECK_TRUE(!heightfield.raycast(Geometry::Ray(glm::vec3(-5.f, 10.f, 3.f), glm::vec3(-1.f, -1.f, 0.f))).has_value(), "Outside grid");
+		}
+		{SCOPE_SECTION("Query");
+			size_t triangle_count = 0;
+			heightfield.query(Geometry::AABB(glm::vec3(2.5f, -10.f, 2.5f), glm::vec3(5.5f, 10.f, 3.5f)), [&triangle_count](const Geometry::Triangle&) { triangle_count++; });
+			CHECK_EQUAL(triangle_count, size_t(4), "Triangles of overlapped cells");
+
+			triangle_count = 0;
+			heightfield.query(Geometry::AABB(glm::vec3(2.5f, 20.f, 2.5f), glm::vec3(5.5f, 30.f, 3.5f)), [&triangle_count](const Geometry::Triangle&) { triangle_count++; });
+			CHECK_EQUAL(triangle_count, size_t(0), "Above the surface");
+		}
+	}
+
 	void GeometryTester::run_frustrum_tests()
 	{SCOPE_SECTION("Frustrum");
 		{SCOPE_SECTION("Frustrum from standard ortho projection");
@@ -294,6 +751,24 @@ namespace Test
 				CHECK_EQUAL(frustrum.m_far.m_normal,    glm::vec3(0.f, 0.f, -1.f), "Far");
 			}
 		}
+		{SCOPE_SECTION("Frustrum v AABB");
+			// Camera away from the origin looking down -z with a 90° FOV, so at depth z the frustrum extends z either side.
+			const auto eye      = glm::vec3(10.f, 2.f, 5.f);
+			const auto view     = glm::lookAt(eye, eye + glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+			const auto frustrum = Geometry::Frustrum(glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f) * view);
+			auto box = [&eye](const glm::vec3& p_center_from_eye, float p_half_size) { return Geometry::AABB(eye + p_center_from_eye - glm::vec3(p_half_size), eye + p_center_from_eye + glm::vec3(p_half_size)); };
+
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(0.f, 0.f, -10.f), 1.f)),    "Inside");
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(3.f, -2.f, -50.f), 5.f)),   "Inside off centre");
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(0.f), 0.5f)),               "Straddling near");
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(0.f, 0.f, -100.f), 1.f)),   "Straddling far");
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(10.f, 0.f, -10.f), 1.f)),   "Straddling right");
+			CHECK_TRUE(Geometry::intersecting(frustrum, box(glm::vec3(0.f, -10.f, -10.f), 1.f)),  "Straddling bottom");
+			CHECK_TRUE(!Geometry::intersecting(frustrum, box(glm::vec3(0.f, 0.f, 10.f), 1.f)),    "Behind the camera");
+			CHECK_TRUE(!Geometry::intersecting(frustrum, box(glm::vec3(0.f, 0.f, -150.f), 1.f)),  "Beyond far");
+			CHECK_TRUE(!Geometry::intersecting(frustrum, box(glm::vec3(-30.f, 0.f, -10.f), 1.f)), "Left");
+			CHECK_TRUE(!Geometry::intersecting(frustrum, box(glm::vec3(0.f, 30.f, -10.f), 1.f)),  "Above");
+		}
 	}
 
 	void GeometryTester::run_sphere_tests()
@@ -524,5 +999,428 @@ namespace Test
 			CHECK_TRUE(!Geometry::point_inside(ray, point_on_ray_behind), "Point behind ray start");
 		}
 	}
+
+	void GeometryTester::run_support_point_tests()
+	{SCOPE_SECTION("Support point");
+		std::mt19937 generator(123456);
+		std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+		auto random_vec3 = [&]() { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+
+		{SCOPE_SECTION("PointCloud v brute force");
+			// 37 points is not a multiple of any lane width, so the padding is exercised by every kernel.
+			std::vector<glm::vec3> points;
+			for (size_t i = 0; i < 37; i++)
+				points.push_back(random_vec3());
+			const auto cloud = Geometry::PointCloud(points);
+			CHECK_EQUAL(cloud.size(), points.size(), "Size excludes padding");
+
+			const std::array<Utility::InstructionSet, 3> instruction_sets = {Utility::InstructionSet::Scalar, Utility::InstructionSet::SSE4, Utility::InstructionSet::AVX2};
+			for (const auto instruction_set : instruction_sets)
+			{
+				if (instruction_set > Utility::instruction_set())
+					continue; // Kernel not supported by the running CPU.
+
+				SCOPE_SECTION(Utility::to_string(instruction_set));
+				bool all_match = true;
+				for (size_t i = 0; i < 100; i++)
+				{
+					const auto direction = random_vec3();
+					if (cloud[cloud.support_index(direction, instruction_set)] != GJK::support_point(direction, points))
+						all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches GJK::support_point");
+			}
+		}
+		{SCOPE_SECTION("Duplicate furthest points");
+			// Ties resolve to the lowest index regardless of which lane found them.
+			const auto cloud = Geometry::PointCloud({glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f)});
+			CHECK_EQUAL(cloud.support_index(glm::vec3(1.f, 0.f, 0.f)), size_t(1), "Lowest index of furthest point");
+			CHECK_EQUAL(cloud.support_index(glm::vec3(-1.f, 0.f, 0.f)), size_t(0), "Lowest index of furthest point reversed");
+		}
+		{SCOPE_SECTION("Hill-climbing");
+			// UV sphere hull with enough vertices to be above the PointCloud::Hill_Climb_Threshold.
+			constexpr uint32_t rings    = 12;
+			constexpr uint32_t segments = 16;
+			std::vector<glm::vec3> points = {glm::vec3(0.f, 1.f, 0.f), glm::vec3(0.f, -1.f, 0.f)}; // Poles
+			for (uint32_t ring = 1; ring <= rings; ring++)
+			{
+				const float theta = glm::pi<float>() * float(ring) / float(rings + 1);
+				for (uint32_t segment = 0; segment < segments; segment++)
+				{
+					const float phi = glm::two_pi<float>() * float(segment) / float(segments);
+					points.push_back(glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)));
+				}
+			}
+			auto ring_index = [&](uint32_t ring, uint32_t segment) { return 2u + (ring - 1u) * segments + (segment % segments); };
+			std::vector<uint32_t> triangles;
+			for (uint32_t segment = 0; segment < segments; segment++)
+			{
+				triangles.insert(triangles.end(), {0u, ring_index(1, segment), ring_index(1, segment + 1)});
+				triangles.insert(triangles.end(), {1u, ring_index(rings, segment + 1), ring_index(rings, segment)});
+				for (uint32_t ring = 1; ring < rings; ring++)
+				{
+					triangles.insert(triangles.end(), {ring_index(ring, segment), ring_index(ring + 1, segment), ring_index(ring + 1, segment + 1)});
+					triangles.insert(triangles.end(), {ring_index(ring, segment), ring_index(ring + 1, segment + 1), ring_index(ring, segment + 1)});
+				}
+			}
+			const auto cloud = Geometry::PointCloud(points, triangles);
+			CHECK_TRUE(cloud.has_adjacency(), "Has adjacency");
+
+			// Climb from the previous result as GJK would, checking each result is as far as the linear scan result.
+			size_t hint     = 0;
+			bool all_match  = true;
+			for (size_t i = 0; i < 200; i++)
+			{
+				const auto direction       = random_vec3();
+				const auto climbed_point   = cloud[cloud.support_index(direction, hint)];
+				const auto linear_point    = cloud[cloud.support_index(direction)];
+				if (glm::dot(climbed_point, direction) != glm::dot(linear_point, direction))
+					all_match = false;
+			}
+			CHECK_TRUE(all_match, "Matches linear scan");
+
+			{SCOPE_SECTION("Concave");
+				// The same sphere with every other ring pulled in. Climbing its edges would stop on the outer rings' local maxima.
+				std::vector<glm::vec3> concave_points = points;
+				for (uint32_t ring = 2; ring <= rings; ring += 2)
+					for (uint32_t segment = 0; segment < segments; segment++)
+						concave_points[ring_index(ring, segment)] *= 0.6f;
+
+				const auto concave_cloud = Geometry::PointCloud(concave_points, triangles);
+				CHECK_TRUE(concave_cloud.size() >= Geometry::PointCloud::Hill_Climb_Threshold, "Above the hill-climbing threshold");
+				CHECK_TRUE(!concave_cloud.has_adjacency(), "No adjacency for a concave surface");
+
+				bool concave_match = true;
+				for (size_t i = 0; i < 200; i++)
+				{
+					const auto direction = random_vec3();
+					size_t start         = i % concave_points.size();
+					if (concave_cloud[concave_cloud.support_index(direction, start)] != GJK::support_point(direction, concave_points))
+						concave_match = false;
+				}
+				CHECK_TRUE(concave_match, "Hill-climbed support matches brute force");
+			}
+			{SCOPE_SECTION("Disconnected");
+				// Only the cap triangles around the poles, the rings between them are loose points no climb can reach.
+				std::vector<uint32_t> caps;
+				for (uint32_t segment = 0; segment < segments; segment++)
+				{
+					caps.insert(caps.end(), {0u, ring_index(1, segment), ring_index(1, segment + 1)});
+					caps.insert(caps.end(), {1u, ring_index(rings, segment + 1), ring_index(rings, segment)});
+				}
+				CHECK_TRUE(!Geometry::PointCloud(points, caps).has_adjacency(), "No adjacency for a disconnected surface");
+			}
+		}
+		{SCOPE_SECTION("Shape v point set");
+			std::vector<glm::vec3> points;
+			for (size_t i = 0; i < 64; i++)
+				points.push_back(random_vec3());
+			const auto cloud = Geometry::PointCloud(points);
+
+			const auto orientation_1 = glm::angleAxis(0.5f, glm::normalize(glm::vec3(1.f, 2.f, 3.f)));
+			const auto orientation_2 = glm::angleAxis(1.5f, glm::normalize(glm::vec3(-1.f, 0.f, 1.f)));
+			const auto transform_1   = glm::translate(glm::identity<glm::mat4>(), glm::vec3(1.f, 0.f, 0.f)) * glm::mat4_cast(orientation_1);
+			const auto transform_2   = glm::translate(glm::identity<glm::mat4>(), glm::vec3(-1.f, 2.f, 0.f)) * glm::mat4_cast(orientation_2);
+			const auto shape_1       = GJK::Shape(cloud, transform_1, orientation_1);
+			const auto shape_2       = GJK::Shape(cloud, transform_2, orientation_2);
+
+			const auto direction = glm::vec3(0.3f, -0.2f, 0.9f);
+			CHECK_EQUAL(GJK::support_point(direction, shape_1, shape_2), GJK::support_point(direction, points, transform_1, orientation_1, points, transform_2, orientation_2), "Minkowski support point");
+
+			GJK::Simplex simplex;
+			const bool shape_intersecting = GJK::intersecting(shape_1, shape_2, simplex);
+			CHECK_TRUE(shape_intersecting == GJK::intersecting(points, transform_1, orientation_1, points, transform_2, orientation_2), "Intersecting");
+		}
+		{SCOPE_SECTION("Pair cache warm start");
+			const auto cloud = Geometry::PointCloud({glm::vec3(-1.f, -1.f, -1.f), glm::vec3(1.f, -1.f, -1.f), glm::vec3(-1.f, 1.f, -1.f), glm::vec3(1.f, 1.f, -1.f),
+			                                         glm::vec3(-1.f, -1.f,  1.f), glm::vec3(1.f, -1.f,  1.f), glm::vec3(-1.f, 1.f,  1.f), glm::vec3(1.f, 1.f,  1.f)});
+			const auto orientation = glm::identity<glm::quat>();
+			GJK::PairCache cache;
+			GJK::Simplex simplex;
+
+			{SCOPE_SECTION("Separated");
+				const auto shape_1 = GJK::Shape(cloud, glm::identity<glm::mat4>(), orientation, &cache.support_index_1);
+				const auto shape_2 = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(0.f, 3.f, 0.f)), orientation, &cache.support_index_2);
+				CHECK_TRUE(!GJK::intersecting(shape_1, shape_2, simplex, cache), "Not intersecting");
+				CHECK_TRUE(glm::dot(GJK::support_point(cache.separating_axis, shape_1, shape_2), cache.separating_axis) <= 0.f, "Cached axis separates");
+
+				// Move further apart, the cached axis still separates.
+				const auto shape_2_moved = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(0.f, 3.1f, 0.f)), orientation, &cache.support_index_2);
+				CHECK_TRUE(!GJK::intersecting(shape_1, shape_2_moved, simplex, cache), "Not intersecting warm-started");
+				CHECK_EQUAL(simplex.size, 1, "Exits after first support point");
+			}
+			{SCOPE_SECTION("Overlapping");
+				const auto shape_1 = GJK::Shape(cloud, glm::identity<glm::mat4>(), orientation, &cache.support_index_1);
+				const auto shape_2 = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(0.f, 1.5f, 0.f)), orientation, &cache.support_index_2);
+				CHECK_TRUE(GJK::intersecting(shape_1, shape_2, simplex, cache), "Intersecting with a stale separating axis");
+				CHECK_EQUAL(simplex.size, 4, "Simplex encloses origin");
+			}
+		}
+		{SCOPE_SECTION("EPA");
+			const auto cloud = Geometry::PointCloud({glm::vec3(-1.f, -1.f, -1.f), glm::vec3(1.f, -1.f, -1.f), glm::vec3(-1.f, 1.f, -1.f), glm::vec3(1.f, 1.f, -1.f),
+			                                         glm::vec3(-1.f, -1.f,  1.f), glm::vec3(1.f, -1.f,  1.f), glm::vec3(-1.f, 1.f,  1.f), glm::vec3(1.f, 1.f,  1.f)});
+			const auto orientation = glm::identity<glm::quat>();
+			const auto shape_1     = GJK::Shape(cloud, glm::identity<glm::mat4>(), orientation);
+			const auto shape_2     = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(0.f, 1.5f, 0.f)), orientation);
+
+			{SCOPE_SECTION("Overlapping boxes");
+				GJK::Simplex simplex;
+				CHECK_TRUE(GJK::intersecting(shape_1, shape_2, simplex), "Intersecting");
+				GJK::EPAResult result = GJK::EPAResult::Invalid_Simplex;
+				const auto collision  = GJK::EPA(simplex, shape_1, shape_2, &result);
+				CHECK_TRUE(result == GJK::EPAResult::Converged, "Converged");
+				CHECK_TRUE(std::abs(collision.penetration_depth - 0.5f) < 0.01f, "Depth");
+				CHECK_TRUE(glm::dot(collision.normal, glm::vec3(0.f, 1.f, 0.f)) > 0.999f, "Normal out of the Minkowski difference");
+			}
+			{SCOPE_SECTION("Invalid simplex");
+				GJK::EPAResult result = GJK::EPAResult::Converged;
+				const auto collision  = GJK::EPA(GJK::Simplex{glm::vec3(1.f)}, shape_1, shape_2, &result);
+				CHECK_TRUE(result == GJK::EPAResult::Invalid_Simplex, "Reported");
+				CHECK_EQUAL(collision.penetration_depth, 0.f, "No depth");
+			}
+		}
+		{SCOPE_SECTION("Distance");
+			const auto cloud = Geometry::PointCloud({glm::vec3(-1.f, -1.f, -1.f), glm::vec3(1.f, -1.f, -1.f), glm::vec3(-1.f, 1.f, -1.f), glm::vec3(1.f, 1.f, -1.f),
+			                                         glm::vec3(-1.f, -1.f,  1.f), glm::vec3(1.f, -1.f,  1.f), glm::vec3(-1.f, 1.f,  1.f), glm::vec3(1.f, 1.f,  1.f)});
+			const auto orientation = glm::identity<glm::quat>();
+			const auto shape_1     = GJK::Shape(cloud, glm::identity<glm::mat4>(), orientation);
+
+			{SCOPE_SECTION("Face to face");
+				const auto shape_2    = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(3.f, 0.f, 0.f)), orientation);
+				const auto separation = GJK::distance(shape_1, shape_2);
+				CHECK_TRUE(separation.has_value(), "Separated");
+				CHECK_TRUE(std::abs(separation->distance - 1.f) < 0.001f, "Distance");
+				CHECK_TRUE(glm::dot(separation->normal, glm::vec3(1.f, 0.f, 0.f)) > 0.999f, "Normal points from shape 1 to shape 2");
+			}
+			{SCOPE_SECTION("Corner to corner");
+				const auto shape_2    = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(-3.f, -3.f, -3.f)), orientation);
+				const auto separation = GJK::distance(shape_1, shape_2);
+				CHECK_TRUE(separation.has_value(), "Separated");
+				CHECK_TRUE(std::abs(separation->distance - std::sqrt(3.f)) < 0.001f, "Distance");
+				CHECK_TRUE(glm::dot(separation->normal, glm::normalize(glm::vec3(-1.f))) > 0.999f, "Normal points from shape 1 to shape 2");
+			}
+			{SCOPE_SECTION("Overlapping");
+				const auto shape_2 = GJK::Shape(cloud, glm::translate(glm::identity<glm::mat4>(), glm::vec3(1.5f, 0.5f, 0.f)), orientation);
+				CHECK_TRUE(!GJK::distance(shape_1, shape_2).has_value(), "No distance when intersecting");
+			}
+		}
+	}
+	void GeometryTester::run_contact_tests()
+	{SCOPE_SECTION("Analytic contact");
+		// Contacts are from the perspective of the first shape, the normal pushes it out of the second.
+		auto close_to = [](const glm::vec3& p_value, const glm::vec3& p_expected) { return glm::length(p_value - p_expected) < 0.0001f; };
+
+		{SCOPE_SECTION("Sphere v Sphere");
+			const auto contact = Geometry::contact(Geometry::Sphere(glm::vec3(0.f), 1.f), Geometry::Sphere(glm::vec3(1.5f, 0.f, 0.f), 1.f));
+			CHECK_TRUE(contact.has_value(), "Overlapping");
+			if (contact.has_value())
+			{
+				CHECK_TRUE(close_to(contact->normal, glm::vec3(-1.f, 0.f, 0.f)), "Normal");
+				CHECK_TRUE(std::abs(contact->penetration_depth - 0.5f) < 0.0001f, "Depth");
+				CHECK_TRUE(close_to(contact->position, glm::vec3(1.f, 0.f, 0.f)), "Position");
+			}
+			CHECK_TRUE(!Geometry::contact(Geometry::Sphere(glm::vec3(0.f), 1.f), Geometry::Sphere(glm::vec3(2.1f, 0.f, 0.f), 1.f)).has_value(), "Separated");
+		}
+		{SCOPE_SECTION("Sphere v Box");
+			const auto box = Geometry::Cuboid(glm::vec3(0.f), glm::vec3(1.f), glm::angleAxis(glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f)));
+
+			const auto outside = Geometry::contact(Geometry::Sphere(glm::vec3(0.f, 1.5f, 0.f), 1.f), box);
+			CHECK_TRUE(outside.has_value(), "Center outside");
+			if (outside.has_value())
+			{
+				CHECK_TRUE(close_to(outside->normal, glm::vec3(0.f, 1.f, 0.f)), "Center outside normal");
+				CHECK_TRUE(std::abs(outside->penetration_depth - 0.5f) < 0.0001f, "Center outside depth");
+			}
+
+			const auto inside = Geometry::contact(Geometry::Sphere(glm::vec3(0.8f, 0.f, 0.f), 0.5f), box);
+			CHECK_TRUE(inside.has_value(), "Center inside");
+			if (inside.has_value())
+			{
+				CHECK_TRUE(close_to(inside->normal, glm::vec3(1.f, 0.f, 0.f)), "Center inside pushed out the nearest face");
+				CHECK_TRUE(std::abs(inside->penetration_depth - 0.7f) < 0.0001f, "Center inside depth");
+			}
+			CHECK_TRUE(!Geometry::contact(Geometry::Sphere(glm::vec3(1.5f, 1.5f, 0.f), 0.5f), box).has_value(), "Separated from edge");
+		}
+		{SCOPE_SECTION("Sphere v Cylinder");
+			const auto cylinder = Geometry::Cylinder(glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f, 1.f, 0.f), 1.f);
+			const auto side     = Geometry::contact(Geometry::Sphere(glm::vec3(0.f, 0.f, 1.5f), 1.f), cylinder);
+			CHECK_TRUE(side.has_value() && close_to(side->normal, glm::vec3(0.f, 0.f, 1.f)) && std::abs(side->penetration_depth - 0.5f) < 0.0001f, "Side");
+			const auto cap = Geometry::contact(Geometry::Sphere(glm::vec3(0.f, -1.5f, 0.f), 1.f), cylinder);
+			CHECK_TRUE(cap.has_value() && close_to(cap->normal, glm::vec3(0.f, -1.f, 0.f)) && std::abs(cap->penetration_depth - 0.5f) < 0.0001f, "Cap");
+			CHECK_TRUE(!Geometry::contact(Geometry::Sphere(glm::vec3(1.5f, 1.5f, 0.f), 0.5f), cylinder).has_value(), "Separated from rim");
+		}
+		{SCOPE_SECTION("Capsule v Capsule");
+			const auto capsule_1 = Geometry::Capsule(glm::vec3(-1.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f), 0.5f);
+			const auto capsule_2 = Geometry::Capsule(glm::vec3(0.f, 0.8f, -1.f), glm::vec3(0.f, 0.8f, 1.f), 0.5f);
+			const auto contact   = Geometry::contact(capsule_1, capsule_2);
+			CHECK_TRUE(contact.has_value() && close_to(contact->normal, glm::vec3(0.f, -1.f, 0.f)) && std::abs(contact->penetration_depth - 0.2f) < 0.0001f, "Crossing");
+			CHECK_TRUE(!Geometry::contact(capsule_1, Geometry::Capsule(glm::vec3(0.f, 1.1f, -1.f), glm::vec3(0.f, 1.1f, 1.f), 0.5f)).has_value(), "Separated");
+		}
+		{SCOPE_SECTION("Box v Box");
+			{SCOPE_SECTION("Resting face");
+				// A small box resting on a large one reports a corner of the small box, inside the overlap.
+				const auto floor   = Geometry::Cuboid(glm::vec3(0.f), glm::vec3(10.f, 1.f, 10.f));
+				const auto box     = Geometry::Cuboid(glm::vec3(3.f, 1.4f, 3.f), glm::vec3(0.5f));
+				const auto contact = Geometry::contact(floor, box);
+				CHECK_TRUE(contact.has_value(), "Overlapping");
+				if (contact.has_value())
+				{
+					CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, -1.f, 0.f)), "Normal");
+					CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.0001f, "Depth");
+					CHECK_TRUE(std::abs(contact->position.x - 3.f) <= 0.5f && std::abs(contact->position.z - 3.f) <= 0.5f, "Position under the small box");
+				}
+			}
+			{SCOPE_SECTION("Edge v edge");
+				// Box 1 is turned 45° about z and box 2 45° about x, so the top edge of box 1 crosses under the bottom edge of box 2.
+				const auto box_1   = Geometry::Cuboid(glm::vec3(0.f), glm::vec3(1.f), glm::angleAxis(glm::radians(45.f), glm::vec3(0.f, 0.f, 1.f)));
+				const auto box_2   = Geometry::Cuboid(glm::vec3(0.f, 2.f * std::sqrt(2.f) - 0.1f, 0.f), glm::vec3(1.f), glm::angleAxis(glm::radians(45.f), glm::vec3(1.f, 0.f, 0.f)));
+				const auto contact = Geometry::contact(box_2, box_1);
+				CHECK_TRUE(contact.has_value(), "Overlapping");
+				if (contact.has_value())
+				{
+					CHECK_TRUE(close_to(contact->normal, glm::vec3(0.f, 1.f, 0.f)), "Normal");
+					CHECK_TRUE(std::abs(contact->penetration_depth - 0.1f) < 0.001f, "Depth");
+					CHECK_TRUE(glm::length(contact->position - glm::vec3(0.f, std::sqrt(2.f) - 0.1f, 0.f)) < 0.001f, "Position between the edges");
+				}
+			}
+			{SCOPE_SECTION("Separated on an edge axis");
+				// Only the cross product of the two edges separates these boxes.
+				const auto box_1 = Geometry::Cuboid(glm::vec3(0.f), glm::vec3(1.f), glm::angleAxis(glm::radians(45.f), glm::vec3(0.f, 0.f, 1.f)));
+				const auto box_2 = Geometry::Cuboid(glm::vec3(0.f, 2.f * std::sqrt(2.f) + 0.1f, 0.f), glm::vec3(1.f), glm::angleAxis(glm::radians(45.f), glm::vec3(1.f, 0.f, 0.f)));
+				CHECK_TRUE(!Geometry::contact(box_1, box_2).has_value(), "Separated");
+			}
+		}
+	}
+	void GeometryTester::run_batch_intersection_tests()
+	{
+		// Every kernel is checked against the single pair functions in Intersect.hpp on the same random shapes.
+		// 37 shapes is not a multiple of the lane width, so the scalar remainder of the wider kernels is exercised.
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+		std::uniform_real_distribution<float> size(0.1f, 3.f);
+		auto random_vec3 = [&]() { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+
+		Geometry::AABBArrays AABBs;
+		Geometry::SphereArrays spheres;
+		for (size_t i = 0; i < 37; i++)
+		{
+			const auto center    = random_vec3();
+			const auto half_size = glm::vec3(size(generator), size(generator), size(generator));
+			AABBs.add(Geometry::AABB(center - half_size, center + half_size));
+			spheres.add(Geometry::Sphere(random_vec3(), size(generator)));
+		}
+		// Rays along an axis exercise the parallel slab test.
+		const std::array<Geometry::Ray, 4> rays = {
+			Geometry::Ray(glm::vec3(0.f), glm::normalize(glm::vec3(1.f, 0.3f, -0.2f))),
+			Geometry::Ray(glm::vec3(-10.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f)),
+			Geometry::Ray(random_vec3(), glm::normalize(glm::vec3(0.f, -1.f, 0.5f))),
+			Geometry::Ray(random_vec3(), glm::normalize(random_vec3()))};
+		const std::array<Geometry::AABB, 2> query_AABBs = {Geometry::AABB(glm::vec3(-3.f), glm::vec3(3.f)), Geometry::AABB(glm::vec3(2.f, -8.f, -1.f), glm::vec3(9.f, 1.f, 4.f))};
+		const std::array<Geometry::Sphere, 2> query_spheres = {Geometry::Sphere(glm::vec3(0.f), 4.f), Geometry::Sphere(random_vec3(), 2.f)};
+
+		const std::array<Utility::InstructionSet, 3> instruction_sets = {Utility::InstructionSet::Scalar, Utility::InstructionSet::SSE4, Utility::InstructionSet::AVX2};
+		for (const auto instruction_set : instruction_sets)
+		{
+			if (instruction_set > Utility::instruction_set())
+				continue; // Kernel not supported by the running CPU.
+
+			SCOPE_SECTION(Utility::to_string(instruction_set));
+			Geometry::BatchHits hits;
+			{SCOPE_SECTION("Ray v AABBArrays");
+				bool all_match = true;
+				size_t hit_count = 0;
+				for (const auto& ray : rays)
+				{
+					Geometry::intersecting(ray, AABBs, hits, instruction_set);
+					for (size_t i = 0; i < AABBs.size(); i++)
+					{// get_intersection tests the line so it also hits AABBs behind the ray start, its entry is negative for those.
+						float distance_along_ray = 0.f;
+						const bool line_hit = Geometry::get_intersection(AABBs[i], ray, &distance_along_ray).has_value();
+						if (line_hit && distance_along_ray >= 0.f)
+						{
+							if (!hits.hit(i) || std::abs(hits.distances[i] - distance_along_ray) > 0.0001f)
+								all_match = false;
+						}
+						else if (!line_hit && hits.hit(i))
+							all_match = false;
+					}
+					hit_count += hits.hit_count();
+				}
+				CHECK_TRUE(all_match, "Matches get_intersection");
+				CHECK_TRUE(hit_count > 0, "Some hits");
+			}
+			{SCOPE_SECTION("Ray v SphereArrays");
+				bool all_match = true;
+				for (const auto& ray : rays)
+				{
+					Geometry::intersecting(ray, spheres, hits, instruction_set);
+					for (size_t i = 0; i < spheres.size(); i++)
+					{// A hit is on the sphere surface unless the ray starts inside it. A miss passes the sphere or points away from it.
+						const auto sphere    = spheres[i];
+						const bool inside    = glm::distance(ray.m_start, sphere.m_center) <= sphere.m_radius;
+						const auto closest_t = glm::dot(sphere.m_center - ray.m_start, ray.m_direction);
+						const bool passes    = glm::distance(ray.m_start + ray.m_direction * std::max(closest_t, 0.f), sphere.m_center) <= sphere.m_radius;
+						if (hits.hit(i) != (inside || passes))
+							all_match = false;
+						else if (hits.hit(i) && inside && hits.distances[i] != 0.f)
+							all_match = false;
+						else if (hits.hit(i) && !inside && std::abs(glm::distance(ray.m_start + ray.m_direction * hits.distances[i], sphere.m_center) - sphere.m_radius) > 0.001f)
+							all_match = false;
+					}
+				}
+				CHECK_TRUE(all_match, "Hits the sphere surface");
+			}
+			{SCOPE_SECTION("AABB v AABBArrays");
+				bool all_match = true;
+				for (const auto& AABB : query_AABBs)
+				{
+					Geometry::intersecting(AABB, AABBs, hits, instruction_set);
+					for (size_t i = 0; i < AABBs.size(); i++)
+						if (hits.hit(i) != Geometry::intersecting(AABB, AABBs[i]))
+							all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches intersecting");
+				CHECK_EQUAL(hits.size, AABBs.size(), "Size");
+			}
+			{SCOPE_SECTION("AABB v SphereArrays");
+				bool all_match = true;
+				for (const auto& AABB : query_AABBs)
+				{
+					Geometry::intersecting(AABB, spheres, hits, instruction_set);
+					for (size_t i = 0; i < spheres.size(); i++)
+						if (hits.hit(i) != Geometry::intersecting(AABB, spheres[i]))
+							all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches intersecting");
+			}
+			{SCOPE_SECTION("Sphere v AABBArrays");
+				bool all_match = true;
+				for (const auto& sphere : query_spheres)
+				{
+					Geometry::intersecting(sphere, AABBs, hits, instruction_set);
+					for (size_t i = 0; i < AABBs.size(); i++)
+						if (hits.hit(i) != Geometry::intersecting(AABBs[i], sphere))
+							all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches intersecting");
+			}
+			{SCOPE_SECTION("Sphere v SphereArrays");
+				bool all_match = true;
+				for (const auto& sphere : query_spheres)
+				{
+					Geometry::intersecting(sphere, spheres, hits, instruction_set);
+					for (size_t i = 0; i < spheres.size(); i++)
+						if (hits.hit(i) != Geometry::intersecting(sphere, spheres[i]))
+							all_match = false;
+				}
+				CHECK_TRUE(all_match, "Matches intersecting");
+			}
+		}
+		{SCOPE_SECTION("Zero direction ray");
+			Geometry::BatchHits hits;
+			Geometry::intersecting(Geometry::Ray(glm::vec3(0.f), glm::vec3(0.f)), AABBs, hits);
+			CHECK_EQUAL(hits.hit_count(), size_t(0), "No hits");
+		}
+	}
 } // namespace Test
 DISABLE_WARNING_POP
\ No newline at end of file
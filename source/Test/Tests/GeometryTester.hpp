@@ -16,8 +16,12 @@ namespace Test
 	private:
 		void run_AABB_tests();
 		void run_triangle_tests();
+		void run_heightfield_tests();
 		void run_frustrum_tests();
 		void run_sphere_tests();
 		void run_point_tests();
+		void run_support_point_tests();
+		void run_contact_tests();
+		void run_batch_intersection_tests();
 	};
 } // namespace Test
\ No newline at end of file
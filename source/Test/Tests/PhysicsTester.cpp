@@ -0,0 +1,438 @@
+#include "PhysicsTester.hpp"
+#include "ComponentInfos.hpp"
+
+#include "Component/Collider.hpp"
+#include "Component/Mesh.hpp"
+#include "Component/RigidBody.hpp"
+#include "Component/Transform.hpp"
+
+#include "Platform/Core.hpp"
+#include "Platform/Input.hpp"
+#include "Platform/Window.hpp"
+
+#include "System/CollisionSystem.hpp"
+#include "System/ContactSolver.hpp"
+#include "System/Integrator.hpp"
+#include "System/MeshSystem.hpp"
+#include "System/PhysicsSystem.hpp"
+#include "System/SceneSystem.hpp"
+#include "System/TextureSystem.hpp"
+#include "System/TransformSnapshot.hpp"
+
+#include "Utility/CPUFeatures.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "Utility/Utility.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <utility>
+#include <vector>
+
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_HIDES_PREVIOUS_DECLERATION // Required to allow shadowing for the SCOPE_SECTION macro
+
+namespace Test
+{
+	// Bodies with random state, spun and pushed so every term of the integrator kernels contributes.
+	static void make_random_bodies(size_t p_count, std::vector<Component::RigidBody>& p_rigid_bodies, std::vector<Component::Transform>& p_transforms)
+	{
+		std::mt19937 generator;
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+		auto random_vec3 = [&]() { return glm::vec3(distribution(generator), distribution(generator), distribution(generator)); };
+
+		p_rigid_bodies.clear();
+		p_transforms.clear();
+		p_rigid_bodies.reserve(p_count);
+		p_transforms.reserve(p_count);
+		for (size_t i = 0; i < p_count; i++)
+		{
+			auto& transform         = p_transforms.emplace_back(random_vec3() * 100.f);
+			transform.m_orientation = glm::normalize(glm::quat(distribution(generator), distribution(generator), distribution(generator), distribution(generator)) + glm::quat(0.01f, 0.f, 0.f, 0.f));
+
+			auto& rigid_body = p_rigid_bodies.emplace_back(i % 3 != 0);
+			rigid_body.set_mass(1.f + (distribution(generator) + 1.f) * 10.f);
+			const auto principal_moments = glm::abs(random_vec3()) + glm::vec3(0.1f);
+			rigid_body.set_inertia_tensor(glm::mat3(principal_moments.x, 0.f, 0.f, 0.f, principal_moments.y, 0.f, 0.f, 0.f, principal_moments.z));
+			rigid_body.update_world_inertia(transform.m_orientation);
+			rigid_body.m_force            = random_vec3() * 50.f;
+			rigid_body.m_momentum         = random_vec3() * 20.f;
+			rigid_body.m_torque           = random_vec3() * 5.f;
+			rigid_body.m_angular_momentum = random_vec3() * 2.f;
+		}
+	}
+	static bool close_to(const glm::mat4& p_a, const glm::mat4& p_b)
+	{
+		for (glm::length_t column = 0; column < 4; column++)
+			for (glm::length_t row = 0; row < 4; row++)
+				if (std::abs(p_a[column][row] - p_b[column][row]) > 1e-5f)
+					return false;
+		return true;
+	}
+	static bool bitwise_equal(const glm::vec3& p_a, const glm::vec3& p_b)
+	{
+		return std::bit_cast<uint32_t>(p_a.x) == std::bit_cast<uint32_t>(p_b.x)
+		    && std::bit_cast<uint32_t>(p_a.y) == std::bit_cast<uint32_t>(p_b.y)
+		    && std::bit_cast<uint32_t>(p_a.z) == std::bit_cast<uint32_t>(p_b.z);
+	}
+	static bool bitwise_equal(const glm::quat& p_a, const glm::quat& p_b)
+	{
+		return std::bit_cast<uint32_t>(p_a.w) == std::bit_cast<uint32_t>(p_b.w)
+		    && bitwise_equal(glm::vec3(p_a.x, p_a.y, p_a.z), glm::vec3(p_b.x, p_b.y, p_b.z));
+	}
+
+	void PhysicsTester::run_unit_tests()
+	{
+		run_integrator_tests();
+		run_contact_solver_tests();
+		run_transform_snapshot_tests();
+
+		if (m_graphics)
+		{
+			Platform::Core::initialise_directories();
+			Platform::Core::initialise_GLFW();
+			Platform::Input input   = Platform::Input();
+			Platform::Window window = Platform::Window(1920, 1080, input);
+			Platform::Core::initialise_OpenGL();
+			EngineComponentInfos component_infos;
+
+			run_island_tests();
+			run_publish_transforms_tests();
+
+			Platform::Core::deinitialise_GLFW();
+		}
+	}
+	void PhysicsTester::run_performance_tests()
+	{
+		{SCOPE_SECTION("Integrator");
+			constexpr size_t body_count = 100'000;
+			constexpr float delta_time  = 1.f / 60.f;
+			const glm::vec3 gravity     = glm::vec3(0.f, -9.81f, 0.f);
+
+			std::vector<Component::RigidBody> rigid_bodies;
+			std::vector<Component::Transform> transforms;
+			make_random_bodies(body_count, rigid_bodies, transforms);
+
+			Utility::ThreadPool thread_pool;
+			System::Integrator integrator;
+			run_performance_test(std::format("Integrator {} bodies", body_count), body_count, [&]()
+			{
+				integrator.clear();
+				for (size_t i = 0; i < body_count; i++)
+					integrator.add(rigid_bodies[i], transforms[i]);
+
+				integrator.integrate_velocities(delta_time, gravity, thread_pool);
+				integrator.integrate_positions(delta_time, thread_pool);
+				return integrator.size();
+			});
+		}
+	}
+
+	void PhysicsTester::run_integrator_tests()
+	{
+		SCOPE_SECTION("Integrator");
+		constexpr float delta_time = 1.f / 60.f;
+		const glm::vec3 gravity    = glm::vec3(0.f, -9.81f, 0.f);
+		Utility::ThreadPool thread_pool;
+
+		{SCOPE_SECTION("Semi-implicit Euler");
+			// The position integrates the velocity of the same tick.
+			std::vector<Component::RigidBody> rigid_bodies{Component::RigidBody{}};
+			std::vector<Component::Transform> transforms{Component::Transform{glm::vec3(0.f)}};
+			rigid_bodies[0].m_force = glm::vec3(2.f, 0.f, 0.f);
+
+			System::Integrator integrator;
+			integrator.add(rigid_bodies[0], transforms[0]);
+			integrator.integrate_velocities(delta_time, gravity, thread_pool);
+			integrator.integrate_positions(delta_time, thread_pool);
+
+			const glm::vec3 expected_velocity = (glm::vec3(2.f, 0.f, 0.f) + gravity) * delta_time;
+			CHECK_TRUE(glm::length(rigid_bodies[0].m_velocity - expected_velocity) < 1e-6f, "Velocity integrates force and gravity");
+			CHECK_TRUE(glm::length(transforms[0].m_position - expected_velocity * delta_time) < 1e-6f, "Position integrates the new velocity");
+			CHECK_TRUE(rigid_bodies[0].m_force == glm::vec3(0.f), "Force is reset");
+			CHECK_TRUE(transforms[0].m_orientation == glm::quat(1.f, 0.f, 0.f, 0.f), "No spin keeps the orientation");
+		}
+		{SCOPE_SECTION("Kernels are bit-identical");
+			// Enough bodies to split into several ranges, with a remainder the AVX2 kernels hand to the scalar ones.
+			constexpr size_t body_count = System::Integrator::Min_Range_Size * 2 + 13;
+			constexpr size_t tick_count = 10;
+
+			std::vector<Component::RigidBody> scalar_rigid_bodies;
+			std::vector<Component::Transform> scalar_transforms;
+			make_random_bodies(body_count, scalar_rigid_bodies, scalar_transforms);
+
+			const std::array<Utility::InstructionSet, 2> instruction_sets = {Utility::InstructionSet::Scalar, Utility::InstructionSet::AVX2};
+			std::array<std::vector<Component::RigidBody>, 2> rigid_bodies = {scalar_rigid_bodies, scalar_rigid_bodies};
+			std::array<std::vector<Component::Transform>, 2> transforms   = {scalar_transforms, scalar_transforms};
+			for (size_t set = 0; set < instruction_sets.size(); set++)
+			{
+				if (instruction_sets[set] > Utility::instruction_set())
+					return; // The CPU can't run the AVX2 kernels, nothing to compare against.
+
+				System::Integrator integrator;
+				for (size_t tick = 0; tick < tick_count; tick++)
+				{
+					integrator.clear();
+					for (size_t i = 0; i < body_count; i++)
+						integrator.add(rigid_bodies[set][i], transforms[set][i]);
+
+					integrator.integrate_velocities(delta_time, gravity, thread_pool, instruction_sets[set]);
+					integrator.integrate_positions(delta_time, thread_pool, instruction_sets[set]);
+				}
+			}
+
+			size_t mismatch_count = 0;
+			for (size_t i = 0; i < body_count; i++)
+			{
+				const auto& scalar = rigid_bodies[0][i];
+				const auto& AVX2   = rigid_bodies[1][i];
+				if (!bitwise_equal(scalar.m_momentum, AVX2.m_momentum)                  || !bitwise_equal(scalar.m_velocity, AVX2.m_velocity)
+				 || !bitwise_equal(scalar.m_angular_momentum, AVX2.m_angular_momentum) || !bitwise_equal(scalar.m_angular_velocity, AVX2.m_angular_velocity)
+				 || !bitwise_equal(transforms[0][i].m_position, transforms[1][i].m_position)
+				 || !bitwise_equal(transforms[0][i].m_orientation, transforms[1][i].m_orientation))
+					mismatch_count++;
+			}
+			CHECK_EQUAL(mismatch_count, 0, "AVX2 matches scalar");
+		}
+	}
+
+	void PhysicsTester::run_contact_solver_tests()
+	{
+		SCOPE_SECTION("Contact solver");
+		constexpr float delta_time      = 1.f / 60.f;
+		constexpr float friction        = 0.5f;
+		constexpr int iterations        = 10;
+		const glm::vec3 gravity         = glm::vec3(0.f, -9.81f, 0.f);
+		const glm::mat3 inverse_inertia = glm::mat3(6.f); // Unit cube of mass 1, I = m(w² + h²)/12 about every axis.
+
+		// A unit cube with mass 1 resting on a static floor at y = 0. The cube is body 1 and entity_1 of the manifold, the floor is the static world.
+		// The manifold holds the 4 bottom corners, refreshed for the cube's position like ContactManifold::refresh each tick.
+		auto refresh_corners = [](System::ContactManifold& p_manifold, const glm::vec3& p_position)
+		{
+			const std::array<glm::vec3, 4> corners = {glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(0.5f, -0.5f, -0.5f), glm::vec3(0.5f, -0.5f, 0.5f), glm::vec3(-0.5f, -0.5f, 0.5f)};
+			p_manifold.normal      = glm::vec3(0.f, 1.f, 0.f);
+			p_manifold.point_count = corners.size();
+			for (size_t i = 0; i < corners.size(); i++)
+			{
+				p_manifold.points[i].position          = p_position + corners[i];
+				p_manifold.points[i].penetration_depth = 0.5f - p_position.y;
+			}
+		};
+		// Apply gravity then solve the contact, returning the solved body.
+		auto solve_tick = [&](System::ContactSolver& p_solver, System::ContactManifold& p_manifold, System::SolverBody p_body, float p_restitution, int p_iterations)
+		{
+			p_body.velocity += gravity * delta_time;
+			refresh_corners(p_manifold, p_body.position);
+
+			p_solver.clear();
+			const size_t body = p_solver.add_body(p_body);
+			p_solver.add_manifold(p_manifold, body, 0, friction, p_restitution, delta_time);
+			p_solver.solve(p_iterations);
+			return p_solver.get_body(body);
+		};
+
+		System::ContactSolver solver;
+		System::SolverBody cube;
+		cube.inverse_mass    = 1.f;
+		cube.inverse_inertia = inverse_inertia;
+
+		{SCOPE_SECTION("Resting box");
+			// Start sunk into the floor, position correction pushes it back out to the slop and then holds it there.
+			cube.position = glm::vec3(0.f, 0.45f, 0.f);
+			System::ContactManifold manifold;
+			for (size_t tick = 0; tick < 120; tick++)
+			{
+				cube           = solve_tick(solver, manifold, cube, 0.5f, iterations);
+				cube.position += cube.velocity * delta_time;
+			}
+
+			const float penetration = 0.5f - cube.position.y;
+			CHECK_TRUE(penetration >= 0.f && penetration <= System::ContactSolver::Penetration_Slop + 1e-4f, "Penetration within slop");
+			CHECK_TRUE(glm::length(cube.velocity) < 1e-3f, "At rest");
+			CHECK_TRUE(glm::length(cube.angular_velocity) < 1e-3f, "No spin");
+
+			float normal_impulse = 0.f;
+			for (size_t i = 0; i < manifold.point_count; i++)
+				normal_impulse += manifold.points[i].normal_impulse;
+			CHECK_TRUE(std::abs(normal_impulse - glm::length(gravity) * delta_time) < 1e-3f, "Normal impulses hold up the weight");
+
+			{SCOPE_SECTION("Warm starting");
+				// With no iterations only the impulses accumulated last tick are applied. For a persistent contact they cancel this tick's gravity.
+				System::ContactManifold fresh_manifold;
+				const auto cold = solve_tick(solver, fresh_manifold, cube, 0.5f, 0);
+				const auto warm = solve_tick(solver, manifold, cube, 0.5f, 0);
+				CHECK_TRUE(std::abs(cold.velocity.y - gravity.y * delta_time) < 1e-5f, "New contact starts without impulse");
+				CHECK_TRUE(std::abs(warm.velocity.y) < 1e-3f, "Persistent contact re-applies its impulses");
+				CHECK_TRUE(std::abs(manifold.points[0].normal_impulse - normal_impulse / 4.f) < 1e-3f, "Accumulated impulses stored back");
+			}
+		}
+		{SCOPE_SECTION("Restitution threshold");
+			// Impacts against the floor with a perfectly elastic restitution, only the one above Restitution_Threshold bounces.
+			auto impact = [&](float p_speed)
+			{
+				System::SolverBody body = cube;
+				body.position           = glm::vec3(0.f, 0.5f, 0.f);
+				body.velocity           = glm::vec3(0.f, -p_speed, 0.f) - (gravity * delta_time);
+				body.angular_velocity   = glm::vec3(0.f);
+				System::ContactManifold manifold;
+				return solve_tick(solver, manifold, body, 1.f, iterations).velocity.y;
+			};
+			const float slow_speed = System::ContactSolver::Restitution_Threshold * 0.5f;
+			const float fast_speed = System::ContactSolver::Restitution_Threshold * 4.f;
+			CHECK_TRUE(std::abs(impact(slow_speed)) < 1e-3f, "Slow impact doesn't bounce");
+			CHECK_TRUE(std::abs(impact(fast_speed) - fast_speed) < 1e-2f, "Fast impact bounces");
+		}
+	}
+
+	void PhysicsTester::run_island_tests()
+	{
+		SCOPE_SECTION("Islands");
+		const DeltaTime delta_time = DeltaTime(1.f / 60.f);
+
+		System::TextureSystem texture_system;
+		System::MeshSystem mesh_system{texture_system};
+		System::SceneSystem scene_system{texture_system, mesh_system};
+		auto& scene = scene_system.add_scene();
+		scene_system.set_current_scene(scene);
+		System::CollisionSystem collision_system{scene_system};
+		System::PhysicsSystem physics_system{scene_system, collision_system};
+
+		// A static floor with its top at y = 0 and two stacks of two unit spheres far enough apart to never touch.
+		// The spheres start 0.005 into what they rest on, inside the penetration slop, so the stacks settle without bouncing.
+		auto& entities = scene.m_entities;
+		Component::Transform floor_transform{glm::vec3(0.f, -1.f, 0.f)};
+		floor_transform.m_scale = glm::vec3(20.f, 1.f, 20.f);
+		entities.add_entity(std::move(floor_transform), Component::Mesh{mesh_system.m_cube}, Component::Collider{Component::Collider::Shape::Box});
+
+		auto add_sphere = [&](const glm::vec3& p_position)
+		{
+			return entities.add_entity(Component::Transform{p_position}, Component::Mesh{mesh_system.m_sphere}, Component::Collider{Component::Collider::Shape::Sphere}, Component::RigidBody{});
+		};
+		const std::array<ECS::Entity, 2> stack_1 = {add_sphere(glm::vec3(-5.f, 0.995f, 0.f)), add_sphere(glm::vec3(-5.f, 2.99f, 0.f))};
+		const std::array<ECS::Entity, 2> stack_2 = {add_sphere(glm::vec3(5.f, 0.995f, 0.f)), add_sphere(glm::vec3(5.f, 2.99f, 0.f))};
+
+		auto is_asleep = [&](const ECS::Entity& p_entity) { return entities.get_component<Component::RigidBody>(p_entity).m_asleep; };
+		auto tick = [&]()
+		{
+			physics_system.integrate(delta_time);
+			collision_system.update();
+		};
+
+		collision_system.update(); // Find the contacts the first tick solves.
+		{SCOPE_SECTION("Separate stacks")
+			tick();
+			CHECK_EQUAL(physics_system.island_count(), 2, "Two stacks form two islands");
+		}
+		{SCOPE_SECTION("Sleep")
+			// The bodies of an island need to be at rest for Time_To_Sleep before the island sleeps.
+			const size_t ticks_to_sleep = static_cast<size_t>(System::PhysicsSystem::Time_To_Sleep / delta_time.count());
+			for (size_t i = 0; i < ticks_to_sleep / 2; i++)
+				tick();
+			CHECK_TRUE(!is_asleep(stack_1[0]) && !is_asleep(stack_2[0]), "Awake before the sleep timer");
+
+			for (size_t i = 0; i < ticks_to_sleep * 4; i++)
+				tick();
+			CHECK_TRUE(is_asleep(stack_1[0]) && is_asleep(stack_1[1]), "First stack asleep after resting");
+			CHECK_TRUE(is_asleep(stack_2[0]) && is_asleep(stack_2[1]), "Second stack asleep after resting");
+			CHECK_TRUE(entities.get_component<Component::Transform>(stack_1[1]).m_position.y > 2.9f, "Sleeping stack still standing");
+		}
+		{SCOPE_SECTION("Wake")
+			// Drop an awake sphere onto the first stack. Touching the top sphere wakes the bottom one too, the second stack sleeps on.
+			const auto falling_sphere = add_sphere(glm::vec3(-5.f, 5.5f, 0.f));
+			bool stack_1_woken = false;
+			for (size_t i = 0; i < 60 && !stack_1_woken; i++)
+			{
+				tick();
+				stack_1_woken = !is_asleep(stack_1[0]) && !is_asleep(stack_1[1]);
+			}
+			CHECK_TRUE(!is_asleep(falling_sphere), "Falling sphere awake");
+			CHECK_TRUE(stack_1_woken, "Touched island wakes as a whole");
+			CHECK_TRUE(is_asleep(stack_2[0]) && is_asleep(stack_2[1]), "Untouched island stays asleep");
+		}
+	}
+
+	void PhysicsTester::run_transform_snapshot_tests()
+	{
+		SCOPE_SECTION("TransformSnapshot");
+		using Clock = std::chrono::steady_clock;
+		const auto timestep = std::chrono::milliseconds(20);
+
+		System::TransformSnapshot snapshot;
+		snapshot.m_time     = Clock::time_point{} + std::chrono::seconds(1);
+		snapshot.m_timestep = std::chrono::duration_cast<DeltaTime>(timestep);
+
+		{SCOPE_SECTION("get_alpha")
+			CHECK_TRUE(snapshot.get_alpha(snapshot.m_time) == 0.f, "Alpha is 0 at the tick");
+			CHECK_TRUE(std::abs(snapshot.get_alpha(snapshot.m_time + timestep / 2) - 0.5f) < 1e-4f, "Alpha is 0.5 half a timestep after the tick");
+			CHECK_TRUE(std::abs(snapshot.get_alpha(snapshot.m_time + timestep) - 1.f) < 1e-4f, "Alpha is 1 a timestep after the tick");
+			CHECK_TRUE(snapshot.get_alpha(snapshot.m_time - timestep) == 0.f, "Alpha clamped to 0 before the tick");
+			CHECK_TRUE(snapshot.get_alpha(snapshot.m_time + timestep * 3) == 1.f, "Alpha clamped to 1 past the next tick");
+
+			System::TransformSnapshot no_timestep;
+			CHECK_TRUE(no_timestep.get_alpha(Clock::now()) == 1.f, "Alpha is 1 without a timestep");
+		}
+		{SCOPE_SECTION("get_model")
+			// Moves 2 along x while turning a quarter turn about y and doubling in size.
+			Component::Transform previous{glm::vec3(0.f)};
+			Component::Transform current{glm::vec3(2.f, 0.f, 0.f)};
+			current.m_orientation = glm::angleAxis(glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f));
+			current.m_scale       = glm::vec3(2.f);
+			constexpr EntityID entity = 3;
+			snapshot.set(entity, previous, current);
+
+			Component::Transform halfway{glm::vec3(1.f, 0.f, 0.f)};
+			halfway.m_orientation = glm::angleAxis(glm::radians(45.f), glm::vec3(0.f, 1.f, 0.f));
+			halfway.m_scale       = glm::vec3(1.5f);
+
+			const auto model_0    = snapshot.get_model(entity, 0.f);
+			const auto model_half = snapshot.get_model(entity, 0.5f);
+			const auto model_1    = snapshot.get_model(entity, 1.f);
+			CHECK_TRUE(model_0.has_value() && close_to(*model_0, previous.get_model()), "Alpha 0 is the previous Transform");
+			CHECK_TRUE(model_half.has_value() && close_to(*model_half, halfway.get_model()), "Alpha 0.5 is halfway in position, orientation and scale");
+			CHECK_TRUE(model_1.has_value() && close_to(*model_1, current.get_model()), "Alpha 1 is the current Transform");
+			CHECK_TRUE(snapshot.find(entity) != nullptr && snapshot.find(entity)->m_position == current.m_position, "find returns the current Transform");
+
+			CHECK_TRUE(!snapshot.get_model(1, 0.5f).has_value(), "No model for an entity without a Transform");
+			CHECK_TRUE(!snapshot.get_model(100, 0.5f).has_value(), "No model for an entity past the end");
+			snapshot.clear();
+			CHECK_TRUE(!snapshot.get_model(entity, 0.5f).has_value(), "No model after clear");
+		}
+	}
+	void PhysicsTester::run_publish_transforms_tests()
+	{
+		SCOPE_SECTION("publish_transforms");
+		using Clock = std::chrono::steady_clock;
+		const DeltaTime timestep = DeltaTime(1.f / 60.f);
+
+		System::TextureSystem texture_system;
+		System::MeshSystem mesh_system{texture_system};
+		System::SceneSystem scene_system{texture_system, mesh_system};
+		auto& scene = scene_system.add_scene();
+		scene_system.set_current_scene(scene);
+		System::CollisionSystem collision_system{scene_system};
+		System::PhysicsSystem physics_system{scene_system, collision_system};
+
+		auto& entities   = scene.m_entities;
+		const auto first = entities.add_entity(Component::Transform{glm::vec3(0.f)}, Component::RigidBody{});
+		physics_system.publish_transforms(Clock::now(), timestep);
+
+		// Move the first body and add a second, only the first has a Transform in the previous snapshot to interpolate from.
+		entities.get_component<Component::Transform>(first).m_position = glm::vec3(1.f, 0.f, 0.f);
+		const auto second = entities.add_entity(Component::Transform{glm::vec3(0.f, 5.f, 0.f)}, Component::RigidBody{});
+		physics_system.publish_transforms(Clock::now(), timestep);
+
+		const auto& snapshot    = physics_system.latest_transforms();
+		const auto first_model  = snapshot.get_model(first, 0.5f);
+		const auto second_model  = snapshot.get_model(second, 0.f);
+		CHECK_TRUE(first_model.has_value() && close_to(*first_model, Component::Transform{glm::vec3(0.5f, 0.f, 0.f)}.get_model()), "Body in both snapshots interpolates from its last published Transform");
+		CHECK_TRUE(second_model.has_value() && close_to(*second_model, entities.get_component<Component::Transform>(second).get_model()), "Body only in the newest snapshot uses its current Transform");
+	}
+} // namespace Test
+DISABLE_WARNING_POP
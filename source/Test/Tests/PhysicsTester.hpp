@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Test/TestManager.hpp"
+
+namespace Test
+{
+	class PhysicsTester : public TestManager
+	{
+	public:
+		// Without p_graphics the tests that need a PhysicsSystem are skipped, the MeshSystem of its scene uploads its meshes to a GL context.
+		PhysicsTester(bool p_graphics) : TestManager(std::string("PHYSICS")), m_graphics{p_graphics} {}
+
+		void run_unit_tests()        override;
+		void run_performance_tests() override;
+
+	private:
+		bool m_graphics;
+
+		void run_integrator_tests();
+		void run_contact_solver_tests();
+		void run_island_tests();
+		void run_transform_snapshot_tests();
+		void run_publish_transforms_tests();
+	};
+} // namespace Test
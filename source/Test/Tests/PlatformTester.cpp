@@ -0,0 +1,155 @@
+#include "PlatformTester.hpp"
+
+#include "Platform/Input.hpp"
+#include "Platform/InputRecording.hpp"
+#include "Utility/Utility.hpp"
+
+#include "imgui.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_HIDES_PREVIOUS_DECLERATION // Required to allow shadowing for the SCOPE_SECTION macro
+
+namespace Test
+{
+	void PlatformTester::run_unit_tests()
+	{
+		run_input_recording_tests();
+	}
+	void PlatformTester::run_performance_tests()
+	{}
+
+	void PlatformTester::run_input_recording_tests()
+	{
+		using namespace std::chrono_literals;
+		SCOPE_SECTION("Input recording");
+
+		// InputRecorder reads the UI capture state from ImGui at the end of every tick.
+		ImGui::CreateContext();
+		auto& io = ImGui::GetIO();
+
+		const auto path = std::filesystem::temp_directory_path() / "Spirit_PlatformTester.sprtinpt";
+		const Platform::InputLogHeader header{.physics_ticks_per_second = 50, .input_ticks_per_second = 100, .render_ticks_per_second = 144, .seed = 7, .cursor_position = {12.5f, -3.f}};
+
+		// The events applied over the ticks recorded, one of every InputEvent alternative in the first tick.
+		const std::vector<Platform::InputEvent> first_tick_events = {
+			Platform::KeyEvent{Platform::Key::W, Platform::Action::Press},
+			Platform::ModifierEvent{Platform::Modifier::Shift, Platform::Action::Press},
+			Platform::MouseButtonEvent{Platform::MouseButton::Right, Platform::Action::Release},
+			Platform::CursorMoveEvent{{640.25f, 360.5f}},
+			Platform::ScrollEvent{{0.f, -1.5f}}};
+		const std::vector<Platform::InputEvent> last_tick_events = {Platform::KeyEvent{Platform::Key::Escape, Platform::Action::Repeat}};
+
+		// Record three ticks, the second without events. The last tick's deltas take several varint bytes.
+		auto record = [&](bool p_finish)
+		{
+			Platform::Input input;
+			Platform::InputRecorder recorder{input, path, header};
+
+			for (const auto& event : first_tick_events)
+				input.apply(event);
+			io.WantCaptureMouse    = true;
+			io.WantCaptureKeyboard = false;
+			recorder.end_tick(3, 8333us);
+
+			io.WantCaptureMouse    = false;
+			io.WantCaptureKeyboard = true;
+			recorder.end_tick(3, 16666us);
+
+			for (const auto& event : last_tick_events)
+				input.apply(event);
+			io.WantCaptureKeyboard = false;
+			recorder.end_tick(1000, 5s);
+
+			if (p_finish)
+				recorder.finish(1200);
+		};
+
+		{SCOPE_SECTION("Round trip")
+			record(true);
+
+			Platform::Input input;
+			std::vector<Platform::InputEvent> replayed_events;
+			input.m_input_event.subscribe(&replayed_events, [](std::vector<Platform::InputEvent>* p_events, const Platform::InputEvent& p_event) { p_events->push_back(p_event); });
+
+			Platform::InputReplay replay{input, path};
+			CHECK_EQUAL(replay.header().physics_ticks_per_second, header.physics_ticks_per_second, "Header physics rate");
+			CHECK_EQUAL(replay.header().input_ticks_per_second, header.input_ticks_per_second, "Header input rate");
+			CHECK_EQUAL(replay.header().render_ticks_per_second, header.render_ticks_per_second, "Header render rate");
+			CHECK_EQUAL(replay.header().seed, header.seed, "Header seed");
+			CHECK_TRUE(replay.header().cursor_position == header.cursor_position, "Header cursor position");
+			CHECK_TRUE(input.cursor_position() == header.cursor_position, "Replay starts at the recorded cursor position");
+			CHECK_EQUAL(replay.input_ticks(), 3, "Input tick count");
+			CHECK_EQUAL(replay.physics_ticks(), 1200, "Physics ticks from the end record");
+
+			CHECK_TRUE(!replay.tick_due(2), "First tick not due before its physics tick");
+			CHECK_TRUE(replay.tick_due(3), "First tick due at its physics tick");
+			replay.apply_next_tick();
+			CHECK_TRUE(replayed_events == first_tick_events, "First tick replays every InputEvent alternative in order");
+			CHECK_TRUE(input.cursor_over_UI(), "First tick cursor over UI");
+			CHECK_TRUE(!input.keyboard_captured_by_UI(), "First tick keyboard not captured");
+			CHECK_TRUE(input.is_key_down(Platform::Key::W), "Replayed key press updates the Input");
+			CHECK_TRUE(input.cursor_position() == glm::vec2(640.25f, 360.5f), "Replayed cursor move updates the Input");
+
+			replayed_events.clear();
+			CHECK_TRUE(replay.tick_due(3), "Tick without events due at the same physics tick");
+			replay.apply_next_tick();
+			CHECK_TRUE(replayed_events.empty(), "Tick without events applies none");
+			CHECK_TRUE(!input.cursor_over_UI(), "Tick without events cursor not over UI");
+			CHECK_TRUE(input.keyboard_captured_by_UI(), "Tick without events keyboard captured");
+
+			CHECK_TRUE(!replay.tick_due(999), "Last tick not due before its physics tick");
+			CHECK_TRUE(replay.tick_due(1000), "Last tick due at its physics tick");
+			replay.apply_next_tick();
+			CHECK_TRUE(replayed_events == last_tick_events, "Last tick events");
+			CHECK_TRUE(!replay.tick_due(replay.physics_ticks()), "No ticks due after the last");
+		}
+		{SCOPE_SECTION("No end record")
+			// A run that didn't exit cleanly never writes the end record, the replay ends at its last input tick.
+			record(false);
+
+			Platform::Input input;
+			Platform::InputReplay replay{input, path};
+			CHECK_EQUAL(replay.input_ticks(), 3, "Input tick count");
+			CHECK_EQUAL(replay.physics_ticks(), 1000, "Physics ticks end at the last input tick");
+		}
+		{SCOPE_SECTION("Corrupt event count")
+			// Replace the count of the last tick's single event and the event itself with a count of 2^32 - 1.
+			record(false);
+			std::vector<char> data;
+			{
+				std::ifstream file(path, std::ios::binary);
+				data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			}
+			data.resize(data.size() - 4);
+			for (const uint8_t byte : {0xFF, 0xFF, 0xFF, 0xFF, 0x0F})
+				data.push_back(static_cast<char>(byte));
+			{
+				std::ofstream file(path, std::ios::binary | std::ios::trunc);
+				file.write(data.data(), static_cast<std::streamsize>(data.size()));
+			}
+
+			bool rejected = false;
+			try
+			{
+				Platform::Input input;
+				Platform::InputReplay replay{input, path};
+			}
+			catch (const std::logic_error&)   { rejected = true; }
+			catch (const std::runtime_error&) { rejected = true; }
+			catch (const std::exception&)     {} // Any other exception, such as std::bad_alloc, means the count wasn't checked.
+			CHECK_TRUE(rejected, "Event count larger than the bytes left is rejected before allocating");
+		}
+
+		std::filesystem::remove(path);
+		ImGui::DestroyContext();
+	}
+} // namespace Test
+DISABLE_WARNING_POP
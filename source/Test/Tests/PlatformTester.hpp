@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Test/TestManager.hpp"
+
+namespace Test
+{
+	class PlatformTester : public TestManager
+	{
+	public:
+		PlatformTester() : TestManager(std::string("PLATFORM")) {}
+
+		void run_unit_tests()        override;
+		void run_performance_tests() override;
+
+	private:
+		void run_input_recording_tests();
+	};
+} // namespace Test
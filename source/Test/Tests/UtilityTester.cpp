@@ -0,0 +1,137 @@
+#include "UtilityTester.hpp"
+
+#include "Utility/FixedTimestep.hpp"
+#include "Utility/Utility.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_HIDES_PREVIOUS_DECLERATION // Required to allow shadowing for the SCOPE_SECTION macro
+
+namespace Test
+{
+	void UtilityTester::run_unit_tests()
+	{
+		run_fixed_timestep_tests();
+	}
+	void UtilityTester::run_performance_tests()
+	{}
+
+	void UtilityTester::run_fixed_timestep_tests()
+	{
+		using Clock = Utility::FixedTimestep::Clock;
+		SCOPE_SECTION("FixedTimestep");
+
+		// Times are compared in nanoseconds since a start of 0.
+		constexpr int64_t Second = 1'000'000'000;
+		const Clock::time_point start{};
+		auto at          = [&](int64_t p_nanoseconds) { return start + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(p_nanoseconds)); };
+		auto nanoseconds = [&](Clock::time_point p_time) { return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(p_time - start).count()); };
+
+		{SCOPE_SECTION("Tick n at 60Hz")
+			// 1/60 s isn't a whole number of nanoseconds, tick n must be due at floor(n * 1e9 / 60) ns rather than n accumulated timesteps.
+			Utility::FixedTimestep ticks{60, start};
+			bool steps_within_a_nanosecond = true;
+			for (int tick = 0; tick < 60; tick++)
+			{
+				const int64_t before = nanoseconds(ticks.current_time());
+				ticks.consume(ticks.next_tick());
+				const int64_t step = nanoseconds(ticks.current_time()) - before;
+				steps_within_a_nanosecond = steps_within_a_nanosecond && (step == 16'666'666 || step == 16'666'667);
+			}
+			CHECK_TRUE(steps_within_a_nanosecond, "Consecutive timesteps differ by at most one nanosecond");
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), Second, "60 ticks take exactly 1 second");
+
+			// 100 years of ticks, n * 1e9 overflows 64 bits.
+			constexpr int64_t Seconds = 100ll * 365 * 24 * 60 * 60;
+			Utility::FixedTimestep far_ticks{60, start};
+			far_ticks.skip_missed(at(Seconds * Second + 16'666'666));
+			CHECK_EQUAL(nanoseconds(far_ticks.current_time()), Seconds * Second + 16'666'666, "Tick 60 * 100 years + 1");
+			CHECK_EQUAL(nanoseconds(far_ticks.next_tick()), Seconds * Second + 33'333'333, "Tick 60 * 100 years + 2");
+			far_ticks.skip_missed(at(Seconds * Second + Second - 1));
+			CHECK_EQUAL(nanoseconds(far_ticks.current_time()), Seconds * Second + 983'333'333, "Tick 60 * 100 years + 59");
+			CHECK_EQUAL(nanoseconds(far_ticks.next_tick()), (Seconds + 1) * Second, "Tick 60 * (100 years + 1 second)");
+		}
+		{SCOPE_SECTION("Last tick due")
+			// Skipping to t advances to the last tick due by t, which must not be after t while the tick following it is.
+			std::mt19937_64 generator{42};
+			for (const unsigned rate : {1u, 3u, 7u, 60u, 144u, 1000u, 999'983u})
+			{
+				const int64_t timestep = Second / rate;
+				std::uniform_int_distribution<int64_t> step(0, timestep * 3);
+				std::uniform_int_distribution<int64_t> far(0, 4'000'000'000 * Second);
+
+				bool never_after  = true;
+				bool next_after   = true;
+				Utility::FixedTimestep ticks{rate, start};
+				int64_t time = 0;
+				for (int i = 0; i < 1000; i++)
+				{
+					time += step(generator);
+					ticks.skip_missed(at(time));
+					never_after = never_after && ticks.current_time() <= at(time);
+					next_after  = next_after && ticks.next_tick() > at(time);
+
+					const int64_t far_time = far(generator);
+					Utility::FixedTimestep far_ticks{rate, start};
+					far_ticks.skip_missed(at(far_time));
+					never_after = never_after && far_ticks.current_time() <= at(far_time);
+					next_after  = next_after && far_ticks.next_tick() > at(far_time);
+				}
+				CHECK_TRUE(never_after, std::format("Last tick due is not after the time at {}Hz", rate));
+				CHECK_TRUE(next_after, std::format("Tick after the last due is after the time at {}Hz", rate));
+			}
+		}
+		{SCOPE_SECTION("Rate change")
+			Utility::FixedTimestep ticks{60, start};
+			for (int tick = 0; tick < 31; tick++)
+				ticks.consume(ticks.next_tick());
+			constexpr int64_t Tick_31 = 516'666'666; // floor(31 * 1e9 / 60)
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), Tick_31, "Tick 31 at 60Hz");
+
+			ticks.set_ticks_per_second(144);
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), Tick_31, "Changing the rate keeps the last consumed tick");
+			CHECK_EQUAL(nanoseconds(ticks.next_tick()), Tick_31 + 6'944'444, "Next tick is one 144Hz timestep after the last consumed tick");
+			ticks.set_ticks_per_second(144);
+			CHECK_EQUAL(nanoseconds(ticks.next_tick()), Tick_31 + 6'944'444, "Setting the same rate changes nothing");
+
+			int consumed = 0;
+			while (ticks.consume(at(Tick_31 + Second)))
+				consumed++;
+			CHECK_EQUAL(consumed, 144, "A second after the change has 144 ticks");
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), Tick_31 + Second, "Last tick lands exactly a second after the change");
+
+			// Ticks due before the change but not yet consumed run at the new rate from the last consumed tick.
+			Utility::FixedTimestep behind{60, start};
+			behind.set_ticks_per_second(120);
+			consumed = 0;
+			while (behind.consume(at(Second / 2)))
+				consumed++;
+			CHECK_EQUAL(consumed, 60, "Backlog before the change runs at the new rate");
+			CHECK_EQUAL(nanoseconds(behind.current_time()), Second / 2, "Backlog ends at the time it was due by");
+		}
+		{SCOPE_SECTION("limit_backlog")
+			Utility::FixedTimestep ticks{60, start};
+			for (int tick = 0; tick < 3; tick++)
+				ticks.consume(ticks.next_tick());
+
+			ticks.limit_backlog(at(200'000'000), std::chrono::milliseconds(250));
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), 50'000'000, "Backlog within the limit is kept");
+
+			// A stall to 10.005s keeps the ticks due in the last 250ms, the last skipped is tick 585 at 9.75s.
+			const auto now = at(10 * Second + 5'000'000);
+			ticks.limit_backlog(now, std::chrono::milliseconds(250));
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), 9'750'000'000, "Skipped to the last tick due 250ms before now");
+			CHECK_EQUAL(nanoseconds(ticks.next_tick()), 9'766'666'666, "Next tick is tick 586, on the same phase");
+
+			int consumed = 0;
+			while (ticks.consume(now))
+				consumed++;
+			CHECK_EQUAL(consumed, 15, "Ticks 586 to 600 are caught up");
+			CHECK_EQUAL(nanoseconds(ticks.current_time()), 10 * Second, "Catching up ends on tick 600 at exactly 10s");
+		}
+	}
+} // namespace Test
+DISABLE_WARNING_POP
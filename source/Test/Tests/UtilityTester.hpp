@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Test/TestManager.hpp"
+
+namespace Test
+{
+	class UtilityTester : public TestManager
+	{
+	public:
+		UtilityTester() : TestManager(std::string("UTILITY")) {}
+
+		void run_unit_tests()        override;
+		void run_performance_tests() override;
+
+	private:
+		void run_fixed_timestep_tests();
+	};
+} // namespace Test
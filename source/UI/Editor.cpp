@@ -616,6 +616,14 @@ namespace UI
 						}
 					}
 
+					ImGui::Checkbox("Collision response", &m_physics_system.m_apply_collision_response);
+					if (!m_physics_system.m_apply_collision_response) ImGui::BeginDisabled();
+					ImGui::Slider("Restitution",         m_physics_system.m_restitution, 0.f, 1.f);
+					ImGui::Slider("Friction",            m_physics_system.m_friction, 0.f, 2.f);
+					ImGui::Slider("Velocity iterations", m_physics_system.m_velocity_iterations, 1, 50);
+					ImGui::Checkbox("Allow sleeping", &m_physics_system.m_allow_sleeping);
+					if (!m_physics_system.m_apply_collision_response) ImGui::EndDisabled();
+
 					ImGui::Checkbox("Show orientations",        &debug_options.m_show_orientations);
 					ImGui::Checkbox("Show bounding box",        &debug_options.m_show_bounding_box);
 					ImGui::Checkbox("Fill bounding box",        &debug_options.m_fill_bounding_box);
@@ -666,7 +674,7 @@ namespace UI
 							Component::RigidBody{},
 							Component::Transform{*m_cursor_intersection},
 							Component::Mesh{m_mesh_system.m_cube},
-							Component::Collider{});
+							Component::Collider{Component::Collider::Shape::Box});
 					}
 					else if (ImGui::Button("Terrain"))
 					{
@@ -0,0 +1,268 @@
+#include "Benchmark.hpp"
+#include "Logger.hpp"
+#include "Utility.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+	#include <psapi.h>
+#elif defined(__linux__) || defined(__APPLE__)
+	#include <sys/resource.h>
+#endif
+
+namespace Utility
+{
+	std::optional<Benchmark::Parameters> Benchmark::Parameters::parse(int argc, char* argv[])
+	{
+		Parameters parameters;
+		bool benchmark = false;
+
+		for (int index = 1; index + 1 < argc; ++index)
+		{
+			const std::string_view argument = argv[index];
+			if (argument == "--benchmark")
+			{
+				parameters.scene = argv[++index];
+				benchmark        = true;
+			}
+			else if (argument == "--replay")
+			{
+				parameters.input_log = argv[++index];
+				benchmark            = true;
+			}
+			else if (argument == "--ticks")
+				parameters.physics_ticks = std::strtoull(argv[++index], nullptr, 10);
+			else if (argument == "--seed")
+				parameters.seed = static_cast<uint32_t>(std::strtoul(argv[++index], nullptr, 10));
+			else if (argument == "--output")
+				parameters.output = argv[++index];
+		}
+
+		// The options may come before or after --benchmark and --replay.
+		if (!benchmark)
+			return std::nullopt;
+
+		ASSERT_THROW(!parameters.output.empty(), "[BENCHMARK] --output <json file> is required to benchmark");
+		return parameters;
+	}
+	bool Benchmark::Parameters::is_option(std::string_view p_argument)
+	{
+		return p_argument == "--benchmark" || p_argument == "--replay" || p_argument == "--ticks" || p_argument == "--seed" || p_argument == "--output";
+	}
+
+	Benchmark::Run Benchmark::start_run(const Parameters& p_parameters, const std::optional<Recording>& p_recording, const std::function<void(std::istream&)>& p_load_scene)
+	{
+		Run run;
+		run.scene_name    = p_parameters.scene.empty() ? "startup" : p_parameters.scene.string();
+		run.seed          = p_recording ? p_recording->seed : p_parameters.seed;
+		run.physics_ticks = p_recording ? p_recording->physics_ticks : p_parameters.physics_ticks;
+
+		Utility::set_random_seed(run.seed);
+		if (!p_parameters.scene.empty())
+		{
+			std::ifstream file(p_parameters.scene);
+			ASSERT_THROW(file.is_open(), "[BENCHMARK] Failed to open scene '{}'", p_parameters.scene.string());
+			p_load_scene(file);
+		}
+		LOG("[BENCHMARK] Running {} physics ticks of scene '{}' with seed {}", run.physics_ticks, run.scene_name, run.seed);
+
+		set("config", "scene", run.scene_name);
+		set("config", "seed", static_cast<uint64_t>(run.seed));
+		if (p_recording)
+			set("config", "input_log", p_parameters.input_log.string());
+		record_memory_high_water("scene_loaded");
+		return run;
+	}
+	void Benchmark::keep_samples(std::initializer_list<Timings*> p_timings, size_t p_expected_count)
+	{
+		for (auto* timings : p_timings)
+			timings->keep_samples(p_expected_count);
+	}
+
+	void Benchmark::Timings::keep_samples(size_t p_expected_count)
+	{
+		ASSERT(m_count == 0, "[BENCHMARK] Samples of '{}' must be kept from the first add", m_name);
+		m_keep_samples = true;
+		m_samples.reserve(p_expected_count);
+	}
+	void Benchmark::Timings::add(Clock::duration p_duration)
+	{
+		const float microseconds = std::chrono::duration<float, std::micro>(p_duration).count();
+		if (m_keep_samples)
+			m_samples.push_back(microseconds);
+
+		m_bins[bin_index(microseconds)]++;
+		m_min = m_count == 0 ? microseconds : std::min(m_min, microseconds);
+		m_max = m_count == 0 ? microseconds : std::max(m_max, microseconds);
+		m_total += microseconds;
+		m_count++;
+	}
+	Benchmark::Summary Benchmark::Timings::summarise() const
+	{
+		Summary summary;
+		if (m_count == 0)
+			return summary;
+
+		summary.count = m_count;
+		summary.min   = m_min;
+		summary.mean  = m_total / static_cast<double>(m_count);
+		summary.max   = m_max;
+
+		// Nearest-rank percentile, the smallest duration at least p percent of the durations are less than or equal to.
+		auto rank = [this](double p_percent) { return std::clamp<size_t>(static_cast<size_t>(std::ceil(p_percent / 100.0 * static_cast<double>(m_count))), 1, m_count); };
+
+		if (m_keep_samples)
+		{
+			std::vector<float> sorted = m_samples;
+			std::sort(sorted.begin(), sorted.end());
+			summary.p50 = sorted[rank(50.0) - 1];
+			summary.p95 = sorted[rank(95.0) - 1];
+			summary.p99 = sorted[rank(99.0) - 1];
+		}
+		else
+		{
+			// The upper bound of the bin holding the ranked duration, clamped as no duration lies outside the min and max.
+			auto percentile = [&](double p_percent)
+			{
+				const size_t target = rank(p_percent);
+				size_t seen         = 0;
+				for (size_t i = 0; i < Bin_Count; i++)
+				{
+					seen += m_bins[i];
+					if (seen >= target)
+						return static_cast<double>(std::clamp(bin_upper_bound(i), m_min, m_max));
+				}
+				return static_cast<double>(m_max);
+			};
+			summary.p50 = percentile(50.0);
+			summary.p95 = percentile(95.0);
+			summary.p99 = percentile(99.0);
+		}
+		return summary;
+	}
+	size_t Benchmark::Timings::bin_index(float p_microseconds)
+	{
+		if (!(p_microseconds > Min_Bin_Bound)) // Also catches NaN.
+			return 0;
+
+		const auto index = static_cast<size_t>(std::ceil(std::log2(p_microseconds / Min_Bin_Bound) * static_cast<float>(Bins_Per_Octave)));
+		return std::min(index, Bin_Count - 1);
+	}
+	float Benchmark::Timings::bin_upper_bound(size_t p_index)
+	{
+		return p_index + 1 == Bin_Count ? std::numeric_limits<float>::max()
+		                                 : Min_Bin_Bound * std::exp2(static_cast<float>(p_index) / static_cast<float>(Bins_Per_Octave));
+	}
+
+	void Benchmark::set(std::string_view p_section, std::string_view p_name, Value p_value)
+	{
+		auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& p_entry) { return p_entry.section == p_section && p_entry.name == p_name; });
+		if (it != m_entries.end())
+			it->value = std::move(p_value);
+		else
+			m_entries.push_back({std::string(p_section), std::string(p_name), std::move(p_value)});
+	}
+	void Benchmark::record_memory_high_water(std::string_view p_name)
+	{
+		set("memory_high_water_bytes", p_name, static_cast<uint64_t>(peak_memory_usage()));
+	}
+
+	static std::string to_JSON_string(std::string_view p_string)
+	{
+		std::string escaped = "\"";
+		for (const char character : p_string)
+		{
+			switch (character)
+			{
+				case '"':  escaped += "\\\""; break;
+				case '\\': escaped += "\\\\"; break;
+				case '\n': escaped += "\\n";  break;
+				case '\t': escaped += "\\t";  break;
+				default:   escaped += character; break;
+			}
+		}
+		return escaped + '"';
+	}
+	static std::string to_JSON_value(const Benchmark::Value& p_value)
+	{
+		if (auto integer = std::get_if<uint64_t>(&p_value))
+			return std::to_string(*integer);
+		else if (auto real = std::get_if<double>(&p_value))
+			return std::isfinite(*real) ? std::format("{:.3f}", *real) : "null";
+		else
+			return to_JSON_string(std::get<std::string>(p_value));
+	}
+
+	std::string Benchmark::to_JSON() const
+	{
+		std::vector<std::string_view> sections;
+		for (const auto& entry : m_entries)
+			if (std::find(sections.begin(), sections.end(), entry.section) == sections.end())
+				sections.push_back(entry.section);
+
+		std::string JSON = "{\n";
+		for (const auto& section : sections)
+		{
+			JSON += std::format("\t{}: {{\n", to_JSON_string(section));
+
+			bool first = true;
+			for (const auto& entry : m_entries)
+			{
+				if (entry.section != section)
+					continue;
+
+				JSON += std::format("{}\t\t{}: {}", first ? "" : ",\n", to_JSON_string(entry.name), to_JSON_value(entry.value));
+				first = false;
+			}
+			JSON += "\n\t},\n";
+		}
+
+		JSON += "\t\"systems\": {\n";
+		for (size_t i = 0; i < m_timings.size(); i++)
+		{
+			const Summary summary = m_timings[i].summarise();
+			JSON += std::format("\t\t{}: {{\"count\": {}, \"min_us\": {:.3f}, \"mean_us\": {:.3f}, \"p50_us\": {:.3f}, \"p95_us\": {:.3f}, \"p99_us\": {:.3f}, \"max_us\": {:.3f}}}{}\n",
+				to_JSON_string(m_timings[i].name()), summary.count, summary.min, summary.mean, summary.p50, summary.p95, summary.p99, summary.max,
+				i + 1 == m_timings.size() ? "" : ",");
+		}
+		JSON += "\t}\n}\n";
+		return JSON;
+	}
+	void Benchmark::write_JSON(const std::filesystem::path& p_path) const
+	{
+		std::ofstream file(p_path);
+		ASSERT_THROW(file.is_open(), "[BENCHMARK] Failed to open '{}' to write the results", p_path.string());
+		file << to_JSON();
+		LOG("[BENCHMARK] Results written to '{}'", p_path.string());
+	}
+
+	size_t Benchmark::peak_memory_usage()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return counters.PeakWorkingSetSize;
+		return 0;
+#elif defined(__linux__) || defined(__APPLE__)
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+	#ifdef __APPLE__
+		return static_cast<size_t>(usage.ru_maxrss); // Bytes on macOS.
+	#else
+		return static_cast<size_t>(usage.ru_maxrss) * 1024; // Kilobytes on Linux.
+	#endif
+#else
+		return 0;
+#endif
+	}
+} // namespace Utility
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace Utility
+{
+	// Collects the duration of every update of a set of named systems alongside counts describing the run, and reports them as JSON.
+	// Durations are binned into a fixed histogram so an interactive run of any length uses constant memory, percentiles are then
+	// the upper bound of their bin. Runs of a known length can keep every duration with Timings::keep_samples for exact percentiles.
+	// Timings are added before the run starts. Each Timings may then be written by one thread while other threads write theirs.
+	class Benchmark
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Command line options of the benchmark mode:
+		// [--benchmark <scene file>] [--replay <input log>] [--ticks <physics ticks>] [--seed <seed>] --output <json file>
+		struct Parameters
+		{
+			std::filesystem::path scene;     // Scene saved by Scene::serialise to load and run. If empty the startup scene is run.
+			std::filesystem::path input_log; // Log written by Platform::InputRecorder to replay. If set the physics ticks, tick rates and seed are the recording's.
+			size_t physics_ticks = 1000;     // Physics ticks to run, render ticks run at their rate over the same simulated time.
+			uint32_t seed        = 1234;     // Seed for Utility::random_engine.
+			std::filesystem::path output;    // File to write the JSON to. Required so the results aren't mixed with the log on stdout.
+
+			//@return The Parameters if --benchmark or --replay was passed, otherwise nullopt. Throws if --output is missing.
+			static std::optional<Parameters> parse(int argc, char* argv[]);
+			//@return True if p_argument is one of the Parameters options, used to skip them when parsing other options.
+			static bool is_option(std::string_view p_argument);
+		};
+
+		// The seed and length of a replayed input log, a replay runs with these in place of the Parameters'.
+		struct Recording
+		{
+			uint32_t seed        = 0;
+			size_t physics_ticks = 0;
+		};
+		// The settings of a benchmark run, see start_run.
+		struct Run
+		{
+			std::string scene_name; // The scene file or "startup".
+			uint32_t seed        = 0;
+			size_t physics_ticks = 0;
+
+			// Ticks of a stream at p_ticks_per_second due over the simulated time of the physics ticks, rounded up.
+			size_t ticks_at(unsigned p_ticks_per_second, unsigned p_physics_ticks_per_second) const { return physics_ticks * p_ticks_per_second / p_physics_ticks_per_second + 1; }
+		};
+
+		// Distribution of a series of durations in microseconds.
+		struct Summary
+		{
+			size_t count = 0;
+			double min   = 0.0;
+			double mean  = 0.0;
+			double p50   = 0.0;
+			double p95   = 0.0;
+			double p99   = 0.0;
+			double max   = 0.0;
+		};
+		// The durations of every update of one system.
+		class Timings
+		{
+		public:
+			Timings(std::string_view p_name) : m_name{p_name}, m_samples{}, m_keep_samples{false}, m_bins{}, m_count{0}, m_total{0.0}, m_min{0.f}, m_max{0.f} {}
+
+			// Keep every duration so summarise reports exact percentiles. Call before the first add, reserving the expected count
+			// so the run doesn't reallocate. Memory then grows with every add, so only for runs of a known length.
+			void keep_samples(size_t p_expected_count);
+			void add(Clock::duration p_duration);
+			Summary summarise() const;
+			const std::string& name() const { return m_name; }
+
+		private:
+			// Bin i holds the durations above the bound of bin i - 1 up to Min_Bin_Bound * 2^(i / Bins_Per_Octave) microseconds, about 9% wide.
+			// The bins cover 0.125us to over 8 minutes, anything longer falls in the last.
+			static constexpr size_t Bin_Count       = 256;
+			static constexpr size_t Bins_Per_Octave = 8;
+			static constexpr float Min_Bin_Bound    = 0.125f;
+			static size_t bin_index(float p_microseconds);
+			static float bin_upper_bound(size_t p_index);
+
+			std::string m_name;
+			std::vector<float> m_samples; // Microseconds, only filled if m_keep_samples.
+			bool m_keep_samples;
+			std::array<uint64_t, Bin_Count> m_bins;
+			size_t m_count;
+			double m_total;
+			float m_min;
+			float m_max;
+		};
+		// Adds the time between its construction and destruction to a Timings.
+		class ScopedTimer
+		{
+		public:
+			ScopedTimer(Timings& p_timings) : m_timings{p_timings}, m_start{Clock::now()} {}
+			~ScopedTimer() { m_timings.add(Clock::now() - m_start); }
+			ScopedTimer(const ScopedTimer& p_other)            = delete;
+			ScopedTimer& operator=(const ScopedTimer& p_other) = delete;
+
+		private:
+			Timings& m_timings;
+			Clock::time_point m_start;
+		};
+
+		using Value = std::variant<uint64_t, double, std::string>;
+
+		// The setup every application's benchmark mode shares. Seeds Utility::random_engine, loads the scene of p_parameters,
+		// logs the run, sets the "config" section and records the "scene_loaded" memory high-water mark.
+		//@param p_recording The replayed input log of p_parameters, nullopt if it has none.
+		//@param p_load_scene Called with the open scene file to deserialise and make current. Not called for the startup scene.
+		Run start_run(const Parameters& p_parameters, const std::optional<Recording>& p_recording, const std::function<void(std::istream&)>& p_load_scene);
+		// Keep every duration of each of p_timings for exact percentiles, see Timings::keep_samples.
+		static void keep_samples(std::initializer_list<Timings*> p_timings, size_t p_expected_count);
+
+		// Add a system to time. The returned reference stays valid for the lifetime of the Benchmark.
+		Timings& add_timings(std::string_view p_name) { return m_timings.emplace_back(p_name); }
+		// Set p_name in p_section of the report to p_value, replacing any value already set.
+		void set(std::string_view p_section, std::string_view p_name, Value p_value);
+		// Set p_name in the "memory_high_water_bytes" section to the peak memory used by the process so far.
+		void record_memory_high_water(std::string_view p_name);
+
+		// The sections in the order they were first set followed by "systems" with the Summary of each Timings.
+		std::string to_JSON() const;
+		// Write to_JSON to p_path.
+		void write_JSON(const std::filesystem::path& p_path) const;
+
+		//@return The peak resident memory of the process in bytes, 0 if the platform doesn't provide it.
+		static size_t peak_memory_usage();
+
+	private:
+		struct Entry
+		{
+			std::string section;
+			std::string name;
+			Value value;
+		};
+
+		std::deque<Timings> m_timings; // Deque so the references returned by add_timings are stable.
+		std::vector<Entry> m_entries;
+	};
+} // namespace Utility
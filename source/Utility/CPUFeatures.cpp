@@ -0,0 +1,59 @@
+#include "CPUFeatures.hpp"
+
+#if defined(Z_X86) && defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+	#include <immintrin.h>
+#endif
+
+namespace Utility
+{
+	static InstructionSet detect_instruction_set()
+	{
+#if defined(Z_X86) && defined(_MSC_VER) && !defined(__clang__)
+		int info[4] = {0, 0, 0, 0};
+		__cpuid(info, 0);
+		const int max_leaf = info[0];
+
+		__cpuid(info, 1);
+		const bool SSE4_2  = (info[2] & (1 << 20)) != 0;
+		const bool OSXSAVE = (info[2] & (1 << 27)) != 0;
+		const bool AVX     = (info[2] & (1 << 28)) != 0;
+
+		bool AVX2 = false;
+		// AVX state has to be enabled by the OS (XCR0 bits 1 and 2) as well as supported by the CPU.
+		if (max_leaf >= 7 && OSXSAVE && AVX && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(info, 7, 0);
+			AVX2 = (info[1] & (1 << 5)) != 0;
+		}
+
+		if (AVX2)   return InstructionSet::AVX2;
+		if (SSE4_2) return InstructionSet::SSE4;
+		return InstructionSet::Scalar;
+#elif defined(Z_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))   return InstructionSet::AVX2;
+		if (__builtin_cpu_supports("sse4.2")) return InstructionSet::SSE4;
+		return InstructionSet::Scalar;
+#else
+		return InstructionSet::Scalar;
+#endif
+	}
+
+	InstructionSet instruction_set()
+	{
+		static const InstructionSet detected = detect_instruction_set();
+		return detected;
+	}
+
+	const char* to_string(InstructionSet p_instruction_set)
+	{
+		switch (p_instruction_set)
+		{
+			case InstructionSet::Scalar: return "Scalar";
+			case InstructionSet::SSE4:   return "SSE4";
+			case InstructionSet::AVX2:   return "AVX2";
+			default:                     return "Unknown";
+		}
+	}
+} // namespace Utility
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// Architecture and per-function target macros for SIMD kernels.
+// Kernels are compiled for a wider instruction set than the build baseline using TARGET_AVX2/TARGET_SSE4 and
+// are only called after Utility::instruction_set() confirms the running CPU supports them.
+//
+// Every SIMD kernel gives bit-identical results to its scalar kernel, so a simulation doesn't depend on the CPU it runs on.
+// A kernel performs the operations of its scalar kernel in the same order, with separate mul and add rather than FMA, which
+// rounds once where the scalar code rounds twice. The targets enable AVX2 and SSE4.2 without FMA so the compiler can't contract them either.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define Z_X86
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define TARGET_AVX2
+	#define TARGET_SSE4
+#elif defined(__GNUC__) || defined(__clang__)
+	#define TARGET_AVX2 __attribute__((target("avx2")))
+	#define TARGET_SSE4 __attribute__((target("sse4.2")))
+#else
+	#define TARGET_AVX2
+	#define TARGET_SSE4
+#endif
+
+namespace Utility
+{
+	// Instruction sets the SIMD kernels are written for, ordered from narrowest to widest.
+	enum class InstructionSet : uint8_t
+	{
+		Scalar,
+		SSE4,
+		AVX2
+	};
+
+	// The widest InstructionSet the running CPU (and OS) supports. Detected on first call and cached.
+	InstructionSet instruction_set();
+	const char* to_string(InstructionSet p_instruction_set);
+} // namespace Utility
@@ -0,0 +1,69 @@
+#include "FixedTimestep.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+
+namespace Utility
+{
+	// Clock periods in a second. steady_clock is integral nanoseconds on every platform we build for.
+	static_assert(FixedTimestep::Clock::period::num == 1, "FixedTimestep requires a Clock period of 1/N seconds.");
+	constexpr uint64_t Periods_Per_Second = FixedTimestep::Clock::period::den;
+
+	FixedTimestep::FixedTimestep(unsigned p_ticks_per_second, Clock::time_point p_start)
+		: m_start{p_start}
+		, m_tick{0}
+		, m_ticks_per_second{p_ticks_per_second}
+	{
+		ASSERT(m_ticks_per_second > 0, "[FIXED TIMESTEP] Ticks per second must be above 0");
+	}
+
+	void FixedTimestep::set_ticks_per_second(unsigned p_ticks_per_second)
+	{
+		ASSERT(p_ticks_per_second > 0, "[FIXED TIMESTEP] Ticks per second must be above 0");
+		if (p_ticks_per_second == m_ticks_per_second)
+			return;
+
+		m_start            = current_time();
+		m_tick             = 0;
+		m_ticks_per_second = p_ticks_per_second;
+	}
+
+	bool FixedTimestep::consume(Clock::time_point p_now)
+	{
+		if (next_tick() > p_now)
+			return false;
+
+		m_tick++;
+		return true;
+	}
+	void FixedTimestep::skip_missed(Clock::time_point p_now)
+	{
+		m_tick = std::max(m_tick, last_tick_due(p_now));
+	}
+	void FixedTimestep::limit_backlog(Clock::time_point p_now, Clock::duration p_max_behind)
+	{
+		if (p_now - current_time() > p_max_behind)
+			skip_missed(p_now - p_max_behind);
+	}
+
+	FixedTimestep::Clock::time_point FixedTimestep::tick_time(uint64_t p_tick) const
+	{
+		// Whole seconds and the remaining ticks are converted separately so the product can't overflow for any realistic run time.
+		const uint64_t seconds   = p_tick / m_ticks_per_second;
+		const uint64_t remainder = p_tick % m_ticks_per_second;
+		const uint64_t periods   = seconds * Periods_Per_Second + (remainder * Periods_Per_Second) / m_ticks_per_second;
+		return m_start + Clock::duration(static_cast<Clock::rep>(periods));
+	}
+	uint64_t FixedTimestep::last_tick_due(Clock::time_point p_now) const
+	{
+		if (p_now <= m_start)
+			return 0;
+
+		// Inverse of tick_time. Tick times are rounded down, so tick j of the second is due by the remainder r while
+		// j * Periods_Per_Second < (r + 1) * ticks_per_second. Dividing r * ticks_per_second alone would miss ticks due by r after rounding.
+		const uint64_t periods   = static_cast<uint64_t>((p_now - m_start).count());
+		const uint64_t seconds   = periods / Periods_Per_Second;
+		const uint64_t remainder = periods % Periods_Per_Second;
+		return seconds * m_ticks_per_second + ((remainder + 1) * m_ticks_per_second - 1) / Periods_Per_Second;
+	}
+} // namespace Utility
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Config.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace Utility
+{
+	// A stream of ticks at a fixed rate that can be changed at runtime.
+	// The time of tick n is computed from n as start + n / ticks_per_second in integer Clock periods. No timestep is accumulated so the
+	// stream never drifts however long it runs, at any rate, even rates whose timestep a Clock period can't represent exactly (1/60 s).
+	// Each tick time is rounded down to the Clock period on its own, so consecutive timesteps differ by at most one Clock period.
+	class FixedTimestep
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		FixedTimestep(unsigned p_ticks_per_second, Clock::time_point p_start = Clock::now());
+
+		unsigned ticks_per_second() const { return m_ticks_per_second; }
+		// Change the rate. The following ticks are timed at the new rate from the last consumed tick.
+		void set_ticks_per_second(unsigned p_ticks_per_second);
+		// The time between ticks as a float, use for integration not scheduling.
+		DeltaTime timestep() const { return DeltaTime(1.f / static_cast<float>(m_ticks_per_second)); }
+
+		// The time of the last consumed tick, the time the stream has advanced to.
+		Clock::time_point current_time() const { return tick_time(m_tick); }
+		// The time the next tick is due.
+		Clock::time_point next_tick() const { return tick_time(m_tick + 1); }
+
+		// Advance the stream one tick if the next tick is due by p_now.
+		//@return True if a tick was consumed.
+		bool consume(Clock::time_point p_now);
+		// Advance the stream past every tick due by p_now without running them. Ticks stay on the same phase.
+		void skip_missed(Clock::time_point p_now);
+		// Skip the ticks due more than p_max_behind before p_now so a stall doesn't cause a burst of catch up ticks.
+		void limit_backlog(Clock::time_point p_now, Clock::duration p_max_behind);
+
+	private:
+		Clock::time_point m_start;   // Time of tick 0, moved up to the last consumed tick when the rate changes.
+		uint64_t m_tick;             // Ticks consumed since m_start.
+		unsigned m_ticks_per_second;
+
+		Clock::time_point tick_time(uint64_t p_tick) const;
+		// The last tick due by p_now.
+		uint64_t last_tick_due(Clock::time_point p_now) const;
+	};
+} // namespace Utility
@@ -1,6 +1,8 @@
 #include "Logger.hpp"
 
-#include "UI/Editor.hpp"
+#ifndef Z_HEADLESS
+	#include "UI/Editor.hpp"
+#endif
 
 #include <iostream>
 #include <stdexcept>
@@ -9,11 +11,13 @@ void Logger::log_info(const std::string& p_message)
 {
 	const auto info_str = std::format("[INFO] {}", p_message);
 
+#ifndef Z_HEADLESS // No Editor to sink to.
 	if constexpr (s_log_to_editor)
 	{
 		if (s_editor_sink)
 			s_editor_sink->log(info_str);
 	}
+#endif
 
 	if constexpr (s_log_to_console)
 		std::cout << info_str << std::endl;
@@ -25,11 +29,13 @@ void Logger::log_warning(const std::string& p_message, const std::source_locatio
 {
 	const auto warn_str = std::format("[WARNING] {} -{}", p_message, to_string(p_location));
 
+#ifndef Z_HEADLESS // No Editor to sink to.
 	if constexpr (s_log_to_editor)
 	{
 		if (s_editor_sink)
 			s_editor_sink->log_warning(warn_str);
 	}
+#endif
 
 	if constexpr (s_log_to_console)
 		std::cout << warn_str << std::endl;
@@ -41,11 +47,13 @@ void Logger::log_error(const std::string& p_message, const std::source_location&
 {
 	const auto error_str = std::format("[ERROR] {} -{}", p_message, to_string(p_location));
 
+#ifndef Z_HEADLESS // No Editor to sink to.
 	if constexpr (s_log_to_editor)
 	{
 		if (s_editor_sink)
 			s_editor_sink->log_error(error_str);
 	}
+#endif
 
 	if constexpr (s_log_to_console)
 		std::cout << error_str << std::endl;
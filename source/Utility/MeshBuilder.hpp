@@ -63,7 +63,7 @@ namespace Utility
 		}
 		[[nodiscard]] Data::Mesh get_mesh()
 		{
-			return Data::Mesh{data, primitive_mode};
+			return Data::Mesh{data, primitive_mode, build_collision_shape};
 		}
 
 	private:
@@ -0,0 +1,108 @@
+#include "PreciseSleeper.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+	#include <sys/timerfd.h>
+	#include <time.h>
+	#include <unistd.h>
+#endif
+
+namespace Utility
+{
+	constexpr auto Min_Spin_Margin     = std::chrono::microseconds(50);
+	constexpr auto Max_Spin_Margin     = std::chrono::milliseconds(2);
+	constexpr auto Initial_Spin_Margin = std::chrono::milliseconds(1);
+
+	static double to_microseconds(PreciseSleeper::Clock::duration p_duration)
+	{
+		return std::chrono::duration<double, std::micro>(p_duration).count();
+	}
+
+	void PreciseSleeper::Statistics::add(double p_value)
+	{
+		count++;
+		min = count == 1 ? p_value : std::min(min, p_value);
+		max = count == 1 ? p_value : std::max(max, p_value);
+
+		const double delta = p_value - mean;
+		mean += delta / static_cast<double>(count);
+		m_sum_squared_deviation += delta * (p_value - mean);
+	}
+	double PreciseSleeper::Statistics::standard_deviation() const
+	{
+		return count > 1 ? std::sqrt(m_sum_squared_deviation / static_cast<double>(count - 1)) : 0.0;
+	}
+
+	PreciseSleeper::PreciseSleeper()
+		: m_spin_margin{Initial_Spin_Margin}
+		, m_coarse_error{}
+		, m_oversleep{}
+		, m_spin{}
+#ifdef __linux__
+		, m_timer_fd{timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC)} // steady_clock is CLOCK_MONOTONIC on Linux.
+#endif
+	{}
+	PreciseSleeper::~PreciseSleeper()
+	{
+#ifdef __linux__
+		if (m_timer_fd != -1)
+			close(m_timer_fd);
+#endif
+	}
+
+	void PreciseSleeper::sleep_until(Clock::time_point p_deadline)
+	{
+		if (Clock::now() >= p_deadline)
+			return;
+
+		const Clock::time_point wake_time = p_deadline - m_spin_margin;
+		if (Clock::now() < wake_time)
+		{
+			coarse_sleep_until(wake_time);
+			const Clock::time_point woke = Clock::now();
+			m_coarse_error.add(to_microseconds(woke - wake_time));
+
+			// Cover all but the rarest late wake-ups so the spin, not the coarse sleep, decides when we return.
+			const auto margin = std::chrono::duration<double, std::micro>(m_coarse_error.mean + 3.0 * m_coarse_error.standard_deviation());
+			m_spin_margin = std::clamp(std::chrono::duration_cast<Clock::duration>(margin), Clock::duration(Min_Spin_Margin), Clock::duration(Max_Spin_Margin));
+		}
+
+		const Clock::time_point spin_start = Clock::now();
+		Clock::time_point now              = spin_start;
+		while (now < p_deadline)
+		{
+			std::this_thread::yield();
+			now = Clock::now();
+		}
+
+		m_spin.add(to_microseconds(std::max(p_deadline - spin_start, Clock::duration::zero())));
+		m_oversleep.add(to_microseconds(now - p_deadline));
+	}
+
+	void PreciseSleeper::coarse_sleep_until(Clock::time_point p_wake_time)
+	{
+#ifdef __linux__
+		if (m_timer_fd != -1)
+		{
+			const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(p_wake_time.time_since_epoch()).count();
+			itimerspec timer{};
+			timer.it_value.tv_sec  = static_cast<time_t>(since_epoch / 1'000'000'000);
+			timer.it_value.tv_nsec = static_cast<long>(since_epoch % 1'000'000'000);
+
+			if (timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &timer, nullptr) == 0)
+			{
+				// Blocks until the timer expires. An interrupted read wakes early, the spin makes up the difference.
+				uint64_t expirations = 0;
+				const auto bytes_read = read(m_timer_fd, &expirations, sizeof(expirations));
+				(void)bytes_read;
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_until(p_wake_time);
+	}
+} // namespace Utility
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace Utility
+{
+	// Sleeps the calling thread until a deadline, waking as close to it as possible without burning a core while waiting.
+	// OS sleeps wake late by an unpredictable amount, so the thread sleeps until a margin before the deadline then spins the rest.
+	// The margin adapts to how late the coarse sleeps have been waking. On Linux the coarse sleep is a timerfd on the absolute
+	// deadline, which wakes within tens of microseconds, elsewhere std::this_thread::sleep_until.
+	// A PreciseSleeper is owned by one thread.
+	class PreciseSleeper
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Running mean, standard deviation and range of a series of durations in microseconds.
+		struct Statistics
+		{
+			size_t count = 0;
+			double mean  = 0.0;
+			double min   = 0.0;
+			double max   = 0.0;
+
+			void add(double p_value);
+			double standard_deviation() const;
+
+		private:
+			double m_sum_squared_deviation = 0.0; // Welford's M2.
+		};
+
+		PreciseSleeper();
+		~PreciseSleeper();
+		PreciseSleeper(const PreciseSleeper& p_other)            = delete;
+		PreciseSleeper& operator=(const PreciseSleeper& p_other) = delete;
+
+		// Block until p_deadline. Returns immediately if p_deadline has passed.
+		void sleep_until(Clock::time_point p_deadline);
+
+		// How late each sleep_until returned after its deadline. The standard deviation is the wake-up jitter.
+		const Statistics& oversleep() const { return m_oversleep; }
+		// How long each sleep_until spent spinning after the coarse sleep, the CPU time paid for precision.
+		const Statistics& spin() const { return m_spin; }
+
+	private:
+		Clock::duration m_spin_margin; // The coarse sleep ends this long before the deadline.
+		Statistics m_coarse_error;     // How late coarse sleeps woke relative to their requested time, drives m_spin_margin.
+		Statistics m_oversleep;
+		Statistics m_spin;
+#ifdef __linux__
+		int m_timer_fd; // -1 if a timerfd couldn't be created.
+#endif
+
+		void coarse_sleep_until(Clock::time_point p_wake_time);
+	};
+} // namespace Utility
@@ -0,0 +1,123 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace Utility
+{
+	ThreadPool::ThreadPool(size_t p_thread_count)
+		: m_workers{}
+		, m_mutex{}
+		, m_work_available{}
+		, m_work_done{}
+		, m_task{nullptr}
+		, m_task_count{0}
+		, m_next_task{0}
+		, m_tasks_completed{0}
+		, m_busy_workers{0}
+		, m_generation{0}
+		, m_stop{false}
+	{
+		m_workers.reserve(p_thread_count);
+		for (size_t i = 0; i < p_thread_count; i++)
+			m_workers.emplace_back([this]() { worker_loop(); });
+	}
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stop = true;
+		}
+		m_work_available.notify_all();
+
+		for (auto& worker : m_workers)
+			worker.join();
+	}
+
+	void ThreadPool::worker_loop()
+	{
+		uint64_t last_generation = 0;
+		while (true)
+		{
+			const std::function<void(size_t)>* task = nullptr;
+			size_t task_count = 0;
+			{
+				std::unique_lock lock(m_mutex);
+				m_work_available.wait(lock, [&]() { return m_stop || m_generation != last_generation; });
+				if (m_stop)
+					return;
+
+				last_generation = m_generation;
+				if (!m_task)
+					continue; // Woke after the parallel_for had already finished without this worker.
+
+				task            = m_task;
+				task_count      = m_task_count;
+				m_busy_workers++;
+			}
+
+			run_tasks(*task, task_count);
+
+			{
+				std::lock_guard lock(m_mutex);
+				m_busy_workers--;
+			}
+			m_work_done.notify_all();
+		}
+	}
+
+	void ThreadPool::run_tasks(const std::function<void(size_t)>& p_task, size_t p_task_count)
+	{
+		for (size_t i = m_next_task.fetch_add(1, std::memory_order_relaxed); i < p_task_count; i = m_next_task.fetch_add(1, std::memory_order_relaxed))
+		{
+			p_task(i);
+			m_tasks_completed.fetch_add(1, std::memory_order_release);
+		}
+	}
+
+	void ThreadPool::parallel_for(size_t p_count, const std::function<void(size_t)>& p_task)
+	{
+		if (p_count == 0)
+			return;
+
+		if (m_workers.empty() || p_count == 1)
+		{
+			for (size_t i = 0; i < p_count; i++)
+				p_task(i);
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_mutex);
+			m_task       = &p_task;
+			m_task_count = p_count;
+			m_next_task.store(0, std::memory_order_relaxed);
+			m_tasks_completed.store(0, std::memory_order_relaxed);
+			m_generation++;
+		}
+		m_work_available.notify_all();
+
+		run_tasks(p_task, p_count);
+
+		std::unique_lock lock(m_mutex);
+		m_work_done.wait(lock, [&]() { return m_busy_workers == 0 && m_tasks_completed.load(std::memory_order_acquire) == p_count; });
+		m_task = nullptr;
+	}
+
+	void ThreadPool::parallel_for_ranges(size_t p_count, size_t p_min_range, const std::function<void(size_t, size_t)>& p_task)
+	{
+		if (p_count == 0)
+			return;
+
+		// Over-split by 4 ranges per thread so a thread that gets descheduled doesn't hold up the whole call.
+		const size_t range_count = std::clamp(p_count / std::max(p_min_range, size_t(1)), size_t(1), concurrency() * 4);
+		const size_t range_size  = (p_count + range_count - 1) / range_count;
+
+		parallel_for(range_count, [&](size_t p_range)
+		{
+			const size_t begin = p_range * range_size;
+			const size_t end   = std::min(begin + range_size, p_count);
+			if (begin < end)
+				p_task(begin, end);
+		});
+	}
+} // namespace Utility
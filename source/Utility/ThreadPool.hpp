@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utility
+{
+	// A fixed set of worker threads kept alive between calls so dispatching work each tick doesn't pay for thread creation.
+	// Work is submitted as a parallel_for over independent indices. The calling thread takes part and the call blocks until every index is done.
+	// Only one parallel_for can run at a time, nested or concurrent calls from different threads are not supported.
+	class ThreadPool
+	{
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_work_available;
+		std::condition_variable m_work_done;
+
+		// State of the current parallel_for. Written under m_mutex before m_generation is incremented.
+		const std::function<void(size_t)>* m_task;
+		size_t m_task_count;
+		std::atomic<size_t> m_next_task;
+		std::atomic<size_t> m_tasks_completed;
+		size_t m_busy_workers;  // Workers inside run_tasks. parallel_for waits for 0 before returning so no worker can claim an index of the next call.
+		uint64_t m_generation;  // Incremented per parallel_for, workers compare against the last generation they ran.
+		bool m_stop;
+
+		void worker_loop();
+		void run_tasks(const std::function<void(size_t)>& p_task, size_t p_task_count);
+
+	public:
+		// Create a pool with p_thread_count workers. The calling thread of parallel_for is an extra worker so the default leaves one core for it.
+		explicit ThreadPool(size_t p_thread_count = std::max(std::thread::hardware_concurrency(), 1u) - 1);
+		~ThreadPool();
+		ThreadPool(const ThreadPool& p_other)            = delete;
+		ThreadPool& operator=(const ThreadPool& p_other) = delete;
+
+		// Number of threads work is spread over, including the calling thread.
+		size_t concurrency() const { return m_workers.size() + 1; }
+
+		// Call p_task(i) for every i in [0, p_count). Indices are claimed dynamically so uneven tasks balance across the threads.
+		void parallel_for(size_t p_count, const std::function<void(size_t)>& p_task);
+		// Split [0, p_count) into contiguous ranges of at least p_min_range and call p_task(begin, end) for each.
+		// Ranges keep each thread on a contiguous block of memory, use this over parallel_for when the per-index work is small.
+		void parallel_for_ranges(size_t p_count, size_t p_min_range, const std::function<void(size_t, size_t)>& p_task);
+	};
+} // namespace Utility
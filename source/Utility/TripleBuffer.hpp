@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Utility
+{
+	// Lock-free hand-off of the latest T from one writer thread to one reader thread.
+	// The writer fills write_buffer() then publish()es it, the reader calls update() then reads read_buffer().
+	// Of the three buffers one is owned by the writer, one by the reader and one is shared between them. publish and update swap their
+	// own buffer with the shared one using a single atomic exchange, so neither thread ever waits on or sees a partially written T.
+	// The writer never blocks and may publish faster than the reader updates, the reader then skips to the latest published T.
+	template <typename T>
+	class TripleBuffer
+	{
+		static constexpr uint8_t Index_Mask = 0b011;
+		static constexpr uint8_t Fresh_Bit  = 0b100; // Set in m_shared when the shared buffer was published but not yet taken by update.
+
+		std::array<T, 3> m_buffers;
+		uint8_t m_write_index;          // Only accessed by the writer.
+		uint8_t m_published_index;      // Only accessed by the writer.
+		std::atomic<uint8_t> m_shared;  // Index of the shared buffer | Fresh_Bit.
+		uint8_t m_read_index;           // Only accessed by the reader.
+
+	public:
+		TripleBuffer()
+			: m_buffers{}
+			, m_write_index{0}
+			, m_published_index{1}
+			, m_shared{1}
+			, m_read_index{2}
+		{}
+		TripleBuffer(const TripleBuffer& p_other)            = delete;
+		TripleBuffer& operator=(const TripleBuffer& p_other) = delete;
+
+		// Writer: the buffer to fill before the next publish. Holds an older published T, not necessarily the last one.
+		T& write_buffer() { return m_buffers[m_write_index]; }
+		// Writer: make write_buffer() the latest T and take the shared buffer to write next.
+		void publish()
+		{
+			const uint8_t previous = m_shared.exchange(m_write_index | Fresh_Bit, std::memory_order_acq_rel);
+			m_published_index = m_write_index;
+			m_write_index     = previous & Index_Mask;
+		}
+		// Writer: the T of the last publish, default constructed before the first.
+		// Safe to read alongside the reader as the writer can only be handed it back to write by publishing another.
+		const T& published_buffer() const { return m_buffers[m_published_index]; }
+
+		// Reader: take the latest published T if there is one newer than read_buffer().
+		//@return True if read_buffer() changed.
+		bool update()
+		{
+			if (!(m_shared.load(std::memory_order_relaxed) & Fresh_Bit))
+				return false;
+
+			const uint8_t previous = m_shared.exchange(m_read_index, std::memory_order_acq_rel);
+			m_read_index = previous & Index_Mask;
+			return true;
+		}
+		// Reader: the T taken by the last update. Unchanged until the next update.
+		const T& read_buffer() const { return m_buffers[m_read_index]; }
+	};
+} // namespace Utility
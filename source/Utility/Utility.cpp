@@ -3,6 +3,7 @@
 
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <atomic>
 #include <numbers>
 
 namespace Utility
@@ -12,6 +13,21 @@ namespace Utility
 		return std::abs(p_a - p_b) < p_epsilon;
 	}
 
+	static std::atomic<bool> s_random_seeded = false;
+	static std::atomic<std::mt19937::result_type> s_random_seed = 0;
+
+	std::mt19937& random_engine()
+	{
+		thread_local std::mt19937 engine = s_random_seeded ? std::mt19937(s_random_seed.load()) : std::mt19937(std::random_device()());
+		return engine;
+	}
+	void set_random_seed(std::mt19937::result_type p_seed)
+	{
+		s_random_seed   = p_seed;
+		s_random_seeded = true;
+		random_engine().seed(p_seed);
+	}
+
 	glm::mat4 make_model_matrix(const glm::vec3& p_position, const glm::vec3& p_rotation, const glm::vec3& p_scale)
 	{
 		glm::mat4 model = glm::translate(glm::identity<glm::mat4>(), p_position);
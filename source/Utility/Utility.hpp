@@ -24,6 +24,13 @@ namespace Utility
 	// @param p_epsilon: The maximum difference between the two values for them to be considered similar.
 	bool equal_floats(const float p_a, const float p_b, const float p_epsilon = EPSILON);
 
+	// The engine behind every random number of the application, one per thread.
+	// Seeded non-deterministically unless set_random_seed was called, after which each thread's engine starts from that seed.
+	std::mt19937& random_engine();
+	// Make the random numbers reproducible, e.g. for benchmarks. Reseeds the calling thread's engine immediately,
+	// the other threads take the seed when they first use random_engine.
+	void set_random_seed(std::mt19937::result_type p_seed);
+
 	// Produces a random floating-point value in the interval min to max
 	// Satisfies all requirements of RandomNumberDistribution (https://en.cppreference.com/w/cpp/numeric/random/uniform_real_distribution)
 	template<class T>
@@ -32,8 +39,7 @@ namespace Utility
 		// Use std::uniform_real_distribution to transform the random unsigned int generated by std::mt19937 into a type in [p_min, p_max).
 		// Each call to dis(gen) generates a new random.
 
-		std::random_device rd;  // Will be used to obtain a seed for the random number engine
-		std::mt19937 gen(rd()); // Standard mersenne_twister_engine seeded with rd()
+		std::mt19937& gen = random_engine();
 		std::uniform_real_distribution<T> dis(p_min, p_max);
 		return dis(gen);
 	}
@@ -46,8 +52,7 @@ namespace Utility
 		// Use std::uniform_real_distribution to transform the random unsigned int generated by std::mt19937 into a type in [p_min, p_max).
 		// Each call to dis(gen) generates a new random.
 
-		std::random_device rd;  // Will be used to obtain a seed for the random number engine
-		std::mt19937 gen(rd()); // Standard mersenne_twister_engine seeded with rd()
+		std::mt19937& gen = random_engine();
 		std::uniform_real_distribution<T> dis(p_min, p_max);
 
 		for (size_t i = 0; i < p_array.size(); i++)
@@ -61,8 +66,7 @@ namespace Utility
 		// Use std::uniform_real_distribution to transform the random unsigned int generated by std::mt19937 into a type in [p_min, p_max).
 		// Each call to dis(gen) generates a new random.
 
-		std::random_device rd;  // Will be used to obtain a seed for the random number engine
-		std::mt19937 gen(rd()); // Standard mersenne_twister_engine seeded with rd()
+		std::mt19937& gen = random_engine();
 		std::uniform_real_distribution<T> dis(p_min, p_max);
 
 		std::vector<T> vec;